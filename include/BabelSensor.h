@@ -4,19 +4,33 @@
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 #include <WString.h>
+#include "HubSensorList.h"
+#include "MQTTRouter.h"
+#include "PollInterval.h"
 
 class BabelSensor {
     public:
         BabelSensor(const char* serverUrl);
         bool init();
-        bool login(const char* username, const char* password);
+        // Polls the hub over HTTP (rate limited) and returns the latest value
         float getRemoteTemperature();
-        bool isAuthenticated() const { return !authToken.isEmpty(); }
+        float getLastTemperature() const { return lastTemperature; }
+        // millis() when the hub last reported or confirmed that value; 0 if never
+        unsigned long getLastReadingTime() const { return lastReadingAt; }
+        // Applies a reading pushed by the hub over MQTT; true if it held any
+        bool applyMqttPayload(MQTTPayload payload);
+        bool isAuthenticated() const;
+        // Adapted to how often the hub's readings actually change
+        unsigned long getPollInterval() const { return pollInterval.get(); }
     
     private:
-        String serverUrl;
-        String authToken;
-        unsigned long lastUpdate;
+        static bool applySensor(const HubSensorList::Sensor& sensor, bool& found, float& temperature);
+
+        unsigned long lastPoll;
+        unsigned long lastFullUpdate;
+        PollInterval pollInterval;
         float lastTemperature;
-        static constexpr unsigned long UPDATE_INTERVAL = 30000; // 30 seconds
+        unsigned long lastReadingAt;
+        String etag;
+        String lastModified;
 };
\ No newline at end of file
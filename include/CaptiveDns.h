@@ -0,0 +1,45 @@
+// CaptiveDns.h
+#pragma once
+
+#include <Arduino.h>
+
+// DNS responder for the setup access point: every A query is answered with
+// the portal's own address, so whatever a phone or laptop looks up lands on
+// the setup page. Other record types get an empty answer, which makes clients
+// fall back to A instead of treating the name as missing.
+//
+// The socket is non-blocking and owns no task. Whoever runs it selects on
+// fd() and calls poll() when it is readable; in the firmware that is the HTTP
+// server task, which watches the socket alongside its connections.
+class CaptiveDns {
+public:
+    static constexpr uint16_t PORT = 53;
+    static constexpr size_t PACKET_SIZE = 512;      // Largest plain UDP DNS message
+    static constexpr uint32_t TTL = 60;
+
+    CaptiveDns();
+    ~CaptiveDns();
+
+    // `address` is in network byte order, as IPAddress converts to uint32_t
+    bool begin(uint32_t address, uint16_t port = PORT);
+    void stop();
+    bool isRunning() const { return _fd >= 0; }
+    int fd() const { return _fd; }
+    uint32_t address() const { return _address; }
+
+    // Answers every query waiting on the socket, without blocking
+    void poll();
+
+    // Builds the reply to one query and returns its length, or 0 when the
+    // message is to be ignored. `response` may be the query buffer itself.
+    static size_t answer(const uint8_t* query, size_t length, uint32_t address,
+                         uint8_t* response, size_t capacity);
+
+    CaptiveDns(const CaptiveDns&) = delete;
+    CaptiveDns& operator=(const CaptiveDns&) = delete;
+
+private:
+    int _fd;
+    uint32_t _address;
+    uint8_t _packet[PACKET_SIZE];
+};
@@ -5,17 +5,19 @@
 
 class CustomHash {
 public:
+    static constexpr size_t SHA256_SIZE = 32;
+
+    static void sha256(const uint8_t* data, size_t length, uint8_t (&digest)[SHA256_SIZE]) {
+        mbedtls_md(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), data, length, digest);
+    }
+
+    static void sha256(const String& input, uint8_t (&digest)[SHA256_SIZE]) {
+        sha256(reinterpret_cast<const uint8_t*>(input.c_str()), input.length(), digest);
+    }
+
     static String sha256(const String& input) {
-        byte shaResult[32];
-        mbedtls_md_context_t ctx;
-        mbedtls_md_type_t md_type = MBEDTLS_MD_SHA256;
-        
-        mbedtls_md_init(&ctx);
-        mbedtls_md_setup(&ctx, mbedtls_md_info_from_type(md_type), 0);
-        mbedtls_md_starts(&ctx);
-        mbedtls_md_update(&ctx, (const unsigned char*)input.c_str(), input.length());
-        mbedtls_md_finish(&ctx, shaResult);
-        mbedtls_md_free(&ctx);
+        uint8_t shaResult[SHA256_SIZE];
+        sha256(input, shaResult);
         
         String hashStr = "";
         for(int i= 0; i< 32; i++) {
@@ -26,4 +28,13 @@ public:
         
         return hashStr;
     }
+
+    // 32-bit FNV-1a; chain calls by passing the previous result as `hash`
+    static uint32_t fnv1a(const char* data, uint32_t hash = 2166136261u) {
+        while (*data) {
+            hash ^= (uint8_t)*data++;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
 };
\ No newline at end of file
@@ -117,6 +117,7 @@ class DisplayHandler {
         bool displayValid;
         DisplayMode currentMode;
         unsigned long modeStartTime;
+        uint8_t remoteSlots;
         unsigned long lastUpdate;
         uint8_t currentBrightness;
         DisplayPreferences displayPreferences;
@@ -141,10 +142,14 @@ class DisplayHandler {
         void showHumidity(float humidity);
         void showPressure(float pressure);
         void showRemoteTemp(float temp);
+        void showRemoteIndex(uint8_t index);
         void test();
     
         // Existing public methods
         DisplayMode getCurrentMode() const { return currentMode; }
+        unsigned long getModeElapsed() const { return millis() - modeStartTime; }
+        // The remote temperature page lasts one DISPLAY_REMOTE_DURATION per slot
+        void setRemoteSlots(uint8_t slots) { remoteSlots = slots > 0 ? slots : 1; }
         void setDisplayPreferences(const DisplayPreferences& prefs);
         const DisplayPreferences& getDisplayPreferences() const { return displayPreferences; }
         void applyNightModeBrightness(int currentHour);
@@ -0,0 +1,36 @@
+// EventChannel.h
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+// Server-sent events transport: up to MAX_CLIENTS sockets taken over from
+// HttpServer, each event framed into a fixed buffer and written without
+// waiting. A client that can't take a whole event at once is stalled or
+// gone and is dropped, so one slow page never holds up the rest. Not
+// thread-safe; EventStream calls it from the HTTP server task only.
+class EventChannel {
+public:
+    static constexpr size_t MAX_CLIENTS = 4;
+    static constexpr size_t EVENT_BUFFER_SIZE = 320;
+    static constexpr unsigned long RECONNECT_DELAY = 3000;
+
+    // Answers the request with the event-stream head. False, with nothing
+    // written, when every slot is taken; false when the client is gone.
+    bool open(WiFiClient& client);
+    // Takes a slot for a client that open() accepted
+    bool add(WiFiClient& client);
+
+    // One event to one client; a client the event can't reach is stopped
+    bool send(WiFiClient& client, const char* event, const char* data);
+    void broadcast(const char* event, const char* data);
+    // Comment line that keeps idle connections from being reaped by proxies
+    void keepalive();
+
+    size_t clientCount() const;
+
+private:
+    WiFiClient* freeSlot();
+
+    WiFiClient clients[MAX_CLIENTS];
+};
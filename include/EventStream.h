@@ -0,0 +1,39 @@
+// EventStream.h
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include "EventChannel.h"
+
+// Server-sent events channel behind /api/events. The handler hands the
+// request's socket over to this class instead of answering it; from then on
+// the stream pushes relay and sensor changes to every open page over an
+// EventChannel. All writes happen on the HTTP server task, so clients need
+// no locking.
+class EventStream {
+public:
+    static constexpr size_t MAX_CLIENTS = EventChannel::MAX_CLIENTS;
+    static constexpr unsigned long KEEPALIVE_INTERVAL = 15000;
+    static constexpr unsigned long SENSOR_EVENT_INTERVAL = 5000;
+
+    static EventStream& getInstance();
+
+    bool subscribe(WiFiClient& client);
+    void loop();
+    size_t clientCount() const { return channel.clientCount(); }
+
+    EventStream(const EventStream&) = delete;
+    EventStream& operator=(const EventStream&) = delete;
+
+private:
+    EventStream();
+
+    void formatSensors(char* buffer, size_t size) const;
+
+    EventChannel channel;
+    uint32_t relayVersion;
+    uint32_t sensorStamp;
+    float remoteTemperature;
+    unsigned long lastKeepalive;
+    unsigned long lastSensorEvent;
+};
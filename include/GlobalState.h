@@ -26,12 +26,22 @@ public:
     float getHumidity() const { return sensorData.humidity; }
     float getPressure() const { return sensorData.pressure; }
     float getRemoteTemperature() const { return sensorData.remoteTemperature; }
+    uint32_t getLastSensorUpdate() const { return sensorData.lastUpdate; }
+    // When the hub last reported or confirmed the remote temperature; 0 if never
+    uint32_t getLastRemoteUpdate() const { return sensorData.lastRemoteUpdate; }
     bool isBMEWorking() const { return systemStatus.bmeWorking; }
+    uint32_t getFreeHeap() const { return systemStatus.freeHeap; }
+    uint32_t getUptime() const { return systemStatus.uptime; }
     DisplayHandler* getDisplay() { return display; }
     SemaphoreHandle_t getMutex() const { return mutex; }
 
     // Setters
     void setBMEWorking(bool status) { systemStatus.bmeWorking = status; }
+    // Refreshed from the main loop whenever Metrics::sample() runs
+    void updateSystemStats(uint32_t freeHeap, uint32_t uptime) {
+        systemStatus.freeHeap = freeHeap;
+        systemStatus.uptime = uptime;
+    }
     void setMutex(SemaphoreHandle_t newMutex) { mutex = newMutex; }
     
     void updateSensorData(float temp, float hum, float pres) {
@@ -41,8 +51,9 @@ public:
         sensorData.lastUpdate = millis();
     }
 
-    void setRemoteTemperature(float temp) { 
-        sensorData.remoteTemperature = temp; 
+    void setRemoteTemperature(float temp, uint32_t readAt) {
+        sensorData.remoteTemperature = temp;
+        sensorData.lastRemoteUpdate = readAt;
     }
 
     void setDisplay(DisplayHandler* newDisplay) { 
@@ -61,6 +72,7 @@ private:
         float pressure;
         float remoteTemperature;
         uint32_t lastUpdate;
+        uint32_t lastRemoteUpdate;
     };
 
     struct SystemStatus {
@@ -0,0 +1,73 @@
+// Histogram.h
+#pragma once
+
+#include <Arduino.h>
+
+// Fixed-bucket histogram. Bucket i counts values <= bounds[i]; one extra
+// overflow bucket counts everything above the last bound. No allocation,
+// constant-time record.
+//
+// Count holds the counters, minimum and maximum and Sum the running total.
+// Both default to plain integers; any type that converts to and from
+// uint32_t (Count) or uint64_t (Sum) and supports ++ or += works, such as
+// the lock-free ones in Metrics.h.
+template <size_t N, typename Count = uint32_t, typename Sum = uint64_t>
+class FixedHistogram {
+public:
+    explicit FixedHistogram(const uint32_t (&bounds)[N]) : bounds(bounds) {
+        reset();
+    }
+
+    void record(uint32_t value) {
+        size_t i = 0;
+        while (i < N && value > bounds[i]) i++;
+        buckets[i]++;
+        total++;
+        sum += value;
+        if (value < minimum) minimum = value;
+        if (value > maximum) maximum = value;
+    }
+
+    void reset() {
+        for (Count& bucket : buckets) bucket = 0;
+        total = 0;
+        sum = 0;
+        minimum = UINT32_MAX;
+        maximum = 0;
+    }
+
+    // Upper bound of the bucket holding the given percentile (0-100). Values
+    // in the overflow bucket report the largest value seen.
+    uint32_t percentile(uint8_t percent) const {
+        uint32_t n = total;
+        if (n == 0) return 0;
+        uint32_t rank = ((uint64_t)n * percent + 99) / 100;
+        if (rank == 0) rank = 1;
+        uint32_t seen = 0;
+        for (size_t i = 0; i < N; i++) {
+            seen += buckets[i];
+            if (seen >= rank) return bounds[i];
+        }
+        return maximum;
+    }
+
+    uint32_t count() const { return total; }
+    uint64_t getSum() const { return sum; }
+    uint32_t mean() const {
+        uint32_t n = total;
+        return n ? (uint32_t)(getSum() / n) : 0;
+    }
+    uint32_t getMin() const { return count() ? (uint32_t)minimum : 0; }
+    uint32_t getMax() const { return maximum; }
+    uint32_t bucket(size_t i) const { return i <= N ? buckets[i] : 0; }
+    uint32_t bound(size_t i) const { return i < N ? bounds[i] : UINT32_MAX; }
+    static constexpr size_t bucketCount() { return N + 1; }
+
+private:
+    const uint32_t (&bounds)[N];
+    Count buckets[N + 1];
+    Count total;
+    Sum sum;
+    Count minimum;
+    Count maximum;
+};
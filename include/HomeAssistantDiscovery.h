@@ -0,0 +1,43 @@
+// HomeAssistantDiscovery.h
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+class MQTTManager;
+
+// Publishes Home Assistant MQTT discovery configs for the clock's sensors and
+// relays. Payloads are generated once into SPIFFS and published as retained
+// messages; both steps are keyed on a stamp of the firmware version and the
+// topic configuration, so a reconnect with an unchanged stamp sends nothing.
+class HomeAssistantDiscovery {
+public:
+    static void publish(MQTTManager& mqtt, const String& nodeId);
+    static void invalidate();
+
+private:
+    struct Entity {
+        const char* component;
+        const char* objectId;
+        const char* name;
+        const char* deviceClass;
+        const char* unit;
+        const char* valueKey;
+        int8_t relayId;
+    };
+
+    static const Entity ENTITIES[];
+    static const size_t ENTITY_COUNT;
+
+    static uint32_t computeStamp(const String& nodeId);
+    static bool readStamp(const char* path, uint32_t& stamp);
+    static bool writeStamp(const char* path, uint32_t stamp);
+    static bool generateCache(const String& nodeId);
+    static void buildPayload(const Entity& entity, const String& nodeId, JsonDocument& doc);
+    static String discoveryTopic(const Entity& entity, const String& nodeId);
+    static String cachePath(size_t index);
+
+    static const char* CACHE_DIR;
+    static const char* CACHE_STAMP_PATH;
+    static const char* SENT_STAMP_PATH;
+};
@@ -0,0 +1,200 @@
+// HttpServer.h
+#pragma once
+
+#include <Arduino.h>
+#include <HTTP_Method.h>
+#include <WiFiClient.h>
+#include <functional>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "ResponseStream.h"
+
+// Event-driven HTTP/1.1 server on the lwIP socket API. One task multiplexes
+// the listening socket and every open connection with select(), so a slow
+// client only ever holds its own connection. The request/response calls
+// mirror the subset of Arduino's WebServer that the handlers use.
+//
+// Handlers run on the server task and must not block. A handler whose answer
+// takes long (a WiFi scan, an upstream call) takes a ticket with defer(),
+// hands the work to another task and returns; that task later answers with
+// complete(), which is safe to call from anywhere.
+//
+// A body produced piece by piece goes out with beginChunked(), sendChunk()
+// and endChunked(). Each chunk is written to the socket at once; only what
+// the socket can't take right away is queued in memory, up to
+// MAX_STREAM_BACKLOG. A client that falls further behind is disconnected
+// and sendChunk() returns false, so the producer can stop.
+class HttpServer final : public ResponseStream {
+public:
+    using Handler = std::function<void()>;
+    using RequestHandler = void (*)();
+    // Maps a request to its handler; nullptr falls through to onNotFound. The
+    // request accessors are already valid when it runs.
+    using Resolver = RequestHandler (*)(HTTPMethod method, const char* uri);
+    using Ticket = uint32_t;
+
+    static constexpr size_t MAX_CONNECTIONS = 6;
+    static constexpr size_t MAX_WATCHED = 5;  // DNS responder plus the relay sockets
+    static constexpr size_t MAX_COLLECTED_HEADERS = 5;
+    static constexpr size_t HEAD_BUFFER_SIZE = 1024;    // Request line plus headers
+    static constexpr size_t MAX_BODY_SIZE = 4096;
+    static constexpr size_t MAX_STREAM_BACKLOG = 2048;  // Streamed bytes queued for a slow client
+    static constexpr unsigned long IDLE_TIMEOUT = 5000;
+    static constexpr unsigned long DEFER_TIMEOUT = 30000;
+    static constexpr uint32_t SELECT_TIMEOUT_MS = 10;  // Also the loop hook period
+
+    explicit HttpServer(uint16_t port);
+    ~HttpServer();
+
+    bool begin();
+    void stop();
+
+    // Routing is set up once, before begin()
+    void setResolver(Resolver resolver) { _resolver = resolver; }
+    void onNotFound(RequestHandler handler) { _notFound = handler; }
+    void collectHeaders(const char* headers[], size_t count);
+
+    // Called on the server task after every select() round
+    void setLoopHook(Handler hook) { _loopHook = hook; }
+
+    // Request accessors, valid inside a handler
+    const String& uri() const;
+    HTTPMethod method() const;
+    String arg(const char* name) const;
+    bool hasArg(const char* name) const;
+    const String& header(const char* name) const;
+    const String& hostHeader() const;
+    // Peer IPv4 address, in network byte order
+    uint32_t remoteAddress() const;
+
+    // Response calls, valid inside a handler
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void send(int code, const char* contentType = nullptr, const String& content = String());
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t length);
+
+    // Streamed response, valid inside a handler. HTTP/1.0 clients get the
+    // raw body and a closed connection instead of chunked coding. A stream
+    // the handler leaves open is ended when it returns.
+    bool beginChunked(int code, const char* contentType) override;
+    bool sendChunk(const char* data, size_t length) override;
+    void endChunked() override;
+
+    // Hands the request's socket over to the caller; the server forgets it.
+    // The socket stays non-blocking: write to it with sendNow().
+    WiFiClient client();
+
+    // Writes to a socket taken with client() without waiting. Returns false
+    // unless all of `data` went out; the peer is then stalled or gone, and
+    // since the message is cut short the caller should drop it.
+    static bool sendNow(int fd, const void* data, size_t length);
+
+    // A socket taken with client() that the loop hook goes on reading can be
+    // watched: select() then also wakes for it, so the hook runs as soon as
+    // data arrives instead of on the next timeout. Server task only; unwatch
+    // before closing.
+    bool watch(int fd);
+    void unwatch(int fd);
+
+    // Deferred responses. defer() returns 0 when no response can be deferred.
+    Ticket defer();
+    bool complete(Ticket ticket, int code, const char* contentType, const String& content);
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+private:
+    enum class State : uint8_t {
+        IDLE,
+        READING_HEAD,
+        READING_BODY,
+        DEFERRED,
+        WRITING
+    };
+
+    struct Connection {
+        int fd;
+        uint32_t peer;              // Peer IPv4 address, network byte order
+        State state;
+        unsigned long lastActivity;
+        char head[HEAD_BUFFER_SIZE];
+        size_t headLength;
+
+        HTTPMethod method;
+        String uri;
+        String query;
+        String body;
+        String host;
+        String contentType;
+        String headers[MAX_COLLECTED_HEADERS];
+        size_t contentLength;
+        bool keepAlive;
+        bool http10;
+        bool chunked;               // Body uses chunked transfer coding
+
+        String response;            // Status line, headers and any copied body
+        const char* staticBody;     // Flash-resident body sent without copying
+        size_t staticLength;
+        size_t sent;
+        Ticket ticket;
+    };
+
+    struct Completion {
+        Ticket ticket;
+        int code;
+        String contentType;
+        String content;
+    };
+
+    static constexpr uint32_t TASK_STACK_SIZE = 8192;
+    static constexpr UBaseType_t TASK_PRIORITY = 1;
+    static constexpr int LISTEN_BACKLOG = 4;
+    static constexpr size_t UNKNOWN_LENGTH = SIZE_MAX;
+    static constexpr size_t HEAD_OVERHEAD = 64;     // Content-Type and Connection lines, final CRLF
+
+    static void serverTask(void* parameter);
+    void run();
+
+    void accept();
+    void receive(Connection& conn);
+    void transmit(Connection& conn);
+    void processHead(Connection& conn);
+    bool parseHead(Connection& conn, size_t headEnd);
+    void dispatch(Connection& conn);
+    void finish(Connection& conn);
+    void close(Connection& conn);
+    void expire(unsigned long now);
+    void drainCompletions();
+
+    bool stream(Connection& conn, const struct iovec* parts, size_t count);
+    void beginResponse(Connection& conn, int code, const char* contentType, size_t length, const String& headers);
+    void fail(Connection& conn, int code, const char* message);
+
+    static void reset(Connection& conn);
+    static bool findArg(const String& params, const char* name, String* value);
+    static String urlDecode(const char* begin, const char* end);
+    static HTTPMethod parseMethod(const char* name, size_t length);
+    static const char* statusText(int code);
+
+    uint16_t _port;
+    int _listenFd;
+    volatile bool _running;
+    TaskHandle_t _task;
+    SemaphoreHandle_t _stopped;
+    QueueHandle_t _completions;
+
+    Connection _connections[MAX_CONNECTIONS];
+    int _watched[MAX_WATCHED];
+    Connection* _current;           // Connection whose handler is running
+    String _pendingHeaders;
+    bool _responded;
+    bool _streaming;                // _current has a chunked response open
+    Ticket _nextTicket;
+
+    Resolver _resolver;
+    RequestHandler _notFound;
+    Handler _loopHook;
+    const char* _collected[MAX_COLLECTED_HEADERS];
+    size_t _collectedCount;
+};
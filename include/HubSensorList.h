@@ -0,0 +1,41 @@
+// HubSensorList.h
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <functional>
+
+// Reads the sensorHUB's sensor list (GET /api/sensors) straight off a stream,
+// one element at a time through a filter that keeps only the fields used
+// here. Memory use is one small fixed document however many sensors the hub
+// lists or however large each of its sensor objects is. MQTT messages from
+// the hub go through the same document.
+class HubSensorList {
+public:
+    static constexpr size_t ID_LENGTH = 24;
+    // The four kept fields, their keys and an id string
+    static constexpr size_t SENSOR_CAPACITY = JSON_OBJECT_SIZE(4) + 128;
+
+    struct Sensor {
+        char id[ID_LENGTH];     // Empty when the hub gave none
+        float value;            // babelTemperature for a Babel sensor, temperature otherwise
+        bool isBabel;
+    };
+
+    // Called for every listed sensor that carries a value, in list order
+    using Visitor = std::function<void(const Sensor& sensor)>;
+
+    // Reads a list through its closing bracket, so a keep-alive connection
+    // is left at the end of the body; false if the list is malformed
+    static bool read(Stream& stream, const Visitor& visit);
+    // One MQTT message, holding a single sensor object or a list of them;
+    // false if it is malformed
+    static bool parse(const uint8_t* data, size_t length, const Visitor& visit);
+
+private:
+    // Keeps the fields toSensor() reads, for one sensor object
+    static void setFilter(JsonObject filter);
+    // False when the sensor carries no value
+    static bool toSensor(JsonObjectConst fields, Sensor& sensor);
+    static int readSeparator(Stream& stream);
+};
@@ -0,0 +1,74 @@
+// JsonStreamWriter.h
+#pragma once
+
+#include <Arduino.h>
+#include "ResponseStream.h"
+
+// Writes a JSON response body straight to the client as it is produced.
+// Output collects in a small fixed buffer that leaves as one chunk whenever it
+// fills, so no body is ever held in memory in full and nothing is allocated
+// for it. Commas are placed here; callers emit keys and values in order:
+//
+//     JsonStreamWriter json(server);
+//     json.beginObject().field("success", true).endObject();
+//
+// Headers must be set before construction. The response is finished when the
+// writer goes out of scope. Once the stream refuses a chunk the rest of the
+// output is discarded; failed() tells a long producer it can stop early.
+class JsonStreamWriter {
+public:
+    static constexpr size_t BUFFER_SIZE = 256;
+    static constexpr size_t MAX_DEPTH = 32;   // One bit of _hasItems per level
+
+    explicit JsonStreamWriter(ResponseStream* stream, int code = 200);
+    ~JsonStreamWriter();
+
+    // A key is only given for members of an object
+    JsonStreamWriter& beginObject(const char* key = nullptr);
+    JsonStreamWriter& endObject();
+    JsonStreamWriter& beginArray(const char* key = nullptr);
+    JsonStreamWriter& endArray();
+
+    JsonStreamWriter& key(const char* name);
+    JsonStreamWriter& value(const char* text);
+    JsonStreamWriter& value(bool flag);
+    JsonStreamWriter& value(int number);
+    JsonStreamWriter& value(unsigned number);
+    JsonStreamWriter& value(long number);
+    JsonStreamWriter& value(unsigned long number);
+    JsonStreamWriter& value(double number);     // Non-finite values become null
+    JsonStreamWriter& null();
+
+    template <typename T>
+    JsonStreamWriter& field(const char* name, T content) {
+        return key(name).value(content);
+    }
+
+    // Sends what is buffered and ends the response
+    void end();
+    bool failed() const { return _failed; }
+
+    JsonStreamWriter(const JsonStreamWriter&) = delete;
+    JsonStreamWriter& operator=(const JsonStreamWriter&) = delete;
+
+private:
+    void separate();
+    void open(char bracket);
+    void close(char bracket);
+    void writeString(const char* text);
+    void writeNumber(const char* format, ...);
+    void put(const char* data, size_t length);
+    void put(char c);
+    void flush();
+
+    static size_t utf8SequenceLength(const uint8_t* p);
+
+    ResponseStream* _stream;
+    char _buffer[BUFFER_SIZE];
+    size_t _length;
+    uint32_t _hasItems;     // Per nesting level: a comma goes before the next item
+    uint8_t _depth;
+    bool _afterKey;
+    bool _ended;
+    bool _failed;
+};
@@ -7,6 +7,9 @@
 #include <PubSubClient.h>
 #include <functional>
 #include "certificates.h"
+#include "MQTTRouter.h"
+#include "Histogram.h"
+#include "Metrics.h"
 
 class MQTTManager {
 public:
@@ -20,12 +23,22 @@ public:
     bool maintainConnection();
     bool connected();
     bool publish(const char* topic, const char* payload, bool retained = true);
+
+    // Large payloads are streamed through beginPublish/write/endPublish in
+    // small chunks, so they never have to fit in PubSubClient's buffer.
+    // The writer must emit exactly `length` bytes.
+    using PayloadWriter = std::function<bool(Print& out)>;
+    bool publishStream(const char* topic, size_t length, PayloadWriter writer, bool retained = false);
+    bool publishLarge(const char* topic, const uint8_t* payload, size_t length, bool retained = false);
+    bool publishJson(const char* topic, const JsonDocument& doc, bool retained = false);
     bool subscribe(const char* topic);
 
-    // Callback type to match PubSubClient
-    using MQTTCallback = std::function<void(const String& topic, const String& payload)>;
-    void setCallback(std::function<void(char*, uint8_t*, unsigned int)> callback);
-    void handleMessage(char* topic, byte* payload, unsigned int length);
+    // Register a handler for a topic filter; subscribed on every (re)connect
+    bool route(const char* filter, MQTTRouter::Handler handler);
+
+    // Reports the depth of the work queue fed by inbound messages
+    using QueueDepthProbe = std::function<uint32_t()>;
+    void setQueueDepthProbe(QueueDepthProbe probe) { queueDepthProbe = probe; }
 
 private:
     WiFiClientSecure wifiClient;
@@ -34,15 +47,47 @@ private:
     unsigned long lastReconnectAttempt;
     unsigned long lastPublishTime;
     unsigned int currentReconnectDelay;
-    MQTTCallback userCallback;
+    MQTTRouter router;
+    QueueDepthProbe queueDepthProbe;
+
+    // Connection health, published periodically on MQTT_TOPIC_METRICS. The
+    // counters live in the metrics registry so /metrics can read them too.
+    MqttMetrics& counters;
+    struct Telemetry {
+        uint32_t pingSequence;
+        unsigned long pingSentAt;
+        bool pingPending;
+        int lastFailureState;
+        unsigned long lastPing;
+        unsigned long lastMetricsPublish;
+    };
+    Telemetry telemetry;
+    bool wasConnected;
+
+    static const uint32_t HANDSHAKE_BOUNDS_MS[8];
+    static const uint32_t RTT_BOUNDS_MS[8];
+    FixedHistogram<8> handshakeMs;
+    FixedHistogram<8> rttMs;
 
     bool connect();
     void setupSecureClient();
     void logState(const char* context);
     void handleCallback(char* topic, byte* payload, unsigned int length);
+    void handleLoopback(const char* topic, MQTTPayload payload);
+    void updateTelemetry();
+    bool publishMetrics();
+    static const char* stateToString(int state);
 
     static constexpr unsigned int INITIAL_RECONNECT_DELAY = 1000;
     static constexpr unsigned int MAX_RECONNECT_DELAY = 60000;
     static constexpr unsigned int PUBLISH_RATE_LIMIT = 100;
     static constexpr unsigned int RECONNECT_INTERVAL = 5000;
+    static constexpr unsigned long PING_INTERVAL = 30000;
+    static constexpr unsigned long METRICS_INTERVAL = 60000;
+
+    // Resident packet buffer: bounds inbound messages and small publishes.
+    // Larger inbound messages are dropped by PubSubClient, so subscriptions
+    // stay on topics whose messages fit (one hub sensor, not the hub's list).
+    static constexpr uint16_t BUFFER_SIZE = 512;
+    static constexpr size_t STREAM_CHUNK_SIZE = 128;
 };
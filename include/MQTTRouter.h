@@ -0,0 +1,66 @@
+// MQTTRouter.h
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+
+// Non-owning view over an inbound payload. It points straight into
+// PubSubClient's receive buffer and is only valid for the duration of the
+// handler call. The buffer is writable, so handlers may parse JSON in place;
+// if several filters match one topic, later handlers see those edits.
+struct MQTTPayload {
+    uint8_t* data;
+    unsigned int length;
+};
+
+// Topic router backed by a trie of topic levels. Filters are compiled into
+// the trie once at registration; dispatch walks the incoming topic level by
+// level without copying it. Supports the MQTT '+' and '#' wildcards.
+class MQTTRouter {
+public:
+    using Handler = std::function<void(const char* topic, MQTTPayload payload)>;
+
+    static constexpr size_t MAX_ROUTES = 8;
+    static constexpr size_t MAX_NODES = 32;
+    static constexpr size_t MAX_FILTER_LENGTH = 96;
+
+    MQTTRouter();
+
+    bool add(const char* filter, Handler handler);
+    size_t dispatch(const char* topic, MQTTPayload payload) const;
+
+    size_t routeCount() const { return _routeCount; }
+    const char* filter(size_t index) const;
+
+private:
+    static constexpr int8_t NONE = -1;
+
+    struct Node {
+        const char* segment;
+        uint8_t length;
+        int8_t firstChild;
+        int8_t nextSibling;
+        int8_t route;
+    };
+
+    struct Route {
+        char filter[MAX_FILTER_LENGTH];
+        Handler handler;
+    };
+
+    int8_t findChild(int8_t parent, const char* segment, size_t length) const;
+    int8_t addChild(int8_t parent, const char* segment, size_t length);
+    // Length of the level starting at `level`, and the start of the next one
+    static const char* nextLevel(const char* level, size_t* length);
+    size_t match(int8_t nodeIndex, const char* topic, const char* level, MQTTPayload payload) const;
+    size_t invoke(int8_t route, const char* topic, MQTTPayload payload) const;
+
+    static bool isWildcard(const Node& node, char wildcard) {
+        return node.length == 1 && node.segment[0] == wildcard;
+    }
+
+    Node _nodes[MAX_NODES];
+    size_t _nodeCount;
+    Route _routes[MAX_ROUTES];
+    size_t _routeCount;
+};
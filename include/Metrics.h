@@ -0,0 +1,162 @@
+// Metrics.h
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "Histogram.h"
+
+class ResponseStream;
+
+// Monotonic counter, safe to bump from any task
+class MetricCounter {
+public:
+    MetricCounter() : value(0) {}
+    void add(uint32_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    uint32_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> value;
+};
+
+class MetricGauge {
+public:
+    MetricGauge() : value(0) {}
+    void set(uint32_t current) { value.store(current, std::memory_order_relaxed); }
+    void add(int32_t delta) { value.fetch_add(static_cast<uint32_t>(delta), std::memory_order_relaxed); }
+    uint32_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> value;
+};
+
+// Histogram cells that any task can update without taking a lock: each
+// update is a relaxed atomic op. Concurrent recorders can lose a minimum or
+// maximum update, never a count.
+class RelaxedCount {
+public:
+    RelaxedCount() : value(0) {}
+    RelaxedCount& operator=(uint32_t current) {
+        value.store(current, std::memory_order_relaxed);
+        return *this;
+    }
+    void operator++(int) { value.fetch_add(1, std::memory_order_relaxed); }
+    operator uint32_t() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> value;
+};
+
+// 64-bit sum kept as two 32-bit halves, since 64-bit atomics aren't
+// lock-free on the ESP32; a reader racing a carry can see it one wrap short.
+class SplitSum {
+public:
+    SplitSum() : low(0), high(0) {}
+    SplitSum& operator=(uint64_t current) {
+        low.store(static_cast<uint32_t>(current), std::memory_order_relaxed);
+        high.store(static_cast<uint32_t>(current >> 32), std::memory_order_relaxed);
+        return *this;
+    }
+    SplitSum& operator+=(uint32_t amount) {
+        uint32_t before = low.fetch_add(amount, std::memory_order_relaxed);
+        if (before + amount < before) high.fetch_add(1, std::memory_order_relaxed);
+        return *this;
+    }
+    operator uint64_t() const {
+        uint32_t upper;
+        uint32_t lower;
+        do {
+            upper = high.load(std::memory_order_relaxed);
+            lower = low.load(std::memory_order_relaxed);
+        } while (upper != high.load(std::memory_order_relaxed));
+        return (static_cast<uint64_t>(upper) << 32) | lower;
+    }
+
+private:
+    std::atomic<uint32_t> low;
+    std::atomic<uint32_t> high;
+};
+
+// Histogram of microsecond durations that any task can record into
+template <size_t N>
+using MetricHistogram = FixedHistogram<N, RelaxedCount, SplitSum>;
+
+// Counters kept for MQTTManager; also published in its own metrics message
+struct MqttMetrics {
+    MetricCounter connects;
+    MetricCounter reconnects;
+    MetricCounter connectFailures;
+    MetricCounter disconnects;
+    MetricCounter messagesIn;
+    MetricCounter messagesOut;
+    MetricCounter bytesIn;
+    MetricCounter bytesOut;
+    MetricCounter pingsSent;
+    MetricCounter pingsLost;
+    MetricGauge connected;
+};
+
+struct HttpMetrics {
+    MetricCounter requests;
+    MetricCounter responses[5];     // By status class, 1xx to 5xx
+    MetricCounter rejected;         // Turned away with every slot busy
+    MetricGauge connections;
+};
+
+// Device-wide metrics registry, rendered at /metrics in OpenMetrics text.
+// Metrics are plain members updated in place by the code they describe;
+// heap and stack gauges are refreshed by sample() from the main loop.
+class Metrics {
+public:
+    static constexpr size_t MAX_TASKS = 10;
+    static constexpr unsigned long SAMPLE_INTERVAL = 5000;
+    static constexpr size_t RENDER_BUFFER_SIZE = 256;
+
+    static Metrics& getInstance();
+
+    // Tasks whose stack high-water mark is reported. Registering a name again
+    // replaces its handle; a task must be unregistered before it is deleted.
+    bool registerTask(const char* name, TaskHandle_t handle);
+    void unregisterTask(TaskHandle_t handle);
+
+    // Refreshes the heap, uptime and stack gauges. Called from the main loop;
+    // rate-limited to SAMPLE_INTERVAL, returns whether it took a sample.
+    bool sample();
+    uint32_t getHeapFree() const { return heapFree.get(); }
+    uint32_t getUptime() const { return uptime.get(); }
+
+    // Streams every metric as a chunked response from a fixed stack buffer
+    void render(ResponseStream* stream);
+
+    MqttMetrics mqtt;
+    HttpMetrics http;
+    MetricHistogram<10> loopLatency;
+    MetricHistogram<8> bme280Read;
+    MetricHistogram<8> sensorHubRead;
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+private:
+    struct TaskEntry {
+        const char* name;
+        std::atomic<TaskHandle_t> handle;
+        MetricGauge stackFree;
+    };
+
+    Metrics();
+
+    TaskEntry tasks[MAX_TASKS];
+    std::atomic<size_t> taskCount;
+    unsigned long lastSample;
+
+    MetricGauge heapFree;
+    MetricGauge heapMinimum;
+    MetricGauge heapLargestBlock;
+    MetricGauge uptime;
+
+    static const uint32_t LOOP_BOUNDS_US[10];
+    static const uint32_t BME280_BOUNDS_US[8];
+    static const uint32_t SENSORHUB_BOUNDS_US[8];
+};
@@ -0,0 +1,28 @@
+// PollInterval.h
+#pragma once
+
+// How long to wait between polls of the hub, adapted to how often its
+// readings actually change. A poll that brings a change halves the interval,
+// down to MIN; one that brings none (including a 304 Not Modified) lengthens
+// it by STEP, up to MAX. Readings that move get picked up quickly, and a hub
+// that sits still is asked a few times a minute.
+class PollInterval {
+public:
+    static constexpr unsigned long MIN = 10000;
+    static constexpr unsigned long MAX = 60000;
+    static constexpr unsigned long STEP = 5000;
+    static constexpr unsigned long INITIAL = 30000;
+
+    unsigned long get() const { return interval; }
+
+    void update(bool changed) {
+        if (changed) {
+            interval = interval / 2 > MIN ? interval / 2 : MIN;
+        } else {
+            interval = interval + STEP < MAX ? interval + STEP : MAX;
+        }
+    }
+
+private:
+    unsigned long interval = INITIAL;
+};
@@ -5,15 +5,52 @@
 #include <freertos/semphr.h>
 #include <functional>
 
+// Bit flags naming the individual display preference fields
+enum DisplayPreferenceField : uint8_t {
+    PREF_FIELD_NIGHT_MODE   = 1 << 0,
+    PREF_FIELD_DAY_BRIGHT   = 1 << 1,
+    PREF_FIELD_NIGHT_BRIGHT = 1 << 2,
+    PREF_FIELD_NIGHT_START  = 1 << 3,
+    PREF_FIELD_NIGHT_END    = 1 << 4,
+    PREF_FIELD_ALL          = 0x1F
+};
+
 class PreferencesManager {
 public:
     using PreferencesChangedCallback = std::function<void(const DisplayPreferences&)>;
     
     static void begin();
-    static void saveDisplayPreferences(const DisplayPreferences& prefs);
+    // Only the fields named in `fields` are written to storage
+    static void saveDisplayPreferences(const DisplayPreferences& prefs, uint8_t fields = PREF_FIELD_ALL);
     static DisplayPreferences loadDisplayPreferences();
     static void setPreferencesChangedCallback(PreferencesChangedCallback callback);
 
+    // Returns the DisplayPreferenceField mask of fields that differ
+    static uint8_t diffDisplayPreferences(const DisplayPreferences& a, const DisplayPreferences& b) {
+        uint8_t changed = 0;
+        if (a.nightModeDimmingEnabled != b.nightModeDimmingEnabled) changed |= PREF_FIELD_NIGHT_MODE;
+        if (a.dayBrightness != b.dayBrightness) changed |= PREF_FIELD_DAY_BRIGHT;
+        if (a.nightBrightness != b.nightBrightness) changed |= PREF_FIELD_NIGHT_BRIGHT;
+        if (a.nightStartHour != b.nightStartHour) changed |= PREF_FIELD_NIGHT_START;
+        if (a.nightEndHour != b.nightEndHour) changed |= PREF_FIELD_NIGHT_END;
+        return changed;
+    }
+
+    // Brightness is set on a 1-25 scale by the web API and remote config
+    // and stored as 1-75. toBrightnessLevel rounds to the nearest level, so
+    // a stored byte read back and written again comes out unchanged.
+    static uint8_t toStoredBrightness(int level) {
+        return map(level, 1, 25, 1, 75);
+    }
+    static int toBrightnessLevel(uint8_t stored) {
+        int clamped = constrain(stored, 1, 75);
+        return 1 + ((clamped - 1) * 24 + 37) / 74;
+    }
+
+    // Version of the last remote configuration applied (0 = none)
+    static uint32_t getConfigVersion();
+    static void setConfigVersion(uint32_t version);
+
 private:
     static PreferenceStorage* storage;
     static SemaphoreHandle_t prefsMutex;
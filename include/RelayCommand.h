@@ -0,0 +1,37 @@
+// RelayCommand.h
+#pragma once
+
+#include <Arduino.h>
+
+enum class RelayCommandSource {
+    USER,
+    MQTT,
+    SCHEDULE
+};
+
+enum class RelayState {
+    OFF,
+    ON,
+    UNKNOWN
+};
+
+struct RelayCommand {
+    uint8_t relayId;
+    RelayState state;
+    RelayCommandSource source;
+    unsigned long timestamp;
+    uint32_t tag;           // Caller's correlation id, handed back on completion
+};
+
+struct RelayStatus {
+    RelayState state;
+    bool override;
+};
+
+inline const char* relayStateName(RelayState state) {
+    switch (state) {
+        case RelayState::ON: return "ON";
+        case RelayState::OFF: return "OFF";
+        default: return "UNKNOWN";
+    }
+}
@@ -7,51 +7,48 @@
 #include <ArduinoJson.h>
 #include <HTTPClient.h>
 #include <WiFiClient.h>
+#include <functional>
 #include "config.h"
-
-enum class RelayCommandSource {
-    USER,
-    MQTT
-};
-
-enum class RelayState {
-    OFF,
-    ON,
-    UNKNOWN
-};
-
-struct RelayCommand {
-    uint8_t relayId;
-    RelayState state;
-    RelayCommandSource source;
-    unsigned long timestamp;
-};
-
-struct RelayStatus {
-    RelayState state;
-    bool override;
-};
+#include "MQTTRouter.h"
+#include "RelayCommand.h"
+#include "RelayWorker.h"
 
 class RelayControlHandler {
 public:
+    // Invoked from the relay worker task once a queued command has run
+    using CompletionCallback = RelayWorker::CompletionCallback;
+
     static RelayControlHandler& getInstance();
 
     bool begin();
-    void processCommand(uint8_t relayId, RelayState state, RelayCommandSource source);
+    // Publishes relay states the worker has changed. Call from the task that
+    // runs the MQTT client; PubSubClient is not safe to use from two tasks.
+    void loop();
+    // Queues the command for the relay worker and returns immediately
+    bool processCommand(uint8_t relayId, RelayState state, RelayCommandSource source, uint32_t tag = 0);
+    bool addCompletionListener(CompletionCallback callback);
+    // Cached relay state, kept current by the commands the worker runs and by
+    // its STATE_POLL_INTERVAL poll of the hub, which catches changes made at
+    // the hub itself. No MQTT relay-state topic is part of the hub's contract,
+    // so the cache doesn't rely on one. Reading it never touches the network.
     RelayStatus getRelayStatus(uint8_t relayId) const;
+    uint32_t getStateVersion() const { return stateVersion; }
+    uint32_t getStateEpoch() const { return stateEpoch; }
+    // Snapshot of all NUM_RELAYS relays in one lock; returns the state version it matches
+    uint32_t getCachedStates(RelayStatus* statuses) const;
+    uint32_t getCachedStatesJson(String& response) const;
     bool isOverridden(uint8_t relayId) const { return userOverride[relayId]; }
     void clearOverride(uint8_t relayId) { userOverride[relayId] = false; }
     
-    static void handleMqttMessage(const String& topic, const String& payload);
+    static void handleMqttMessage(const char* topic, MQTTPayload payload);
     bool setState(uint8_t relayId, RelayState newState);
     bool setState(bool on);
     bool getState();
     bool getOverride();
     void printRelayStatus();
-    bool getRelayStates(String& response);
-    String getAuthToken() const { return authToken; }
+    uint32_t getPendingCommands() const { return worker.getPending(); }
     
-    static constexpr uint8_t NUM_RELAYS = 2;  // Total number of relays
+    static constexpr uint8_t NUM_RELAYS = RelayWorker::NUM_RELAYS;  // Total number of relays
 
 private:
     static RelayControlHandler* instance;
@@ -60,20 +57,34 @@ private:
     RelayControlHandler(const RelayControlHandler&) = delete;
     RelayControlHandler& operator=(const RelayControlHandler&) = delete;
 
-    bool authenticate();  // Single authenticate method declaration
-    bool refreshAuthToken();
-    bool makeAuthenticatedRequest(const char* endpoint, const char* method, const char* payload);
+    // Returns the HTTP status; retries once with a fresh token on 401
+    int makeAuthenticatedRequest(const char* endpoint, const char* method, const char* payload,
+                                 String* response = nullptr,
+                                 TickType_t tokenWait = pdMS_TO_TICKS(5000));
+    void publishState(uint8_t relayId, RelayState state);
+    bool refreshStates();
+    void updateCachedState(uint8_t relayId, RelayState state);
+    static bool parseRelayEntry(JsonVariantConst entry, uint8_t defaultId, uint8_t& relayId, RelayState& state);
+
+    static void workerTask(void* parameter);
+    void runWorker();
     
-    String authToken;
-    unsigned long tokenExpiry;
     RelayState currentState[NUM_RELAYS];
     bool userOverride[NUM_RELAYS];
     SemaphoreHandle_t relayMutex;
-    QueueHandle_t commandQueue;
+    RelayWorker worker;
+    TaskHandle_t workerHandle;
     unsigned long lastStateChange[NUM_RELAYS];
+    // State the worker set but loop() has not published yet; UNKNOWN = none
+    RelayState unpublishedState[NUM_RELAYS];
+    volatile uint32_t stateVersion;
+    uint32_t stateEpoch;
     
     static constexpr size_t QUEUE_SIZE = 10;
     static constexpr TickType_t COMMAND_TIMEOUT = pdMS_TO_TICKS(5000);
+    static constexpr uint32_t WORKER_STACK_SIZE = 8192;
+    static constexpr UBaseType_t WORKER_PRIORITY = 1;
+    static constexpr unsigned long STATE_POLL_INTERVAL = 30000;
     
     bool relayState;
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+// RelayScheduler.h
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <time.h>
+#include "RelayControlHandler.h"
+#include "JsonStreamWriter.h"
+#include "ScheduleEngine.h"
+
+// On-device relay schedule: persists the rules and runs a ScheduleEngine once
+// a minute on its own task, fed from GlobalState and driving the relay handler.
+class RelayScheduler {
+public:
+    static constexpr size_t MAX_RULES = ScheduleEngine::MAX_RULES;
+    static constexpr uint16_t MINUTES_PER_DAY = ScheduleWindow::MINUTES_PER_DAY;
+    static constexpr uint8_t ALL_DAYS = 0x7F;
+    // A sensor condition only holds on a reading at most this old
+    static constexpr unsigned long READING_STALE_AFTER = 180000;
+
+    static RelayScheduler& getInstance();
+
+    bool begin();
+
+    // Advances the schedule to wall-clock time `now`. Called once a minute by
+    // the scheduler task.
+    void tick(const struct tm& now);
+
+    // Replaces all rules and persists them. Relays keep their current state.
+    bool setRules(const ScheduleRule* newRules, size_t count);
+    size_t getRules(ScheduleRule* out, size_t capacity);
+
+    bool fromJson(JsonArrayConst array);
+    // Writes the rules as a JSON array in the format fromJson() reads
+    void toJson(JsonStreamWriter& json);
+
+    RelayScheduler(const RelayScheduler&) = delete;
+    RelayScheduler& operator=(const RelayScheduler&) = delete;
+
+private:
+    static const char* STORAGE_PATH;
+    static constexpr uint8_t STORAGE_VERSION = 1;
+    static constexpr uint32_t TASK_STACK_SIZE = 4096;
+    static constexpr UBaseType_t TASK_PRIORITY = 1;
+
+    RelayScheduler();
+
+    static void schedulerTask(void* parameter);
+    void runScheduler();
+
+    static bool readCondition(ScheduleCondition condition, float& value);
+    static void command(uint8_t relayId, RelayState state);
+    static bool isValid(const ScheduleRule& rule);
+
+    bool load();
+    bool save(const ScheduleRule* rules, size_t count);
+
+    ScheduleEngine engine;
+    SemaphoreHandle_t mutex;
+    TaskHandle_t taskHandle;
+};
@@ -0,0 +1,125 @@
+// RelaySocket.h
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <functional>
+#include "RelayCommand.h"
+#include "RelayWorker.h"
+
+class HttpServer;
+
+// WebSocket channel behind /api/relay/ws for toggling relays from the web UI.
+// A command is acknowledged as soon as it is queued for the relay worker;
+// the outcome of the hub call is pushed on the same socket when the worker
+// reports it. Like EventStream, every socket is served from the HTTP server
+// task, so only the completion queue is shared with other tasks. The server
+// watches the sockets, so a command is read as soon as it arrives.
+//
+// Messages are binary frames of a few bytes:
+//
+//     client  CMD     0x01 seq relay state      state: 0 off, 1 on
+//     device  ACK     0x81 seq status           status: AckStatus
+//     device  RESULT  0x82 seq relay outcome state
+//
+// `seq` is chosen by the client and echoed back. A command superseded by a
+// newer one for the same relay before it ran gets the newer one's outcome.
+//
+// The relays are reached through the Relays hooks given to begin(), which
+// main wires to RelayControlHandler, and completions come back through
+// completed(); that keeps the socket side buildable on the host.
+class RelaySocket {
+public:
+    static constexpr size_t MAX_CLIENTS = 4;
+    static constexpr size_t MAX_PENDING = 8;
+    static constexpr size_t MAX_PAYLOAD = 125;              // Largest control frame
+    static constexpr unsigned long RESULT_TIMEOUT = 15000;
+    static constexpr size_t COMPLETION_QUEUE_SIZE = 8;
+
+    enum Message : uint8_t {
+        CMD = 0x01,
+        ACK = 0x81,
+        RESULT = 0x82
+    };
+
+    enum AckStatus : uint8_t {
+        QUEUED = 0,
+        INVALID = 1,
+        BUSY = 2                // Command queue or pending table full
+    };
+
+    enum Outcome : uint8_t {
+        DONE = 0,
+        FAILED = 1,
+        TIMED_OUT = 2
+    };
+
+    struct Relays {
+        // Queues a user command tagged `tag`; false when it can't be taken
+        std::function<bool(uint8_t relayId, RelayState state, uint32_t tag)> submit;
+        // Last known state of the relay
+        std::function<RelayState(uint8_t relayId)> state;
+    };
+
+    static RelaySocket& getInstance();
+
+    // Call once relay control is up
+    bool begin(const Relays& relays);
+    // Relay completion listener; runs on the relay worker and only queues
+    void completed(const RelayCommand& command, bool success);
+    // Takes the current request's socket and completes the upgrade handshake
+    bool accept(HttpServer* server, const String& key);
+    void loop();
+    size_t clientCount() const;
+
+    RelaySocket(const RelaySocket&) = delete;
+    RelaySocket& operator=(const RelaySocket&) = delete;
+
+private:
+    struct Client {
+        WiFiClient socket;
+        bool active;
+        uint8_t frame[2 + 4 + MAX_PAYLOAD];     // Header, mask, payload
+        size_t length;
+    };
+
+    struct Pending {
+        bool used;
+        uint8_t client;
+        uint8_t seq;
+        uint8_t relayId;
+        uint32_t tag;
+        unsigned long queuedAt;
+    };
+
+    struct Completion {
+        uint32_t tag;
+        uint8_t relayId;
+        bool success;
+        RelayState state;
+    };
+
+    RelaySocket();
+
+    void receive(size_t index);
+    bool handleFrame(size_t index, uint8_t opcode, const uint8_t* payload, size_t length);
+    void handleCommand(size_t index, const uint8_t* payload, size_t length);
+    void resolve(const Completion& completion);
+    void expire(unsigned long now);
+
+    bool send(size_t index, uint8_t opcode, const uint8_t* payload, size_t length);
+    void sendClose(size_t index, uint16_t code);
+    void drop(size_t index);
+
+    static String acceptKey(const String& key);
+    static uint8_t stateByte(RelayState state);
+
+    Client clients[MAX_CLIENTS];
+    Pending pending[MAX_PENDING];
+    Relays relays;
+    HttpServer* server;
+    QueueHandle_t completions;
+    uint32_t nextTag;
+};
@@ -0,0 +1,13 @@
+// RelayStateResponse.h
+#pragma once
+
+#include <Arduino.h>
+#include "HttpServer.h"
+#include "RelayCommand.h"
+
+// Answers a relay state poll from a snapshot of the relay state cache. The
+// ETag names the cache's epoch and version, so a page whose copy is still
+// current gets a 304 with no body. The epoch changes on every boot, which
+// keeps a version counted from zero again from matching an old copy.
+void sendRelayStates(HttpServer* server, const RelayStatus* statuses, uint8_t count,
+                     uint32_t epoch, uint32_t version);
@@ -0,0 +1,51 @@
+// RelayWorker.h
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <functional>
+#include "RelayCommand.h"
+
+// Hand-off between the tasks that issue relay commands and the one task that
+// carries them out against the hub. submit() only queues, so the web server
+// and MQTT tasks never wait on the network. The worker drains the queue in
+// one go and runs only the newest command per relay, since the hub would
+// overwrite the older ones anyway; completion listeners then hear about each
+// command that ran, on the worker's task.
+class RelayWorker {
+public:
+    static constexpr uint8_t NUM_RELAYS = 2;
+    static constexpr size_t MAX_COMPLETION_LISTENERS = 4;
+
+    // Carries out one command; returns whether the hub accepted it
+    using Executor = std::function<bool(const RelayCommand& command)>;
+    using CompletionCallback = std::function<void(const RelayCommand& command, bool success)>;
+
+    RelayWorker(size_t queueSize, Executor executor);
+
+    bool isReady() const { return queue != nullptr; }
+    bool addCompletionListener(CompletionCallback callback);
+
+    // Queues the command without blocking; false when the queue is full
+    bool submit(const RelayCommand& command);
+
+    // Waits up to `wait` for a command, then runs everything queued by then.
+    // Returns false if nothing arrived. Called in a loop by the worker task.
+    bool runOnce(TickType_t wait);
+
+    uint32_t getPending() const { return queue ? uxQueueMessagesWaiting(queue) : 0; }
+    uint32_t getCoalesced() const { return coalesced; }
+
+    RelayWorker(const RelayWorker&) = delete;
+    RelayWorker& operator=(const RelayWorker&) = delete;
+
+private:
+    void notifyCompletion(const RelayCommand& command, bool success);
+
+    QueueHandle_t queue;
+    Executor executor;
+    uint32_t coalesced;
+    CompletionCallback completionListeners[MAX_COMPLETION_LISTENERS];
+    size_t completionListenerCount;
+};
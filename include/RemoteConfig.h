@@ -0,0 +1,39 @@
+// RemoteConfig.h
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "MQTTRouter.h"
+#include "SystemDefinitions.h"
+
+class MQTTManager;
+
+// Applies display configuration pushed over a retained MQTT topic.
+//
+// Payload: {"version": 7, "display": {"nightDimming": true, "dayBrightness": 20,
+//           "nightBrightness": 3, "nightStartHour": 22, "nightEndHour": 6}}
+// Brightness uses the same 1-25 scale as /api/preferences. Fields that are
+// absent keep their current value. Configs whose version is not newer than
+// the last applied one are ignored, so the retained copy the broker replays
+// on every reconnect is a no-op.
+class RemoteConfig {
+public:
+    enum class Result {
+        APPLIED,
+        UNCHANGED,
+        STALE,
+        INVALID
+    };
+
+    static void begin(MQTTManager& mqtt);
+    static void handleMessage(const char* topic, MQTTPayload payload);
+
+    // Merges the fields present in `display` over `current` into `next` and
+    // reports which fields changed as a DisplayPreferenceField mask
+    static Result computeDelta(JsonObjectConst display,
+                               const DisplayPreferences& current,
+                               DisplayPreferences& next,
+                               uint8_t& changed);
+
+    static const char* resultToString(Result result);
+};
@@ -0,0 +1,55 @@
+// RemoteSensorSet.h
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Latest reading of every remote sensor the sensorHUB reports, keyed by the
+// hub's sensor ID. Fixed capacity; a reading that has not been refreshed for
+// STALE_AFTER is kept but no longer shown or published.
+class RemoteSensorSet {
+public:
+    static constexpr size_t MAX_SENSORS = 8;
+    static constexpr size_t ID_LENGTH = 24;
+    static constexpr unsigned long STALE_AFTER = 180000;  // Three missed polls at the slowest rate
+
+    struct Reading {
+        char id[ID_LENGTH];
+        float value;
+        unsigned long updatedAt;
+    };
+
+    static RemoteSensorSet& getInstance();
+
+    // Inserts or refreshes a reading. When the table is full, the stalest
+    // stale entry makes room; if none is stale the reading is dropped.
+    bool update(const char* id, float value);
+
+    // Marks every reading updated since `since` as confirmed just now, for a
+    // poll the hub answered with 304 Not Modified
+    void touch(unsigned long since);
+
+    // Fresh readings, in table order
+    size_t freshCount() const;
+    bool getFresh(size_t index, Reading& out) const;
+    size_t snapshot(Reading* out, size_t capacity) const;
+
+    // Bumped whenever a reading is added or changes value
+    uint32_t getVersion() const { return version; }
+
+    RemoteSensorSet(const RemoteSensorSet&) = delete;
+    RemoteSensorSet& operator=(const RemoteSensorSet&) = delete;
+
+private:
+    RemoteSensorSet();
+
+    static bool isFresh(const Reading& reading, unsigned long now) {
+        return now - reading.updatedAt < STALE_AFTER;
+    }
+
+    Reading entries[MAX_SENSORS];
+    size_t count;
+    volatile uint32_t version;
+    SemaphoreHandle_t mutex;
+};
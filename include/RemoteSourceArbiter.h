@@ -0,0 +1,39 @@
+// RemoteSourceArbiter.h
+#pragma once
+
+#include <Arduino.h>
+
+enum class RemoteSource {
+    MQTT,   // Hub pushes readings to the broker; no HTTP traffic
+    HTTP    // Broker quiet; poll the hub directly
+};
+
+// Picks where remote readings come from. MQTT is primary: HTTP polling only
+// runs after MQTT has been silent for MQTT_STALE_AFTER, and stops again once
+// MQTT has delivered steadily for MQTT_RECOVER_HOLD. The boot state is HTTP,
+// so the display has data before MQTT proves itself. Time is passed in, so
+// the class has no clock or network dependencies.
+class RemoteSourceArbiter {
+public:
+    static constexpr unsigned long MQTT_STALE_AFTER = 120000;   // 2 minutes
+    static constexpr unsigned long MQTT_RECOVER_HOLD = 60000;   // 1 minute
+    static constexpr uint8_t MQTT_RECOVER_MESSAGES = 2;
+
+    RemoteSourceArbiter();
+
+    void onMqttReading(unsigned long now);
+    RemoteSource update(unsigned long now);
+    RemoteSource getSource() const { return source; }
+
+    static const char* sourceToString(RemoteSource source);
+
+private:
+    bool mqttFresh(unsigned long now) const {
+        return mqttMessages > 0 && now - lastMqttReading < MQTT_STALE_AFTER;
+    }
+
+    RemoteSource source;
+    unsigned long lastMqttReading;
+    unsigned long mqttStreakStart;
+    uint16_t mqttMessages;          // Readings in the current unbroken streak
+};
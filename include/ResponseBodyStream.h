@@ -0,0 +1,67 @@
+// ResponseBodyStream.h
+#pragma once
+
+#include <Arduino.h>
+
+// Read side of an HTTP response body that counts what the caller takes, so a
+// pooled keep-alive connection is only handed out again once its response is
+// entirely off the wire. HTTPClient::end() keeps the socket open without
+// draining it; any body bytes left behind would be read as the start of the
+// next response on that connection.
+class ResponseBodyStream : public Stream {
+public:
+    ResponseBodyStream() : source(nullptr), consumed(0), complete(false) {}
+
+    void attach(Stream* stream) {
+        source = stream;
+    }
+
+    // For a body read by other means, such as HTTPClient::getString()
+    void markComplete() { complete = true; }
+    size_t getConsumed() const { return consumed; }
+
+    // Whether a body of `contentLength` bytes (-1 when unknown) has been read
+    // to its end. One of unknown length ends only when the hub closes the
+    // connection, so reading it through this stream never completes it.
+    bool finished(int contentLength) const {
+        return complete || (contentLength >= 0 && consumed >= static_cast<size_t>(contentLength));
+    }
+
+    // Whether a connection may go back into the pool after a response with
+    // this status. Only successful responses read to their end qualify;
+    // error bodies are never read.
+    static bool canReuse(int code, bool bodyFinished) {
+        if (code == 204 || code == 304) return true;
+        return code >= 200 && code < 300 && bodyFinished;
+    }
+
+    int available() override {
+        return source ? source->available() : 0;
+    }
+
+    int read() override {
+        int c = source ? source->read() : -1;
+        if (c >= 0) consumed++;
+        return c;
+    }
+
+    int peek() override {
+        return source ? source->peek() : -1;
+    }
+
+    using Stream::readBytes;
+    size_t readBytes(char* buffer, size_t length) override {
+        size_t n = source ? source->readBytes(buffer, length) : 0;
+        consumed += n;
+        return n;
+    }
+
+    size_t write(uint8_t) override {
+        return 0;
+    }
+
+private:
+    Stream* source;
+    size_t consumed;
+    bool complete;
+};
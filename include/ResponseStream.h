@@ -0,0 +1,18 @@
+// ResponseStream.h
+#pragma once
+
+#include <stddef.h>
+
+// Destination for a response body produced piece by piece. HttpServer is
+// the one on the device; the host tests collect the body in memory.
+class ResponseStream {
+public:
+    virtual bool beginChunked(int code, const char* contentType) = 0;
+    // False once the body can no longer be delivered, because the client is
+    // gone or has fallen too far behind. The producer should stop there.
+    virtual bool sendChunk(const char* data, size_t length) = 0;
+    virtual void endChunked() = 0;
+
+protected:
+    ~ResponseStream() = default;
+};
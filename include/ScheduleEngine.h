@@ -0,0 +1,54 @@
+// ScheduleEngine.h
+#pragma once
+
+#include <functional>
+#include "RelayCommand.h"
+#include "ScheduleRule.h"
+#include "TimerWheel.h"
+
+// Runs schedule rules against a minute-of-the-week clock. Each rule keeps one
+// timer on a minute-resolution timer wheel for its next window edge, so a tick
+// only touches the rules that are due plus the open windows that watch a
+// sensor condition. Sensors and relays are reached through Hooks. Not
+// thread-safe; the owner serialises calls.
+class ScheduleEngine {
+public:
+    static constexpr size_t MAX_RULES = 16;
+    static constexpr size_t WHEEL_SLOTS = 64;
+    static constexpr int16_t HYSTERESIS = 5;  // Tenths; keeps a relay from chattering at the limit
+
+    struct Hooks {
+        // Current value of the condition's sensor; false when there is no
+        // fresh reading, which a condition never holds on
+        std::function<bool(ScheduleCondition condition, float& value)> read;
+        std::function<void(uint8_t relayId, RelayState state)> command;
+    };
+
+    explicit ScheduleEngine(const Hooks& hooks);
+
+    // Advances to minute `now` of the week. Anything but the next minute (the
+    // first tick, NTP sync, DST) rebuilds the wheel from scratch.
+    void tick(uint16_t now);
+
+    // Replaces all rules, which must be valid; none counts as engaged, so
+    // relays keep their current state
+    void setRules(const ScheduleRule* newRules, size_t count);
+    size_t getRules(ScheduleRule* out, size_t capacity) const;
+
+    bool isEngaged(uint8_t index) const { return engaged[index]; }
+
+private:
+    void rebuild(uint16_t now);
+    void schedule(uint8_t index, uint16_t now);
+    void evaluate(uint8_t index, uint16_t now);
+    bool conditionHolds(const ScheduleRule& rule, bool engaged) const;
+    void command(const ScheduleRule& rule, bool engage);
+
+    Hooks hooks;
+    ScheduleRule rules[MAX_RULES];
+    size_t ruleCount;
+    bool engaged[MAX_RULES];
+    uint32_t watching;           // Rules with an open window and a condition
+    TimerWheel<WHEEL_SLOTS, MAX_RULES> wheel;  // Next window edge per rule
+    int32_t lastMinute;          // Minute of the week, -1 until the first tick
+};
@@ -0,0 +1,41 @@
+// ScheduleRule.h
+#pragma once
+
+#include <stdint.h>
+
+// Sensor value a schedule rule can be conditioned on
+enum class ScheduleCondition : uint8_t {
+    NONE,
+    REMOTE_TEMPERATURE,
+    TEMPERATURE,
+    HUMIDITY
+};
+
+// One schedule entry, stored on flash exactly as laid out here (12 bytes,
+// naturally aligned so no packing is needed).
+// A rule with a window (start != end) holds its relay in `action` while the
+// window is open and the condition holds, and switches it back when either
+// stops being true. A rule with start == end fires `action` once at start.
+struct ScheduleRule {
+    uint8_t relayId;
+    uint8_t action;         // RelayState::ON or RelayState::OFF
+    uint8_t days;           // Bit per weekday, bit 0 = Sunday as in tm_wday
+    uint8_t condition;      // ScheduleCondition
+    uint16_t startMinute;   // Minute of the day, 0-1439
+    uint16_t endMinute;     // Exclusive; before start means past midnight
+    int16_t threshold;      // Condition limit in tenths of a unit
+    char comparison;        // '<' or '>'
+    uint8_t reserved;
+};
+
+// When a rule's window is open. Times are minutes of the week, 0 being
+// Sunday 00:00.
+class ScheduleWindow {
+public:
+    static constexpr uint16_t MINUTES_PER_DAY = 1440;
+    static constexpr uint16_t MINUTES_PER_WEEK = 7 * MINUTES_PER_DAY;
+
+    static bool contains(const ScheduleRule& rule, uint16_t now);
+    // Minutes to the rule's next start or end, 1 to MINUTES_PER_WEEK
+    static uint16_t minutesUntilEdge(const ScheduleRule& rule, uint16_t now);
+};
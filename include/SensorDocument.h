@@ -0,0 +1,20 @@
+// SensorDocument.h
+#pragma once
+
+#include <Arduino.h>
+
+// The combined sensor state document, published on MQTT_TOPIC_STATE for Home
+// Assistant and sent to the web UI as the `sensors` event:
+//
+//     {"temperature":21.4,"humidity":48.0,"pressure":1013.2,"remote_temperature":54.5}
+//
+// Values carry one decimal. A reading that is missing or failed (NaN or
+// infinite) is written as null, since printf's "nan" is not JSON.
+class SensorDocument {
+public:
+    static constexpr size_t MAX_LENGTH = 128;     // Fits any document with readings a sensor can report
+
+    // Returns the length written, or 0 if `size` is too small
+    static size_t format(char* buffer, size_t size, float temperature, float humidity,
+                         float pressure, float remoteTemperature);
+};
@@ -0,0 +1,64 @@
+// SensorHubAuth.h
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "TokenRefresh.h"
+
+// Single owner of the sensorHUB bearer token. A background task logs in once,
+// refreshes the token ahead of expiry and after a rejection, and every client
+// just copies the current token out.
+class SensorHubAuth {
+public:
+    static constexpr unsigned long TOKEN_LIFETIME = TOKEN_REFRESH_INTERVAL;
+    static constexpr unsigned long REFRESH_MARGIN = 10UL * 60UL * 1000UL;  // 10 minutes
+    static constexpr TokenRefresh REFRESH = {TOKEN_LIFETIME, REFRESH_MARGIN};
+    static constexpr unsigned long RETRY_DELAY = 30000;
+    static constexpr TickType_t DEFAULT_WAIT = pdMS_TO_TICKS(5000);
+
+    static SensorHubAuth& getInstance();
+
+    bool begin();
+
+    // Never blocks on the network; empty until the first login succeeds
+    String getToken();
+    bool hasToken();
+
+    // Report that the hub rejected `token`. Wakes the refresher unless the
+    // token was already replaced by another client's report.
+    void invalidate(const String& token);
+
+    // Blocks until a valid token is available or `wait` elapses
+    bool waitForToken(TickType_t wait = DEFAULT_WAIT);
+
+    // Overflow-safe: correct across the 49-day millis() wrap
+    static bool needsRefresh(unsigned long now, unsigned long issuedAt) {
+        return REFRESH.due(now, issuedAt);
+    }
+
+    SensorHubAuth(const SensorHubAuth&) = delete;
+    SensorHubAuth& operator=(const SensorHubAuth&) = delete;
+
+private:
+    SensorHubAuth();
+
+    static void refreshTask(void* parameter);
+    void runRefresh();
+    bool login();
+
+    String token;
+    unsigned long issuedAt;
+    bool valid;
+    SemaphoreHandle_t mutex;
+    EventGroupHandle_t events;
+    TaskHandle_t taskHandle;
+    uint32_t logins;
+
+    static constexpr EventBits_t TOKEN_READY = BIT0;
+    static constexpr uint32_t TASK_STACK_SIZE = 6144;
+    static constexpr UBaseType_t TASK_PRIORITY = 1;
+};
@@ -0,0 +1,82 @@
+// SensorHubClient.h
+#pragma once
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "config.h"
+#include "ResponseBodyStream.h"
+
+// Shared HTTP transport for every sensorHUB call. Keeps a small pool of
+// keep-alive connections and caches the hub's resolved address, so a request
+// normally costs neither an mDNS lookup nor a TCP handshake.
+class SensorHubClient {
+public:
+    static constexpr size_t POOL_SIZE = 2;
+    static constexpr unsigned long ADDRESS_TTL = 300000;  // 5 minutes
+    static constexpr TickType_t ACQUIRE_TIMEOUT = pdMS_TO_TICKS(2000);
+    static constexpr uint32_t RESOLVE_TIMEOUT = 2000;
+    static constexpr uint16_t HTTP_TIMEOUT = 5000;
+
+    class Request;
+
+    static SensorHubClient& getInstance();
+
+    bool resolve(IPAddress& address);
+    void invalidateAddress();
+
+    SensorHubClient(const SensorHubClient&) = delete;
+    SensorHubClient& operator=(const SensorHubClient&) = delete;
+
+private:
+    struct Connection {
+        WiFiClient client;
+        HTTPClient http;
+        bool inUse;
+    };
+
+    SensorHubClient();
+    Connection* acquire(TickType_t wait);
+    void release(Connection* connection, bool healthy);
+
+    Connection pool[POOL_SIZE];
+    SemaphoreHandle_t poolSemaphore;
+    SemaphoreHandle_t poolMutex;
+    IPAddress cachedAddress;
+    unsigned long resolvedAt;
+    bool addressValid;
+};
+
+// One request on a pooled connection. The connection goes back to the pool,
+// still open, when the Request goes out of scope, provided the response was
+// a success and its body was read to the end; otherwise it is closed.
+class SensorHubClient::Request {
+public:
+    explicit Request(const char* path, TickType_t wait = ACQUIRE_TIMEOUT);
+    ~Request();
+
+    Request(const Request&) = delete;
+    Request& operator=(const Request&) = delete;
+
+    bool valid() const { return connection != nullptr; }
+    void addHeader(const String& name, const String& value);
+    // HTTP/1.0 keeps the hub from chunking the body, for callers that parse
+    // straight off getStream(). Reset when the Request ends.
+    void useHTTP10(bool enable);
+    void collectHeaders(const char* headers[], size_t count);
+    String header(const char* name);
+    int GET();
+    int POST(const String& payload);
+    String getString();
+    Stream& getStream();
+    HTTPClient& http() { return connection->http; }
+
+private:
+    int finish(int code);
+
+    Connection* connection;
+    int lastCode;
+    ResponseBodyStream body;
+};
@@ -0,0 +1,78 @@
+// StreamedPublish.h
+#pragma once
+
+#include <Arduino.h>
+
+// Print adapter that batches bytes into N-byte writes to an MQTT client.
+// Without it ArduinoJson would hand PubSubClient one byte at a time, and
+// every byte would become its own TLS record.
+template <size_t N, typename Client>
+class ChunkedPublishWriter : public Print {
+public:
+    explicit ChunkedPublishWriter(Client& client) : client(client), used(0), total(0), failed(false) {}
+
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        size_t remaining = size;
+        while (remaining > 0 && !failed) {
+            size_t n = min(remaining, N - used);
+            memcpy(buffer + used, data, n);
+            used += n;
+            data += n;
+            remaining -= n;
+            if (used == N) flush();
+        }
+        return failed ? 0 : size;
+    }
+
+    void flush() override {
+        if (used == 0 || failed) return;
+        if (client.write(buffer, used) != used) {
+            failed = true;
+        }
+        total += used;
+        used = 0;
+    }
+
+    size_t bytesWritten() const { return total + used; }
+    bool hasFailed() const { return failed; }
+
+private:
+    Client& client;
+    uint8_t buffer[N];
+    size_t used;
+    size_t total;
+    bool failed;
+};
+
+// Sends one PUBLISH whose `length`-byte body `writer` produces in pieces:
+// beginPublish(), the body in N-byte writes, endPublish(). Templated on the
+// MQTT client and its transport so the host tests can drive it with mocks.
+//
+// The broker expects exactly the announced length, so a body that comes out
+// short or long, or a write the socket doesn't take, leaves the stream out
+// of sync. A DISCONNECT packet would land inside the unfinished PUBLISH;
+// instead the transport is closed and the caller's reconnect logic takes over.
+template <size_t N, typename Client, typename Transport, typename Writer>
+bool streamPublish(Client& client, Transport& transport, const char* topic, size_t length,
+                   Writer& writer, bool retained) {
+    if (!client.beginPublish(topic, length, retained)) {
+        Serial.printf("MQTT: Failed to begin streamed publish for topic: %s\n", topic);
+        return false;
+    }
+
+    ChunkedPublishWriter<N, Client> out(client);
+    bool ok = writer(out);
+    out.flush();
+
+    if (!ok || out.hasFailed() || out.bytesWritten() != length) {
+        Serial.printf("MQTT: Streamed publish to %s failed (%u of %u bytes)\n",
+                      topic, (unsigned)out.bytesWritten(), (unsigned)length);
+        transport.stop();
+        return false;
+    }
+    return client.endPublish() == 1;
+}
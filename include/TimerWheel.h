@@ -0,0 +1,69 @@
+// TimerWheel.h
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Single-level hashed timer wheel for up to CAPACITY timers with ids
+// 0..CAPACITY-1. Each timer waits in the slot its delay lands on and counts
+// the laps it still has to sit out, so advance() only walks the timers in
+// one slot. No allocation; each id may be scheduled once at a time.
+template <size_t SLOTS, size_t CAPACITY>
+class TimerWheel {
+public:
+    static_assert(CAPACITY <= 127, "ids are stored as int8_t");
+
+    TimerWheel() {
+        clear();
+    }
+
+    void clear() {
+        for (size_t i = 0; i < SLOTS; i++) {
+            slots[i] = NONE;
+        }
+        cursor = 0;
+    }
+
+    // Fires `id` on the `delay`th advance() from now; delay must be at least 1
+    void schedule(uint8_t id, uint32_t delay) {
+        size_t slot = (cursor + delay) % SLOTS;
+
+        // The slot comes round every SLOTS steps; count the laps first
+        timers[id].rounds = (delay - 1) / SLOTS;
+        timers[id].next = slots[slot];
+        slots[slot] = id;
+    }
+
+    // Moves one step and calls fire(id) for every timer that is now due.
+    // fire may schedule the id again.
+    template <typename Fire>
+    void advance(Fire fire) {
+        cursor = (cursor + 1) % SLOTS;
+
+        int8_t id = slots[cursor];
+        slots[cursor] = NONE;
+        while (id != NONE) {
+            int8_t next = timers[id].next;
+            if (timers[id].rounds > 0) {
+                timers[id].rounds--;
+                timers[id].next = slots[cursor];
+                slots[cursor] = id;
+            } else {
+                fire(static_cast<uint8_t>(id));
+            }
+            id = next;
+        }
+    }
+
+private:
+    struct Timer {
+        int8_t next;
+        uint32_t rounds;
+    };
+
+    static constexpr int8_t NONE = -1;
+
+    Timer timers[CAPACITY];
+    int8_t slots[SLOTS];
+    size_t cursor;
+};
@@ -0,0 +1,23 @@
+// TokenRefresh.h
+#pragma once
+
+// When to renew a bearer token that is good for `lifetime` ms: `margin` ms
+// before it runs out. Times are millis() readings; the unsigned
+// subtraction keeps every check correct across the 49-day wrap.
+struct TokenRefresh {
+    unsigned long lifetime;
+    unsigned long margin;
+
+    constexpr unsigned long refreshAfter() const {
+        return lifetime > margin ? lifetime - margin : 0;
+    }
+
+    constexpr bool due(unsigned long now, unsigned long issuedAt) const {
+        return now - issuedAt >= refreshAfter();
+    }
+
+    // Milliseconds left until the refresh is due, 0 once it is
+    constexpr unsigned long remaining(unsigned long now, unsigned long issuedAt) const {
+        return due(now, issuedAt) ? 0 : refreshAfter() - (now - issuedAt);
+    }
+};
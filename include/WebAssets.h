@@ -0,0 +1,23 @@
+// WebAssets.h
+#pragma once
+
+#include <Arduino.h>
+#include "HttpServer.h"
+
+// A pre-gzipped static asset generated by tools/build_assets.py. The ETag is
+// a hash of the minified content, so it changes exactly when the asset does.
+struct WebAsset {
+    const char* name;
+    const char* contentType;
+    const uint8_t* data;
+    size_t length;
+    const char* etag;
+};
+
+// Looks up an asset by name, nullptr if there is none
+const WebAsset* findWebAsset(const char* name);
+
+// Sends `asset` with Content-Encoding: gzip and its ETag, or a bodyless 304
+// when the client's If-None-Match already names it. Requires the server to
+// collect the If-None-Match header.
+void sendWebAsset(HttpServer* server, const WebAsset& asset, const char* cacheControl);
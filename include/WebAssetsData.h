@@ -0,0 +1,540 @@
+// WebAssetsData.h
+// Generated by tools/build_assets.py from include/WebContent.h and include/icons.h. Do not edit.
+#pragma once
+
+#include "WebAssets.h"
+
+static const uint8_t ASSET_APP_CSS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x57, 0x4b, 0x6f, 0xe3, 0x36,
+    0x10, 0xbe, 0xfb, 0x57, 0x08, 0xd9, 0x16, 0x58, 0x03, 0x96, 0x21, 0x59, 0x96, 0xe3, 0x38, 0x58,
+    0xa0, 0xed, 0xa1, 0x68, 0x0f, 0xbd, 0x74, 0xd1, 0x53, 0xd0, 0x03, 0x25, 0x8d, 0x6c, 0x36, 0xb2,
+    0x28, 0x88, 0x54, 0x1e, 0x5b, 0xe4, 0xbf, 0xef, 0x90, 0x22, 0x25, 0x8a, 0x94, 0xb3, 0x0e, 0x7c,
+    0xf2, 0x70, 0x38, 0x9c, 0x99, 0xef, 0x9b, 0x87, 0x0e, 0x2d, 0x63, 0x22, 0xf8, 0x7f, 0x11, 0x86,
+    0xd9, 0x31, 0xcc, 0x59, 0xc5, 0xda, 0x43, 0xf0, 0xa9, 0x4c, 0xe5, 0xef, 0x1e, 0x85, 0x39, 0x69,
+    0x0b, 0x3c, 0x39, 0x04, 0xcf, 0x27, 0x2a, 0x40, 0x4a, 0x04, 0xbc, 0x88, 0x41, 0x31, 0x49, 0x12,
+    0x29, 0x3b, 0x01, 0x29, 0x68, 0x3d, 0xde, 0x8f, 0xc9, 0x6d, 0x02, 0x7b, 0x79, 0xc2, 0xbb, 0xcc,
+    0x3d, 0x4c, 0xcb, 0x5d, 0xb2, 0x53, 0x87, 0x19, 0x6b, 0x0b, 0x68, 0x87, 0x03, 0x00, 0xf5, 0x00,
+    0xad, 0x9b, 0x4e, 0xa8, 0x37, 0x3f, 0x95, 0xfb, 0xf2, 0xae, 0x24, 0xa3, 0xf0, 0xc4, 0x9e, 0x40,
+    0x69, 0xee, 0xcb, 0xa8, 0x54, 0xca, 0xbc, 0xa2, 0xd2, 0x84, 0xd2, 0x86, 0x48, 0xfe, 0xa4, 0xf4,
+    0x89, 0x54, 0x1d, 0x68, 0xe1, 0xa0, 0x9a, 0x75, 0x42, 0xb0, 0x7a, 0xc6, 0x47, 0x7d, 0x60, 0x8c,
+    0xc7, 0x69, 0x7a, 0x9b, 0x29, 0x33, 0x5c, 0x10, 0xd1, 0x71, 0xd7, 0x15, 0x2d, 0x95, 0x79, 0x98,
+    0x44, 0xc3, 0xbb, 0x3c, 0x07, 0xae, 0xd5, 0x61, 0x57, 0x6e, 0x81, 0xd8, 0x62, 0xad, 0x1f, 0xc3,
+    0x1e, 0x12, 0xe5, 0x0f, 0xb4, 0x2d, 0xd3, 0x9e, 0x97, 0x39, 0x4a, 0x77, 0xa3, 0x50, 0xeb, 0x16,
+    0x77, 0x49, 0xb4, 0x51, 0x30, 0xd8, 0x7e, 0x0f, 0x06, 0x58, 0x59, 0x0e, 0x52, 0xa3, 0xfa, 0xb6,
+    0x78, 0x28, 0x88, 0x20, 0xa1, 0x38, 0xc1, 0x19, 0xbe, 0xdc, 0x14, 0xa4, 0x7d, 0xbc, 0xf9, 0xd7,
+    0x85, 0x37, 0xde, 0xc8, 0xdf, 0x04, 0x5e, 0x34, 0x2b, 0x7f, 0x1e, 0xc0, 0x63, 0x4e, 0x5d, 0x18,
+    0xef, 0xa2, 0x9c, 0x94, 0x77, 0x17, 0x30, 0xce, 0xa2, 0x0c, 0xf2, 0x74, 0x06, 0x63, 0x4d, 0x18,
+    0x0b, 0xe3, 0x4d, 0x21, 0x7f, 0x3e, 0xc6, 0x49, 0x21, 0x7f, 0x2e, 0xc6, 0xdb, 0x8d, 0xfc, 0x39,
+    0x18, 0x8f, 0xaa, 0x0e, 0xc6, 0xbb, 0x6d, 0x86, 0xf8, 0xcc, 0x60, 0xbc, 0xdd, 0x10, 0x4d, 0x70,
+    0x1b, 0xe3, 0xd1, 0x95, 0x29, 0xc6, 0x63, 0x34, 0x13, 0x8c, 0xe3, 0x2c, 0x85, 0x4d, 0x34, 0x83,
+    0x31, 0x49, 0x8b, 0x1d, 0xb9, 0x75, 0x30, 0xce, 0x6e, 0xe3, 0x3c, 0xce, 0x3d, 0x8c, 0xa1, 0xbc,
+    0x23, 0x77, 0xc4, 0xc1, 0x78, 0xb7, 0xcb, 0xb2, 0x1d, 0x71, 0x31, 0x86, 0x32, 0x4d, 0xd2, 0x48,
+    0x62, 0x9c, 0xb1, 0xe2, 0x15, 0x41, 0x2d, 0x59, 0x2d, 0xc2, 0x92, 0x9c, 0x69, 0xf5, 0x7a, 0x08,
+    0x42, 0xd2, 0x34, 0x15, 0x84, 0xfc, 0x95, 0x0b, 0x38, 0xaf, 0x82, 0xdf, 0x2a, 0x5a, 0x3f, 0xfe,
+    0x45, 0xf2, 0xaf, 0xea, 0xff, 0xef, 0xa8, 0xb9, 0x0a, 0x6e, 0xbe, 0xc2, 0x91, 0x41, 0xf0, 0xcf,
+    0x9f, 0x37, 0xab, 0xe0, 0x6f, 0x96, 0x31, 0xc1, 0x56, 0xc1, 0x1f, 0x50, 0x3d, 0x81, 0xa0, 0x39,
+    0x59, 0x05, 0xbf, 0xb6, 0x94, 0x54, 0xab, 0x80, 0x93, 0x9a, 0x87, 0x1c, 0x5a, 0x5a, 0xde, 0x2f,
+    0xce, 0xa4, 0x3d, 0xd2, 0xfa, 0x10, 0x44, 0x01, 0xe9, 0x04, 0x93, 0xff, 0x5f, 0xc2, 0x67, 0x5a,
+    0x88, 0xd3, 0x21, 0xd8, 0x45, 0x51, 0xf3, 0x72, 0xbf, 0x68, 0x48, 0x21, 0x91, 0x3f, 0x04, 0x1b,
+    0xf5, 0x37, 0x23, 0xf9, 0xe3, 0xb1, 0x65, 0x5d, 0x5d, 0x18, 0xb7, 0x9f, 0x48, 0xfb, 0x79, 0x64,
+    0xdf, 0xf2, 0x7e, 0x31, 0x91, 0x8f, 0x64, 0xc3, 0x13, 0x74, 0x19, 0x90, 0x67, 0xf4, 0x78, 0xc2,
+    0xcc, 0xc4, 0x6b, 0x04, 0x4e, 0xb4, 0xe8, 0x0c, 0x15, 0x94, 0xa1, 0x0f, 0xae, 0xe9, 0x20, 0x5a,
+    0x27, 0x3c, 0x00, 0xc2, 0x61, 0x15, 0x38, 0x02, 0x99, 0xa3, 0xb5, 0xe4, 0x36, 0x26, 0x69, 0xbc,
+    0x66, 0xde, 0xd4, 0xa4, 0x5f, 0xda, 0xce, 0x6f, 0x95, 0xf3, 0x3d, 0x57, 0x5b, 0xe4, 0x72, 0xc7,
+    0xd1, 0x83, 0x4d, 0x2f, 0x7c, 0x09, 0xf9, 0x89, 0x14, 0xec, 0x59, 0xa6, 0x01, 0x45, 0x01, 0xea,
+    0x06, 0xed, 0x31, 0x23, 0x9f, 0xa3, 0x95, 0xfa, 0xad, 0xe3, 0xa5, 0xc9, 0x14, 0xd2, 0x1d, 0x79,
+    0x76, 0x36, 0xd9, 0x68, 0x98, 0x71, 0xbe, 0x85, 0x8a, 0x08, 0xfa, 0x04, 0xd7, 0x86, 0xa4, 0x22,
+    0xe0, 0x90, 0x4b, 0x3d, 0x0c, 0xc2, 0xb5, 0xbe, 0xb5, 0x52, 0x3f, 0x48, 0xe3, 0x9d, 0x15, 0xc4,
+    0x20, 0x44, 0x67, 0x39, 0xc3, 0x0a, 0x32, 0x40, 0x58, 0xf5, 0xb8, 0xb4, 0x5f, 0x39, 0x54, 0x84,
+    0x23, 0x14, 0x27, 0x5a, 0xa9, 0xac, 0x4d, 0xad, 0xd4, 0xac, 0x56, 0x2e, 0x9d, 0x62, 0x43, 0x3b,
+    0x4e, 0xbf, 0x81, 0x71, 0x44, 0x09, 0x9e, 0x35, 0x6e, 0xc8, 0x0b, 0x9b, 0x37, 0x91, 0xd2, 0x09,
+    0x22, 0x07, 0xf7, 0x49, 0xc3, 0x50, 0x7e, 0x9c, 0x36, 0x53, 0xd3, 0xf1, 0xde, 0x33, 0x9d, 0xba,
+    0xa6, 0x65, 0xc4, 0x9e, 0x69, 0xb7, 0x1d, 0xf5, 0xd6, 0x13, 0xc7, 0xfa, 0xee, 0x0a, 0xeb, 0x9b,
+    0x6b, 0xad, 0xaf, 0x4b, 0xd6, 0x9e, 0x43, 0x89, 0x64, 0xe3, 0x83, 0xd5, 0x3f, 0x35, 0x55, 0xaa,
+    0x48, 0x06, 0x15, 0xaa, 0x16, 0x94, 0x37, 0x15, 0xc1, 0xea, 0xcd, 0x2a, 0x96, 0x3f, 0x7a, 0x2c,
+    0x52, 0x29, 0xb8, 0xe2, 0x79, 0xc9, 0x58, 0x36, 0xbc, 0x3f, 0x18, 0x2d, 0x2b, 0xc0, 0xfb, 0x47,
+    0xd2, 0x18, 0x3e, 0x9a, 0xe8, 0xe2, 0xa8, 0x8f, 0x6c, 0xb8, 0xea, 0xf9, 0xd3, 0x5f, 0x25, 0x15,
+    0x3d, 0xd6, 0x21, 0x0e, 0xfe, 0x33, 0x96, 0x43, 0x0e, 0xb5, 0x80, 0x16, 0xfd, 0xe9, 0x5a, 0x2e,
+    0x1d, 0x6a, 0x18, 0xed, 0x05, 0x43, 0x15, 0xa1, 0xbb, 0x86, 0x84, 0x5e, 0xd1, 0x99, 0x8e, 0xbf,
+    0xf4, 0xca, 0x4c, 0x05, 0x69, 0x57, 0x05, 0xa9, 0x2a, 0x2c, 0x84, 0x8d, 0x55, 0x08, 0x96, 0x93,
+    0x07, 0xd5, 0xc2, 0x67, 0xeb, 0xda, 0x9a, 0x1f, 0x4b, 0x2f, 0x36, 0x75, 0xf8, 0x20, 0x5e, 0x1b,
+    0x9c, 0x8a, 0x4a, 0xae, 0xc6, 0xa2, 0xce, 0x77, 0xdb, 0x33, 0x60, 0xaf, 0x81, 0xd2, 0x03, 0x27,
+    0x47, 0x76, 0x10, 0x6c, 0x49, 0xed, 0xa0, 0xd8, 0xe7, 0x51, 0x67, 0xce, 0xd3, 0xba, 0x90, 0xc4,
+    0xff, 0x3a, 0x2e, 0x68, 0xf9, 0xaa, 0x14, 0x31, 0x85, 0x87, 0x80, 0x37, 0x24, 0xc7, 0xc9, 0x05,
+    0xe2, 0x19, 0xa0, 0xbe, 0x90, 0xe4, 0x39, 0x22, 0x8c, 0x6f, 0xaa, 0xd9, 0x37, 0x9b, 0x03, 0x33,
+    0x15, 0x27, 0xcd, 0x0d, 0x5d, 0xde, 0xcf, 0xf4, 0x37, 0x55, 0xbb, 0x67, 0x7c, 0x45, 0x77, 0xf4,
+    0x44, 0x71, 0x44, 0x75, 0x64, 0xe5, 0xd3, 0xe8, 0xcd, 0xdb, 0x62, 0x9a, 0xbe, 0xfa, 0x08, 0x2a,
+    0x7d, 0xfa, 0x62, 0x1c, 0x45, 0x3f, 0xdf, 0x2f, 0x4c, 0xe3, 0xbe, 0x40, 0x80, 0x61, 0x8a, 0xfb,
+    0x0c, 0x48, 0xe4, 0x0d, 0xd6, 0x09, 0xd9, 0xff, 0x4d, 0xaf, 0xc1, 0xb2, 0xcc, 0x1e, 0xa9, 0x90,
+    0x53, 0x0d, 0x08, 0xbe, 0x98, 0xc3, 0xd8, 0x85, 0x66, 0x9c, 0x39, 0x1c, 0xcc, 0x05, 0xfd, 0x8e,
+    0x38, 0x75, 0xe7, 0x4c, 0x2e, 0x3e, 0x17, 0xed, 0x68, 0xe7, 0xfb, 0xca, 0x30, 0xce, 0xbb, 0x53,
+    0x6c, 0x98, 0x5f, 0xd6, 0x62, 0xe1, 0x07, 0x90, 0xca, 0xf8, 0xbd, 0xba, 0x98, 0xef, 0xf4, 0xc1,
+    0x3a, 0x4e, 0x7b, 0x6a, 0x23, 0x61, 0x43, 0x8c, 0xfa, 0x43, 0x11, 0xbd, 0x43, 0x7f, 0x7b, 0xc5,
+    0xe9, 0xf9, 0x2f, 0xe8, 0x19, 0xc2, 0x86, 0xe6, 0x8f, 0x0e, 0x99, 0x7f, 0xdc, 0x20, 0x2c, 0x9a,
+    0x5b, 0x46, 0x64, 0x0b, 0xc5, 0x1b, 0x08, 0xb8, 0x77, 0xc2, 0xa1, 0xc2, 0x31, 0xb2, 0x5a, 0xac,
+    0x2b, 0x26, 0x79, 0x2b, 0x5b, 0x5d, 0x5f, 0x72, 0x2e, 0x4b, 0xd4, 0x38, 0xa5, 0xdf, 0x14, 0x31,
+    0x87, 0x21, 0xf3, 0x32, 0x6d, 0x22, 0x26, 0xbf, 0x3f, 0x9c, 0x5e, 0x73, 0x9d, 0xe4, 0xdd, 0xd6,
+    0xe3, 0x4d, 0x80, 0xcb, 0xcb, 0x88, 0xac, 0x36, 0xf2, 0x04, 0x3a, 0xad, 0xef, 0x65, 0xdc, 0x59,
+    0x6c, 0xf4, 0x97, 0x92, 0x09, 0xa1, 0x27, 0xdb, 0x10, 0x9e, 0x1a, 0x2a, 0xb3, 0xeb, 0xc6, 0x38,
+    0xef, 0xde, 0x1f, 0x51, 0x1e, 0xcf, 0x26, 0xf9, 0xfd, 0xc1, 0x7a, 0xb1, 0xe1, 0x6e, 0x64, 0x1f,
+    0x62, 0x94, 0x7d, 0x8f, 0xe4, 0x72, 0xa1, 0xb9, 0xf6, 0xa2, 0x5a, 0xa8, 0x6d, 0xee, 0xcd, 0xe4,
+    0x65, 0x3e, 0x25, 0xba, 0x15, 0x0a, 0xd6, 0x4c, 0x72, 0xa2, 0x93, 0xb4, 0x35, 0x9d, 0x51, 0x3d,
+    0xb0, 0xd6, 0x9b, 0xf8, 0xac, 0x57, 0xe3, 0xf2, 0xbe, 0xf4, 0xa6, 0xea, 0xb8, 0xbf, 0xdb, 0xfe,
+    0xae, 0xd5, 0xaa, 0x3e, 0x6b, 0xcc, 0x6c, 0xf6, 0xae, 0xa9, 0x71, 0xb9, 0xb7, 0x0d, 0x21, 0x07,
+    0x4b, 0x36, 0xce, 0x1b, 0x2b, 0x16, 0x37, 0x01, 0xbe, 0xd7, 0xe6, 0x03, 0xe5, 0x02, 0xdf, 0x3f,
+    0x38, 0x6d, 0x1c, 0x97, 0xf0, 0x54, 0x72, 0x7b, 0x9a, 0x8d, 0xf1, 0xe3, 0x47, 0xc5, 0xf0, 0x40,
+    0x8b, 0x9f, 0xbe, 0xdc, 0x84, 0xc8, 0xbb, 0x16, 0x64, 0xe2, 0xf1, 0x18, 0xfb, 0xd3, 0x9a, 0x79,
+    0x17, 0xad, 0x5a, 0xf0, 0x57, 0xc2, 0xcb, 0x76, 0xca, 0xd2, 0x33, 0x64, 0xbe, 0x7a, 0x2e, 0x58,
+    0x5a, 0xcb, 0x75, 0xba, 0x8f, 0xb1, 0x65, 0xd5, 0xa5, 0xfd, 0xd8, 0xd5, 0x9b, 0x6e, 0xb8, 0xce,
+    0x15, 0xdd, 0xec, 0xe4, 0x67, 0x33, 0xc2, 0x73, 0x3c, 0x56, 0x92, 0xd9, 0xe3, 0xfe, 0x4e, 0x32,
+    0x6c, 0x43, 0x9d, 0xac, 0x6b, 0x85, 0x5d, 0xff, 0x80, 0x5e, 0x1b, 0xcc, 0x6b, 0x9f, 0xec, 0xdb,
+    0x61, 0x26, 0xdc, 0xa6, 0xd1, 0x33, 0x7e, 0xda, 0x17, 0xbc, 0x62, 0x7e, 0x77, 0x4b, 0x1e, 0xc8,
+    0x92, 0xce, 0x14, 0x8b, 0x1a, 0x42, 0xd7, 0x2c, 0x70, 0x1e, 0x45, 0xcc, 0xc1, 0xf5, 0x9f, 0x26,
+    0x5e, 0xa8, 0x33, 0x5d, 0x64, 0xfa, 0x01, 0xe8, 0x2e, 0x67, 0xbf, 0x9c, 0xa1, 0xa0, 0x24, 0xf8,
+    0xec, 0x7e, 0x51, 0x2e, 0xd1, 0x86, 0x0b, 0x43, 0x9f, 0xf2, 0xc8, 0x4e, 0x79, 0xd4, 0xa7, 0xfc,
+    0xed, 0x3b, 0x5a, 0xe5, 0x61, 0xe8, 0xbf, 0x12, 0x00, 0x00,
+};
+
+static const uint8_t ASSET_APP_JS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x1a, 0x6b, 0x6f, 0xdb, 0x38,
+    0xf2, 0xbb, 0x7f, 0x05, 0x13, 0xf4, 0x2a, 0x19, 0xb5, 0x15, 0xa7, 0x7b, 0x07, 0x2c, 0xec, 0x24,
+    0x8b, 0x3e, 0xaf, 0x3d, 0xa4, 0x4d, 0xb1, 0x49, 0xef, 0x70, 0xc8, 0x05, 0x6b, 0xd9, 0xa2, 0x63,
+    0x5e, 0x65, 0xd1, 0x95, 0xa8, 0xa4, 0x46, 0xd6, 0xff, 0xfd, 0x66, 0x86, 0xa4, 0x48, 0xc9, 0xb2,
+    0x93, 0x6c, 0xb7, 0x38, 0x04, 0xad, 0x25, 0x71, 0x66, 0x38, 0xef, 0x07, 0xa5, 0x59, 0x99, 0x4d,
+    0x95, 0x90, 0x19, 0x5b, 0xca, 0x65, 0x99, 0xc6, 0x8a, 0x5f, 0x88, 0x05, 0x3f, 0x5b, 0xe2, 0xa3,
+    0x22, 0xec, 0xb2, 0xbb, 0xce, 0x14, 0x2e, 0x14, 0x2b, 0x54, 0x9c, 0xab, 0x73, 0x9e, 0xf2, 0xa9,
+    0x62, 0xc7, 0x2c, 0x91, 0xd3, 0x72, 0xc1, 0x33, 0x15, 0x5d, 0x73, 0xf5, 0x26, 0xe5, 0x78, 0xf9,
+    0x72, 0xf5, 0x3e, 0x09, 0x83, 0x4c, 0x5c, 0xcf, 0x55, 0x9f, 0x80, 0x83, 0xee, 0xc8, 0xe0, 0xf2,
+    0x2c, 0x79, 0x28, 0x26, 0x80, 0x22, 0x9e, 0x98, 0xb1, 0x70, 0xcf, 0xdf, 0xf2, 0xf7, 0xdf, 0xd9,
+    0x5e, 0x45, 0xa6, 0xcb, 0x72, 0xae, 0xca, 0x3c, 0x1b, 0x75, 0x66, 0x32, 0x67, 0x61, 0xca, 0x15,
+    0x13, 0x40, 0x7a, 0x30, 0x82, 0x9f, 0x23, 0xf6, 0xfc, 0xaf, 0xf0, 0xfb, 0xec, 0x99, 0x63, 0x7d,
+    0x2e, 0xcb, 0x1c, 0x96, 0x45, 0xa4, 0xe4, 0xb9, 0xca, 0x45, 0x76, 0x1d, 0x76, 0xa3, 0x65, 0x9c,
+    0x9c, 0x23, 0xf9, 0xf0, 0x79, 0x8f, 0x05, 0x03, 0xc7, 0xaa, 0x02, 0xe1, 0x35, 0x10, 0x60, 0x8c,
+    0x9f, 0xdc, 0x21, 0xee, 0x7a, 0x38, 0x18, 0x8c, 0x47, 0x1d, 0x8f, 0x9d, 0x28, 0x4e, 0x92, 0x30,
+    0xe3, 0xb7, 0x4c, 0xeb, 0x29, 0x74, 0x58, 0x3d, 0x26, 0xba, 0x40, 0xac, 0x62, 0xf5, 0x5e, 0xc8,
+    0x35, 0xfc, 0xcd, 0xac, 0x09, 0x0a, 0x10, 0x6b, 0x79, 0x9e, 0x8a, 0x84, 0xe7, 0xa7, 0xf1, 0x84,
+    0xa7, 0xda, 0x00, 0x95, 0x90, 0x05, 0xad, 0x30, 0x39, 0x73, 0x5a, 0xfc, 0x5a, 0xf2, 0x7c, 0xa5,
+    0xb7, 0x92, 0xf9, 0x8b, 0x34, 0x0d, 0x03, 0x91, 0x2d, 0x4b, 0x75, 0xa9, 0x56, 0x4b, 0x7e, 0xbc,
+    0x9f, 0xc7, 0xd9, 0x35, 0xdf, 0xbf, 0x0a, 0xba, 0x4e, 0x19, 0x29, 0xd2, 0xdd, 0x61, 0x07, 0xbd,
+    0x47, 0x24, 0x12, 0xf6, 0x8c, 0x05, 0xfd, 0x9b, 0x38, 0x2d, 0xb9, 0x35, 0x08, 0xa1, 0x76, 0x0d,
+    0x17, 0x28, 0xd8, 0x9b, 0x1b, 0xc0, 0x3a, 0x15, 0x85, 0xe2, 0x19, 0xcf, 0xcd, 0xce, 0x41, 0x8f,
+    0x01, 0xd3, 0xc7, 0x27, 0xec, 0x4e, 0x6f, 0x15, 0x29, 0xfe, 0x4d, 0xbd, 0x92, 0x19, 0xc0, 0xa0,
+    0xf9, 0x0d, 0x32, 0xd1, 0x1d, 0xb1, 0x75, 0xab, 0x02, 0x2e, 0xe6, 0xc0, 0xce, 0x85, 0xbc, 0xbe,
+    0x4e, 0xb9, 0xe7, 0x80, 0xca, 0x3d, 0x7d, 0xa9, 0xb2, 0x5d, 0x9e, 0x44, 0x90, 0x7d, 0x45, 0xa0,
+    0xfd, 0x89, 0xca, 0x9c, 0x75, 0x8b, 0x32, 0x7b, 0x0f, 0x57, 0xbb, 0x90, 0x01, 0xa4, 0x2f, 0x00,
+    0xc6, 0x21, 0x2d, 0xa4, 0xbc, 0x17, 0x0b, 0x61, 0x2a, 0x34, 0x72, 0xde, 0x06, 0xbb, 0xe8, 0xbf,
+    0x76, 0x77, 0xbc, 0xb6, 0x44, 0x9d, 0x2b, 0x1b, 0x0e, 0xe3, 0x1b, 0x9e, 0x90, 0x02, 0x60, 0xbb,
+    0x54, 0x4e, 0xe3, 0xf4, 0x1c, 0x0c, 0x1b, 0x5f, 0x73, 0xdc, 0xf2, 0xbd, 0xe2, 0x0b, 0x23, 0x9e,
+    0x63, 0x6f, 0x99, 0xf3, 0x19, 0xcf, 0x8b, 0xd7, 0x71, 0xfe, 0x05, 0x50, 0x6e, 0x45, 0x96, 0xc8,
+    0xdb, 0x68, 0x11, 0xab, 0xe9, 0xfc, 0x03, 0x4f, 0x44, 0xcc, 0x9e, 0x3e, 0xdd, 0x7c, 0x18, 0x06,
+    0xa1, 0x41, 0xeb, 0x4f, 0x65, 0x2a, 0xf3, 0x7e, 0x31, 0x45, 0xa2, 0x43, 0x96, 0x00, 0x95, 0x6e,
+    0xd0, 0xd5, 0xa0, 0xbc, 0xd0, 0xb2, 0xf8, 0x3c, 0x1d, 0x1f, 0xb3, 0x00, 0x81, 0x02, 0x94, 0x02,
+    0x42, 0xd4, 0x2d, 0xc1, 0x3e, 0x1e, 0x2b, 0xe4, 0x71, 0x95, 0xba, 0xec, 0x85, 0xd1, 0x59, 0x04,
+    0x66, 0x7e, 0xa1, 0x20, 0x0a, 0x26, 0xa5, 0xe2, 0x21, 0xd0, 0x53, 0x71, 0x5f, 0x4b, 0xd5, 0x33,
+    0xd4, 0x41, 0x3a, 0xa3, 0xad, 0xa8, 0x50, 0xab, 0x94, 0x47, 0x89, 0x28, 0x96, 0x69, 0xbc, 0x02,
+    0x09, 0x83, 0x4c, 0x66, 0x3c, 0x18, 0x75, 0xac, 0x06, 0x37, 0x01, 0x26, 0xa0, 0xb7, 0x2f, 0x01,
+    0x7a, 0x56, 0xdd, 0x08, 0x2d, 0x2e, 0x3b, 0x4d, 0x05, 0x80, 0x56, 0x2e, 0x6b, 0x54, 0x3a, 0x2d,
+    0xf3, 0x1c, 0xc0, 0xac, 0x19, 0xb6, 0x8a, 0x71, 0xbd, 0x4d, 0x0c, 0xe3, 0x04, 0x75, 0x3a, 0x95,
+    0xea, 0xfe, 0xb0, 0x6a, 0x52, 0x4c, 0x91, 0x48, 0xbc, 0xe6, 0x18, 0x45, 0xdd, 0x31, 0x7c, 0xb8,
+    0xad, 0x3a, 0xb4, 0x2a, 0xda, 0xae, 0x44, 0xa3, 0xe5, 0x35, 0x83, 0x2c, 0xc4, 0xbf, 0xd7, 0x96,
+    0xf7, 0xf0, 0xfb, 0x67, 0x9a, 0x5c, 0xa7, 0x14, 0x97, 0x50, 0xe6, 0xf2, 0x16, 0x12, 0xbd, 0x2a,
+    0x8b, 0x70, 0xc1, 0x8b, 0x02, 0xf6, 0x87, 0xbc, 0x5b, 0xbc, 0xc9, 0x73, 0x89, 0x25, 0x61, 0x16,
+    0x83, 0x70, 0xb5, 0x1a, 0x07, 0x80, 0xaf, 0xc5, 0xcd, 0xce, 0x04, 0x41, 0x40, 0x7e, 0x91, 0xd2,
+    0x38, 0x2e, 0x92, 0xab, 0x47, 0x8d, 0xdc, 0x67, 0x18, 0xf0, 0x01, 0xb6, 0x0a, 0xe2, 0x40, 0xa6,
+    0x69, 0x5c, 0x14, 0x1f, 0x63, 0xf2, 0x44, 0xb3, 0x39, 0x0b, 0x20, 0x39, 0x87, 0x56, 0x8c, 0x5f,
+    0x58, 0xc0, 0xf1, 0x22, 0x60, 0x43, 0x00, 0x28, 0xa7, 0x53, 0xd8, 0x86, 0xb4, 0xc9, 0x15, 0x96,
+    0x72, 0x59, 0xaa, 0xd0, 0xba, 0xf7, 0x8e, 0x8d, 0xad, 0xbd, 0x7b, 0xec, 0xa7, 0xc1, 0x60, 0x40,
+    0x4a, 0x8c, 0x8b, 0x55, 0x36, 0x65, 0x95, 0x2a, 0x53, 0x19, 0x27, 0x9f, 0x28, 0xc2, 0x79, 0x06,
+    0x7b, 0x50, 0x6a, 0x56, 0xf9, 0xaa, 0xd2, 0x5e, 0xce, 0x8b, 0x25, 0x5c, 0x20, 0x9f, 0xf1, 0x6d,
+    0x2c, 0x14, 0x9b, 0x71, 0x48, 0x22, 0x61, 0x70, 0x10, 0x2f, 0xc5, 0xc1, 0xd2, 0x21, 0x82, 0xc5,
+    0xef, 0x3a, 0x0b, 0xae, 0xe6, 0x32, 0x01, 0x86, 0xff, 0xfe, 0xe6, 0x22, 0xe8, 0x75, 0xe6, 0x3c,
+    0x86, 0xb2, 0x50, 0x0c, 0x61, 0x25, 0x78, 0x01, 0x12, 0x2c, 0x55, 0x00, 0x6b, 0xf1, 0x72, 0x09,
+    0xf1, 0x19, 0xe3, 0xee, 0x07, 0xff, 0x2d, 0x20, 0xb9, 0x1a, 0xfb, 0x92, 0xe2, 0xed, 0x76, 0x91,
+    0xfc, 0x42, 0x9c, 0xcc, 0x73, 0x79, 0xcb, 0xb0, 0xd2, 0x92, 0x56, 0xc2, 0xf1, 0xbb, 0x8b, 0x8b,
+    0x4f, 0x8c, 0x14, 0xb3, 0x67, 0x0c, 0x3b, 0x64, 0x4f, 0xee, 0x2a, 0x2c, 0xfd, 0x68, 0x3d, 0x26,
+    0x49, 0x2b, 0x01, 0xca, 0x54, 0x55, 0xec, 0x57, 0xa0, 0xb8, 0x75, 0x68, 0xf2, 0xad, 0x04, 0xad,
+    0xa5, 0xf2, 0x3a, 0x0c, 0x4e, 0x41, 0x1b, 0x3c, 0x61, 0x9e, 0x5c, 0x43, 0x10, 0x4c, 0x93, 0xf0,
+    0x58, 0x84, 0xbb, 0xc8, 0xd8, 0xa4, 0x8d, 0x4b, 0x03, 0x41, 0x6c, 0x62, 0x46, 0x0d, 0xde, 0xc6,
+    0x22, 0x05, 0xb2, 0x4a, 0x92, 0xba, 0x7d, 0xf2, 0x81, 0xc7, 0x29, 0x46, 0x19, 0xf0, 0x69, 0xb0,
+    0xf1, 0xce, 0x56, 0x83, 0x3c, 0x4e, 0x84, 0x7c, 0x59, 0x2a, 0x05, 0x77, 0xed, 0x5e, 0x5c, 0xbc,
+    0x5c, 0xa1, 0x37, 0x99, 0x86, 0xeb, 0xb5, 0x58, 0x2c, 0xa0, 0x19, 0x41, 0xe2, 0x55, 0x9b, 0x41,
+    0x34, 0xb0, 0xcb, 0xf0, 0x89, 0x21, 0xf7, 0x28, 0x14, 0x3d, 0xd3, 0xf5, 0x9b, 0x52, 0x5a, 0x88,
+    0xbb, 0x47, 0x3e, 0x2d, 0x72, 0xc8, 0x2c, 0x9e, 0x80, 0x1c, 0xe4, 0x92, 0xe0, 0x64, 0xfa, 0x86,
+    0x6a, 0x82, 0xc6, 0x87, 0xe2, 0x32, 0xfd, 0x02, 0x72, 0x1e, 0x33, 0x95, 0x43, 0x23, 0x40, 0x4d,
+    0x80, 0x15, 0x6d, 0xf5, 0x32, 0x47, 0x6a, 0x19, 0xa8, 0x6c, 0x57, 0x1c, 0x02, 0x60, 0x7f, 0x52,
+    0x41, 0xba, 0x7a, 0x48, 0xac, 0x3c, 0x8c, 0x84, 0x6e, 0x39, 0xdb, 0x88, 0x00, 0xf1, 0x7f, 0x6a,
+    0x11, 0x1f, 0xca, 0x80, 0x6b, 0x95, 0x3c, 0x36, 0xee, 0xa5, 0xd1, 0xe4, 0xa0, 0xde, 0x70, 0xd5,
+    0x75, 0x01, 0x05, 0xd6, 0xb2, 0x45, 0x15, 0xc4, 0x5f, 0xb4, 0x06, 0x21, 0xcf, 0x88, 0x6a, 0x4b,
+    0xa3, 0x8e, 0xc5, 0x6a, 0xa4, 0xa3, 0x36, 0xd0, 0x35, 0xed, 0xdb, 0x54, 0x21, 0xec, 0xec, 0xc4,
+    0xc1, 0xbd, 0x1b, 0x00, 0xf5, 0xdd, 0x1b, 0x8b, 0xa3, 0x8e, 0xc3, 0x6d, 0xe3, 0x60, 0x03, 0x7c,
+    0xfd, 0x7f, 0x9b, 0x38, 0xbc, 0x1d, 0xbb, 0xfe, 0xf6, 0x2d, 0xf2, 0xd1, 0xf0, 0xf0, 0x0e, 0x86,
+    0x03, 0x8d, 0xe9, 0x8d, 0x26, 0xae, 0xf5, 0xdf, 0xc4, 0x7a, 0x93, 0x25, 0x1a, 0x67, 0xcd, 0xa6,
+    0xd8, 0x61, 0x01, 0x22, 0x46, 0xbe, 0xad, 0x40, 0x98, 0x5c, 0xe8, 0x41, 0x18, 0xe8, 0xd4, 0x8e,
+    0x39, 0x00, 0x23, 0xaa, 0x91, 0x65, 0x34, 0x12, 0x64, 0x78, 0x57, 0xdc, 0x76, 0x24, 0x8e, 0x21,
+    0x95, 0x0b, 0xc2, 0x89, 0xaa, 0x1a, 0x88, 0x61, 0x67, 0x9a, 0xef, 0x46, 0x9a, 0xc7, 0x96, 0xce,
+    0x4f, 0xf3, 0x90, 0x16, 0x16, 0xcd, 0x54, 0x8f, 0xcf, 0x5e, 0xeb, 0x1c, 0x84, 0xb9, 0xec, 0xad,
+    0xb9, 0xd5, 0xb0, 0xf5, 0xc6, 0x94, 0x88, 0x00, 0x9c, 0x71, 0x1a, 0x93, 0x23, 0x86, 0x15, 0x09,
+    0xb4, 0x4a, 0x33, 0x17, 0xe9, 0x5e, 0xc9, 0xe6, 0x90, 0x5e, 0xdd, 0xd5, 0x87, 0x6c, 0x19, 0xe7,
+    0x05, 0x7f, 0x9f, 0xa9, 0xb0, 0x4e, 0xa3, 0x06, 0x05, 0xc9, 0xa6, 0xd7, 0x74, 0xd3, 0xad, 0x98,
+    0x0d, 0x38, 0x87, 0x5b, 0x59, 0x79, 0x37, 0x6a, 0x05, 0xe6, 0x30, 0x8d, 0xa5, 0x77, 0xe3, 0x19,
+    0x20, 0xc0, 0xea, 0xac, 0x47, 0xdf, 0x55, 0x45, 0x3f, 0x9d, 0x9d, 0x37, 0xcb, 0xa8, 0x09, 0xb3,
+    0xfe, 0x05, 0x4c, 0x82, 0xad, 0xc5, 0xb4, 0x77, 0x4f, 0xa9, 0xed, 0x75, 0x26, 0x32, 0x59, 0x0d,
+    0xd9, 0x3f, 0xce, 0xcf, 0x3e, 0x42, 0xb9, 0xc4, 0x99, 0x55, 0xcc, 0x56, 0xa1, 0xc7, 0x43, 0x97,
+    0xaa, 0xf1, 0xc3, 0x8a, 0x27, 0xd5, 0x0e, 0x57, 0xb2, 0x31, 0xa7, 0x6c, 0x96, 0x47, 0xdf, 0xa1,
+    0x3d, 0x1f, 0xd4, 0x53, 0x11, 0x33, 0x80, 0xb3, 0x32, 0x4d, 0x57, 0x54, 0x0d, 0x6d, 0x6f, 0xfa,
+    0x88, 0xaa, 0x8a, 0x94, 0x36, 0xab, 0xea, 0x03, 0xc3, 0x11, 0x90, 0x1f, 0x1d, 0x8d, 0xcd, 0x0d,
+    0xef, 0x8b, 0xc6, 0x2a, 0x0e, 0x97, 0xb0, 0xf2, 0x2b, 0x87, 0xee, 0x4c, 0x77, 0x5a, 0xba, 0xb9,
+    0x64, 0x2f, 0xf2, 0x3c, 0x5e, 0x45, 0xb3, 0x5c, 0x2e, 0xc2, 0x1d, 0x67, 0x00, 0x97, 0xd4, 0x86,
+    0xe7, 0x88, 0x0d, 0xc3, 0x3f, 0xb0, 0x98, 0x62, 0xff, 0x57, 0xb9, 0x22, 0x4c, 0xe5, 0x08, 0x00,
+    0x0d, 0x62, 0x44, 0x30, 0xdd, 0x7a, 0xcf, 0x0c, 0x8c, 0x82, 0x17, 0xd1, 0xde, 0x46, 0x1e, 0x82,
+    0xaa, 0x5a, 0x80, 0x3d, 0xcd, 0x84, 0x28, 0xe8, 0xd7, 0x2e, 0x62, 0xff, 0x8b, 0x17, 0xe0, 0x02,
+    0x97, 0xfa, 0xea, 0xca, 0xf4, 0x14, 0xda, 0x41, 0x04, 0x76, 0x14, 0xbe, 0x50, 0x5d, 0xaf, 0x73,
+    0xd4, 0x4d, 0xa8, 0x46, 0xbb, 0x14, 0x57, 0x55, 0xff, 0x84, 0xcc, 0x31, 0x00, 0x52, 0x22, 0xc3,
+    0x36, 0xc1, 0xb5, 0xe9, 0xdc, 0x64, 0xf2, 0x1d, 0xf9, 0x7d, 0x4c, 0xe8, 0x4f, 0xee, 0xc4, 0xba,
+    0x6f, 0x06, 0xb1, 0x3e, 0x61, 0x8e, 0x2b, 0x9f, 0x95, 0x37, 0x60, 0x07, 0x91, 0x3c, 0x8e, 0x96,
+    0x45, 0x6a, 0x12, 0x7b, 0x78, 0xe7, 0xe5, 0x88, 0x9d, 0x5b, 0x12, 0xa6, 0xfa, 0x54, 0x62, 0x75,
+    0x4d, 0xb3, 0x6e, 0xef, 0x1b, 0x85, 0x93, 0x08, 0x50, 0x0b, 0x6b, 0xa6, 0x89, 0x0a, 0xce, 0x9f,
+    0x16, 0x3c, 0xa8, 0x48, 0xc9, 0x53, 0x79, 0xcb, 0xf3, 0x57, 0x60, 0xf4, 0xb0, 0x6b, 0xeb, 0x7c,
+    0x43, 0x7e, 0xdc, 0xb4, 0xf1, 0xa8, 0x75, 0x5f, 0x0b, 0x83, 0x8d, 0xde, 0xbf, 0x21, 0x84, 0xb0,
+    0xc9, 0xfb, 0x28, 0x69, 0xfa, 0xba, 0xbf, 0x87, 0x6c, 0xf6, 0x7f, 0xcd, 0x7e, 0xb2, 0x26, 0xda,
+    0xba, 0xad, 0x40, 0x95, 0x4b, 0x70, 0x5e, 0xee, 0xbb, 0xe7, 0xa3, 0x26, 0x11, 0xda, 0x20, 0x68,
+    0x9d, 0x22, 0xbe, 0x63, 0x86, 0xd8, 0x8c, 0x99, 0xd6, 0x3c, 0xd8, 0x7d, 0x70, 0xe9, 0x27, 0x29,
+    0x31, 0xdb, 0xe8, 0xe0, 0x30, 0xbb, 0x7b, 0xe9, 0x66, 0xbd, 0x19, 0xb2, 0xe7, 0x1c, 0x08, 0xe5,
+    0x45, 0x58, 0xe8, 0x5f, 0x6f, 0xb0, 0xe5, 0x1a, 0x6c, 0xd7, 0x58, 0x4b, 0x38, 0x7d, 0x03, 0xe9,
+    0xc6, 0x5b, 0x7d, 0xdf, 0x3c, 0xa6, 0x9a, 0x09, 0x9e, 0x26, 0x14, 0xea, 0x9d, 0x4b, 0x8b, 0x0a,
+    0x33, 0xfd, 0x92, 0xe7, 0xc0, 0x66, 0x8e, 0x43, 0xbd, 0xe1, 0x21, 0xf2, 0x9e, 0xc2, 0xa4, 0xcf,
+    0xfe, 0x53, 0x0e, 0x06, 0x93, 0xc1, 0xab, 0xe0, 0xaa, 0xe7, 0x10, 0xe7, 0xe5, 0x42, 0x24, 0x42,
+    0xad, 0x3c, 0x2c, 0xfb, 0x08, 0x51, 0xfe, 0x52, 0x03, 0x86, 0x54, 0x5a, 0x14, 0xf5, 0x2d, 0xec,
+    0x23, 0x04, 0x9e, 0x7f, 0x8a, 0x6b, 0xe0, 0x39, 0x5f, 0x48, 0xc5, 0xb7, 0xf0, 0xa6, 0x17, 0x7f,
+    0xdb, 0xce, 0x62, 0x3d, 0x83, 0x5d, 0x8a, 0xa4, 0xc7, 0xc8, 0x53, 0x7b, 0xac, 0xcc, 0x84, 0xba,
+    0x42, 0xff, 0xd6, 0x9a, 0x70, 0xaa, 0xe6, 0xf7, 0xe6, 0x12, 0x91, 0x18, 0xe5, 0x72, 0x1b, 0x76,
+    0xbc, 0x35, 0xd8, 0xf0, 0x08, 0x17, 0x36, 0x70, 0xa1, 0x11, 0x64, 0xe5, 0x62, 0xc2, 0x61, 0xce,
+    0xff, 0x45, 0x3f, 0x84, 0xa0, 0x7e, 0x2b, 0xbe, 0xf1, 0x24, 0x3c, 0xec, 0x42, 0x49, 0x41, 0x8e,
+    0x30, 0x12, 0xfb, 0x7d, 0x8a, 0x44, 0x63, 0xb8, 0x68, 0x2e, 0x92, 0x84, 0x67, 0xf6, 0xac, 0xa3,
+    0x7e, 0x36, 0x52, 0x4e, 0x8a, 0x69, 0x2e, 0x26, 0xfc, 0x42, 0xd2, 0xb1, 0x98, 0x0e, 0x24, 0x32,
+    0xbb, 0x39, 0x31, 0xa4, 0xc7, 0xe7, 0xd0, 0xa2, 0x4c, 0xa9, 0xed, 0x6f, 0x89, 0x3c, 0xeb, 0x10,
+    0x02, 0xb8, 0xce, 0x81, 0x2b, 0x3c, 0xe2, 0xe5, 0xea, 0xbd, 0xb9, 0x0b, 0x37, 0x30, 0x7a, 0xec,
+    0x6f, 0xfa, 0x78, 0xc1, 0xd4, 0x33, 0x7d, 0x32, 0x31, 0x4d, 0x79, 0x9c, 0x57, 0x48, 0x96, 0x96,
+    0x37, 0xf0, 0x72, 0xc7, 0x88, 0xe9, 0x39, 0x3d, 0xd6, 0x4c, 0x60, 0x13, 0x0c, 0x15, 0x74, 0x0f,
+    0xba, 0xe5, 0xcc, 0x4f, 0x27, 0x80, 0x5e, 0x95, 0x50, 0x42, 0x02, 0xd7, 0x35, 0xb6, 0x19, 0xc4,
+    0xd4, 0xfb, 0x50, 0xdd, 0xd4, 0x50, 0x54, 0x37, 0x29, 0x8a, 0xef, 0xdd, 0xc6, 0x38, 0xd9, 0x8e,
+    0x8d, 0x6c, 0xb8, 0xee, 0xdc, 0xa4, 0xa6, 0x27, 0x7f, 0xc7, 0x69, 0x2a, 0x6d, 0x2e, 0xf7, 0xaa,
+    0xe8, 0xb9, 0x84, 0xbc, 0xaa, 0xa8, 0xdf, 0x2e, 0xe8, 0x72, 0xc8, 0x32, 0xe8, 0x97, 0x7a, 0x1d,
+    0x02, 0x87, 0x56, 0x91, 0xdc, 0xa0, 0x07, 0xee, 0xf1, 0x75, 0xc8, 0x06, 0xbd, 0x0e, 0x9d, 0xd1,
+    0x63, 0xc3, 0x08, 0xed, 0x1e, 0x90, 0xc9, 0xc0, 0x6b, 0x36, 0xbc, 0xe0, 0x5f, 0x7c, 0x62, 0xc8,
+    0x42, 0x2f, 0xa5, 0xe6, 0xa2, 0xd0, 0x7b, 0x27, 0x1b, 0x67, 0xd7, 0x76, 0x6f, 0xb4, 0x4f, 0x85,
+    0x14, 0x8e, 0x6f, 0x8b, 0xe1, 0xc1, 0xc1, 0x93, 0x3b, 0x3c, 0x04, 0xd4, 0x2e, 0x29, 0x0b, 0xb5,
+    0x76, 0xb9, 0xf8, 0xe0, 0xb6, 0xc0, 0x0c, 0xaa, 0xb1, 0xa3, 0x89, 0xc8, 0xe2, 0x7c, 0x85, 0x4d,
+    0x2b, 0x9e, 0x4a, 0xc5, 0xd8, 0x61, 0x4c, 0xca, 0x19, 0x74, 0x4f, 0x41, 0x05, 0x22, 0x33, 0xb9,
+    0x24, 0x97, 0xb6, 0x2f, 0x1a, 0x88, 0xa7, 0x6a, 0x77, 0x7d, 0x31, 0x62, 0x6b, 0x0f, 0xc1, 0x74,
+    0x5a, 0xb0, 0x4a, 0x2a, 0x44, 0x34, 0x42, 0xca, 0xf9, 0x94, 0x8b, 0x1b, 0x4e, 0x6f, 0x68, 0x3e,
+    0x83, 0xdf, 0xfd, 0xac, 0x5b, 0x9a, 0xba, 0x19, 0x2a, 0x2a, 0x24, 0xb6, 0xdb, 0xb7, 0x53, 0xdf,
+    0x17, 0xf5, 0xdc, 0x72, 0xea, 0xa6, 0x15, 0x66, 0x55, 0xeb, 0x8e, 0xd7, 0xf0, 0xac, 0xad, 0x63,
+    0x8c, 0x68, 0x69, 0x69, 0xbd, 0x56, 0xa7, 0x22, 0x68, 0x04, 0x6f, 0x8f, 0xae, 0x2f, 0xa8, 0x67,
+    0x7f, 0xb4, 0x66, 0x96, 0xe8, 0x3e, 0xac, 0xa7, 0xbb, 0xa3, 0xca, 0x84, 0x3e, 0x8b, 0xd6, 0x7a,
+    0x86, 0x40, 0x0e, 0xc3, 0x02, 0xf9, 0x39, 0x67, 0x7b, 0x90, 0x5d, 0x2a, 0x83, 0x45, 0x67, 0x9f,
+    0xde, 0x7c, 0xb4, 0xb6, 0xb5, 0x69, 0x43, 0x23, 0xf2, 0xaf, 0x28, 0x7d, 0x75, 0xfd, 0x8c, 0x41,
+    0xe6, 0x79, 0xca, 0x06, 0xdf, 0xde, 0xbe, 0x35, 0x10, 0xda, 0x9d, 0x2e, 0x2d, 0xc4, 0x15, 0xbe,
+    0x44, 0xa3, 0x78, 0xa2, 0xb2, 0x89, 0xbf, 0x80, 0xb3, 0x86, 0x1b, 0xe2, 0x72, 0x3d, 0x1e, 0xf9,
+    0x3a, 0x8c, 0x48, 0x8c, 0x86, 0x29, 0x2e, 0x07, 0xdf, 0x06, 0x87, 0x3d, 0x66, 0x29, 0xf6, 0x98,
+    0x2f, 0xa6, 0x4e, 0x8b, 0x67, 0x1f, 0x31, 0x25, 0x1e, 0x42, 0xf2, 0x1b, 0x5c, 0x75, 0x5d, 0xc8,
+    0x98, 0x93, 0xa5, 0x5e, 0xc7, 0x1a, 0x79, 0x96, 0x43, 0x5f, 0xb4, 0xf9, 0x26, 0xcc, 0x67, 0x9c,
+    0x40, 0x2e, 0x0f, 0xaf, 0xae, 0x68, 0x6c, 0x20, 0xce, 0x03, 0x6d, 0x07, 0xbd, 0x32, 0xb8, 0xa2,
+    0x2d, 0x07, 0xdf, 0x7e, 0x3e, 0xb4, 0x2a, 0xd6, 0x0b, 0xcf, 0xcd, 0x42, 0x63, 0x8a, 0x19, 0x83,
+    0xdb, 0x23, 0x65, 0x28, 0xfa, 0x72, 0xb1, 0x88, 0xb3, 0x04, 0x6b, 0x8f, 0x1a, 0x57, 0x4c, 0x62,
+    0xf4, 0x26, 0x90, 0xfe, 0x41, 0x94, 0x56, 0x36, 0x6a, 0x53, 0xc5, 0xd8, 0x4d, 0x15, 0xd8, 0x12,
+    0xe7, 0x32, 0xd5, 0xca, 0xc0, 0x9e, 0xa4, 0xc6, 0xc5, 0x73, 0xec, 0xcc, 0x12, 0x7e, 0x23, 0x20,
+    0x5b, 0x4e, 0xca, 0x62, 0x45, 0x1d, 0x9a, 0xc8, 0x20, 0xa5, 0x8a, 0xc4, 0x32, 0x12, 0xac, 0xc7,
+    0x6e, 0xee, 0xd0, 0x83, 0x54, 0x9b, 0x98, 0xcf, 0xe9, 0xa8, 0x69, 0x27, 0x87, 0x0e, 0xed, 0xa7,
+    0xfb, 0x94, 0x90, 0xc8, 0x8c, 0xda, 0xdd, 0x6a, 0x72, 0x6b, 0x85, 0xb2, 0xd2, 0x18, 0x72, 0x87,
+    0x28, 0xcd, 0x8c, 0x44, 0x27, 0x41, 0xf0, 0x15, 0x6a, 0xc2, 0x20, 0xc0, 0x6a, 0x22, 0xe8, 0xbf,
+    0x51, 0xe3, 0x55, 0x22, 0x59, 0xf0, 0x95, 0x56, 0x96, 0x9d, 0xa3, 0xaa, 0x2c, 0xe9, 0xa2, 0xf2,
+    0x51, 0x83, 0xca, 0xaf, 0xd8, 0xb1, 0x3e, 0xbe, 0xc5, 0x6f, 0x69, 0x8d, 0x1d, 0x35, 0xd7, 0x19,
+    0xb7, 0xbc, 0xa3, 0x9a, 0xe3, 0x5b, 0x5c, 0xa8, 0x23, 0xf5, 0x3e, 0xb8, 0x4a, 0xd3, 0xbe, 0x44,
+    0x14, 0x41, 0xc2, 0x84, 0x0b, 0x35, 0x09, 0x5d, 0x97, 0xa5, 0x1f, 0xd9, 0x22, 0xff, 0x09, 0x07,
+    0x0c, 0xdb, 0xce, 0x10, 0x8c, 0x19, 0x7e, 0x13, 0x40, 0x5a, 0xf4, 0xf4, 0x04, 0x33, 0xf4, 0x98,
+    0x86, 0xca, 0xf7, 0x03, 0x8f, 0x16, 0xaa, 0x8c, 0x24, 0x6c, 0x36, 0x72, 0x3b, 0xd7, 0x03, 0xb5,
+    0x76, 0xe4, 0x30, 0xfe, 0x83, 0x47, 0x0e, 0xb5, 0x58, 0x7d, 0xd4, 0x79, 0x83, 0xc1, 0x4c, 0xab,
+    0x31, 0xe0, 0xfe, 0xe3, 0x86, 0x46, 0x62, 0xd8, 0x79, 0xd6, 0xd0, 0xdd, 0x32, 0x60, 0x41, 0x5b,
+    0x02, 0xad, 0xf0, 0x39, 0x20, 0x58, 0x37, 0x7b, 0xb0, 0xe7, 0x14, 0x1a, 0xc9, 0x7b, 0xe3, 0xae,
+    0x1f, 0xec, 0x36, 0xde, 0x9e, 0x81, 0x8a, 0xcc, 0x91, 0x1f, 0x2a, 0xd0, 0x3e, 0x8a, 0x4b, 0x35,
+    0x07, 0x4b, 0xa0, 0x63, 0xb9, 0x8e, 0xc3, 0xe6, 0xf6, 0x07, 0xaa, 0x11, 0x87, 0x4d, 0xd4, 0xa1,
+    0xa1, 0xe9, 0x6b, 0xb1, 0x4e, 0x8f, 0x94, 0x7a, 0x2a, 0xaf, 0x05, 0xb1, 0x56, 0xaf, 0x80, 0x8d,
+    0x97, 0x8a, 0x06, 0xca, 0xbd, 0x33, 0x8e, 0xf3, 0xc4, 0xcf, 0x09, 0xb5, 0x43, 0x99, 0x30, 0x88,
+    0x70, 0xbd, 0x9a, 0xaa, 0xf0, 0xa6, 0xf1, 0x11, 0x8b, 0xa1, 0x32, 0x17, 0x69, 0x82, 0xb9, 0x01,
+    0x21, 0x22, 0xba, 0x83, 0x5e, 0xd1, 0x46, 0x3a, 0xdd, 0x47, 0x2a, 0xbe, 0xa6, 0x01, 0x1f, 0x8b,
+    0x76, 0xf0, 0xee, 0x30, 0x40, 0x7f, 0xdf, 0xd3, 0x4b, 0x34, 0xfd, 0x63, 0xe6, 0xc0, 0xd4, 0xa6,
+    0x62, 0x91, 0x15, 0xf5, 0xaf, 0x21, 0x82, 0x2e, 0x02, 0x6b, 0x58, 0x28, 0x05, 0x44, 0xc1, 0xbe,
+    0xcf, 0x44, 0x49, 0x68, 0x61, 0xeb, 0xab, 0xc1, 0xaa, 0xd3, 0xc4, 0xa3, 0x4c, 0x5f, 0xd6, 0x29,
+    0xb4, 0x12, 0xd5, 0x11, 0x44, 0x18, 0xe0, 0xb2, 0x79, 0xa1, 0xb4, 0xa8, 0xbf, 0xbe, 0x4c, 0x51,
+    0x69, 0x7d, 0x5a, 0x37, 0xcb, 0x02, 0x32, 0x70, 0xfe, 0xee, 0xe2, 0xc3, 0x29, 0x2e, 0x1f, 0x25,
+    0xe2, 0x86, 0x11, 0xc2, 0xf1, 0x3e, 0xae, 0xf6, 0xaf, 0x73, 0x59, 0x2e, 0xf7, 0x4f, 0x8e, 0x74,
+    0xa9, 0x86, 0x47, 0xc7, 0xfb, 0x9a, 0x44, 0x59, 0xf0, 0x3c, 0x03, 0xa2, 0xfb, 0x27, 0x9f, 0xcd,
+    0xd5, 0xd1, 0x01, 0x01, 0x9d, 0x80, 0xc7, 0x77, 0x82, 0x23, 0xfa, 0x14, 0x85, 0x89, 0x64, 0x03,
+    0x9e, 0xe1, 0xff, 0xc7, 0xfb, 0xee, 0x1e, 0xfc, 0x4b, 0x42, 0xc8, 0x2f, 0xb1, 0xc2, 0xf9, 0xcf,
+    0x73, 0xfe, 0xb5, 0x14, 0x39, 0x4f, 0x4e, 0x8e, 0x0e, 0x80, 0x2b, 0x43, 0xf6, 0xc1, 0xfc, 0x2d,
+    0x01, 0xe6, 0x56, 0xe6, 0xc9, 0xfe, 0xc9, 0x27, 0x73, 0xb5, 0x9b, 0xbf, 0x0a, 0xde, 0xf0, 0xe7,
+    0xee, 0xf5, 0x87, 0x3c, 0xee, 0xbe, 0xce, 0xaf, 0x3d, 0xd8, 0x72, 0xeb, 0xad, 0x7c, 0x4f, 0xe8,
+    0xfc, 0xc5, 0xd0, 0x82, 0xb1, 0x6f, 0x21, 0xd4, 0xbe, 0x15, 0x04, 0x0f, 0x28, 0xfb, 0x1a, 0x60,
+    0xff, 0x04, 0xbc, 0x1a, 0x46, 0xb9, 0xa3, 0x03, 0x7d, 0x7f, 0x62, 0xad, 0x04, 0x56, 0x27, 0x24,
+    0x0c, 0xe3, 0x7a, 0x11, 0xa2, 0x7e, 0x8a, 0xe3, 0x08, 0x8e, 0x45, 0xeb, 0x35, 0x9f, 0xc5, 0x90,
+    0x06, 0x31, 0x78, 0x1e, 0x9c, 0x32, 0x48, 0x01, 0x3f, 0xb6, 0xd8, 0x58, 0xab, 0x9a, 0x12, 0x63,
+    0x6f, 0x75, 0xc6, 0xef, 0x75, 0xac, 0xf2, 0xcc, 0xb2, 0xbd, 0xfd, 0x61, 0xa5, 0xa8, 0x1a, 0x84,
+    0x20, 0x49, 0xcb, 0x38, 0x09, 0x1f, 0x55, 0x57, 0x28, 0xef, 0x30, 0xd3, 0x0e, 0x6d, 0x29, 0x26,
+    0x5e, 0x69, 0xd8, 0x9a, 0xfc, 0x41, 0x22, 0x4c, 0x31, 0x8d, 0x34, 0x35, 0x3f, 0x0c, 0xba, 0x51,
+    0x3c, 0x83, 0xf9, 0xdb, 0xbe, 0xcb, 0x59, 0xbb, 0x2f, 0x3f, 0x36, 0x5b, 0x93, 0xd7, 0x67, 0x1f,
+    0x8c, 0x61, 0xf4, 0xeb, 0xf0, 0xf6, 0x26, 0x65, 0xf3, 0xa3, 0x2e, 0x93, 0x06, 0xb5, 0x12, 0x1b,
+    0xe5, 0xc6, 0xe5, 0xc5, 0xd6, 0x0f, 0x12, 0x47, 0x9d, 0x96, 0x8f, 0xe4, 0xcc, 0xc3, 0x46, 0xb7,
+    0xe7, 0xce, 0x8b, 0xe5, 0xf2, 0x33, 0x1d, 0x44, 0x60, 0xd7, 0xd6, 0x72, 0xea, 0x81, 0x1f, 0xa8,
+    0x34, 0xbe, 0x6d, 0x18, 0x6d, 0x49, 0x75, 0xcd, 0x63, 0x33, 0xef, 0x64, 0xbf, 0x6f, 0xf3, 0x1e,
+    0x35, 0xc4, 0xe6, 0xad, 0x59, 0x33, 0x7c, 0xee, 0x0f, 0x9c, 0xe6, 0xfb, 0x37, 0xf4, 0x49, 0x33,
+    0x2f, 0x76, 0xcc, 0x40, 0xbe, 0x69, 0x88, 0x32, 0x43, 0x09, 0xbc, 0x0f, 0x99, 0x3c, 0x99, 0x75,
+    0x29, 0xf3, 0xba, 0xde, 0x6a, 0x70, 0xd4, 0xff, 0xfe, 0x07, 0x5c, 0x70, 0x4f, 0x61, 0x01, 0x2a,
+    0x00, 0x00,
+};
+
+static const uint8_t ASSET_SETUP_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x57, 0xc9, 0x72, 0xe3, 0x36,
+    0x10, 0xbd, 0xfb, 0x2b, 0x10, 0x9c, 0xc3, 0x55, 0x8b, 0x2d, 0x8f, 0xa8, 0x54, 0xc6, 0x4b, 0xe5,
+    0x90, 0xb1, 0x5d, 0xb1, 0x2f, 0x73, 0x84, 0x40, 0x48, 0xc2, 0x18, 0x04, 0x18, 0x00, 0x92, 0xac,
+    0x7c, 0x7d, 0x1a, 0x8b, 0x2c, 0x51, 0xe6, 0x78, 0x5c, 0x95, 0xb9, 0xa4, 0x74, 0x00, 0xd9, 0x78,
+    0xbd, 0xbc, 0xee, 0x66, 0x03, 0x9a, 0xfe, 0x72, 0x7d, 0x7f, 0xf5, 0xf4, 0xf5, 0xe1, 0x06, 0xad,
+    0x6c, 0x23, 0x66, 0x67, 0xd3, 0xfd, 0xc2, 0x48, 0x0d, 0x8b, 0xe5, 0x56, 0xb0, 0xd9, 0xcd, 0xe3,
+    0xc3, 0xa0, 0x44, 0x57, 0x4a, 0x5a, 0xad, 0x04, 0x7a, 0x20, 0x92, 0x89, 0x69, 0x16, 0xb6, 0xce,
+    0xa6, 0x0d, 0xb3, 0x04, 0x49, 0xd2, 0xb0, 0x0a, 0x6f, 0x38, 0xdb, 0xb6, 0x4a, 0x5b, 0x8c, 0x28,
+    0x60, 0x99, 0xb4, 0x15, 0xde, 0xf2, 0xda, 0xae, 0xaa, 0x9a, 0x6d, 0x38, 0x65, 0x89, 0x7f, 0xf9,
+    0x15, 0x71, 0xc9, 0x2d, 0x27, 0x22, 0x31, 0x94, 0x08, 0x56, 0x15, 0x18, 0x8c, 0x08, 0x2e, 0x9f,
+    0x91, 0x66, 0xa2, 0xc2, 0xc6, 0xee, 0x04, 0x33, 0x2b, 0xc6, 0xc0, 0xca, 0x4a, 0xb3, 0x45, 0x85,
+    0x33, 0xd2, 0xb6, 0x29, 0x35, 0xe6, 0xb7, 0x4d, 0xb5, 0x58, 0xd0, 0x31, 0xbb, 0x98, 0x8f, 0x86,
+    0x8b, 0xfc, 0xa2, 0x38, 0x5f, 0x10, 0xa7, 0x9a, 0xc5, 0x50, 0xe7, 0xaa, 0xde, 0xc1, 0x52, 0xf3,
+    0x0d, 0xa2, 0x82, 0x18, 0x53, 0x61, 0x4a, 0x74, 0xed, 0x10, 0xab, 0xa2, 0x9f, 0x01, 0xc8, 0x3b,
+    0x78, 0xbb, 0x62, 0x0d, 0x4b, 0xac, 0x5a, 0x2e, 0x05, 0x73, 0x7a, 0xf3, 0xb5, 0xb5, 0x4a, 0x22,
+    0x5e, 0x77, 0xb7, 0x92, 0xb9, 0x95, 0x18, 0x11, 0xcd, 0x49, 0x22, 0xc8, 0xdc, 0xc5, 0xfc, 0xe4,
+    0xe5, 0xa8, 0x26, 0xfa, 0x39, 0x13, 0x7c, 0xb9, 0xb2, 0xa8, 0x51, 0xb5, 0x37, 0x61, 0x36, 0x4b,
+    0xaf, 0x6f, 0xd6, 0x32, 0xe1, 0x90, 0x14, 0x8c, 0x5e, 0x1a, 0x21, 0xc1, 0xd7, 0xca, 0xda, 0xf6,
+    0x32, 0xcb, 0xb6, 0xdb, 0x6d, 0xba, 0x1d, 0xa4, 0x4a, 0x2f, 0xb3, 0x32, 0xcf, 0xf3, 0x0c, 0xf0,
+    0x18, 0x85, 0x9c, 0xe1, 0x72, 0x08, 0x19, 0x60, 0xce, 0x5c, 0x78, 0x76, 0xd9, 0xfd, 0xac, 0x5e,
+    0x2a, 0x9c, 0xa3, 0x1c, 0x95, 0x43, 0xe4, 0x64, 0x0b, 0x2e, 0xc0, 0xbf, 0x54, 0x92, 0x61, 0x64,
+    0x80, 0xdb, 0x33, 0x54, 0x81, 0xae, 0xb5, 0x86, 0xdc, 0x5f, 0x29, 0xa1, 0xf4, 0x5e, 0x9a, 0xec,
+    0x6d, 0xbe, 0x0a, 0x20, 0xe3, 0x8c, 0x92, 0xb6, 0xc2, 0x5a, 0xad, 0x65, 0xdd, 0x11, 0x7f, 0x53,
+    0x5c, 0xee, 0xe5, 0xc0, 0x81, 0x72, 0x4d, 0x81, 0x1d, 0x05, 0xcf, 0x05, 0xe8, 0xd3, 0x5d, 0x58,
+    0x75, 0x85, 0x47, 0x78, 0x36, 0xcd, 0xc2, 0x76, 0xa8, 0x21, 0x43, 0x2f, 0x45, 0xd8, 0xdd, 0xb9,
+    0x15, 0xd8, 0x96, 0xf1, 0x15, 0xd6, 0x81, 0x43, 0x3b, 0x50, 0x1f, 0xb6, 0x3c, 0x01, 0x97, 0xbd,
+    0xe8, 0x61, 0x5a, 0x46, 0x7c, 0x78, 0x72, 0x1a, 0xa3, 0x74, 0x3c, 0x0c, 0x3a, 0xfe, 0xa9, 0xcf,
+    0xc7, 0x45, 0x3a, 0x18, 0xc7, 0x90, 0xc2, 0xa3, 0xf7, 0x34, 0x49, 0xcf, 0x2f, 0x82, 0x62, 0x78,
+    0xec, 0xd3, 0x8c, 0x5a, 0xd1, 0xd5, 0x20, 0xc2, 0xcb, 0x3e, 0x6c, 0x79, 0x02, 0x2e, 0xdf, 0x45,
+    0x1f, 0x98, 0xc4, 0x38, 0xba, 0x54, 0x42, 0x9c, 0xef, 0x73, 0x09, 0xe8, 0x13, 0x2a, 0xde, 0xee,
+    0x41, 0xcf, 0x35, 0xd4, 0x51, 0x1b, 0x36, 0x4a, 0xfd, 0x4f, 0xfb, 0x10, 0xf9, 0xb9, 0x50, 0xe1,
+    0x9a, 0x9b, 0x56, 0x90, 0xdd, 0x25, 0x72, 0xbe, 0x3e, 0xb9, 0xf6, 0x6c, 0x89, 0x5d, 0x21, 0xe0,
+    0xf6, 0xa5, 0x2c, 0x50, 0x51, 0xa6, 0xe7, 0x93, 0xdf, 0x27, 0x68, 0x02, 0x91, 0x15, 0xee, 0x57,
+    0xa4, 0x20, 0x1d, 0xa0, 0x73, 0xf8, 0xe5, 0xfe, 0xb7, 0x07, 0xfd, 0xe3, 0x92, 0xe4, 0x54, 0x0f,
+    0x49, 0xca, 0xc2, 0xf7, 0xee, 0x9e, 0x60, 0x28, 0x74, 0x47, 0x83, 0x61, 0xd4, 0x72, 0x48, 0x9b,
+    0x9b, 0x26, 0xe5, 0xec, 0x2f, 0x06, 0x21, 0xec, 0xa7, 0x09, 0xcc, 0x91, 0xb2, 0x0b, 0x5e, 0x28,
+    0xdd, 0x24, 0x4b, 0x88, 0xbb, 0xc5, 0x30, 0x13, 0x2c, 0x49, 0xb4, 0xc3, 0x43, 0xbe, 0x70, 0x17,
+    0xa7, 0x49, 0xcd, 0x55, 0x04, 0xba, 0x1a, 0xbb, 0x61, 0xd2, 0xdd, 0xf3, 0x22, 0xb7, 0xc7, 0x65,
+    0xbb, 0xb6, 0xc8, 0xee, 0x5a, 0x16, 0xb7, 0x70, 0x1c, 0xb9, 0xde, 0x74, 0xfe, 0x68, 0x89, 0x85,
+    0xcc, 0x6f, 0x88, 0x58, 0x83, 0xec, 0xfe, 0x0e, 0x54, 0xee, 0xef, 0x80, 0x87, 0xd7, 0xff, 0xa9,
+    0xa6, 0x6f, 0x6f, 0x9d, 0xed, 0xdb, 0xdb, 0x23, 0xe3, 0x3d, 0xd9, 0x02, 0x9d, 0xb5, 0x49, 0xb8,
+    0x5c, 0x28, 0x3f, 0x04, 0x5b, 0x22, 0x67, 0x57, 0xa1, 0x1b, 0x90, 0xb7, 0x77, 0x89, 0xbc, 0xd0,
+    0xf7, 0x64, 0x70, 0x93, 0xc4, 0x6e, 0x49, 0x8c, 0xf7, 0x37, 0xfb, 0x53, 0x41, 0x28, 0x72, 0x99,
+    0xa6, 0x29, 0x94, 0xc7, 0xe9, 0xc7, 0x25, 0x5a, 0xbb, 0xdf, 0x30, 0xad, 0x79, 0xdd, 0x67, 0x48,
+    0xc5, 0xad, 0x1f, 0x5b, 0x8a, 0x81, 0x77, 0x17, 0x57, 0x3c, 0x6f, 0xae, 0x85, 0xc3, 0x87, 0x41,
+    0x48, 0x94, 0x99, 0xc4, 0x09, 0xf1, 0x7b, 0x1d, 0x71, 0xe7, 0xa7, 0xfe, 0x17, 0x98, 0xfa, 0xef,
+    0xb6, 0xc3, 0xcf, 0xaf, 0xbf, 0x74, 0x8e, 0xaf, 0x79, 0xd3, 0x00, 0xc5, 0xd7, 0x2a, 0x31, 0x49,
+    0xe6, 0x82, 0xc1, 0x47, 0xa3, 0xd9, 0xdf, 0x6b, 0xae, 0x19, 0x1c, 0x8f, 0x37, 0x41, 0xf4, 0x5f,
+    0x7b, 0xa2, 0xd7, 0x1d, 0x7c, 0x93, 0x6f, 0xfc, 0x5d, 0x47, 0xd9, 0xdb, 0x3e, 0xe9, 0x2e, 0xdf,
+    0xcd, 0xe8, 0x67, 0xed, 0x5c, 0x49, 0x66, 0x0c, 0x7a, 0x64, 0xd6, 0x82, 0x3f, 0xf3, 0x36, 0xb5,
+    0x46, 0x40, 0xa1, 0x75, 0xe2, 0x6e, 0x1b, 0x04, 0x06, 0x86, 0x7e, 0x4d, 0x23, 0x04, 0x00, 0x5f,
+    0xe8, 0xc1, 0x46, 0x68, 0x9b, 0x13, 0x35, 0x1f, 0x3e, 0xf6, 0xc5, 0xae, 0xc9, 0x2e, 0x99, 0xbf,
+    0xa2, 0xe3, 0xce, 0xac, 0xc8, 0x0f, 0xbd, 0xb2, 0x67, 0xd1, 0x4d, 0x8d, 0x5c, 0xf6, 0x1a, 0xd8,
+    0xa7, 0x0b, 0xa4, 0x87, 0x18, 0xf0, 0x59, 0xe3, 0xe6, 0x19, 0x1c, 0x13, 0x0d, 0x81, 0xe9, 0x59,
+    0x8e, 0x5e, 0x13, 0x58, 0xf8, 0xc9, 0xd0, 0x93, 0x91, 0xef, 0xd3, 0x0b, 0x0d, 0xf7, 0x71, 0x82,
+    0xbe, 0x70, 0x3d, 0x14, 0x47, 0x1f, 0x66, 0x78, 0x6a, 0xa1, 0xd3, 0x12, 0x1f, 0x61, 0x39, 0xc2,
+    0x1f, 0xaf, 0xfe, 0xe1, 0x7b, 0x42, 0x7f, 0xa8, 0xb5, 0xee, 0x29, 0xbd, 0xe5, 0x70, 0x21, 0x6b,
+    0x39, 0x7d, 0x3e, 0x4d, 0x50, 0x3f, 0xe6, 0x90, 0x3a, 0x18, 0x40, 0xda, 0xa2, 0x27, 0xd8, 0x3a,
+    0x50, 0x36, 0x4c, 0x80, 0xfb, 0x63, 0x42, 0x1e, 0xe5, 0x5c, 0x1f, 0x93, 0x37, 0x4e, 0xe8, 0x0e,
+    0x8e, 0x80, 0xef, 0xe5, 0xd1, 0xeb, 0xf3, 0x46, 0xd6, 0x3f, 0xf4, 0x08, 0x98, 0x53, 0x7f, 0xcc,
+    0x5d, 0xc0, 0xde, 0x7a, 0xeb, 0x2e, 0xf1, 0x96, 0x1a, 0xea, 0x65, 0xd6, 0xf3, 0x86, 0xbb, 0xfb,
+    0x77, 0x4c, 0x2a, 0xd9, 0xc0, 0x75, 0xd5, 0x03, 0xf0, 0xec, 0x11, 0x5e, 0xd0, 0xc3, 0x61, 0xaa,
+    0x1d, 0x1f, 0x78, 0x6e, 0x46, 0x45, 0x1e, 0xfe, 0xba, 0xea, 0x07, 0x38, 0xee, 0xce, 0x73, 0x17,
+    0x4a, 0xc7, 0xb3, 0xa1, 0x9a, 0xb7, 0x16, 0x19, 0x4d, 0xe3, 0x25, 0xfd, 0x9b, 0xbb, 0xa3, 0xb3,
+    0x79, 0x4d, 0x4b, 0x46, 0xc7, 0x8b, 0xbc, 0x2e, 0xe9, 0x78, 0x42, 0x3c, 0x03, 0x8f, 0xf4, 0x67,
+    0x6c, 0xb8, 0xa5, 0x67, 0xfe, 0x6f, 0xc6, 0xbf, 0x57, 0x25, 0xe1, 0x53, 0x7d, 0x0c, 0x00, 0x00,
+};
+
+static const uint8_t ASSET_PREFERENCES_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x57, 0x4b, 0x73, 0xdb, 0x36,
+    0x10, 0xbe, 0xe7, 0x57, 0xa0, 0x38, 0x97, 0xa4, 0x48, 0x59, 0x7e, 0xd5, 0x54, 0xa7, 0xf1, 0x63,
+    0x72, 0x48, 0x6c, 0x4f, 0xec, 0x4b, 0x8f, 0x10, 0xb9, 0x12, 0x11, 0x93, 0x00, 0x0b, 0x40, 0x92,
+    0xd5, 0x5f, 0xdf, 0xc5, 0x43, 0xa2, 0x29, 0xd3, 0x8f, 0x99, 0x24, 0xed, 0x74, 0x74, 0x00, 0xb5,
+    0xef, 0x6f, 0x77, 0xb1, 0x00, 0xce, 0x7e, 0xb9, 0xb8, 0x39, 0xbf, 0xff, 0xf3, 0xf6, 0x92, 0x54,
+    0xa6, 0xa9, 0xa7, 0x1f, 0xce, 0xb6, 0x0b, 0xb0, 0x12, 0x17, 0xc3, 0x4d, 0x0d, 0xd3, 0x0b, 0xae,
+    0xdb, 0x9a, 0x6d, 0xc8, 0xad, 0x82, 0x39, 0x28, 0x10, 0x05, 0xe8, 0xb3, 0xc4, 0xb3, 0x3e, 0x9c,
+    0x35, 0x60, 0x18, 0x11, 0xac, 0x81, 0x9c, 0xae, 0x38, 0xac, 0x5b, 0xa9, 0x0c, 0x25, 0x85, 0x14,
+    0x06, 0x84, 0xc9, 0xe9, 0x9a, 0x97, 0xa6, 0xca, 0x4b, 0x58, 0xf1, 0x02, 0x22, 0xf7, 0xe7, 0x57,
+    0xc2, 0x05, 0x37, 0x9c, 0xd5, 0x91, 0x2e, 0x58, 0x0d, 0x79, 0x4a, 0xd1, 0x48, 0xcd, 0xc5, 0x03,
+    0x51, 0x50, 0xe7, 0x54, 0x9b, 0x4d, 0x0d, 0xba, 0x02, 0x40, 0x2b, 0x15, 0xfa, 0xcb, 0x69, 0xc2,
+    0xda, 0x36, 0x2e, 0xb4, 0xfe, 0x7d, 0x95, 0xcf, 0xe7, 0xc5, 0x21, 0x1c, 0xcf, 0x26, 0x07, 0xf3,
+    0xd1, 0x71, 0x7a, 0x34, 0x67, 0x56, 0x35, 0x09, 0xa1, 0xce, 0x64, 0xb9, 0xc1, 0xa5, 0xe4, 0x2b,
+    0x52, 0xd4, 0x4c, 0xeb, 0x9c, 0x16, 0x4c, 0x95, 0x56, 0xa2, 0x4a, 0xa7, 0x97, 0x77, 0xb7, 0xe3,
+    0x8c, 0x9c, 0x63, 0x54, 0x4a, 0xd6, 0xe4, 0x96, 0x09, 0xa8, 0x51, 0x31, 0xed, 0xcb, 0x9b, 0x0a,
+    0x1a, 0x88, 0x8c, 0x5c, 0x2c, 0x6a, 0xb0, 0x7a, 0xb3, 0xa5, 0x31, 0x52, 0x10, 0x5e, 0xf6, 0x59,
+    0xd1, 0xcc, 0x08, 0x4a, 0x98, 0xe2, 0x2c, 0xaa, 0xd9, 0xcc, 0xc6, 0x7c, 0xef, 0xe8, 0xa4, 0x64,
+    0xea, 0x21, 0xa9, 0xf9, 0xa2, 0x32, 0xa4, 0x91, 0xa5, 0x33, 0xa1, 0x57, 0x0b, 0xa7, 0xaf, 0x97,
+    0x22, 0xe2, 0x98, 0x14, 0x4a, 0x1e, 0x9b, 0x5a, 0xa0, 0xaf, 0xca, 0x98, 0xf6, 0x34, 0x49, 0xd6,
+    0xeb, 0x75, 0xbc, 0x1e, 0xc7, 0x52, 0x2d, 0x92, 0x6c, 0x34, 0x1a, 0x25, 0x28, 0x4f, 0x89, 0xcf,
+    0x19, 0xcd, 0x0e, 0x30, 0x03, 0x60, 0xcd, 0xf9, 0x6f, 0x9b, 0xdd, 0x8f, 0xf2, 0x31, 0xa7, 0x23,
+    0x32, 0x22, 0xd9, 0x01, 0xb1, 0xb4, 0x39, 0xaf, 0xd1, 0xbf, 0x90, 0x02, 0x28, 0xd1, 0x88, 0xed,
+    0x01, 0xab, 0x50, 0x2c, 0x15, 0xd6, 0xc8, 0x9c, 0xcb, 0x5a, 0xaa, 0x2d, 0x35, 0xda, 0xda, 0xdc,
+    0x11, 0x30, 0xe3, 0x50, 0xb0, 0x36, 0xa7, 0x4a, 0x2e, 0x45, 0xd9, 0x23, 0x7f, 0x93, 0x5c, 0x6c,
+    0xe9, 0x88, 0xa1, 0xe0, 0xaa, 0x40, 0x74, 0x05, 0x7a, 0x4e, 0x51, 0xbf, 0xd8, 0xf8, 0x55, 0xe5,
+    0x74, 0x42, 0xa7, 0x67, 0x89, 0x67, 0xfb, 0x1a, 0x02, 0x79, 0x4c, 0x3d, 0x77, 0x63, 0x57, 0x44,
+    0x9b, 0x85, 0xbf, 0xb8, 0x8e, 0xad, 0xb4, 0x15, 0x1a, 0x92, 0xcd, 0xf6, 0x84, 0xb3, 0x41, 0xe9,
+    0x83, 0x38, 0x0b, 0xf2, 0xfe, 0xcb, 0x6a, 0x4c, 0xe2, 0xc3, 0x03, 0xaf, 0xe3, 0xbe, 0x86, 0x7c,
+    0x1c, 0xc7, 0xe3, 0xc3, 0x10, 0x92, 0xff, 0x74, 0x9e, 0x4e, 0xe2, 0xa3, 0x63, 0xaf, 0xe8, 0x3f,
+    0x87, 0x34, 0x83, 0x56, 0x70, 0x35, 0x0e, 0xe2, 0xd9, 0x90, 0x6c, 0xb6, 0x27, 0x9c, 0xbd, 0x2a,
+    0xdd, 0x21, 0x09, 0x71, 0xf4, 0xa1, 0xf8, 0x38, 0x5f, 0xc7, 0xe2, 0xa5, 0xf7, 0xa0, 0x38, 0xbb,
+    0x9d, 0x9e, 0x6d, 0xa8, 0x27, 0x6d, 0xd8, 0x48, 0xf9, 0x3f, 0xed, 0x43, 0xe2, 0xe6, 0x42, 0x4e,
+    0x4b, 0x3f, 0x8a, 0x4e, 0x89, 0xf5, 0xf5, 0x9b, 0x6d, 0xcf, 0x96, 0x99, 0x8a, 0x20, 0xb6, 0x2f,
+    0x59, 0x4a, 0xd2, 0x2c, 0x3e, 0x3a, 0xf9, 0xe3, 0x84, 0x9c, 0x60, 0x64, 0xa9, 0xfd, 0xa5, 0x31,
+    0x52, 0xc7, 0xe4, 0x08, 0x7f, 0x23, 0xf7, 0xdb, 0x0a, 0xfd, 0x6d, 0x93, 0x64, 0x55, 0xbb, 0x24,
+    0x25, 0x7e, 0xbf, 0xdb, 0x2f, 0x1c, 0x0a, 0xfd, 0xd1, 0xa0, 0xa1, 0x30, 0x1c, 0xd3, 0x66, 0xa7,
+    0x49, 0x36, 0xfd, 0x0a, 0x76, 0x1a, 0x86, 0x69, 0x82, 0x73, 0x24, 0xeb, 0x0b, 0x2b, 0xcb, 0x8e,
+    0x0a, 0xcf, 0xa6, 0x38, 0x16, 0x0c, 0x8b, 0x1c, 0x0d, 0x53, 0xe6, 0x2c, 0x8c, 0x83, 0x85, 0x14,
+    0x75, 0xc7, 0x7d, 0xdd, 0xb9, 0x54, 0x4d, 0xb4, 0x40, 0xcc, 0x2d, 0xdd, 0x33, 0xca, 0x4a, 0x2e,
+    0x3b, 0x8e, 0x9b, 0x3c, 0x7d, 0x9e, 0x23, 0x59, 0x1e, 0x17, 0xed, 0xd2, 0x10, 0xb3, 0x69, 0x21,
+    0xb0, 0x68, 0x98, 0xcf, 0x2e, 0x88, 0xd1, 0x9d, 0x61, 0x06, 0xcb, 0xb4, 0x62, 0xf5, 0x12, 0x69,
+    0x37, 0xd7, 0xa8, 0x72, 0x73, 0x8d, 0xa0, 0x9d, 0xfe, 0x0f, 0x35, 0x7d, 0x75, 0x65, 0x6d, 0x5f,
+    0x5d, 0x3d, 0x31, 0x3e, 0x90, 0x5a, 0xd4, 0x59, 0xea, 0x88, 0x8b, 0xb9, 0x74, 0x13, 0xb3, 0x65,
+    0x62, 0x7a, 0xee, 0x5b, 0x87, 0x38, 0x7b, 0xa7, 0xc4, 0x11, 0x5d, 0x03, 0x7b, 0x37, 0x51, 0x68,
+    0xad, 0x48, 0x3b, 0x7f, 0xd3, 0xcf, 0x12, 0x43, 0x11, 0x8b, 0x38, 0x8e, 0xb1, 0x96, 0x56, 0x3f,
+    0x2c, 0xc1, 0xda, 0xcd, 0x0a, 0x94, 0xe2, 0xe5, 0x90, 0x21, 0x19, 0x58, 0x6f, 0x5b, 0x0a, 0x81,
+    0xf7, 0x97, 0xf7, 0x15, 0x3d, 0xed, 0x15, 0x3d, 0xfb, 0x2f, 0x8a, 0x9e, 0xfe, 0xbc, 0xa2, 0xa7,
+    0xff, 0x4e, 0xd1, 0xd3, 0x1f, 0x55, 0xf4, 0xf4, 0x7b, 0x8b, 0xfe, 0xf2, 0x74, 0xf0, 0x47, 0x3d,
+    0x08, 0x2d, 0x55, 0xb4, 0xa3, 0x55, 0xbc, 0x2c, 0x41, 0xf8, 0xc1, 0x71, 0xe7, 0x78, 0xfa, 0xf9,
+    0xc8, 0x18, 0xca, 0xc7, 0x3d, 0x34, 0x2d, 0x28, 0xa4, 0xab, 0x1e, 0x88, 0x60, 0xdf, 0x74, 0x5c,
+    0x3a, 0x1d, 0xcc, 0xc0, 0xa7, 0x65, 0xc3, 0x4b, 0x6e, 0x36, 0x03, 0xca, 0x55, 0x60, 0xbd, 0xa0,
+    0x89, 0xf7, 0x3c, 0xad, 0x87, 0xdd, 0xb6, 0x81, 0xf5, 0x82, 0xe6, 0x57, 0x68, 0xa4, 0x01, 0xf2,
+    0x7a, 0xe8, 0xca, 0x09, 0xbd, 0x8e, 0xa0, 0x9f, 0x6b, 0xbb, 0x41, 0x9c, 0x85, 0xb6, 0xbb, 0x81,
+    0x46, 0x96, 0x48, 0x5f, 0x1b, 0xd3, 0xd7, 0xee, 0x2a, 0xf6, 0x05, 0xaf, 0x62, 0xe4, 0x82, 0x37,
+    0x0d, 0x96, 0xf8, 0x79, 0xe2, 0x7f, 0xea, 0xd6, 0x13, 0x36, 0x80, 0xe0, 0x7a, 0xb7, 0x41, 0x40,
+    0xb0, 0x59, 0x0d, 0x78, 0xa2, 0x29, 0xf8, 0x6b, 0xc9, 0x15, 0xe0, 0xdd, 0xf5, 0xd2, 0x93, 0xbe,
+    0x77, 0x3b, 0x0e, 0xba, 0xc3, 0x03, 0xf3, 0x99, 0xbf, 0x8b, 0x40, 0x7b, 0xbe, 0x45, 0xdf, 0x6c,
+    0x71, 0x9f, 0xd9, 0x8f, 0xca, 0xba, 0x12, 0xd8, 0x0a, 0xe4, 0x0e, 0x8c, 0x41, 0x7f, 0x43, 0x3d,
+    0x5d, 0xe3, 0x1e, 0x53, 0x6e, 0x24, 0x32, 0x3c, 0xcd, 0xd5, 0x2e, 0x8d, 0x18, 0x00, 0xce, 0xc1,
+    0xce, 0x86, 0xef, 0x9d, 0x3d, 0x35, 0x17, 0xbe, 0xdf, 0x51, 0x25, 0x0e, 0xd6, 0xd9, 0x4e, 0x3a,
+    0x70, 0xa6, 0xe9, 0xa8, 0x6b, 0x96, 0x2d, 0x8a, 0x7e, 0x6a, 0xc4, 0x62, 0xd0, 0xc0, 0x36, 0x5d,
+    0x48, 0xed, 0x62, 0xa0, 0x1f, 0x1a, 0x7b, 0xd9, 0xc0, 0x3b, 0x5c, 0xc3, 0xf0, 0x6a, 0x93, 0x4d,
+    0x76, 0x09, 0x4c, 0xdd, 0x99, 0x3d, 0x90, 0x91, 0x97, 0xe1, 0xf9, 0xc6, 0x7b, 0x3f, 0x40, 0x57,
+    0xb8, 0x01, 0x88, 0x93, 0x77, 0x23, 0xdc, 0xb7, 0xd0, 0x6b, 0x89, 0xf7, 0xa0, 0x9c, 0xd0, 0xf7,
+    0x57, 0xff, 0xc9, 0xbe, 0xfa, 0x24, 0x97, 0x43, 0xe3, 0xcc, 0x70, 0x7c, 0x2d, 0xb5, 0xbc, 0x78,
+    0xd8, 0x4f, 0xd0, 0xb0, 0x4c, 0x97, 0x3a, 0x9c, 0xfd, 0xca, 0x90, 0x7b, 0x64, 0x75, 0x90, 0x35,
+    0xd4, 0xe8, 0xfe, 0x29, 0x20, 0x27, 0x65, 0x5d, 0x3f, 0x05, 0xaf, 0x2d, 0xd1, 0xa1, 0xf0, 0x0a,
+    0x83, 0x40, 0x06, 0x9d, 0x5e, 0x8a, 0xf2, 0x4d, 0x97, 0x28, 0xb3, 0xef, 0x10, 0xfc, 0xf3, 0xe8,
+    0x99, 0xbb, 0xfe, 0x12, 0x1e, 0x91, 0xbe, 0x62, 0x7a, 0x39, 0x6b, 0xb8, 0x7d, 0x1e, 0x87, 0xb4,
+    0xb2, 0x15, 0xbe, 0x26, 0x9d, 0x00, 0x9d, 0xde, 0xe1, 0x9f, 0xfe, 0x0b, 0xbb, 0xbb, 0x8f, 0xda,
+    0x29, 0x15, 0x80, 0xb8, 0x39, 0xea, 0x4e, 0x0b, 0xda, 0x3f, 0x3c, 0xec, 0x0c, 0xf5, 0x2e, 0x75,
+    0xa1, 0x78, 0x6b, 0x88, 0x56, 0x45, 0x78, 0x3c, 0x7f, 0xb3, 0x6f, 0x67, 0x98, 0x95, 0x45, 0x06,
+    0xc5, 0xe1, 0x7c, 0x54, 0x66, 0xc5, 0xe1, 0x09, 0x73, 0x33, 0xd7, 0x49, 0xba, 0xbb, 0xaf, 0x7f,
+    0x3d, 0x27, 0xee, 0xf9, 0xff, 0x0f, 0xac, 0xf7, 0x64, 0xa3, 0x15, 0x10, 0x00, 0x00,
+};
+
+static const uint8_t ASSET_LOCK[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x5d, 0x50, 0xcb, 0x6e, 0x84, 0x30,
+    0x0c, 0xfc, 0x15, 0xdf, 0x72, 0x72, 0xc8, 0x83, 0x9a, 0xa5, 0x22, 0x1c, 0xda, 0xcb, 0x5e, 0xf6,
+    0x54, 0x89, 0x7b, 0xc5, 0x52, 0x82, 0x04, 0xcb, 0x0a, 0x52, 0xb2, 0xe2, 0xeb, 0xeb, 0x50, 0x75,
+    0x0f, 0xd5, 0x44, 0x96, 0x3d, 0x9a, 0x19, 0x5b, 0xa9, 0xd6, 0xad, 0x87, 0xc7, 0x34, 0xde, 0x56,
+    0x27, 0x7c, 0x08, 0xf7, 0xd7, 0x2c, 0x8b, 0x31, 0xca, 0x68, 0xe5, 0xbc, 0xf4, 0x99, 0x51, 0x4a,
+    0x65, 0xac, 0x10, 0x10, 0x87, 0x6b, 0xf0, 0x4e, 0x68, 0x12, 0xe0, 0xbb, 0xa1, 0xf7, 0xe1, 0xb7,
+    0xdf, 0x86, 0x2e, 0xbe, 0xcd, 0x0f, 0x27, 0x14, 0x28, 0x30, 0x39, 0x3f, 0x51, 0x57, 0xf7, 0xcf,
+    0xe0, 0xe1, 0x6b, 0x18, 0x47, 0x27, 0xda, 0xef, 0x65, 0xe9, 0x6e, 0xe1, 0x7d, 0x1e, 0xe7, 0x45,
+    0xc0, 0xd5, 0x89, 0x8b, 0x3e, 0xc1, 0xc9, 0xa3, 0x6e, 0xa8, 0x55, 0x68, 0x64, 0x41, 0x5c, 0x4c,
+    0x8e, 0x2f, 0x09, 0x1f, 0x05, 0x58, 0x1e, 0xa0, 0x00, 0xda, 0xcc, 0x99, 0x5a, 0xd4, 0x52, 0x03,
+    0xab, 0x40, 0x96, 0x5c, 0xcc, 0xa6, 0x55, 0xab, 0x80, 0x39, 0x59, 0x82, 0x49, 0xf0, 0xda, 0xb4,
+    0x87, 0x04, 0x0c, 0x26, 0x0e, 0x4d, 0x93, 0x24, 0xc9, 0x86, 0xc9, 0x92, 0xb0, 0x5f, 0x4a, 0xa0,
+    0x83, 0x23, 0x62, 0xaf, 0xcd, 0xd1, 0x82, 0x45, 0xbb, 0xda, 0x63, 0x00, 0x1e, 0x78, 0x55, 0xd9,
+    0xd0, 0x3e, 0x95, 0xa0, 0xf3, 0x33, 0x71, 0x02, 0xc7, 0xf2, 0xaa, 0x7d, 0x42, 0x42, 0xfb, 0x2f,
+    0x7f, 0x7d, 0xe6, 0x3e, 0xaf, 0x82, 0xbf, 0x6b, 0x76, 0x91, 0xd5, 0x55, 0xfa, 0xac, 0xfa, 0x07,
+    0x37, 0x80, 0x47, 0x74, 0x54, 0x01, 0x00, 0x00,
+};
+
+static const uint8_t ASSET_SIGNAL_1[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x25, 0x4f, 0x41, 0x8e, 0x83, 0x30,
+    0x0c, 0xfc, 0x8a, 0x6f, 0x3e, 0xe1, 0xc4, 0x31, 0x09, 0x62, 0x45, 0x38, 0x6c, 0xcf, 0x7d, 0x44,
+    0x45, 0x29, 0x41, 0xca, 0x96, 0x0a, 0xd2, 0xa6, 0xda, 0xd7, 0x37, 0x50, 0xc9, 0x92, 0x67, 0xec,
+    0x19, 0x8f, 0xdc, 0x6d, 0xaf, 0x09, 0xde, 0x7f, 0xf1, 0xbe, 0x79, 0x0c, 0x29, 0x3d, 0x7e, 0x94,
+    0xca, 0x39, 0x53, 0x16, 0x5a, 0xd6, 0x49, 0x19, 0xad, 0xb5, 0x2a, 0x0a, 0x84, 0x3c, 0x5f, 0x53,
+    0xf0, 0xc8, 0x0e, 0x21, 0x8c, 0xf3, 0x14, 0xd2, 0x17, 0xbf, 0xe6, 0x31, 0xff, 0x2e, 0x6f, 0x8f,
+    0x1a, 0x34, 0x98, 0xba, 0x14, 0xf6, 0xdd, 0xe3, 0x92, 0x02, 0xdc, 0xe6, 0x18, 0x3d, 0x0e, 0xcf,
+    0x75, 0x1d, 0xef, 0xe9, 0xb4, 0xc4, 0x65, 0x45, 0xb8, 0x7a, 0x3c, 0xb3, 0x01, 0xb6, 0x43, 0xc5,
+    0xe4, 0x04, 0x74, 0x25, 0xc4, 0x86, 0x6c, 0x5b, 0xd5, 0x64, 0x1a, 0x60, 0xb2, 0x4d, 0x2c, 0x9b,
+    0x46, 0x2a, 0x43, 0xc2, 0x43, 0xd1, 0xd8, 0x42, 0x8d, 0x80, 0x90, 0x6b, 0x0b, 0x6a, 0x1d, 0xb8,
+    0xa3, 0x6d, 0x35, 0x89, 0x2d, 0x3a, 0x70, 0xb0, 0xd3, 0xaf, 0x09, 0x76, 0xd3, 0x89, 0x2d, 0x1d,
+    0x11, 0xe5, 0x2a, 0xb0, 0xec, 0x29, 0x6c, 0xe1, 0x98, 0xfc, 0xa3, 0xea, 0xbb, 0xfd, 0x9b, 0xfe,
+    0x03, 0xbf, 0xaf, 0xad, 0xc3, 0xf5, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t ASSET_SIGNAL_2[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x25, 0x8f, 0x4b, 0x0e, 0x83, 0x30,
+    0x0c, 0x44, 0xaf, 0xe2, 0x9d, 0x57, 0x38, 0x1f, 0xc2, 0x27, 0x15, 0x61, 0x51, 0xd6, 0x3d, 0x44,
+    0x05, 0x94, 0x20, 0xa5, 0xa5, 0x82, 0x94, 0xa0, 0x9e, 0xbe, 0x09, 0x95, 0xac, 0xd1, 0xc8, 0x7e,
+    0x1e, 0xcb, 0xcd, 0xb6, 0x4f, 0x70, 0x3c, 0xdd, 0x6b, 0x33, 0x68, 0xbd, 0x7f, 0x5f, 0x18, 0x0b,
+    0x21, 0x50, 0xc8, 0x69, 0x59, 0x27, 0x26, 0x39, 0xe7, 0x2c, 0x12, 0x08, 0x61, 0x1e, 0xbc, 0x35,
+    0x28, 0x4a, 0x04, 0x3b, 0xce, 0x93, 0xf5, 0x7f, 0xbf, 0xcf, 0x63, 0xb8, 0x2e, 0x87, 0x41, 0x0e,
+    0x1c, 0xa4, 0x8a, 0x85, 0x6d, 0xf3, 0xbe, 0x7b, 0x0b, 0x8f, 0xd9, 0x39, 0x83, 0xfd, 0x67, 0x5d,
+    0xc7, 0x97, 0xef, 0x16, 0xb7, 0xac, 0x08, 0x83, 0xc1, 0x9b, 0x90, 0x20, 0x64, 0x9f, 0x49, 0xe2,
+    0x39, 0xf0, 0x2c, 0x27, 0x4d, 0x65, 0x95, 0x15, 0xa4, 0x40, 0x50, 0xed, 0xb2, 0x28, 0x71, 0xa4,
+    0xba, 0x8a, 0x84, 0x06, 0x4d, 0x75, 0x92, 0x0a, 0x74, 0x5c, 0x01, 0xbd, 0x29, 0xaa, 0x45, 0x6a,
+    0x95, 0x54, 0x42, 0x84, 0x4e, 0x3a, 0x99, 0x4e, 0x14, 0x94, 0x90, 0x98, 0x04, 0x42, 0xa5, 0xe0,
+    0xf3, 0x48, 0xac, 0x2f, 0xb2, 0xb6, 0x49, 0x0f, 0xb4, 0x3f, 0xfe, 0x05, 0x45, 0xa4, 0xe8, 0x00,
+    0x00, 0x00,
+};
+
+static const uint8_t ASSET_SIGNAL_3[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x50, 0x49, 0x6e, 0xc3, 0x30,
+    0x0c, 0xfc, 0x0a, 0x6f, 0x3a, 0x89, 0xd6, 0x2e, 0xb1, 0x88, 0x73, 0xa8, 0xaf, 0xe9, 0x23, 0x0a,
+    0xc7, 0xb5, 0x0d, 0x38, 0x71, 0x60, 0xab, 0x51, 0xd0, 0xd7, 0x97, 0x72, 0x1f, 0x50, 0x80, 0x00,
+    0x85, 0x19, 0xce, 0x70, 0xa8, 0xd3, 0xfe, 0x1c, 0xe1, 0x75, 0x5b, 0xee, 0x7b, 0x2b, 0xa6, 0x9c,
+    0x1f, 0x6f, 0x4d, 0x53, 0x4a, 0xc1, 0x62, 0x71, 0xdd, 0xc6, 0xc6, 0x28, 0xa5, 0x1a, 0x9e, 0x10,
+    0x50, 0xe6, 0x6b, 0x9e, 0x5a, 0xa1, 0x83, 0x80, 0x69, 0x98, 0xc7, 0x29, 0xff, 0xbd, 0x9f, 0xf3,
+    0x50, 0xde, 0xd7, 0x57, 0x2b, 0x14, 0x28, 0x30, 0x8e, 0x4b, 0x9c, 0x4f, 0x8f, 0xcf, 0x3c, 0xc1,
+    0xd7, 0xbc, 0x2c, 0xad, 0xe8, 0xbf, 0xb7, 0x6d, 0xb8, 0xe7, 0x6e, 0x5d, 0xd6, 0x4d, 0xc0, 0xb5,
+    0x15, 0x1f, 0xda, 0x40, 0xe8, 0x12, 0x06, 0x6e, 0xe0, 0xd1, 0x43, 0x44, 0x46, 0x2c, 0xd0, 0x45,
+    0x23, 0x43, 0x18, 0x3a, 0x87, 0x46, 0x83, 0x43, 0xeb, 0x98, 0x22, 0xcf, 0x54, 0xe5, 0xf7, 0x88,
+    0x91, 0x40, 0x57, 0x54, 0x2b, 0x4c, 0x60, 0x31, 0x5c, 0x78, 0x8c, 0x7a, 0x69, 0xd0, 0x4b, 0x8d,
+    0x29, 0x49, 0xcf, 0x9e, 0xd2, 0x4a, 0x92, 0xf6, 0x47, 0x34, 0xff, 0x87, 0x38, 0xa4, 0x11, 0x14,
+    0xeb, 0x34, 0x61, 0x22, 0x19, 0x79, 0xbf, 0x41, 0xb7, 0xb0, 0x59, 0xed, 0x9c, 0x51, 0xf3, 0x6a,
+    0x0c, 0x11, 0x08, 0x29, 0xd6, 0x14, 0x47, 0xf5, 0x06, 0x95, 0xe5, 0x63, 0x2d, 0x52, 0xe5, 0x3c,
+    0x72, 0x22, 0x4c, 0x55, 0x25, 0xab, 0x4a, 0xf3, 0x3d, 0x04, 0xd5, 0x10, 0xb4, 0x63, 0x7f, 0xaa,
+    0x2a, 0x3a, 0x12, 0xd5, 0x8f, 0x3c, 0xff, 0x02, 0xad, 0x9a, 0x56, 0xcd, 0x70, 0x01, 0x00, 0x00,
+};
+
+static const uint8_t ASSET_SIGNAL_4[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x25, 0x90, 0xc1, 0x6e, 0xc3, 0x20,
+    0x0c, 0x86, 0x5f, 0xc5, 0x37, 0x4e, 0x18, 0x0c, 0x04, 0xd2, 0x29, 0xc9, 0x61, 0x39, 0xef, 0x21,
+    0xa6, 0x34, 0x4b, 0x22, 0xa5, 0x4d, 0x95, 0xb2, 0x52, 0xed, 0xe9, 0x67, 0x40, 0xb2, 0x00, 0x7d,
+    0xfa, 0xfc, 0xdb, 0xa2, 0x7b, 0xbe, 0x16, 0x78, 0xdf, 0xf6, 0xfb, 0xb3, 0x17, 0x6b, 0x8c, 0x8f,
+    0x0f, 0xa5, 0x52, 0x4a, 0x98, 0x2c, 0x1e, 0xe7, 0xa2, 0x8c, 0xd6, 0x5a, 0xb1, 0x21, 0x20, 0x6d,
+    0xd7, 0xb8, 0xf6, 0x82, 0xbc, 0x80, 0x75, 0xde, 0x96, 0x35, 0xd6, 0xf7, 0x6b, 0x9b, 0xd3, 0xe7,
+    0xf1, 0xee, 0x85, 0x06, 0x0d, 0xc6, 0x71, 0x89, 0xa1, 0x7b, 0x7c, 0xc7, 0x15, 0x7e, 0xb6, 0x7d,
+    0xef, 0xc5, 0xf4, 0x7b, 0x9e, 0xf3, 0x3d, 0x8e, 0xc7, 0x7e, 0x9c, 0x02, 0xae, 0xbd, 0xf8, 0x22,
+    0x03, 0x76, 0x0c, 0xe8, 0x3c, 0x58, 0xb0, 0x68, 0x1d, 0x38, 0x0c, 0x2d, 0x9a, 0x0b, 0x04, 0xf4,
+    0x61, 0x92, 0x48, 0x2d, 0x97, 0x64, 0x80, 0xce, 0x96, 0x2b, 0x10, 0x47, 0xa3, 0x61, 0x4c, 0xd8,
+    0xd8, 0x4a, 0x76, 0x22, 0x20, 0x9a, 0xaa, 0xcc, 0x62, 0xa5, 0xf9, 0x34, 0x6d, 0xb6, 0x1b, 0x6e,
+    0x65, 0x3d, 0x50, 0x4e, 0x60, 0x59, 0x56, 0xb9, 0xa4, 0x9b, 0x8b, 0xac, 0x1d, 0xb2, 0x44, 0xb3,
+    0x91, 0x39, 0x9b, 0x4d, 0x99, 0x97, 0xe9, 0x68, 0x34, 0x7a, 0x5f, 0x36, 0x03, 0xf2, 0xd8, 0x38,
+    0xde, 0x35, 0xef, 0xfd, 0x27, 0xd4, 0xd0, 0xe5, 0xff, 0x18, 0xfe, 0x01, 0x10, 0xa4, 0x6e, 0x82,
+    0x37, 0x01, 0x00, 0x00,
+};
+
+static const WebAsset WEB_ASSETS[] = {
+    {"app.css", "text/css", ASSET_APP_CSS, 1402, "\"ffc6e8b54f0817fa\""},
+    {"app.js", "application/javascript", ASSET_APP_JS, 3106, "\"ebdc2ec6f0d2c69a\""},
+    {"setup.html", "text/html", ASSET_SETUP_HTML, 1056, "\"75150ea0e26d7105\""},
+    {"preferences.html", "text/html", ASSET_PREFERENCES_HTML, 1182, "\"762ec59fdbbe988e\""},
+    {"lock", "image/svg+xml", ASSET_LOCK, 248, "\"bcefec7db1598e8b\""},
+    {"signal-1", "image/svg+xml", ASSET_SIGNAL_1, 201, "\"de51133ae2ffc7d6\""},
+    {"signal-2", "image/svg+xml", ASSET_SIGNAL_2, 194, "\"b7bcf0c32966a73b\""},
+    {"signal-3", "image/svg+xml", ASSET_SIGNAL_3, 256, "\"59e161b94df25111\""},
+    {"signal-4", "image/svg+xml", ASSET_SIGNAL_4, 228, "\"9d722c52ca1b3277\""},
+};
@@ -2,14 +2,7 @@
 #pragma once
 
 #include <Arduino.h>
-#include <WebServer.h>
-#include <ArduinoJson.h>
-#include "WebContent.h"
-#include "RelayControlHandler.h"
-#include "WebServerManager.h"
-
-// Declare external WebServer instance
-extern WebServer server;
+#include "HttpServer.h"
 
 // Handler function declarations
 void handleRoot();
@@ -20,14 +13,22 @@ void handleSetPreferences();
 void handleOptionsPreferences();
 void handleCaptivePortal();
 void handleIcon();
+void handleStaticAsset();
+void handleEvents();
+void handleRelaySocket();
+void handleGetSchedule();
+void handleSetSchedule();
+void handleMetrics();
 void handleGetRelayState();
 void handleSetRelayState();
 void handleRelayControl();
-void addCorsHeaders(WebServer* server);
+void handleUnauthorized();
+void handleGetSession();
+void handleLogin();
+void handleLogout();
+void handleSetCredentials();
+void addCorsHeaders(HttpServer* server);
 
-// Helper functions
-String getNetworksJson();
-void setupWebHandlers();
 
 
 
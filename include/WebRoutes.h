@@ -0,0 +1,20 @@
+// WebRoutes.h
+#pragma once
+
+#include <Arduino.h>
+#include "HttpServer.h"
+
+// Server modes a route is served in; WebServerManager passes the mask of
+// the current mode, so switching modes changes no table
+enum WebRouteMode : uint8_t {
+    ROUTE_PORTAL = 1 << 0,
+    ROUTE_PREFERENCES = 1 << 1,
+    ROUTE_ALL = ROUTE_PORTAL | ROUTE_PREFERENCES
+};
+
+// Looks `method` and `path` up in the static route table, which is perfect-
+// hashed at compile time. Returns nullptr when no route matches or the route
+// is not served in any of `modes`. `needsSession`, when given, is set for
+// routes that require a login once credentials are set.
+HttpServer::RequestHandler findWebRoute(HTTPMethod method, const char* path, uint8_t modes,
+                                        bool* needsSession = nullptr);
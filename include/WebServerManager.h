@@ -1,7 +1,8 @@
 #pragma once
 
-#include <DNSServer.h>
-#include <WebServer.h> 
+#include "CaptiveDns.h"
+#include "HttpServer.h"
+#include <atomic>
 #include <memory>
 #include <Preferences.h>
 #include <functional>
@@ -30,13 +31,15 @@ public:
     
     ~WebServerManager();
     bool begin();
+    // Periodic work for the web side (DNS, event stream); runs on the server
+    // task after every select() round
     void handleClient();
     void stop();
     
     bool startPortalMode();
     bool startPreferencesMode();
     
-    WebServer* getServer() { return _server.get(); }
+    HttpServer* getServer() { return _server.get(); }
     ServerMode getCurrentMode() const { return _currentMode; }
     bool isPortalActive() const { return _currentMode == ServerMode::PORTAL; }
     ConnectionStatus getConnectionStatus() const { return _connectionStatus; }
@@ -57,19 +60,20 @@ private:
     class WiFiEventHandler;
     
     WebServerManager();
-    void setupPortalHandlers();
-    void setupPreferencesHandlers();
-    void clearHandlers();
     void startDNSServer();
     void stopDNSServer();
+    void updateDNSServer();
     void updateConnectionStatus(ConnectionStatus status);
     bool validateConnection();
     void setupWiFiEventHandlers();
-    void setupHandlers();
-    void addCorsHeaders();  // Only declared once here
+    static HttpServer::RequestHandler resolveRoute(HTTPMethod method, const char* uri);
 
-    std::unique_ptr<WebServer> _server;
-    std::unique_ptr<DNSServer> _dnsServer;
+    std::unique_ptr<HttpServer> _server;
+    // The DNS responder runs on the server task; other tasks only set the
+    // address it should answer with, 0 while it should be down
+    CaptiveDns _dns;
+    std::atomic<uint32_t> _dnsAddress;
+    unsigned long _dnsRetryAt;
     Preferences _preferences;
     ServerMode _currentMode;
     ConnectionStatus _connectionStatus;
@@ -80,4 +84,5 @@ private:
 
     static constexpr unsigned long RECONNECT_INTERVAL = 30000;
     static constexpr unsigned long CONNECTION_TIMEOUT = 10000;
+    static constexpr unsigned long DNS_RETRY_INTERVAL = 1000;
 };
\ No newline at end of file
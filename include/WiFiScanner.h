@@ -0,0 +1,51 @@
+// WiFiScanner.h
+#pragma once
+
+#include <Arduino.h>
+#include "JsonStreamWriter.h"
+
+// Background WiFi scan behind /scan. A request starts an asynchronous scan
+// when the cached results are stale and is answered at once from the cache;
+// the JSON carries a "scanning" flag so the page knows to ask again. All
+// calls come from the HTTP server task, so nothing here is locked.
+class WiFiScanner {
+public:
+    static constexpr size_t MAX_NETWORKS = 20;
+    static constexpr size_t SSID_LENGTH = 33;       // 32 bytes plus terminator
+    static constexpr unsigned long CACHE_TTL = 30000;
+    static constexpr unsigned long SCAN_TIMEOUT = 15000;
+
+    static WiFiScanner& getInstance();
+
+    // Starts a scan unless one is running or the cache is still fresh
+    void requestScan();
+
+    // Collects the results of a finished scan; called from the server loop
+    void poll();
+
+    bool isScanning() const { return scanning; }
+
+    // Writes {"scanning":..,"age":..,"networks":[..]}
+    void toJson(JsonStreamWriter& json) const;
+
+    WiFiScanner(const WiFiScanner&) = delete;
+    WiFiScanner& operator=(const WiFiScanner&) = delete;
+
+private:
+    struct Network {
+        char ssid[SSID_LENGTH];
+        int8_t rssi;
+        bool encrypted;
+    };
+
+    WiFiScanner();
+
+    void insert(const char* ssid, int8_t rssi, bool encrypted);
+
+    Network networks[MAX_NETWORKS];
+    size_t networkCount;
+    bool hasResults;
+    bool scanning;
+    unsigned long lastScan;
+    unsigned long scanStarted;
+};
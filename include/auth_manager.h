@@ -2,44 +2,73 @@
 #define AUTH_MANAGER_H
 
 #include <Arduino.h>
-#include <base64.h>
+#include "CustomHash.h"
 
+// Web UI login. The username and password hash are read from NVS once and
+// kept in RAM; a login costs one SHA-256, and every later request only looks
+// its session cookie up in a small fixed table. Tokens and digests are
+// compared in constant time.
+//
+// Until credentials are set the UI stays open, as it always was. Everything
+// here runs on the HTTP server task, so nothing is locked.
 class AuthenticationManager {
 public:
-    // Constructor
-    AuthenticationManager();
+    static constexpr size_t MAX_SESSIONS = 8;
+    static constexpr size_t TOKEN_SIZE = 16;                            // Random bytes per session
+    static constexpr size_t TOKEN_TEXT_SIZE = TOKEN_SIZE * 2 + 1;       // Hex plus terminator
+    static constexpr unsigned long SESSION_IDLE_TIMEOUT = 3600000;      // 1 hour
+    static const char COOKIE_NAME[];
 
-    // Token generation methods
-    String generateToken();
-    String generateSecureToken(bool useEncryption = false);
+    static AuthenticationManager& getInstance();
 
-    // Token validation methods
-    bool validateToken(const String& providedToken);
-    void invalidateToken();
+    // Loads the stored credentials; call before the web server starts
+    void begin();
+    bool isEnabled() const { return enabled; }
 
     // Credential management methods
-    static bool validateCredentials(const String& username, const String& password);
-    static bool setCredentials(const String& username, const String& password);
-    static String getStoredUsername();
+    bool validateCredentials(const String& username, const String& password) const;
+    // Replaces the credentials and ends every session
+    bool setCredentials(const String& username, const String& password);
+    const String& getStoredUsername() const { return storedUsername; }
+
+    // Starts a session and writes its token to `token`; when the table is
+    // full the least recently used session is ended
+    void createSession(char (&token)[TOKEN_TEXT_SIZE]);
+    // Checks the session cookie in a Cookie header and refreshes its idle timer
+    bool validateCookie(const String& cookieHeader);
+    void invalidateCookie(const String& cookieHeader);
+    void invalidateAll();
+
+    AuthenticationManager(const AuthenticationManager&) = delete;
+    AuthenticationManager& operator=(const AuthenticationManager&) = delete;
 
 private:
-    // Token configuration constants
-    static const unsigned long TOKEN_EXPIRY = 3600000;  // 1 hour in milliseconds
-    
-    // Internal token tracking
-    String currentToken;
-    unsigned long tokenCreationTime;
-    
-    // Internal encryption methods
-    String encryptToken(const String& token);
-    String decryptToken(const String& encryptedToken);
+    struct Session {
+        bool used;
+        uint8_t token[TOKEN_SIZE];
+        unsigned long lastUsed;
+    };
+
+    AuthenticationManager();
+
+    // Index of the live session holding the cookie's token, or -1
+    int findSession(const String& cookieHeader);
+    static bool parseToken(const String& cookieHeader, uint8_t (&token)[TOKEN_SIZE]);
+    static bool parseHex(const char* text, uint8_t* out, size_t size);
+    static bool constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t length);
+
+    bool enabled;
+    String storedUsername;
+    uint8_t usernameHash[CustomHash::SHA256_SIZE];
+    uint8_t passwordHash[CustomHash::SHA256_SIZE];
+    Session sessions[MAX_SESSIONS];
 
     // Constants for validation
     static const uint8_t MIN_USERNAME_LENGTH = 3;
     static const uint8_t MIN_PASSWORD_LENGTH = 8;
-    
+
     // Namespace for preferences storage
     static const char* PREF_NAMESPACE;
 };
 
-#endif // AUTH_MANAGER_H
\ No newline at end of file
+#endif // AUTH_MANAGER_H
@@ -18,6 +18,7 @@
 #define DISPLAY_HUM_DURATION 2000     // 2 seconds
 #define DISPLAY_PRES_DURATION 2000    // 2 seconds
 #define DISPLAY_REMOTE_DURATION 3000  // 2 seconds
+#define DISPLAY_REMOTE_LABEL_DURATION 600  // Sensor number shown before each remote reading
 
 // I2C Configuration (BME280)
 #define I2C_SDA 21
@@ -36,7 +37,16 @@
 #define MQTT_CLIENT_ID "ESP32-Display"
 #define MQTT_TOPIC_AUX_DISPLAY "chaoticvolt/mqtt_aux_display1/sensors"
 #define MQTT_TOPIC_RELAY "chaoticvolt/mqtt_aux_display1/relay"
+#define MQTT_TOPIC_RELAY_COMMAND "relay/command"
+#define MQTT_TOPIC_HUB_SENSORS "chaoticvolt/sensorhub/sensors"
+#define MQTT_TOPIC_CONFIG "chaoticvolt/mqtt_aux_display1/config"
 #define MQTT_TOPIC_STATUS "status"
+#define MQTT_TOPIC_STATE MQTT_TOPIC_AUX_DISPLAY "/state"
+#define MQTT_TOPIC_REMOTE_SENSORS MQTT_TOPIC_AUX_DISPLAY "/remote"
+#define MQTT_TOPIC_AVAILABILITY MQTT_TOPIC_AUX_DISPLAY "/status"
+#define MQTT_TOPIC_METRICS MQTT_TOPIC_AUX_DISPLAY "/metrics"
+#define MQTT_TOPIC_LOOPBACK MQTT_TOPIC_AUX_DISPLAY "/diag/loopback"
+#define MQTT_DISCOVERY_PREFIX "homeassistant"
 #define MQTT_QOS 1
 
 // API configuration
@@ -3,37 +3,48 @@
 
 #include <Arduino.h>
 
+// Failed-login throttle keyed on the client's IPv4 address. Clients are
+// tracked in a small fixed table; when it is full the least recently seen
+// client that isn't blocked gives up its record, so a flood of new addresses
+// can't lift a block.
 class RateLimiter {
 private:
     // Configurable rate limit parameters
     static const int MAX_ATTEMPTS;
     static const unsigned long BLOCK_DURATION;
+    static const size_t MAX_CLIENTS = 8;
     
     // Structure to track login attempts
     struct AttemptRecord {
+        bool used;
+        uint32_t address;
         int attempts;
         unsigned long lastAttemptTime;
         unsigned long blockUntil;
     };
 
-    // Current attempt record
-    AttemptRecord loginAttempts;
+    // One record per recently seen client
+    AttemptRecord records[MAX_CLIENTS];
+
+    AttemptRecord* find(uint32_t address);
+    AttemptRecord& findOrAdd(uint32_t address, unsigned long now);
+    static bool isBlocked(const AttemptRecord& record, unsigned long now);
 
 public:
     // Constructor to initialize default state
     RateLimiter();
 
     // Check if login attempt is allowed
-    bool canAttemptLogin();
+    bool canAttemptLogin(uint32_t address);
 
-    // Record a login attempt
-    void recordAttempt();
+    // Record a failed login attempt
+    void recordAttempt(uint32_t address);
 
     // Reset attempt tracking (successful login)
-    void resetAttempts();
+    void resetAttempts(uint32_t address);
 
     // Get remaining time until next login attempt is possible
-    unsigned long getRemainingBlockTime();
+    unsigned long getRemainingBlockTime(uint32_t address);
 };
 
-#endif // RATE_LIMITER_H
\ No newline at end of file
+#endif // RATE_LIMITER_H
@@ -1,8 +1,13 @@
 #include "BabelSensor.h"
 #include "config.h"
+#include "SensorHubClient.h"
+#include "SensorHubAuth.h"
+#include "RemoteSensorSet.h"
+
+static_assert(HubSensorList::ID_LENGTH == RemoteSensorSet::ID_LENGTH, "hub ids go into the remote set as-is");
 
 BabelSensor::BabelSensor(const char* url) 
-    : serverUrl(url), lastUpdate(0), lastTemperature(0.0) {
+    : lastPoll(0), lastFullUpdate(0), lastTemperature(0.0), lastReadingAt(0) {
     Serial.println("BabelSensor initialized with URL: " + String(url));
 }
 
@@ -11,93 +16,112 @@ bool BabelSensor::init() {
     return true;
 }
 
+bool BabelSensor::isAuthenticated() const {
+    return SensorHubAuth::getInstance().hasToken();
+}
+
 float BabelSensor::getRemoteTemperature() {
     unsigned long now = millis();
-    if (now - lastUpdate < UPDATE_INTERVAL) {
+    if (lastPoll != 0 && now - lastPoll < pollInterval.get()) {
         return lastTemperature;
     }
     
-    if (!isAuthenticated()) {
-        Serial.println("Not authenticated, attempting login...");
-        if (!login(API_USERNAME, API_PASSWORD)) {
-            Serial.println("Login failed, returning last temperature");
-            return lastTemperature;
-        }
+    // The token service logs in in the background; never block the loop on it
+    SensorHubAuth& auth = SensorHubAuth::getInstance();
+    String token = auth.getToken();
+    if (token.isEmpty()) {
+        Serial.println("No sensorHUB token yet, returning last temperature");
+        return lastTemperature;
     }
+    lastPoll = now;
     
-    HTTPClient http;
-    String sensorUrl = serverUrl + String(API_SENSORS_ENDPOINT);
-    
-    http.begin(sensorUrl);
-    http.addHeader("Authorization", "Bearer " + authToken);
-    
-    int httpCode = http.GET();
+    SensorHubClient::Request request(API_SENSORS_ENDPOINT);
+    request.addHeader("Authorization", "Bearer " + token);
+
+    // Revalidate rather than refetch when the hub handed out validators
+    if (etag.length() > 0) {
+        request.addHeader("If-None-Match", etag);
+    }
+    if (lastModified.length() > 0) {
+        request.addHeader("If-Modified-Since", lastModified);
+    }
+    static const char* validatorHeaders[] = {"ETag", "Last-Modified"};
+    request.collectHeaders(validatorHeaders, 2);
+
+    // The body is parsed straight off the socket, so it must not be chunked
+    request.useHTTP10(true);
+    int httpCode = request.GET();
     
-    if (httpCode == 200) {
-        String response = http.getString();
-        DynamicJsonDocument doc(2048);
-        DeserializationError error = deserializeJson(doc, response);
-        
-        if (!error) {
-            bool babelSensorFound = false;
-            JsonArray array = doc.as<JsonArray>();
-            
-            for (JsonVariant sensor : array) {
-                if (sensor["isBabelSensor"].as<bool>()) {
-                    babelSensorFound = true;
-                    float newTemp = sensor["babelTemperature"].as<float>();
-                    if (newTemp != lastTemperature) {
-                        lastTemperature = newTemp;
-                        Serial.printf("BabelSensor temperature updated: %.2f\n", lastTemperature);
-                    }
-                    lastUpdate = now;
-                    break;
+    RemoteSensorSet& remotes = RemoteSensorSet::getInstance();
+    if (httpCode == 304) {
+        // Same list as the last full response, so its readings are still current
+        remotes.touch(lastFullUpdate);
+        if (lastReadingAt != 0 && static_cast<long>(lastReadingAt - lastFullUpdate) >= 0) {
+            lastReadingAt = now;
+        }
+        pollInterval.update(false);
+    } else if (httpCode == 200) {
+        etag = request.header("ETag");
+        lastModified = request.header("Last-Modified");
+        lastFullUpdate = now;
+
+        uint32_t version = remotes.getVersion();
+        bool found = false;
+        float newTemp = lastTemperature;
+        bool parsed = HubSensorList::read(request.getStream(), [&](const HubSensorList::Sensor& sensor) {
+            applySensor(sensor, found, newTemp);
+        });
+        if (parsed) {
+            if (found) {
+                lastReadingAt = now;
+                if (newTemp != lastTemperature) {
+                    lastTemperature = newTemp;
+                    Serial.printf("BabelSensor temperature updated: %.2f\n", lastTemperature);
                 }
-            }
-            if (!babelSensorFound) {
+            } else {
                 Serial.println("No BabelSensor found in response");
             }
         }
+        pollInterval.update(remotes.getVersion() != version);
+    } else if (httpCode == 401) {
+        Serial.println("Sensor request unauthorized, token will be refreshed");
+        auth.invalidate(token);
     } else {
         Serial.printf("HTTP request failed, code: %d\n", httpCode);
     }
     
-    http.end();
     return lastTemperature;
 }
-bool BabelSensor::login(const char* username, const char* password) {
-    HTTPClient http;
-    String loginUrl = serverUrl + String(API_LOGIN_ENDPOINT);
-    
-    http.begin(loginUrl);
-    http.addHeader("Content-Type", "application/json");
-    
-    StaticJsonDocument<200> credentials;
-    credentials["username"] = username;
-    credentials["password"] = password;
-    
-    String requestBody;
-    serializeJson(credentials, requestBody);
-    
-    int httpCode = http.POST(requestBody);
-    Serial.printf("Login attempt - HTTP response code: %d\n", httpCode);
-    
-    if (httpCode == 200) {
-        String response = http.getString();
-        StaticJsonDocument<200> doc;
-        DeserializationError error = deserializeJson(doc, response);
-        
-        if (!error && doc.containsKey("token")) {
-            authToken = doc["token"].as<String>();
-            Serial.println("Authentication successful, token received");
-            http.end();
-            return true;
-        }
-        Serial.println("Invalid authentication response format");
-    } else {
-        Serial.printf("Authentication failed with code: %d\n", httpCode);
+
+bool BabelSensor::applyMqttPayload(MQTTPayload payload) {
+    // Kept in one struct so the visitor's captures stay small enough for
+    // std::function to hold inline, without an allocation per message
+    struct {
+        bool found;
+        float temperature;
+        size_t applied;
+    } result = {false, lastTemperature, 0};
+
+    // Sensors read before a malformed part of a list still count
+    HubSensorList::parse(payload.data, payload.length, [&result, this](const HubSensorList::Sensor& sensor) {
+        result.applied += applySensor(sensor, result.found, result.temperature);
+    });
+
+    if (result.found) {
+        lastTemperature = result.temperature;
+        lastReadingAt = millis();
     }
-    
-    http.end();
-    return false;
+    return result.applied > 0;
+}
+
+bool BabelSensor::applySensor(const HubSensorList::Sensor& sensor, bool& found, float& temperature) {
+    // Every sensor goes into the remote set; the first Babel sensor also
+    // remains the primary remote temperature
+    if (!found && sensor.isBabel) {
+        temperature = sensor.value;
+        found = true;
+    }
+
+    if (sensor.id[0] == '\0') return sensor.isBabel;
+    return RemoteSensorSet::getInstance().update(sensor.id, sensor.value) || sensor.isBabel;
 }
@@ -0,0 +1,155 @@
+// CaptiveDns.cpp
+#include "CaptiveDns.h"
+#include <lwip/sockets.h>
+#include <fcntl.h>
+
+namespace {
+
+constexpr size_t HEADER_SIZE = 12;
+constexpr size_t ANSWER_SIZE = 16;     // Name pointer, type, class, TTL, length, address
+constexpr size_t MAX_NAME_LENGTH = 255;
+constexpr size_t MAX_QUERIES_PER_POLL = 8;     // Leaves the HTTP sockets their turn under a flood
+
+constexpr uint16_t TYPE_A = 1;
+constexpr uint16_t TYPE_ANY = 255;
+constexpr uint16_t CLASS_IN = 1;
+constexpr uint16_t CLASS_ANY = 255;
+
+constexpr uint8_t FLAG_RESPONSE = 0x80;
+constexpr uint8_t FLAG_AUTHORITATIVE = 0x04;
+constexpr uint8_t FLAG_RECURSION_DESIRED = 0x01;
+constexpr uint8_t OPCODE_MASK = 0x78;
+
+constexpr uint8_t RCODE_FORMAT_ERROR = 1;
+constexpr uint8_t RCODE_NOT_IMPLEMENTED = 4;
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint8_t* writeU16(uint8_t* p, uint16_t value) {
+    p[0] = value >> 8;
+    p[1] = value & 0xFF;
+    return p + 2;
+}
+
+// Header-only reply carrying just an error code
+size_t fail(const uint8_t* query, uint8_t rcode, uint8_t* response) {
+    uint8_t flags = query[2];
+    response[0] = query[0];
+    response[1] = query[1];
+    response[2] = FLAG_RESPONSE | (flags & (OPCODE_MASK | FLAG_RECURSION_DESIRED));
+    response[3] = rcode;
+    memset(response + 4, 0, HEADER_SIZE - 4);
+    return HEADER_SIZE;
+}
+
+}
+
+CaptiveDns::CaptiveDns()
+    : _fd(-1)
+    , _address(0) {
+}
+
+CaptiveDns::~CaptiveDns() {
+    stop();
+}
+
+bool CaptiveDns::begin(uint32_t address, uint16_t port) {
+    stop();
+
+    _fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (_fd < 0) {
+        Serial.println("[DNS] Failed to create socket");
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(_fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+        Serial.printf("[DNS] Failed to bind port %u\n", port);
+        stop();
+        return false;
+    }
+    fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK);
+
+    _address = address;
+    Serial.printf("[DNS] Answering on port %u\n", port);
+    return true;
+}
+
+void CaptiveDns::stop() {
+    if (_fd < 0) return;
+    ::close(_fd);
+    _fd = -1;
+}
+
+void CaptiveDns::poll() {
+    for (size_t i = 0; i < MAX_QUERIES_PER_POLL && _fd >= 0; i++) {
+        sockaddr_in peer;
+        socklen_t peerLength = sizeof(peer);
+        ssize_t received = recvfrom(_fd, _packet, sizeof(_packet), MSG_DONTWAIT,
+                                    reinterpret_cast<sockaddr*>(&peer), &peerLength);
+        if (received <= 0) return;
+
+        // Replies are built in place; none is longer than the query plus one record
+        size_t length = answer(_packet, received, _address, _packet, sizeof(_packet));
+        if (length > 0) {
+            sendto(_fd, _packet, length, MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&peer), peerLength);
+        }
+    }
+}
+
+size_t CaptiveDns::answer(const uint8_t* query, size_t length, uint32_t address,
+                          uint8_t* response, size_t capacity) {
+    // Too short to answer, or a response rather than a query
+    if (length < HEADER_SIZE || capacity < HEADER_SIZE || (query[2] & FLAG_RESPONSE)) return 0;
+
+    if (query[2] & OPCODE_MASK) return fail(query, RCODE_NOT_IMPLEMENTED, response);
+    if (readU16(query + 4) != 1) return fail(query, RCODE_FORMAT_ERROR, response);
+
+    // The question name: plain labels, since a query has nothing to point back to
+    size_t offset = HEADER_SIZE;
+    size_t nameLength = 0;
+    while (true) {
+        if (offset >= length) return fail(query, RCODE_FORMAT_ERROR, response);
+        uint8_t label = query[offset];
+        if (label == 0) break;
+        if (label > 63) return fail(query, RCODE_FORMAT_ERROR, response);
+        nameLength += label + 1;
+        if (nameLength > MAX_NAME_LENGTH) return fail(query, RCODE_FORMAT_ERROR, response);
+        offset += label + 1;
+    }
+    size_t questionEnd = offset + 1 + 4;
+    if (questionEnd > length) return fail(query, RCODE_FORMAT_ERROR, response);
+
+    uint16_t type = readU16(query + offset + 1);
+    uint16_t qclass = readU16(query + offset + 3);
+    bool answered = (type == TYPE_A || type == TYPE_ANY) && (qclass == CLASS_IN || qclass == CLASS_ANY);
+    size_t total = questionEnd + (answered ? ANSWER_SIZE : 0);
+    if (total > capacity) return fail(query, RCODE_FORMAT_ERROR, response);
+
+    // Header and question are echoed; anything after them (EDNS) is dropped
+    if (response != query) memcpy(response, query, questionEnd);
+    response[2] = FLAG_RESPONSE | FLAG_AUTHORITATIVE | (query[2] & FLAG_RECURSION_DESIRED);
+    response[3] = 0;
+    writeU16(response + 6, answered ? 1 : 0);
+    writeU16(response + 8, 0);
+    writeU16(response + 10, 0);
+    if (!answered) return questionEnd;
+
+    uint8_t* p = response + questionEnd;
+    p = writeU16(p, 0xC000 | HEADER_SIZE);      // Name: pointer to the question's
+    p = writeU16(p, TYPE_A);
+    p = writeU16(p, CLASS_IN);
+    p = writeU16(p, TTL >> 16);
+    p = writeU16(p, TTL & 0xFFFF);
+    p = writeU16(p, 4);
+    memcpy(p, &address, 4);
+    return total;
+}
@@ -19,6 +19,7 @@ DisplayHandler::DisplayHandler()
       displayValid(false),
       currentMode(DisplayMode::TIME),
       modeStartTime(0),
+      remoteSlots(1),
       lastUpdate(0),
       currentBrightness(255)
 {
@@ -115,7 +116,12 @@ void DisplayHandler::setDigit(uint8_t position, uint8_t value, bool dp) {
 void DisplayHandler::update() {
     unsigned long now = millis();
     
-    if (now - modeStartTime >= MODE_DURATIONS[static_cast<int>(currentMode)]) {
+    unsigned long duration = MODE_DURATIONS[static_cast<int>(currentMode)];
+    if (currentMode == DisplayMode::REMOTE_TEMP) {
+        duration *= remoteSlots;
+    }
+
+    if (now - modeStartTime >= duration) {
         nextMode();
         modeStartTime = now;
     }
@@ -240,6 +246,14 @@ void DisplayHandler::showRemoteTemp(float temp) {
     */
 }
 
+void DisplayHandler::showRemoteIndex(uint8_t index) {
+    // "r  n" announces which remote sensor follows
+    setDigit(0, CHAR_r);
+    setDigit(1, CHAR_BLANK);
+    setDigit(2, CHAR_BLANK);
+    setDigit(3, CHAR_0 + ((index + 1) % 10));
+}
+
 void DisplayHandler::setMode(DisplayMode mode) {
     if (xSemaphoreTake(displayMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
         currentMode = mode;
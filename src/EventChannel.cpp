@@ -0,0 +1,87 @@
+// EventChannel.cpp
+#include "EventChannel.h"
+#include "HttpServer.h"
+
+bool EventChannel::open(WiFiClient& client) {
+    if (!freeSlot()) {
+        Serial.println("[SSE] No free event stream slot");
+        return false;
+    }
+
+    client.setNoDelay(true);
+    char head[EVENT_BUFFER_SIZE];
+    int headLength = snprintf(head, sizeof(head),
+                              "HTTP/1.1 200 OK\r\n"
+                              "Content-Type: text/event-stream\r\n"
+                              "Cache-Control: no-cache\r\n"
+                              "Connection: keep-alive\r\n"
+                              "Access-Control-Allow-Origin: *\r\n"
+                              "\r\n"
+                              "retry: %lu\n\n", RECONNECT_DELAY);
+    if (!HttpServer::sendNow(client.fd(), head, headLength)) {
+        client.stop();
+        return false;
+    }
+    return true;
+}
+
+bool EventChannel::add(WiFiClient& client) {
+    WiFiClient* slot = freeSlot();
+    if (!slot || !client.connected()) return false;
+    *slot = client;
+    Serial.printf("[SSE] Client subscribed (%u active)\n", clientCount());
+    return true;
+}
+
+bool EventChannel::send(WiFiClient& client, const char* event, const char* data) {
+    char buffer[EVENT_BUFFER_SIZE];
+    int length = snprintf(buffer, sizeof(buffer), "event: %s\ndata: %s\n\n", event, data);
+    if (length <= 0 || (size_t)length >= sizeof(buffer)) {
+        Serial.printf("[SSE] '%s' event too large\n", event);
+        return false;
+    }
+
+    // A short write means the peer is gone or stalled; drop it rather than
+    // block the web server loop
+    if (!HttpServer::sendNow(client.fd(), buffer, length)) {
+        client.stop();
+        return false;
+    }
+    return true;
+}
+
+void EventChannel::broadcast(const char* event, const char* data) {
+    for (size_t i = 0; i < MAX_CLIENTS; i++) {
+        if (clients[i].connected()) {
+            send(clients[i], event, data);
+        }
+    }
+}
+
+void EventChannel::keepalive() {
+    for (size_t i = 0; i < MAX_CLIENTS; i++) {
+        if (clients[i].connected() && !HttpServer::sendNow(clients[i].fd(), ":\n\n", 3)) {
+            clients[i].stop();
+        }
+    }
+}
+
+size_t EventChannel::clientCount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < MAX_CLIENTS; i++) {
+        // connected() is not const in the Arduino core
+        if (const_cast<WiFiClient&>(clients[i]).connected()) count++;
+    }
+    return count;
+}
+
+WiFiClient* EventChannel::freeSlot() {
+    for (size_t i = 0; i < MAX_CLIENTS; i++) {
+        if (!clients[i].connected()) {
+            // Release whatever socket a closed client still holds
+            clients[i].stop();
+            return &clients[i];
+        }
+    }
+    return nullptr;
+}
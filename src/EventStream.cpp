@@ -0,0 +1,70 @@
+// EventStream.cpp
+#include "EventStream.h"
+#include "GlobalState.h"
+#include "RelayControlHandler.h"
+#include "SensorDocument.h"
+
+EventStream& EventStream::getInstance() {
+    static EventStream instance;
+    return instance;
+}
+
+EventStream::EventStream()
+    : relayVersion(0)
+    , sensorStamp(0)
+    , remoteTemperature(0)
+    , lastKeepalive(0)
+    , lastSensorEvent(0) {
+}
+
+bool EventStream::subscribe(WiFiClient& client) {
+    if (!channel.open(client)) return false;
+
+    // Start every subscriber from a full snapshot
+    String relays;
+    RelayControlHandler::getInstance().getCachedStatesJson(relays);
+    char sensors[EventChannel::EVENT_BUFFER_SIZE];
+    formatSensors(sensors, sizeof(sensors));
+    if (!channel.send(client, "relay", relays.c_str()) || !channel.send(client, "sensors", sensors)) {
+        return false;
+    }
+    return channel.add(client);
+}
+
+void EventStream::loop() {
+    if (channel.clientCount() == 0) return;
+
+    unsigned long now = millis();
+    RelayControlHandler& relayHandler = RelayControlHandler::getInstance();
+    GlobalState& state = GlobalState::getInstance();
+
+    uint32_t version = relayHandler.getStateVersion();
+    if (version != relayVersion) {
+        String relays;
+        relayVersion = relayHandler.getCachedStatesJson(relays);
+        channel.broadcast("relay", relays.c_str());
+    }
+
+    uint32_t stamp = state.getLastSensorUpdate();
+    float remote = state.getRemoteTemperature();
+    if ((stamp != sensorStamp || remote != remoteTemperature) &&
+        now - lastSensorEvent >= SENSOR_EVENT_INTERVAL) {
+        char sensors[EventChannel::EVENT_BUFFER_SIZE];
+        formatSensors(sensors, sizeof(sensors));
+        channel.broadcast("sensors", sensors);
+        sensorStamp = stamp;
+        remoteTemperature = remote;
+        lastSensorEvent = now;
+    }
+
+    if (now - lastKeepalive >= KEEPALIVE_INTERVAL) {
+        channel.keepalive();
+        lastKeepalive = now;
+    }
+}
+
+void EventStream::formatSensors(char* buffer, size_t size) const {
+    GlobalState& state = GlobalState::getInstance();
+    SensorDocument::format(buffer, size, state.getTemperature(), state.getHumidity(), state.getPressure(),
+                           state.getRemoteTemperature());
+}
@@ -0,0 +1,171 @@
+// HomeAssistantDiscovery.cpp
+#include "HomeAssistantDiscovery.h"
+#include "MQTTManager.h"
+#include "CustomHash.h"
+#include "config.h"
+#include <SPIFFS.h>
+
+const char* HomeAssistantDiscovery::CACHE_DIR = "/ha";
+const char* HomeAssistantDiscovery::CACHE_STAMP_PATH = "/ha/cache.stamp";
+const char* HomeAssistantDiscovery::SENT_STAMP_PATH = "/ha/sent.stamp";
+
+const HomeAssistantDiscovery::Entity HomeAssistantDiscovery::ENTITIES[] = {
+    {"sensor", "temperature", "Temperature", "temperature", "°C", "temperature", -1},
+    {"sensor", "humidity", "Humidity", "humidity", "%", "humidity", -1},
+    {"sensor", "pressure", "Pressure", "pressure", "hPa", "pressure", -1},
+    {"sensor", "remote_temperature", "Remote Temperature", "temperature", "°C", "remote_temperature", -1},
+    {"switch", "relay0", "Relay 1", nullptr, nullptr, nullptr, 0},
+    {"switch", "relay1", "Relay 2", nullptr, nullptr, nullptr, 1},
+};
+const size_t HomeAssistantDiscovery::ENTITY_COUNT = sizeof(ENTITIES) / sizeof(ENTITIES[0]);
+
+void HomeAssistantDiscovery::publish(MQTTManager& mqtt, const String& nodeId) {
+    uint32_t stamp = computeStamp(nodeId);
+
+    uint32_t sentStamp = 0;
+    if (readStamp(SENT_STAMP_PATH, sentStamp) && sentStamp == stamp) {
+        // The broker still holds the retained configs from a previous boot
+        return;
+    }
+
+    uint32_t cacheStamp = 0;
+    if (!readStamp(CACHE_STAMP_PATH, cacheStamp) || cacheStamp != stamp) {
+        Serial.printf("[HA] Generating discovery cache (stamp %08X)\n", stamp);
+        if (!generateCache(nodeId) || !writeStamp(CACHE_STAMP_PATH, stamp)) {
+            Serial.println("[HA] Failed to generate discovery cache");
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < ENTITY_COUNT; i++) {
+        File file = SPIFFS.open(cachePath(i), "r");
+        if (!file) {
+            Serial.printf("[HA] Missing cached payload %s\n", cachePath(i).c_str());
+            invalidate();
+            return;
+        }
+
+        String topic = discoveryTopic(ENTITIES[i], nodeId);
+        bool ok = mqtt.publishStream(topic.c_str(), file.size(), [&file](Print& out) {
+            uint8_t buffer[64];
+            size_t n;
+            while ((n = file.read(buffer, sizeof(buffer))) > 0) {
+                if (out.write(buffer, n) != n) return false;
+            }
+            return true;
+        }, true);
+        file.close();
+
+        if (!ok) {
+            Serial.printf("[HA] Failed to publish discovery config %s\n", topic.c_str());
+            return;
+        }
+    }
+
+    writeStamp(SENT_STAMP_PATH, stamp);
+    Serial.printf("[HA] Published %u discovery configs\n", ENTITY_COUNT);
+}
+
+void HomeAssistantDiscovery::invalidate() {
+    SPIFFS.remove(CACHE_STAMP_PATH);
+    SPIFFS.remove(SENT_STAMP_PATH);
+}
+
+uint32_t HomeAssistantDiscovery::computeStamp(const String& nodeId) {
+    uint32_t hash = CustomHash::fnv1a(FIRMWARE_VERSION);
+    hash = CustomHash::fnv1a(nodeId.c_str(), hash);
+    hash = CustomHash::fnv1a(MQTT_DISCOVERY_PREFIX, hash);
+    hash = CustomHash::fnv1a(MQTT_TOPIC_STATE, hash);
+    hash = CustomHash::fnv1a(MQTT_TOPIC_AVAILABILITY, hash);
+    hash = CustomHash::fnv1a(MQTT_TOPIC_RELAY, hash);
+    hash = CustomHash::fnv1a(MQTT_TOPIC_RELAY_COMMAND, hash);
+    return hash;
+}
+
+bool HomeAssistantDiscovery::readStamp(const char* path, uint32_t& stamp) {
+    File file = SPIFFS.open(path, "r");
+    if (!file) return false;
+    bool ok = file.read(reinterpret_cast<uint8_t*>(&stamp), sizeof(stamp)) == sizeof(stamp);
+    file.close();
+    return ok;
+}
+
+bool HomeAssistantDiscovery::writeStamp(const char* path, uint32_t stamp) {
+    File file = SPIFFS.open(path, "w");
+    if (!file) return false;
+    bool ok = file.write(reinterpret_cast<const uint8_t*>(&stamp), sizeof(stamp)) == sizeof(stamp);
+    file.close();
+    return ok;
+}
+
+bool HomeAssistantDiscovery::generateCache(const String& nodeId) {
+    if (!SPIFFS.exists(CACHE_DIR)) {
+        SPIFFS.mkdir(CACHE_DIR);
+    }
+
+    // Anything sent under an older stamp is stale from here on
+    SPIFFS.remove(SENT_STAMP_PATH);
+
+    for (size_t i = 0; i < ENTITY_COUNT; i++) {
+        StaticJsonDocument<768> doc;
+        buildPayload(ENTITIES[i], nodeId, doc);
+
+        File file = SPIFFS.open(cachePath(i), "w");
+        if (!file) {
+            Serial.printf("[HA] Failed to open %s for writing\n", cachePath(i).c_str());
+            return false;
+        }
+        size_t expected = measureJson(doc);
+        size_t written = serializeJson(doc, file);
+        file.close();
+
+        if (written != expected) {
+            Serial.printf("[HA] Short write for %s\n", cachePath(i).c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void HomeAssistantDiscovery::buildPayload(const Entity& entity, const String& nodeId, JsonDocument& doc) {
+    doc["name"] = entity.name;
+    doc["unique_id"] = nodeId + "_" + entity.objectId;
+    doc["availability_topic"] = MQTT_TOPIC_AVAILABILITY;
+
+    if (entity.relayId >= 0) {
+        char stateTopic[96];
+        snprintf(stateTopic, sizeof(stateTopic), "%s/%d/state", MQTT_TOPIC_RELAY, entity.relayId);
+        char payloadOn[48];
+        char payloadOff[48];
+        snprintf(payloadOn, sizeof(payloadOn), "{\"relay_id\":%d,\"state\":\"ON\"}", entity.relayId);
+        snprintf(payloadOff, sizeof(payloadOff), "{\"relay_id\":%d,\"state\":\"OFF\"}", entity.relayId);
+
+        doc["command_topic"] = MQTT_TOPIC_RELAY_COMMAND;
+        doc["state_topic"] = stateTopic;
+        doc["payload_on"] = payloadOn;
+        doc["payload_off"] = payloadOff;
+        doc["state_on"] = "ON";
+        doc["state_off"] = "OFF";
+    } else {
+        doc["state_topic"] = MQTT_TOPIC_STATE;
+        doc["device_class"] = entity.deviceClass;
+        doc["unit_of_measurement"] = entity.unit;
+        doc["state_class"] = "measurement";
+        doc["value_template"] = String("{{ value_json.") + entity.valueKey + " }}";
+    }
+
+    JsonObject device = doc.createNestedObject("device");
+    device["identifiers"][0] = nodeId;
+    device["name"] = DEVICE_NAME;
+    device["model"] = "NTP Clock";
+    device["manufacturer"] = "Chaoticvolt";
+    device["sw_version"] = FIRMWARE_VERSION;
+}
+
+String HomeAssistantDiscovery::discoveryTopic(const Entity& entity, const String& nodeId) {
+    return String(MQTT_DISCOVERY_PREFIX) + "/" + entity.component + "/" + nodeId + "/" + entity.objectId + "/config";
+}
+
+String HomeAssistantDiscovery::cachePath(size_t index) {
+    return String(CACHE_DIR) + "/" + String(index) + ".json";
+}
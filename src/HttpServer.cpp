@@ -0,0 +1,870 @@
+// HttpServer.cpp
+#include "HttpServer.h"
+#include "Metrics.h"
+#include <lwip/sockets.h>
+#include <fcntl.h>
+#include <errno.h>
+
+namespace {
+const String EMPTY_STRING;
+
+bool wouldBlock() {
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+}
+
+HttpServer::HttpServer(uint16_t port)
+    : _port(port)
+    , _listenFd(-1)
+    , _running(false)
+    , _task(nullptr)
+    , _stopped(xSemaphoreCreateBinary())
+    , _completions(xQueueCreate(MAX_CONNECTIONS, sizeof(Completion*)))
+    , _current(nullptr)
+    , _responded(false)
+    , _streaming(false)
+    , _nextTicket(1)
+    , _resolver(nullptr)
+    , _notFound(nullptr)
+    , _collectedCount(0) {
+    for (Connection& conn : _connections) {
+        conn.fd = -1;
+        conn.peer = 0;
+        conn.headLength = 0;
+        reset(conn);
+    }
+    for (int& fd : _watched) {
+        fd = -1;
+    }
+}
+
+HttpServer::~HttpServer() {
+    stop();
+
+    Completion* completion;
+    while (_completions && xQueueReceive(_completions, &completion, 0) == pdTRUE) {
+        delete completion;
+    }
+    if (_completions) vQueueDelete(_completions);
+    if (_stopped) vSemaphoreDelete(_stopped);
+}
+
+bool HttpServer::begin() {
+    if (_task) return true;
+    if (!_stopped || !_completions) {
+        Serial.println("[HTTP] Failed to create server primitives");
+        return false;
+    }
+
+    _listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (_listenFd < 0) {
+        Serial.printf("[HTTP] Failed to create socket: errno %d\n", errno);
+        return false;
+    }
+
+    int enable = 1;
+    setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(_port);
+    if (bind(_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(_listenFd, LISTEN_BACKLOG) < 0) {
+        Serial.printf("[HTTP] Failed to listen on port %u: errno %d\n", _port, errno);
+        ::close(_listenFd);
+        _listenFd = -1;
+        return false;
+    }
+    fcntl(_listenFd, F_SETFL, fcntl(_listenFd, F_GETFL, 0) | O_NONBLOCK);
+
+    _running = true;
+    BaseType_t result = xTaskCreatePinnedToCore(
+        serverTask,
+        "HttpServer",
+        TASK_STACK_SIZE,
+        this,
+        TASK_PRIORITY,
+        &_task,
+        0
+    );
+    if (result != pdPASS) {
+        Serial.println("[HTTP] Failed to create server task");
+        _running = false;
+        _task = nullptr;
+        ::close(_listenFd);
+        _listenFd = -1;
+        return false;
+    }
+
+    Metrics::getInstance().registerTask("HttpServer", _task);
+    Serial.printf("[HTTP] Listening on port %u\n", _port);
+    return true;
+}
+
+void HttpServer::stop() {
+    if (!_task) return;
+
+    // The task closes every socket on its way out; a handler stopping its own
+    // server cannot wait for that, the task just exits once it returns
+    _running = false;
+    Metrics::getInstance().unregisterTask(_task);
+    if (xTaskGetCurrentTaskHandle() != _task) {
+        xSemaphoreTake(_stopped, portMAX_DELAY);
+    }
+    _task = nullptr;
+}
+
+void HttpServer::collectHeaders(const char* headers[], size_t count) {
+    _collectedCount = count < MAX_COLLECTED_HEADERS ? count : MAX_COLLECTED_HEADERS;
+    for (size_t i = 0; i < _collectedCount; i++) {
+        _collected[i] = headers[i];
+    }
+}
+
+const String& HttpServer::uri() const {
+    return _current ? _current->uri : EMPTY_STRING;
+}
+
+HTTPMethod HttpServer::method() const {
+    return _current ? _current->method : HTTP_ANY;
+}
+
+String HttpServer::arg(const char* name) const {
+    if (!_current) return String();
+    if (strcmp(name, "plain") == 0) return _current->body;
+
+    String value;
+    if (findArg(_current->query, name, &value)) return value;
+    if (_current->contentType.startsWith("application/x-www-form-urlencoded") &&
+        findArg(_current->body, name, &value)) {
+        return value;
+    }
+    return String();
+}
+
+bool HttpServer::hasArg(const char* name) const {
+    if (!_current) return false;
+    if (strcmp(name, "plain") == 0) return _current->body.length() > 0;
+
+    return findArg(_current->query, name, nullptr) ||
+           (_current->contentType.startsWith("application/x-www-form-urlencoded") &&
+            findArg(_current->body, name, nullptr));
+}
+
+const String& HttpServer::header(const char* name) const {
+    if (!_current) return EMPTY_STRING;
+    for (size_t i = 0; i < _collectedCount; i++) {
+        if (strcasecmp(_collected[i], name) == 0) {
+            return _current->headers[i];
+        }
+    }
+    return EMPTY_STRING;
+}
+
+const String& HttpServer::hostHeader() const {
+    return _current ? _current->host : EMPTY_STRING;
+}
+
+uint32_t HttpServer::remoteAddress() const {
+    return _current ? _current->peer : 0;
+}
+
+void HttpServer::sendHeader(const String& name, const String& value, bool first) {
+    // Appended in place after a single reserve rather than through temporaries
+    size_t length = _pendingHeaders.length() + name.length() + value.length() + 4;
+    String previous;
+    if (first) {
+        previous = std::move(_pendingHeaders);
+        _pendingHeaders = String();
+    }
+    _pendingHeaders.reserve(length);
+    _pendingHeaders += name;
+    _pendingHeaders += ": ";
+    _pendingHeaders += value;
+    _pendingHeaders += "\r\n";
+    _pendingHeaders += previous;
+}
+
+void HttpServer::send(int code, const char* contentType, const String& content) {
+    if (!_current || _responded) return;
+    Connection& conn = *_current;
+
+    beginResponse(conn, code, contentType, content.length(), _pendingHeaders);
+    if (conn.method != HTTP_HEAD) {
+        conn.response += content;
+    }
+    _pendingHeaders = String();
+    _responded = true;
+}
+
+void HttpServer::send_P(int code, PGM_P contentType, PGM_P content, size_t length) {
+    if (!_current || _responded) return;
+    Connection& conn = *_current;
+
+    // Flash is memory-mapped, so the body goes out straight from it
+    beginResponse(conn, code, contentType, length, _pendingHeaders);
+    if (conn.method != HTTP_HEAD) {
+        conn.staticBody = content;
+        conn.staticLength = length;
+    }
+    _pendingHeaders = String();
+    _responded = true;
+}
+
+bool HttpServer::beginChunked(int code, const char* contentType) {
+    if (!_current || _responded) return false;
+    Connection& conn = *_current;
+
+    // Without chunked coding the end of the body is the end of the connection
+    conn.chunked = !conn.http10;
+    if (!conn.chunked) conn.keepAlive = false;
+
+    beginResponse(conn, code, contentType, UNKNOWN_LENGTH, _pendingHeaders);
+    _pendingHeaders = String();
+    _responded = true;
+    _streaming = true;
+    return true;
+}
+
+bool HttpServer::sendChunk(const char* data, size_t length) {
+    if (!_current || !_streaming) return false;
+    Connection& conn = *_current;
+    if (conn.fd < 0) return false;
+    if (length == 0 || conn.method == HTTP_HEAD) return true;
+
+    if (!conn.chunked) {
+        iovec part = {const_cast<char*>(data), length};
+        return stream(conn, &part, 1);
+    }
+
+    char size[12];
+    int sizeLength = snprintf(size, sizeof(size), "%x\r\n", static_cast<unsigned>(length));
+    iovec parts[3] = {
+        {size, static_cast<size_t>(sizeLength)},
+        {const_cast<char*>(data), length},
+        {const_cast<char*>("\r\n"), 2}
+    };
+    return stream(conn, parts, 3);
+}
+
+void HttpServer::endChunked() {
+    if (!_current || !_streaming) return;
+    Connection& conn = *_current;
+    _streaming = false;
+    if (conn.fd < 0 || conn.method == HTTP_HEAD || !conn.chunked) return;
+
+    iovec last = {const_cast<char*>("0\r\n\r\n"), 5};
+    stream(conn, &last, 1);
+}
+
+WiFiClient HttpServer::client() {
+    if (!_current || _responded || _current->fd < 0) return WiFiClient();
+    Connection& conn = *_current;
+
+    // The new owner writes from the server task too, so the socket keeps
+    // O_NONBLOCK and a stalled peer can't hold up every other connection
+    int fd = conn.fd;
+    conn.fd = -1;
+    conn.headLength = 0;
+    reset(conn);
+    _pendingHeaders = String();
+    _responded = true;
+    Metrics::getInstance().http.connections.add(-1);
+    return WiFiClient(fd);
+}
+
+bool HttpServer::sendNow(int fd, const void* data, size_t length) {
+    if (fd < 0) return false;
+    ssize_t written = ::send(fd, data, length, MSG_DONTWAIT);
+    return written >= 0 && static_cast<size_t>(written) == length;
+}
+
+bool HttpServer::watch(int fd) {
+    if (fd < 0) return false;
+    for (int& slot : _watched) {
+        if (slot < 0) {
+            slot = fd;
+            return true;
+        }
+    }
+    return false;
+}
+
+void HttpServer::unwatch(int fd) {
+    for (int& slot : _watched) {
+        if (slot == fd) slot = -1;
+    }
+}
+
+HttpServer::Ticket HttpServer::defer() {
+    if (!_current || _responded) return 0;
+    Connection& conn = *_current;
+
+    conn.ticket = _nextTicket++;
+    if (_nextTicket == 0) _nextTicket = 1;
+
+    // Headers set so far go out with the eventual answer
+    conn.response = _pendingHeaders;
+    _pendingHeaders = String();
+    conn.state = State::DEFERRED;
+    conn.lastActivity = millis();
+    _responded = true;
+    return conn.ticket;
+}
+
+bool HttpServer::complete(Ticket ticket, int code, const char* contentType, const String& content) {
+    if (!ticket || !_completions) return false;
+
+    Completion* completion = new Completion{ticket, code, String(contentType ? contentType : ""), content};
+    if (xQueueSend(_completions, &completion, pdMS_TO_TICKS(100)) != pdTRUE) {
+        delete completion;
+        return false;
+    }
+    return true;
+}
+
+void HttpServer::serverTask(void* parameter) {
+    static_cast<HttpServer*>(parameter)->run();
+    vTaskDelete(nullptr);
+}
+
+void HttpServer::run() {
+    while (_running) {
+        fd_set readSet;
+        fd_set writeSet;
+        FD_ZERO(&readSet);
+        FD_ZERO(&writeSet);
+        FD_SET(_listenFd, &readSet);
+        int maxFd = _listenFd;
+
+        for (Connection& conn : _connections) {
+            if (conn.fd < 0) continue;
+            if (conn.state == State::WRITING) {
+                FD_SET(conn.fd, &writeSet);
+            } else if (conn.state != State::DEFERRED) {
+                FD_SET(conn.fd, &readSet);
+            }
+            if (conn.fd > maxFd) maxFd = conn.fd;
+        }
+        for (int fd : _watched) {
+            if (fd < 0) continue;
+            FD_SET(fd, &readSet);
+            if (fd > maxFd) maxFd = fd;
+        }
+
+        timeval timeout = {0, static_cast<long>(SELECT_TIMEOUT_MS * 1000)};
+        int ready = select(maxFd + 1, &readSet, &writeSet, nullptr, &timeout);
+        if (ready > 0) {
+            if (FD_ISSET(_listenFd, &readSet)) {
+                accept();
+            }
+            for (Connection& conn : _connections) {
+                if (conn.fd >= 0 && FD_ISSET(conn.fd, &readSet)) {
+                    receive(conn);
+                } else if (conn.fd >= 0 && FD_ISSET(conn.fd, &writeSet)) {
+                    transmit(conn);
+                }
+            }
+        }
+
+        drainCompletions();
+        expire(millis());
+        if (_loopHook) _loopHook();
+    }
+
+    for (Connection& conn : _connections) {
+        if (conn.fd >= 0) close(conn);
+    }
+    ::close(_listenFd);
+    _listenFd = -1;
+    xSemaphoreGive(_stopped);
+}
+
+void HttpServer::accept() {
+    sockaddr_in peer = {};
+    socklen_t peerLength = sizeof(peer);
+    int fd = ::accept(_listenFd, reinterpret_cast<sockaddr*>(&peer), &peerLength);
+    if (fd < 0) return;
+
+    Connection* slot = nullptr;
+    for (Connection& conn : _connections) {
+        if (conn.fd < 0) {
+            slot = &conn;
+            break;
+        }
+    }
+
+    if (!slot) {
+        // Refuse outright rather than let the client queue behind busy slots
+        static const char busy[] = "HTTP/1.1 503 Service Unavailable\r\n"
+                                   "Content-Length: 0\r\nConnection: close\r\n\r\n";
+        ::send(fd, busy, sizeof(busy) - 1, MSG_DONTWAIT);
+        ::close(fd);
+        Metrics::getInstance().http.rejected.add();
+        return;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    slot->fd = fd;
+    slot->peer = peer.sin_addr.s_addr;
+    slot->headLength = 0;
+    reset(*slot);
+    slot->state = State::READING_HEAD;
+    Metrics::getInstance().http.connections.add(1);
+}
+
+void HttpServer::receive(Connection& conn) {
+    if (conn.state == State::READING_HEAD) {
+        ssize_t received = recv(conn.fd, conn.head + conn.headLength,
+                                HEAD_BUFFER_SIZE - 1 - conn.headLength, MSG_DONTWAIT);
+        if (received <= 0) {
+            if (received == 0 || !wouldBlock()) close(conn);
+            return;
+        }
+        conn.headLength += received;
+        conn.lastActivity = millis();
+        processHead(conn);
+        return;
+    }
+
+    if (conn.state == State::READING_BODY) {
+        char buffer[256];
+        size_t wanted = conn.contentLength - conn.body.length();
+        ssize_t received = recv(conn.fd, buffer, wanted < sizeof(buffer) ? wanted : sizeof(buffer), MSG_DONTWAIT);
+        if (received <= 0) {
+            if (received == 0 || !wouldBlock()) close(conn);
+            return;
+        }
+        conn.body.concat(buffer, received);
+        conn.lastActivity = millis();
+        if (conn.body.length() >= conn.contentLength) {
+            dispatch(conn);
+        }
+    }
+}
+
+void HttpServer::processHead(Connection& conn) {
+    conn.head[conn.headLength] = '\0';
+    char* end = strstr(conn.head, "\r\n\r\n");
+    if (!end) {
+        if (conn.headLength >= HEAD_BUFFER_SIZE - 1) {
+            fail(conn, 431, "Request header too large");
+        }
+        return;
+    }
+
+    size_t headEnd = end - conn.head + 4;
+    if (!parseHead(conn, headEnd)) {
+        fail(conn, 400, "Bad request");
+        return;
+    }
+    if (conn.contentLength > MAX_BODY_SIZE) {
+        fail(conn, 413, "Request body too large");
+        return;
+    }
+
+    // Bytes past the head belong to the body, and past that to the next
+    // pipelined request, which stays in the buffer
+    size_t extra = conn.headLength - headEnd;
+    size_t bodyPart = extra < conn.contentLength ? extra : conn.contentLength;
+    conn.body.reserve(conn.contentLength);
+    conn.body.concat(conn.head + headEnd, bodyPart);
+    memmove(conn.head, conn.head + headEnd + bodyPart, extra - bodyPart);
+    conn.headLength = extra - bodyPart;
+
+    if (conn.body.length() < conn.contentLength) {
+        conn.state = State::READING_BODY;
+        return;
+    }
+    dispatch(conn);
+}
+
+bool HttpServer::parseHead(Connection& conn, size_t headEnd) {
+    char* limit = conn.head + headEnd;
+
+    // Request line: METHOD SP target SP version
+    char* eol = strstr(conn.head, "\r\n");
+    *eol = '\0';
+    char* methodEnd = strchr(conn.head, ' ');
+    if (!methodEnd) return false;
+    char* target = methodEnd + 1;
+    char* targetEnd = strchr(target, ' ');
+    if (!targetEnd) return false;
+    *targetEnd = '\0';
+
+    conn.method = parseMethod(conn.head, methodEnd - conn.head);
+    char* query = strchr(target, '?');
+    if (query) {
+        *query = '\0';
+        conn.query = query + 1;
+    }
+    conn.uri = target;
+    conn.http10 = strcmp(targetEnd + 1, "HTTP/1.0") == 0;
+    conn.keepAlive = !conn.http10;
+
+    for (char* line = eol + 2; line < limit - 2; line = eol + 2) {
+        eol = strstr(line, "\r\n");
+        *eol = '\0';
+        char* colon = strchr(line, ':');
+        if (!colon) return false;
+        *colon = '\0';
+        const char* value = colon + 1;
+        while (*value == ' ' || *value == '\t') value++;
+
+        if (strcasecmp(line, "Content-Length") == 0) {
+            conn.contentLength = strtoul(value, nullptr, 10);
+        } else if (strcasecmp(line, "Host") == 0) {
+            conn.host = value;
+        } else if (strcasecmp(line, "Content-Type") == 0) {
+            conn.contentType = value;
+        } else if (strcasecmp(line, "Connection") == 0) {
+            if (strcasecmp(value, "close") == 0) conn.keepAlive = false;
+            else if (strcasecmp(value, "keep-alive") == 0) conn.keepAlive = true;
+        }
+
+        for (size_t i = 0; i < _collectedCount; i++) {
+            if (strcasecmp(line, _collected[i]) == 0) {
+                conn.headers[i] = value;
+            }
+        }
+    }
+    return true;
+}
+
+void HttpServer::dispatch(Connection& conn) {
+    Metrics::getInstance().http.requests.add();
+    if (conn.method == HTTP_ANY) {
+        fail(conn, 501, "Method not implemented");
+        return;
+    }
+
+    // The request is current while resolving, so the resolver can read headers
+    _current = &conn;
+    _responded = false;
+    _streaming = false;
+    _pendingHeaders = String();
+
+    RequestHandler handler = _resolver ? _resolver(conn.method, conn.uri.c_str()) : nullptr;
+    if (!handler) handler = _notFound;
+
+    if (!handler) {
+        _current = nullptr;
+        fail(conn, 404, "Not found");
+        return;
+    }
+
+    handler();
+    endChunked();
+    _current = nullptr;
+
+    if (!_responded) {
+        fail(conn, 500, "Handler sent no response");
+        return;
+    }
+    if (conn.state == State::WRITING) {
+        transmit(conn);
+    }
+}
+
+void HttpServer::transmit(Connection& conn) {
+    size_t headLength = conn.response.length();
+
+    while (true) {
+        const char* data;
+        size_t remaining;
+        if (conn.sent < headLength) {
+            data = conn.response.c_str() + conn.sent;
+            remaining = headLength - conn.sent;
+        } else if (conn.sent < headLength + conn.staticLength) {
+            size_t offset = conn.sent - headLength;
+            data = conn.staticBody + offset;
+            remaining = conn.staticLength - offset;
+        } else {
+            finish(conn);
+            return;
+        }
+
+        ssize_t written = ::send(conn.fd, data, remaining, MSG_DONTWAIT);
+        if (written < 0) {
+            if (!wouldBlock()) close(conn);
+            return;
+        }
+        conn.sent += written;
+        conn.lastActivity = millis();
+    }
+}
+
+bool HttpServer::stream(Connection& conn, const iovec* parts, size_t count) {
+    static constexpr size_t MAX_PARTS = 4;
+
+    // Anything still queued (at first the response head) has to go ahead of
+    // the new data, so it leads the same write
+    iovec vector[MAX_PARTS];
+    size_t vectorCount = 0;
+    size_t queued = conn.response.length() - conn.sent;
+    if (queued > 0) {
+        vector[vectorCount++] = {const_cast<char*>(conn.response.c_str() + conn.sent), queued};
+    }
+    for (size_t i = 0; i < count && vectorCount < MAX_PARTS; i++) {
+        vector[vectorCount++] = parts[i];
+    }
+
+    msghdr message = {};
+    message.msg_iov = vector;
+    message.msg_iovlen = vectorCount;
+    ssize_t written = sendmsg(conn.fd, &message, MSG_DONTWAIT);
+    if (written < 0) {
+        if (!wouldBlock()) {
+            close(conn);
+            return false;
+        }
+        written = 0;
+    }
+    conn.lastActivity = millis();
+
+    size_t done = static_cast<size_t>(written);
+    if (done < queued) {
+        conn.sent += done;
+        done = 0;
+    } else {
+        // Everything queued is out; the queue starts over
+        done -= queued;
+        conn.response = String();
+        conn.sent = 0;
+    }
+
+    // Whatever the socket didn't take waits for transmit(), as long as the
+    // client keeps up well enough that the backlog stays bounded
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += parts[i].iov_len;
+    }
+    if (conn.response.length() - conn.sent + (total - done) > MAX_STREAM_BACKLOG) {
+        Serial.println("[HTTP] Client too slow for streamed response, closing");
+        close(conn);
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (done >= parts[i].iov_len) {
+            done -= parts[i].iov_len;
+            continue;
+        }
+        conn.response.concat(static_cast<const char*>(parts[i].iov_base) + done, parts[i].iov_len - done);
+        done = 0;
+    }
+    return true;
+}
+
+void HttpServer::finish(Connection& conn) {
+    if (!conn.keepAlive) {
+        close(conn);
+        return;
+    }
+
+    reset(conn);
+    conn.state = State::READING_HEAD;
+
+    // A pipelined request may already be waiting in the buffer
+    if (conn.headLength > 0) {
+        processHead(conn);
+    }
+}
+
+void HttpServer::close(Connection& conn) {
+    if (conn.fd >= 0) {
+        ::close(conn.fd);
+        conn.fd = -1;
+        Metrics::getInstance().http.connections.add(-1);
+    }
+    conn.headLength = 0;
+    reset(conn);
+}
+
+void HttpServer::expire(unsigned long now) {
+    for (Connection& conn : _connections) {
+        if (conn.fd < 0) continue;
+
+        if (conn.state == State::DEFERRED) {
+            if (now - conn.lastActivity >= DEFER_TIMEOUT) {
+                conn.keepAlive = false;
+                String headers = conn.response;
+                beginResponse(conn, 504, nullptr, 0, headers);
+                transmit(conn);
+            }
+        } else if (now - conn.lastActivity >= IDLE_TIMEOUT) {
+            close(conn);
+        }
+    }
+}
+
+void HttpServer::drainCompletions() {
+    Completion* completion;
+    while (xQueueReceive(_completions, &completion, 0) == pdTRUE) {
+        // The client may have gone away meanwhile; then the answer is dropped
+        for (Connection& conn : _connections) {
+            if (conn.fd < 0 || conn.state != State::DEFERRED || conn.ticket != completion->ticket) continue;
+
+            String headers = conn.response;
+            const char* contentType = completion->contentType.length() ? completion->contentType.c_str() : nullptr;
+            beginResponse(conn, completion->code, contentType, completion->content.length(), headers);
+            if (conn.method != HTTP_HEAD) {
+                conn.response += completion->content;
+            }
+            transmit(conn);
+            break;
+        }
+        delete completion;
+    }
+}
+
+void HttpServer::beginResponse(Connection& conn, int code, const char* contentType, size_t length, const String& headers) {
+    if (code >= 100 && code < 600) {
+        Metrics::getInstance().http.responses[code / 100 - 1].add();
+    }
+
+    char line[96];
+    if (length != UNKNOWN_LENGTH) {
+        snprintf(line, sizeof(line), "HTTP/1.1 %d %s\r\nContent-Length: %u\r\n",
+                 code, statusText(code), static_cast<unsigned>(length));
+    } else {
+        snprintf(line, sizeof(line), "HTTP/1.1 %d %s\r\n%s",
+                 code, statusText(code), conn.chunked ? "Transfer-Encoding: chunked\r\n" : "");
+    }
+
+    size_t typeLength = contentType ? strlen(contentType) : 0;
+    conn.response = String();
+    conn.response.reserve(strlen(line) + typeLength + headers.length() + HEAD_OVERHEAD);
+    conn.response += line;
+    if (contentType) {
+        conn.response += "Content-Type: ";
+        conn.response += contentType;
+        conn.response += "\r\n";
+    }
+    conn.response += conn.keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    conn.response += headers;
+    conn.response += "\r\n";
+
+    conn.staticBody = nullptr;
+    conn.staticLength = 0;
+    conn.sent = 0;
+    conn.state = State::WRITING;
+}
+
+void HttpServer::fail(Connection& conn, int code, const char* message) {
+    // The request may not have been read in full, so the connection can't be reused
+    conn.keepAlive = false;
+    conn.headLength = 0;
+    beginResponse(conn, code, "text/plain", strlen(message), EMPTY_STRING);
+    conn.response += message;
+    transmit(conn);
+}
+
+void HttpServer::reset(Connection& conn) {
+    conn.state = State::IDLE;
+    conn.lastActivity = millis();
+    conn.method = HTTP_GET;
+    conn.uri = String();
+    conn.query = String();
+    conn.body = String();
+    conn.host = String();
+    conn.contentType = String();
+    for (String& header : conn.headers) {
+        header = String();
+    }
+    conn.contentLength = 0;
+    conn.keepAlive = false;
+    conn.http10 = false;
+    conn.chunked = false;
+    conn.response = String();
+    conn.staticBody = nullptr;
+    conn.staticLength = 0;
+    conn.sent = 0;
+    conn.ticket = 0;
+}
+
+bool HttpServer::findArg(const String& params, const char* name, String* value) {
+    size_t nameLength = strlen(name);
+    const char* cursor = params.c_str();
+    const char* end = cursor + params.length();
+
+    while (cursor < end) {
+        const char* pairEnd = static_cast<const char*>(memchr(cursor, '&', end - cursor));
+        if (!pairEnd) pairEnd = end;
+        const char* equals = static_cast<const char*>(memchr(cursor, '=', pairEnd - cursor));
+        const char* keyEnd = equals ? equals : pairEnd;
+
+        if (static_cast<size_t>(keyEnd - cursor) == nameLength && strncmp(cursor, name, nameLength) == 0) {
+            if (value) *value = equals ? urlDecode(equals + 1, pairEnd) : String();
+            return true;
+        }
+        cursor = pairEnd + 1;
+    }
+    return false;
+}
+
+String HttpServer::urlDecode(const char* begin, const char* end) {
+    String decoded;
+    decoded.reserve(end - begin);
+    for (const char* p = begin; p < end; p++) {
+        if (*p == '+') {
+            decoded += ' ';
+        } else if (*p == '%' && end - p > 2 && isxdigit(p[1]) && isxdigit(p[2])) {
+            char hex[3] = {p[1], p[2], '\0'};
+            decoded += static_cast<char>(strtol(hex, nullptr, 16));
+            p += 2;
+        } else {
+            decoded += *p;
+        }
+    }
+    return decoded;
+}
+
+HTTPMethod HttpServer::parseMethod(const char* name, size_t length) {
+    static const struct {
+        const char* name;
+        HTTPMethod method;
+    } methods[] = {
+        {"GET", HTTP_GET},
+        {"POST", HTTP_POST},
+        {"PUT", HTTP_PUT},
+        {"PATCH", HTTP_PATCH},
+        {"DELETE", HTTP_DELETE},
+        {"OPTIONS", HTTP_OPTIONS},
+        {"HEAD", HTTP_HEAD},
+    };
+    for (const auto& entry : methods) {
+        if (strlen(entry.name) == length && strncmp(entry.name, name, length) == 0) {
+            return entry.method;
+        }
+    }
+    return HTTP_ANY;
+}
+
+const char* HttpServer::statusText(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 426: return "Upgrade Required";
+        case 429: return "Too Many Requests";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        case 504: return "Gateway Timeout";
+        default: return "";
+    }
+}
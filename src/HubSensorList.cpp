@@ -0,0 +1,121 @@
+// HubSensorList.cpp
+#include "HubSensorList.h"
+
+namespace {
+
+// Read side of a message that is already in memory
+class PayloadStream : public Stream {
+public:
+    PayloadStream(const uint8_t* data, size_t length) : data(data), length(length), position(0) {
+        // Nothing more will arrive once the message runs out
+        setTimeout(0);
+    }
+
+    int available() override { return static_cast<int>(length - position); }
+    int read() override { return position < length ? data[position++] : -1; }
+    int peek() override { return position < length ? data[position] : -1; }
+    size_t write(uint8_t) override { return 0; }
+
+private:
+    const uint8_t* data;
+    size_t length;
+    size_t position;
+};
+
+}
+
+bool HubSensorList::read(Stream& stream, const Visitor& visit) {
+    StaticJsonDocument<JSON_OBJECT_SIZE(4)> filter;
+    setFilter(filter.to<JsonObject>());
+
+    if (!stream.find('[')) {
+        Serial.println("Sensor response is not a JSON array");
+        return false;
+    }
+
+    // Elements are parsed one at a time into the same document; the whole body
+    // is consumed so the pooled connection stays usable for the next request
+    StaticJsonDocument<SENSOR_CAPACITY> element;
+    size_t count = 0;
+    while (true) {
+        DeserializationError error = deserializeJson(element, stream, DeserializationOption::Filter(filter));
+        if (error) {
+            if (count == 0 && error == DeserializationError::InvalidInput) {
+                return true;  // Empty list
+            }
+            Serial.printf("Failed to parse sensor %u: %s\n", count, error.c_str());
+            return false;
+        }
+        count++;
+
+        Sensor sensor;
+        if (toSensor(element.as<JsonObjectConst>(), sensor)) {
+            visit(sensor);
+        }
+
+        int separator = readSeparator(stream);
+        if (separator == ']') return true;
+        if (separator != ',') {
+            Serial.println("Malformed sensor list");
+            return false;
+        }
+    }
+}
+
+bool HubSensorList::parse(const uint8_t* data, size_t length, const Visitor& visit) {
+    size_t start = 0;
+    while (start < length && isspace(data[start])) start++;
+    if (start < length && data[start] == '[') {
+        PayloadStream stream(data, length);
+        return read(stream, visit);
+    }
+
+    StaticJsonDocument<JSON_OBJECT_SIZE(4)> filter;
+    setFilter(filter.to<JsonObject>());
+
+    StaticJsonDocument<SENSOR_CAPACITY> element;
+    DeserializationError error = deserializeJson(element, reinterpret_cast<const char*>(data), length,
+                                                 DeserializationOption::Filter(filter));
+    if (error) {
+        Serial.printf("Failed to parse hub sensor message: %s\n", error.c_str());
+        return false;
+    }
+
+    Sensor sensor;
+    if (toSensor(element.as<JsonObjectConst>(), sensor)) {
+        visit(sensor);
+    }
+    return true;
+}
+
+void HubSensorList::setFilter(JsonObject filter) {
+    filter["id"] = true;
+    filter["temperature"] = true;
+    filter["isBabelSensor"] = true;
+    filter["babelTemperature"] = true;
+}
+
+bool HubSensorList::toSensor(JsonObjectConst fields, Sensor& sensor) {
+    sensor.isBabel = fields["isBabelSensor"].as<bool>();
+    JsonVariantConst value = fields[sensor.isBabel ? "babelTemperature" : "temperature"];
+    if (value.isNull()) return false;
+    sensor.value = value.as<float>();
+
+    JsonVariantConst id = fields["id"];
+    if (id.is<const char*>()) {
+        strlcpy(sensor.id, id.as<const char*>(), sizeof(sensor.id));
+    } else if (id.is<long>()) {
+        snprintf(sensor.id, sizeof(sensor.id), "%ld", id.as<long>());
+    } else {
+        sensor.id[0] = '\0';
+    }
+    return true;
+}
+
+int HubSensorList::readSeparator(Stream& stream) {
+    char c;
+    while (stream.readBytes(&c, 1) == 1) {
+        if (!isspace(static_cast<unsigned char>(c))) return c;
+    }
+    return -1;
+}
@@ -0,0 +1,226 @@
+// JsonStreamWriter.cpp
+#include "JsonStreamWriter.h"
+#include <math.h>
+#include <stdarg.h>
+
+JsonStreamWriter::JsonStreamWriter(ResponseStream* stream, int code)
+    : _stream(stream)
+    , _length(0)
+    , _hasItems(0)
+    , _depth(0)
+    , _afterKey(false)
+    , _ended(false)
+    , _failed(false) {
+    if (_stream) _stream->beginChunked(code, "application/json");
+}
+
+JsonStreamWriter::~JsonStreamWriter() {
+    end();
+}
+
+JsonStreamWriter& JsonStreamWriter::beginObject(const char* key) {
+    if (key) this->key(key);
+    open('{');
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::endObject() {
+    close('}');
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::beginArray(const char* key) {
+    if (key) this->key(key);
+    open('[');
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::endArray() {
+    close(']');
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::key(const char* name) {
+    separate();
+    writeString(name);
+    put(':');
+    _afterKey = true;
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::value(const char* text) {
+    if (!text) return null();
+    separate();
+    writeString(text);
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::value(bool flag) {
+    separate();
+    if (flag) {
+        put("true", 4);
+    } else {
+        put("false", 5);
+    }
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::value(int number) {
+    return value(static_cast<long>(number));
+}
+
+JsonStreamWriter& JsonStreamWriter::value(unsigned number) {
+    return value(static_cast<unsigned long>(number));
+}
+
+JsonStreamWriter& JsonStreamWriter::value(long number) {
+    separate();
+    writeNumber("%ld", number);
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::value(unsigned long number) {
+    separate();
+    writeNumber("%lu", number);
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::value(double number) {
+    if (!isfinite(number)) return null();
+    separate();
+    writeNumber("%g", number);
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::null() {
+    separate();
+    put("null", 4);
+    return *this;
+}
+
+void JsonStreamWriter::end() {
+    if (_ended) return;
+    _ended = true;
+    flush();
+    if (_stream) _stream->endChunked();
+}
+
+void JsonStreamWriter::separate() {
+    if (_afterKey) {
+        _afterKey = false;
+        return;
+    }
+    uint32_t bit = 1UL << (_depth % MAX_DEPTH);
+    if (_hasItems & bit) put(',');
+    _hasItems |= bit;
+}
+
+void JsonStreamWriter::open(char bracket) {
+    separate();
+    put(bracket);
+    _depth++;
+    _hasItems &= ~(1UL << (_depth % MAX_DEPTH));
+}
+
+void JsonStreamWriter::close(char bracket) {
+    if (_depth > 0) _depth--;
+    put(bracket);
+}
+
+void JsonStreamWriter::writeString(const char* text) {
+    put('"');
+
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(text);
+    while (*p) {
+        size_t sequence = utf8SequenceLength(p);
+        if (sequence == 0) {
+            // Raw bytes (SSIDs, say) that aren't UTF-8 become U+FFFD
+            put("\\ufffd", 6);
+            p++;
+            continue;
+        }
+
+        if (*p == '"' || *p == '\\') {
+            put('\\');
+            put(static_cast<char>(*p));
+        } else if (*p < 0x20 || *p == 0x7F) {
+            switch (*p) {
+                case '\b': put("\\b", 2); break;
+                case '\f': put("\\f", 2); break;
+                case '\n': put("\\n", 2); break;
+                case '\r': put("\\r", 2); break;
+                case '\t': put("\\t", 2); break;
+                default: writeNumber("\\u%04x", *p); break;
+            }
+        } else {
+            put(reinterpret_cast<const char*>(p), sequence);
+        }
+        p += sequence;
+    }
+
+    put('"');
+}
+
+void JsonStreamWriter::writeNumber(const char* format, ...) {
+    char text[24];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (length > 0) put(text, static_cast<size_t>(length) < sizeof(text) ? length : sizeof(text) - 1);
+}
+
+void JsonStreamWriter::put(const char* data, size_t length) {
+    if (_failed) return;
+    while (length > 0) {
+        if (_length == BUFFER_SIZE) flush();
+        size_t space = BUFFER_SIZE - _length;
+        size_t count = length < space ? length : space;
+        memcpy(_buffer + _length, data, count);
+        _length += count;
+        data += count;
+        length -= count;
+    }
+}
+
+void JsonStreamWriter::put(char c) {
+    if (_failed) return;
+    if (_length == BUFFER_SIZE) flush();
+    _buffer[_length++] = c;
+}
+
+void JsonStreamWriter::flush() {
+    if (_length > 0 && !_failed && _stream && !_stream->sendChunk(_buffer, _length)) {
+        _failed = true;
+    }
+    _length = 0;
+}
+
+size_t JsonStreamWriter::utf8SequenceLength(const uint8_t* p) {
+    if (p[0] < 0x80) return 1;
+
+    // Lead byte ranges and second-byte limits per RFC 3629, which rule out
+    // overlong forms, surrogates and code points above U+10FFFF
+    size_t length;
+    uint8_t low = 0x80;
+    uint8_t high = 0xBF;
+    if (p[0] >= 0xC2 && p[0] <= 0xDF) {
+        length = 2;
+    } else if (p[0] >= 0xE0 && p[0] <= 0xEF) {
+        length = 3;
+        if (p[0] == 0xE0) low = 0xA0;
+        if (p[0] == 0xED) high = 0x9F;
+    } else if (p[0] >= 0xF0 && p[0] <= 0xF4) {
+        length = 4;
+        if (p[0] == 0xF0) low = 0x90;
+        if (p[0] == 0xF4) high = 0x8F;
+    } else {
+        return 0;
+    }
+
+    if (p[1] < low || p[1] > high) return 0;
+    for (size_t i = 2; i < length; i++) {
+        if ((p[i] & 0xC0) != 0x80) return 0;
+    }
+    return length;
+}
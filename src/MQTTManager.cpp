@@ -1,22 +1,39 @@
 // MQTTManager.cpp
 #include "MQTTManager.h"
 #include "config.h"
-#include "RelayControlHandler.h"  // Add this include for RelayState enum
+#include "HomeAssistantDiscovery.h"
+#include "StreamedPublish.h"
+
+// Bucket upper bounds in milliseconds; TLS handshakes run far longer than
+// a broker round trip, hence the separate scales
+const uint32_t MQTTManager::HANDSHAKE_BOUNDS_MS[8] = {250, 500, 1000, 2000, 4000, 8000, 15000, 30000};
+const uint32_t MQTTManager::RTT_BOUNDS_MS[8] = {10, 25, 50, 100, 250, 500, 1000, 5000};
 
 MQTTManager::MQTTManager() 
     : wifiClient()
     , mqttClient(wifiClient)
     , lastReconnectAttempt(0)
     , lastPublishTime(0)
-    , currentReconnectDelay(INITIAL_RECONNECT_DELAY) {
+    , currentReconnectDelay(INITIAL_RECONNECT_DELAY)
+    , counters(Metrics::getInstance().mqtt)
+    , wasConnected(false)
+    , handshakeMs(HANDSHAKE_BOUNDS_MS)
+    , rttMs(RTT_BOUNDS_MS) {
+    memset(&telemetry, 0, sizeof(telemetry));
     setupSecureClient();
+    mqttClient.setCallback([this](char* topic, byte* payload, unsigned int length) {
+        this->handleCallback(topic, payload, length);
+    });
 }
 
 void MQTTManager::begin() {
     wifiClient.setCACert(letsencrypt_root_ca);
     wifiClient.setHandshakeTimeout(15000);
     
-    mqttClient.setBufferSize(8192);
+    uint32_t heapBefore = ESP.getFreeHeap();
+    mqttClient.setBufferSize(BUFFER_SIZE);
+    Serial.printf("MQTT: Packet buffer %u bytes, free heap %u -> %u\n",
+                 BUFFER_SIZE, heapBefore, ESP.getFreeHeap());
     mqttClient.setServer(MQTT_BROKER, MQTT_PORT);
     mqttClient.setSocketTimeout(15);
     mqttClient.setKeepAlive(60);
@@ -27,9 +44,21 @@ void MQTTManager::begin() {
     
     Serial.printf("MQTT: Configured for broker %s:%d with client ID %s\n", 
                  MQTT_BROKER, MQTT_PORT, clientId.c_str());
+
+    route(MQTT_TOPIC_LOOPBACK, [this](const char* topic, MQTTPayload payload) {
+        this->handleLoopback(topic, payload);
+    });
 }
 
 bool MQTTManager::maintainConnection() {
+    if (wasConnected && !connected()) {
+        counters.disconnects.add();
+        telemetry.lastFailureState = mqttClient.state();
+        logState("connection lost");
+    }
+    wasConnected = connected();
+    counters.connected.set(wasConnected);
+
     if (!connected()) {
         unsigned long now = millis();
         if (now - lastReconnectAttempt >= RECONNECT_INTERVAL) {
@@ -39,6 +68,7 @@ bool MQTTManager::maintainConnection() {
             delay(100);
             
             if (connect()) {
+                counters.connected.set(1);
                 currentReconnectDelay = INITIAL_RECONNECT_DELAY;
                 return true;
             } else {
@@ -50,6 +80,7 @@ bool MQTTManager::maintainConnection() {
     }
     
     mqttClient.loop();
+    updateTelemetry();
     return true;
 }
 
@@ -68,6 +99,12 @@ bool MQTTManager::publish(const char* topic, const char* payload, bool retained)
         delay(50);
     }
 
+    // Anything that would not fit the resident buffer goes out streamed
+    size_t payloadLength = strlen(payload);
+    if (payloadLength + strlen(topic) + 7 > BUFFER_SIZE) {
+        return publishLarge(topic, reinterpret_cast<const uint8_t*>(payload), payloadLength, retained);
+    }
+
     const int maxRetries = 3;
     for (int retry = 0; retry < maxRetries; retry++) {
         if (retry > 0) {
@@ -76,6 +113,8 @@ bool MQTTManager::publish(const char* topic, const char* payload, bool retained)
 
         if (mqttClient.publish(topic, payload, retained)) {
             lastPublishTime = millis();
+            counters.messagesOut.add();
+            counters.bytesOut.add(strlen(topic) + payloadLength);
             return true;
         }
         
@@ -85,35 +124,74 @@ bool MQTTManager::publish(const char* topic, const char* payload, bool retained)
     return false;
 }
 
+bool MQTTManager::publishStream(const char* topic, size_t length, PayloadWriter writer, bool retained) {
+    if (!connected()) {
+        Serial.println("MQTT: Cannot publish - not connected");
+        return false;
+    }
+
+    if (!streamPublish<STREAM_CHUNK_SIZE>(mqttClient, wifiClient, topic, length, writer, retained)) {
+        return false;
+    }
+
+    lastPublishTime = millis();
+    counters.messagesOut.add();
+    counters.bytesOut.add(strlen(topic) + length);
+    return true;
+}
+
+bool MQTTManager::publishLarge(const char* topic, const uint8_t* payload, size_t length, bool retained) {
+    return publishStream(topic, length, [payload, length](Print& out) {
+        return out.write(payload, length) == length;
+    }, retained);
+}
+
+bool MQTTManager::publishJson(const char* topic, const JsonDocument& doc, bool retained) {
+    size_t length = measureJson(doc);
+    return publishStream(topic, length, [&doc](Print& out) {
+        serializeJson(doc, out);
+        return true;
+    }, retained);
+}
+
 bool MQTTManager::connect() {
+    unsigned long handshakeStart = millis();
     if (!wifiClient.connect(MQTT_BROKER, MQTT_PORT)) {
         Serial.println("MQTT: SSL connection failed");
+        counters.connectFailures.add();
         return false;
     }
     
-    String statusTopic = String(MQTT_TOPIC_AUX_DISPLAY) + "/status";
-    
     if (mqttClient.connect(clientId.c_str(), 
                           MQTT_USER, 
                           MQTT_PASSWORD,
-                          statusTopic.c_str(),
+                          MQTT_TOPIC_AVAILABILITY,
                           1,
                           true,
                           "offline")) {
-        // Subscribe to relay command topic
-        mqttClient.subscribe("relay/command", 1);
-        
-        // Set up callback
-        mqttClient.setCallback([this](char* topic, byte* payload, unsigned int length) {
-            this->handleCallback(topic, payload, length);
-        });
+        handshakeMs.record(millis() - handshakeStart);
+        counters.connects.add();
+        if (counters.connects.get() > 1) {
+            counters.reconnects.add();
+        }
+        telemetry.pingPending = false;
+
+        // Subscribe to every routed topic filter
+        for (size_t i = 0; i < router.routeCount(); i++) {
+            mqttClient.subscribe(router.filter(i), MQTT_QOS);
+        }
         
         Serial.println("MQTT: Connected successfully");
-        mqttClient.publish(statusTopic.c_str(), "online", true);
+        mqttClient.publish(MQTT_TOPIC_AVAILABILITY, "online", true);
+
+        // No-op unless the firmware or topic configuration changed
+        HomeAssistantDiscovery::publish(*this, clientId);
         return true;
     }
     
-    Serial.printf("MQTT: Connection failed, rc=%d\n", mqttClient.state());
+    counters.connectFailures.add();
+    telemetry.lastFailureState = mqttClient.state();
+    logState("connect failed");
     return false;
 }
 
@@ -125,71 +203,116 @@ bool MQTTManager::subscribe(const char* topic) {
     return mqttClient.subscribe(topic, 1);
 }
 
-void MQTTManager::setCallback(std::function<void(char*, uint8_t*, unsigned int)> callback) {
-    mqttClient.setCallback(callback);
+bool MQTTManager::route(const char* filter, MQTTRouter::Handler handler) {
+    if (!router.add(filter, handler)) {
+        return false;
+    }
+    if (mqttClient.connected()) {
+        mqttClient.subscribe(filter, MQTT_QOS);
+    }
+    return true;
 }
 
 void MQTTManager::setupSecureClient() {
     wifiClient.setCACert(letsencrypt_root_ca);
 }
 
+const char* MQTTManager::stateToString(int state) {
+    switch(state) {
+        case -4: return "TIMEOUT";
+        case -3: return "LOST";
+        case -2: return "FAILED";
+        case -1: return "DISCONNECTED";
+        case 0: return "CONNECTED";
+        case 1: return "BAD_PROTOCOL";
+        case 2: return "BAD_CLIENT_ID";
+        case 3: return "UNAVAILABLE";
+        case 4: return "BAD_CREDENTIALS";
+        case 5: return "UNAUTHORIZED";
+        default: return "UNKNOWN";
+    }
+}
+
 void MQTTManager::logState(const char* context) {
-    const char* stateStr;
-    switch(mqttClient.state()) {
-        case -4: stateStr = "TIMEOUT"; break;
-        case -3: stateStr = "LOST"; break;
-        case -2: stateStr = "FAILED"; break;
-        case -1: stateStr = "DISCONNECTED"; break;
-        case 0: stateStr = "CONNECTED"; break;
-        case 1: stateStr = "BAD_PROTOCOL"; break;
-        case 2: stateStr = "BAD_CLIENT_ID"; break;
-        case 3: stateStr = "UNAVAILABLE"; break;
-        case 4: stateStr = "BAD_CREDENTIALS"; break;
-        case 5: stateStr = "UNAUTHORIZED"; break;
-        default: stateStr = "UNKNOWN"; break;
-    }
-    Serial.printf("MQTT State [%s]: %s (%d)\n", context, stateStr, mqttClient.state());
-}
-
-// callback handling:
-void MQTTManager::handleMessage(char* topic, byte* payload, unsigned int length) {
-    String message((char*)payload, length);
-    
-    // Parse JSON message
-    StaticJsonDocument<200> doc;
-    DeserializationError error = deserializeJson(doc, message);
-    
-    if (error) {
-        Serial.print(F("JSON parsing failed: "));
-        Serial.println(error.c_str());
-        return;
+    int state = mqttClient.state();
+    Serial.printf("MQTT State [%s]: %s (%d)\n", context, stateToString(state), state);
+}
+
+void MQTTManager::updateTelemetry() {
+    unsigned long now = millis();
+
+    if (now - telemetry.lastPing >= PING_INTERVAL) {
+        if (telemetry.pingPending) {
+            counters.pingsLost.add();
+        }
+        char payload[12];
+        snprintf(payload, sizeof(payload), "%u", ++telemetry.pingSequence);
+        telemetry.pingSentAt = now;
+        telemetry.lastPing = now;
+        telemetry.pingPending = mqttClient.publish(MQTT_TOPIC_LOOPBACK, payload, false);
+        if (telemetry.pingPending) {
+            counters.pingsSent.add();
+        }
     }
-    
-    // Check if we have the required fields
-    if (!doc.containsKey("relay_id") || !doc.containsKey("state")) {
-        Serial.println(F("Missing required fields in MQTT message"));
-        return;
+
+    if (now - telemetry.lastMetricsPublish >= METRICS_INTERVAL) {
+        telemetry.lastMetricsPublish = now;
+        publishMetrics();
     }
-    
-    uint8_t relayId = doc["relay_id"].as<uint8_t>();
-    const char* stateStr = doc["state"].as<const char*>();
-    
-    RelayState state = (strcmp(stateStr, "ON") == 0) ? RelayState::ON : RelayState::OFF;
-    
-    // Forward command to relay handler
-    RelayControlHandler::getInstance().processCommand(relayId, state, RelayCommandSource::MQTT);
 }
 
-void MQTTManager::handleCallback(char* topic, byte* payload, unsigned int length) {
-    // Convert payload to string
-    String payloadStr;
-    payloadStr.reserve(length);
-    for(unsigned int i = 0; i < length; i++) {
-        payloadStr += (char)payload[i];
+void MQTTManager::handleLoopback(const char* topic, MQTTPayload payload) {
+    char buffer[12];
+    size_t n = min((size_t)payload.length, sizeof(buffer) - 1);
+    memcpy(buffer, payload.data, n);
+    buffer[n] = '\0';
+
+    if (telemetry.pingPending && strtoul(buffer, nullptr, 10) == telemetry.pingSequence) {
+        rttMs.record(millis() - telemetry.pingSentAt);
+        telemetry.pingPending = false;
     }
-    
-    // Call user callback if set
-    if (userCallback) {
-        userCallback(String(topic), payloadStr);
+}
+
+bool MQTTManager::publishMetrics() {
+    StaticJsonDocument<768> doc;
+    doc["up"] = millis() / 1000;
+    doc["lf"] = telemetry.lastFailureState;
+    doc["con"] = counters.connects.get();
+    doc["rc"] = counters.reconnects.get();
+    doc["cf"] = counters.connectFailures.get();
+    doc["dc"] = counters.disconnects.get();
+    doc["mi"] = counters.messagesIn.get();
+    doc["mo"] = counters.messagesOut.get();
+    doc["bi"] = counters.bytesIn.get();
+    doc["bo"] = counters.bytesOut.get();
+    doc["q"] = queueDepthProbe ? queueDepthProbe() : 0;
+    doc["ps"] = counters.pingsSent.get();
+    doc["pl"] = counters.pingsLost.get();
+
+    // Histograms: count, p50, p95, max, then raw bucket counts
+    auto addHistogram = [&doc](const char* key, const FixedHistogram<8>& histogram) {
+        JsonObject h = doc.createNestedObject(key);
+        h["n"] = histogram.count();
+        h["p50"] = histogram.percentile(50);
+        h["p95"] = histogram.percentile(95);
+        h["max"] = histogram.getMax();
+        JsonArray buckets = h.createNestedArray("b");
+        for (size_t i = 0; i < histogram.bucketCount(); i++) {
+            buckets.add(histogram.bucket(i));
+        }
+    };
+    addHistogram("hs", handshakeMs);
+    addHistogram("rtt", rttMs);
+
+    return publishJson(MQTT_TOPIC_METRICS, doc, false);
+}
+
+void MQTTManager::handleCallback(char* topic, byte* payload, unsigned int length) {
+    counters.messagesIn.add();
+    counters.bytesIn.add(strlen(topic) + length);
+
+    // Hand handlers a view over PubSubClient's buffer; nothing is copied
+    if (router.dispatch(topic, MQTTPayload{payload, length}) == 0) {
+        Serial.printf("MQTT: No route for topic %s\n", topic);
     }
 }
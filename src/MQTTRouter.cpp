@@ -0,0 +1,143 @@
+// MQTTRouter.cpp
+#include "MQTTRouter.h"
+
+MQTTRouter::MQTTRouter() : _nodeCount(1), _routeCount(0) {
+    // Node 0 is the root; it has no segment of its own
+    _nodes[0] = {"", 0, NONE, NONE, NONE};
+}
+
+bool MQTTRouter::add(const char* filter, Handler handler) {
+    if (!filter || !handler) return false;
+
+    size_t filterLength = strlen(filter);
+    if (filterLength == 0 || filterLength >= MAX_FILTER_LENGTH) {
+        Serial.printf("MQTT Router: Invalid filter length for '%s'\n", filter ? filter : "");
+        return false;
+    }
+    if (_routeCount >= MAX_ROUTES) {
+        Serial.printf("MQTT Router: Route table full, dropping '%s'\n", filter);
+        return false;
+    }
+
+    // Check the whole filter and count the nodes it needs before touching
+    // the trie, so a rejected filter leaves nothing behind
+    size_t missing = 0;
+    int8_t node = 0;
+    for (const char* level = filter; level;) {
+        size_t length;
+        const char* next = nextLevel(level, &length);
+
+        bool wildcard = memchr(level, '+', length) || memchr(level, '#', length);
+        if (wildcard && length != 1) {
+            Serial.printf("MQTT Router: Wildcard must fill a whole level in '%s'\n", filter);
+            return false;
+        }
+        if (level[0] == '#' && next) {
+            Serial.printf("MQTT Router: '#' must be the last level in '%s'\n", filter);
+            return false;
+        }
+
+        if (node != NONE) node = findChild(node, level, length);
+        if (node == NONE) missing++;
+        level = next;
+    }
+
+    if (node != NONE && _nodes[node].route != NONE) {
+        Serial.printf("MQTT Router: Filter '%s' already registered\n", filter);
+        return false;
+    }
+    if (_nodeCount + missing > MAX_NODES) {
+        Serial.printf("MQTT Router: Node pool exhausted adding '%s'\n", filter);
+        return false;
+    }
+
+    // Segments point into the route's own copy of the filter, so the trie
+    // never references caller-owned memory
+    Route& route = _routes[_routeCount];
+    memcpy(route.filter, filter, filterLength + 1);
+
+    node = 0;
+    for (const char* level = route.filter; level;) {
+        size_t length;
+        const char* next = nextLevel(level, &length);
+        int8_t child = findChild(node, level, length);
+        node = child != NONE ? child : addChild(node, level, length);
+        level = next;
+    }
+
+    route.handler = handler;
+    _nodes[node].route = _routeCount;
+    _routeCount++;
+    return true;
+}
+
+const char* MQTTRouter::filter(size_t index) const {
+    return index < _routeCount ? _routes[index].filter : nullptr;
+}
+
+int8_t MQTTRouter::findChild(int8_t parent, const char* segment, size_t length) const {
+    for (int8_t child = _nodes[parent].firstChild; child != NONE; child = _nodes[child].nextSibling) {
+        if (_nodes[child].length == length && memcmp(_nodes[child].segment, segment, length) == 0) {
+            return child;
+        }
+    }
+    return NONE;
+}
+
+int8_t MQTTRouter::addChild(int8_t parent, const char* segment, size_t length) {
+    int8_t index = _nodeCount++;
+    _nodes[index] = {segment, static_cast<uint8_t>(length), NONE, _nodes[parent].firstChild, NONE};
+    _nodes[parent].firstChild = index;
+    return index;
+}
+
+const char* MQTTRouter::nextLevel(const char* level, size_t* length) {
+    const char* slash = strchr(level, '/');
+    *length = slash ? (size_t)(slash - level) : strlen(level);
+    return slash ? slash + 1 : nullptr;
+}
+
+size_t MQTTRouter::dispatch(const char* topic, MQTTPayload payload) const {
+    if (!topic) return 0;
+    return match(0, topic, topic, payload);
+}
+
+size_t MQTTRouter::match(int8_t nodeIndex, const char* topic, const char* level, MQTTPayload payload) const {
+    const Node& node = _nodes[nodeIndex];
+    size_t handled = 0;
+
+    if (!level) {
+        // Topic fully consumed: exact match here, and "a/#" also matches "a"
+        handled += invoke(node.route, topic, payload);
+        for (int8_t child = node.firstChild; child != NONE; child = _nodes[child].nextSibling) {
+            if (isWildcard(_nodes[child], '#')) {
+                handled += invoke(_nodes[child].route, topic, payload);
+            }
+        }
+        return handled;
+    }
+
+    size_t length;
+    const char* next = nextLevel(level, &length);
+
+    // Wildcards never match $-prefixed system topics at the first level
+    bool allowWildcard = !(nodeIndex == 0 && level[0] == '$');
+
+    for (int8_t child = node.firstChild; child != NONE; child = _nodes[child].nextSibling) {
+        const Node& candidate = _nodes[child];
+        if (isWildcard(candidate, '#')) {
+            if (allowWildcard) handled += invoke(candidate.route, topic, payload);
+        } else if (isWildcard(candidate, '+')) {
+            if (allowWildcard) handled += match(child, topic, next, payload);
+        } else if (candidate.length == length && memcmp(candidate.segment, level, length) == 0) {
+            handled += match(child, topic, next, payload);
+        }
+    }
+    return handled;
+}
+
+size_t MQTTRouter::invoke(int8_t route, const char* topic, MQTTPayload payload) const {
+    if (route == NONE) return 0;
+    _routes[route].handler(topic, payload);
+    return 1;
+}
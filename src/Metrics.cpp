@@ -0,0 +1,229 @@
+// Metrics.cpp
+#include "Metrics.h"
+#include "ResponseStream.h"
+#include <esp_timer.h>
+#include <stdarg.h>
+
+namespace {
+
+const char CONTENT_TYPE[] = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+// Collects the exposition in a fixed buffer and sends it a chunk at a time.
+// Once the stream refuses a chunk the rest is dropped.
+class MetricsOutput {
+public:
+    explicit MetricsOutput(ResponseStream* stream) : stream(stream), length(0), failed(false) {}
+
+    __attribute__((format(printf, 2, 3))) void printf(const char* format, ...) {
+        if (failed) return;
+        for (int attempt = 0; attempt < 2; attempt++) {
+            va_list args;
+            va_start(args, format);
+            int written = vsnprintf(buffer + length, sizeof(buffer) - length, format, args);
+            va_end(args);
+            if (written < 0) return;
+            if (length + written < sizeof(buffer)) {
+                length += written;
+                return;
+            }
+            // Didn't fit: send what is there and retry on an empty buffer.
+            // A single line longer than the buffer is cut short.
+            if (length == 0) {
+                length = sizeof(buffer) - 1;
+                return;
+            }
+            flush();
+        }
+    }
+
+    void flush() {
+        if (length == 0 || failed) return;
+        failed = !stream->sendChunk(buffer, length);
+        length = 0;
+    }
+
+private:
+    ResponseStream* stream;
+    char buffer[Metrics::RENDER_BUFFER_SIZE];
+    size_t length;
+    bool failed;
+};
+
+// Microseconds as decimal seconds without trailing zeros: 250 -> "0.00025"
+const char* formatSeconds(uint64_t micros, char* out, size_t size) {
+    unsigned long whole = static_cast<unsigned long>(micros / 1000000);
+    unsigned long fraction = static_cast<unsigned long>(micros % 1000000);
+    if (fraction == 0) {
+        snprintf(out, size, "%lu", whole);
+        return out;
+    }
+    int length = snprintf(out, size, "%lu.%06lu", whole, fraction);
+    while (length > 0 && out[length - 1] == '0') out[--length] = '\0';
+    return out;
+}
+
+void family(MetricsOutput& out, const char* name, const char* type, const char* help) {
+    out.printf("# TYPE %s %s\n# HELP %s %s\n", name, type, name, help);
+}
+
+void counter(MetricsOutput& out, const char* name, const char* help, const MetricCounter& metric) {
+    family(out, name, "counter", help);
+    out.printf("%s_total %u\n", name, static_cast<unsigned>(metric.get()));
+}
+
+void gauge(MetricsOutput& out, const char* name, const char* help, const MetricGauge& metric) {
+    family(out, name, "gauge", help);
+    out.printf("%s %u\n", name, static_cast<unsigned>(metric.get()));
+}
+
+// One histogram series; `label` is an optional `key="value",` prefix
+template <size_t N>
+void histogram(MetricsOutput& out, const char* name, const char* label, const MetricHistogram<N>& metric) {
+    char seconds[24];
+    uint32_t cumulative = 0;
+    for (size_t i = 0; i < N; i++) {
+        cumulative += metric.bucket(i);
+        out.printf("%s_bucket{%sle=\"%s\"} %u\n", name, label,
+                   formatSeconds(metric.bound(i), seconds, sizeof(seconds)), static_cast<unsigned>(cumulative));
+    }
+    // The count is taken from the buckets so the two always agree
+    cumulative += metric.bucket(N);
+    out.printf("%s_bucket{%sle=\"+Inf\"} %u\n", name, label, static_cast<unsigned>(cumulative));
+
+    if (*label) {
+        // Drop the trailing comma for the series without an le label
+        int labelLength = static_cast<int>(strlen(label)) - 1;
+        out.printf("%s_count{%.*s} %u\n", name, labelLength, label, static_cast<unsigned>(cumulative));
+        out.printf("%s_sum{%.*s} %s\n", name, labelLength, label, formatSeconds(metric.getSum(), seconds, sizeof(seconds)));
+    } else {
+        out.printf("%s_count %u\n", name, static_cast<unsigned>(cumulative));
+        out.printf("%s_sum %s\n", name, formatSeconds(metric.getSum(), seconds, sizeof(seconds)));
+    }
+}
+
+}
+
+// Bucket upper bounds in microseconds
+const uint32_t Metrics::LOOP_BOUNDS_US[10] = {100, 250, 500, 1000, 2500, 5000, 10000, 50000, 250000, 1000000};
+const uint32_t Metrics::BME280_BOUNDS_US[8] = {1000, 2000, 5000, 10000, 20000, 50000, 100000, 500000};
+const uint32_t Metrics::SENSORHUB_BOUNDS_US[8] = {50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000};
+
+Metrics& Metrics::getInstance() {
+    static Metrics instance;
+    return instance;
+}
+
+Metrics::Metrics()
+    : loopLatency(LOOP_BOUNDS_US)
+    , bme280Read(BME280_BOUNDS_US)
+    , sensorHubRead(SENSORHUB_BOUNDS_US)
+    , taskCount(0)
+    , lastSample(0) {
+    for (TaskEntry& task : tasks) {
+        task.name = nullptr;
+        task.handle.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+bool Metrics::registerTask(const char* name, TaskHandle_t handle) {
+    if (!name || !handle) return false;
+
+    size_t count = taskCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count && i < MAX_TASKS; i++) {
+        if (tasks[i].name && strcmp(tasks[i].name, name) == 0) {
+            tasks[i].handle.store(handle, std::memory_order_release);
+            return true;
+        }
+    }
+
+    size_t slot = taskCount.fetch_add(1, std::memory_order_acq_rel);
+    if (slot >= MAX_TASKS) {
+        taskCount.fetch_sub(1, std::memory_order_acq_rel);
+        Serial.printf("[METRICS] No slot left for task %s\n", name);
+        return false;
+    }
+    // The handle goes in last; readers skip entries whose handle is unset
+    tasks[slot].name = name;
+    tasks[slot].handle.store(handle, std::memory_order_release);
+    return true;
+}
+
+void Metrics::unregisterTask(TaskHandle_t handle) {
+    size_t count = taskCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count && i < MAX_TASKS; i++) {
+        TaskHandle_t expected = handle;
+        if (tasks[i].handle.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) {
+            tasks[i].stackFree.set(0);
+        }
+    }
+}
+
+bool Metrics::sample() {
+    unsigned long now = millis();
+    if (lastSample != 0 && now - lastSample < SAMPLE_INTERVAL) return false;
+    lastSample = now;
+
+    heapFree.set(ESP.getFreeHeap());
+    heapMinimum.set(ESP.getMinFreeHeap());
+    heapLargestBlock.set(ESP.getMaxAllocHeap());
+    uptime.set(static_cast<uint32_t>(esp_timer_get_time() / 1000000));
+
+    size_t count = taskCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count && i < MAX_TASKS; i++) {
+        TaskHandle_t handle = tasks[i].handle.load(std::memory_order_acquire);
+        if (handle) {
+            // In bytes on the ESP32, where stacks are sized in bytes
+            tasks[i].stackFree.set(uxTaskGetStackHighWaterMark(handle));
+        }
+    }
+    return true;
+}
+
+void Metrics::render(ResponseStream* stream) {
+    if (!stream || !stream->beginChunked(200, CONTENT_TYPE)) return;
+    MetricsOutput out(stream);
+
+    gauge(out, "auxdisplay_uptime_seconds", "Time since boot.", uptime);
+    gauge(out, "auxdisplay_heap_free_bytes", "Free heap.", heapFree);
+    gauge(out, "auxdisplay_heap_minimum_free_bytes", "Lowest free heap since boot.", heapMinimum);
+    gauge(out, "auxdisplay_heap_largest_block_bytes", "Largest allocatable heap block.", heapLargestBlock);
+
+    family(out, "auxdisplay_task_stack_free_bytes", "gauge", "Stack never used by the task since it started.");
+    size_t count = taskCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count && i < MAX_TASKS; i++) {
+        if (!tasks[i].handle.load(std::memory_order_acquire)) continue;
+        out.printf("auxdisplay_task_stack_free_bytes{task=\"%s\"} %u\n",
+                   tasks[i].name, static_cast<unsigned>(tasks[i].stackFree.get()));
+    }
+
+    family(out, "auxdisplay_loop_latency_seconds", "histogram", "Main loop iteration time, excluding its idle delay.");
+    histogram(out, "auxdisplay_loop_latency_seconds", "", loopLatency);
+    family(out, "auxdisplay_sensor_read_seconds", "histogram", "Time taken by one sensor reading.");
+    histogram(out, "auxdisplay_sensor_read_seconds", "sensor=\"bme280\",", bme280Read);
+    histogram(out, "auxdisplay_sensor_read_seconds", "sensor=\"sensorhub\",", sensorHubRead);
+
+    gauge(out, "auxdisplay_mqtt_connected", "Whether the broker connection is up.", mqtt.connected);
+    counter(out, "auxdisplay_mqtt_connects", "Successful broker connections.", mqtt.connects);
+    counter(out, "auxdisplay_mqtt_reconnects", "Broker connections after the first.", mqtt.reconnects);
+    counter(out, "auxdisplay_mqtt_connect_failures", "Failed broker connection attempts.", mqtt.connectFailures);
+    counter(out, "auxdisplay_mqtt_disconnects", "Broker connections lost.", mqtt.disconnects);
+    counter(out, "auxdisplay_mqtt_messages_received", "Messages received.", mqtt.messagesIn);
+    counter(out, "auxdisplay_mqtt_messages_sent", "Messages published.", mqtt.messagesOut);
+    counter(out, "auxdisplay_mqtt_received_bytes", "Topic and payload bytes received.", mqtt.bytesIn);
+    counter(out, "auxdisplay_mqtt_sent_bytes", "Topic and payload bytes published.", mqtt.bytesOut);
+    counter(out, "auxdisplay_mqtt_pings_sent", "Loopback pings published.", mqtt.pingsSent);
+    counter(out, "auxdisplay_mqtt_pings_lost", "Loopback pings never echoed back.", mqtt.pingsLost);
+
+    gauge(out, "auxdisplay_http_connections", "Open HTTP connections.", http.connections);
+    counter(out, "auxdisplay_http_requests", "HTTP requests dispatched.", http.requests);
+    counter(out, "auxdisplay_http_rejected_connections", "Connections refused with every slot busy.", http.rejected);
+    family(out, "auxdisplay_http_responses", "counter", "HTTP responses by status class.");
+    for (size_t i = 0; i < 5; i++) {
+        out.printf("auxdisplay_http_responses_total{code=\"%uxx\"} %u\n",
+                   static_cast<unsigned>(i + 1), static_cast<unsigned>(http.responses[i].get()));
+    }
+
+    out.printf("# EOF\n");
+    out.flush();
+    stream->endChunked();
+}
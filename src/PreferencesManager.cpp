@@ -49,26 +49,36 @@ void PreferencesManager::setPreferencesChangedCallback(PreferencesChangedCallbac
     onPreferencesChanged = callback;
 }
 
-void PreferencesManager::saveDisplayPreferences(const DisplayPreferences& prefs) {
+void PreferencesManager::saveDisplayPreferences(const DisplayPreferences& prefs, uint8_t fields) {
     if (!storage || !prefsMutex) {
         Serial.println("Preferences system not initialized");
         return;
     }
 
     if (xSemaphoreTake(prefsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-        storage->putBool("nightMode", prefs.nightModeDimmingEnabled);
+        if (fields & PREF_FIELD_NIGHT_MODE) {
+            storage->putBool("nightMode", prefs.nightModeDimmingEnabled);
+        }
         
         // Store actual 1-75 range values
         uint8_t dayBright = constrain(prefs.dayBrightness, 1, 75);
         uint8_t nightBright = constrain(prefs.nightBrightness, 1, 75);
         
-        storage->putUChar("dayBright", dayBright);
-        storage->putUChar("nightBright", nightBright);
-        storage->putUChar("nightStart", prefs.nightStartHour);
-        storage->putUChar("nightEnd", prefs.nightEndHour);
+        if (fields & PREF_FIELD_DAY_BRIGHT) {
+            storage->putUChar("dayBright", dayBright);
+        }
+        if (fields & PREF_FIELD_NIGHT_BRIGHT) {
+            storage->putUChar("nightBright", nightBright);
+        }
+        if (fields & PREF_FIELD_NIGHT_START) {
+            storage->putUChar("nightStart", prefs.nightStartHour);
+        }
+        if (fields & PREF_FIELD_NIGHT_END) {
+            storage->putUChar("nightEnd", prefs.nightEndHour);
+        }
         
-        Serial.printf("Saving display preferences - Day: %d%%, Night: %d%%\n", 
-                     dayBright, nightBright);
+        Serial.printf("Saving display preferences - Day: %d%%, Night: %d%% (fields 0x%02X)\n", 
+                     dayBright, nightBright, fields);
         
         xSemaphoreGive(prefsMutex);
 
@@ -78,6 +88,26 @@ void PreferencesManager::saveDisplayPreferences(const DisplayPreferences& prefs)
     }
 }
 
+uint32_t PreferencesManager::getConfigVersion() {
+    uint32_t version = 0;
+    if (!storage || !prefsMutex) return version;
+
+    if (xSemaphoreTake(prefsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        version = strtoul(storage->getString("cfgVersion", "0").c_str(), nullptr, 10);
+        xSemaphoreGive(prefsMutex);
+    }
+    return version;
+}
+
+void PreferencesManager::setConfigVersion(uint32_t version) {
+    if (!storage || !prefsMutex) return;
+
+    if (xSemaphoreTake(prefsMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        storage->putString("cfgVersion", String(version).c_str());
+        xSemaphoreGive(prefsMutex);
+    }
+}
+
 DisplayPreferences PreferencesManager::loadDisplayPreferences() {
     DisplayPreferences prefs;
     
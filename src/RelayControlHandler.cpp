@@ -1,20 +1,27 @@
 #include "RelayControlHandler.h"
+#include "Metrics.h"
+#include "MQTTManager.h"
+#include "SensorHubClient.h"
+#include "SensorHubAuth.h"
 
 // Define static members
 RelayControlHandler* RelayControlHandler::instance = nullptr;
 RelayControlHandler* g_relayHandler = nullptr;  // Global instance
 
-RelayControlHandler::RelayControlHandler() {
+RelayControlHandler::RelayControlHandler()
+    : worker(QUEUE_SIZE, [this](const RelayCommand& command) { return setState(command.relayId, command.state); })
+    , workerHandle(nullptr)
+    , stateVersion(0)
+    , stateEpoch(esp_random() & 0xFFFF) {
     // Initialize arrays
     for (uint8_t i = 0; i < NUM_RELAYS; i++) {
         currentState[i] = RelayState::UNKNOWN;
         userOverride[i] = false;
         lastStateChange[i] = 0;
+        unpublishedState[i] = RelayState::UNKNOWN;
     }
     
     relayMutex = xSemaphoreCreateMutex();
-    commandQueue = xQueueCreate(QUEUE_SIZE, sizeof(RelayCommand));
-    tokenExpiry = 0;
 }
 
 RelayControlHandler& RelayControlHandler::getInstance() {
@@ -24,25 +31,62 @@ RelayControlHandler& RelayControlHandler::getInstance() {
 }
 
 bool RelayControlHandler::begin() {
-    if (!relayMutex || !commandQueue) {
+    if (!relayMutex || !worker.isReady()) {
         Serial.println("Failed to create relay synchronization primitives");
         return false;
     }
 
-    // Initial authentication
-    if (!authenticate()) {
-        Serial.println("Initial authentication failed, will retry later");
+    if (!workerHandle) {
+        BaseType_t result = xTaskCreatePinnedToCore(
+            workerTask,
+            "RelayWorker",
+            WORKER_STACK_SIZE,
+            this,
+            WORKER_PRIORITY,
+            &workerHandle,
+            0
+        );
+        if (result != pdPASS) {
+            Serial.println("Failed to create relay worker task");
+            workerHandle = nullptr;
+            return false;
+        }
+        Metrics::getInstance().registerTask("RelayWorker", workerHandle);
     }
 
     return true;
 }
 
-void RelayControlHandler::handleMqttMessage(const String& topic, const String& payload) {
+bool RelayControlHandler::addCompletionListener(CompletionCallback callback) {
+    return worker.addCompletionListener(callback);
+}
+
+void RelayControlHandler::workerTask(void* parameter) {
+    static_cast<RelayControlHandler*>(parameter)->runWorker();
+}
+
+void RelayControlHandler::runWorker() {
+    unsigned long lastPoll = millis() - STATE_POLL_INTERVAL;  // Poll right after boot
+
+    while (true) {
+        // Between commands, keep the state cache fresh for the web UI
+        unsigned long sincePoll = millis() - lastPoll;
+        TickType_t wait = sincePoll >= STATE_POLL_INTERVAL ? 0 : pdMS_TO_TICKS(STATE_POLL_INTERVAL - sincePoll);
+        if (!worker.runOnce(wait)) {
+            refreshStates();
+            lastPoll = millis();
+        }
+    }
+}
+
+void RelayControlHandler::handleMqttMessage(const char* topic, MQTTPayload payload) {
+    // Parsing from a mutable char* puts ArduinoJson in zero-copy mode: strings
+    // stay in the MQTT receive buffer and only the tree lives in the document
     StaticJsonDocument<128> doc;
-    DeserializationError error = deserializeJson(doc, payload);
+    DeserializationError error = deserializeJson(doc, reinterpret_cast<char*>(payload.data), payload.length);
     
     if (error) {
-        Serial.println("Failed to parse MQTT message");
+        Serial.printf("Failed to parse MQTT message: %s\n", error.c_str());
         return;
     }
 
@@ -51,40 +95,93 @@ void RelayControlHandler::handleMqttMessage(const String& topic, const String& p
         return;
     }
 
-    uint8_t relayId = doc["relay_id"].as<uint8_t>();
-    bool stateValue = doc["state"].as<bool>();
-    
-    if (relayId >= NUM_RELAYS) {
-        Serial.println("Invalid relay ID in MQTT message");
+    uint8_t relayId;
+    RelayState newState;
+    if (!parseRelayEntry(doc.as<JsonVariantConst>(), 0, relayId, newState)) {
+        Serial.println("Invalid relay command in MQTT message");
         return;
     }
 
-    RelayState newState = stateValue ? RelayState::ON : RelayState::OFF;
     getInstance().processCommand(relayId, newState, RelayCommandSource::MQTT);
 }
 
+bool RelayControlHandler::parseRelayEntry(JsonVariantConst entry, uint8_t defaultId, uint8_t& relayId, RelayState& state) {
+    if (!entry.containsKey("state")) return false;
+
+    relayId = entry["relay_id"] | defaultId;
+    if (relayId >= NUM_RELAYS) return false;
+
+    // Accept both boolean and "ON"/"OFF" state values
+    JsonVariantConst stateValue = entry["state"];
+    bool on = stateValue.is<const char*>() ? strcmp(stateValue.as<const char*>(), "ON") == 0
+                                           : stateValue.as<bool>();
+    state = on ? RelayState::ON : RelayState::OFF;
+    return true;
+}
+
+void RelayControlHandler::updateCachedState(uint8_t relayId, RelayState state) {
+    if (relayId >= NUM_RELAYS) return;
+
+    if (xSemaphoreTake(relayMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        if (currentState[relayId] != state) {
+            currentState[relayId] = state;
+            lastStateChange[relayId] = millis();
+            stateVersion++;
+        }
+        xSemaphoreGive(relayMutex);
+    }
+}
+
+RelayStatus RelayControlHandler::getRelayStatus(uint8_t relayId) const {
+    RelayStatus status = {RelayState::UNKNOWN, false};
+    if (relayId >= NUM_RELAYS) return status;
+
+    if (xSemaphoreTake(relayMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        status.state = currentState[relayId];
+        status.override = userOverride[relayId];
+        xSemaphoreGive(relayMutex);
+    }
+    return status;
+}
+
+uint32_t RelayControlHandler::getCachedStates(RelayStatus* statuses) const {
+    uint32_t version = 0;
+
+    if (xSemaphoreTake(relayMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        for (uint8_t i = 0; i < NUM_RELAYS; i++) {
+            statuses[i] = {currentState[i], userOverride[i]};
+        }
+        version = stateVersion;
+        xSemaphoreGive(relayMutex);
+    } else {
+        for (uint8_t i = 0; i < NUM_RELAYS; i++) {
+            statuses[i] = {RelayState::UNKNOWN, false};
+        }
+    }
+    return version;
+}
+
+uint32_t RelayControlHandler::getCachedStatesJson(String& response) const {
+    RelayStatus statuses[NUM_RELAYS];
+    uint32_t version = getCachedStates(statuses);
+
+    StaticJsonDocument<256> doc;
+    for (uint8_t i = 0; i < NUM_RELAYS; i++) {
+        JsonObject relay = doc.createNestedObject();
+        relay["relay_id"] = i;
+        relay["state"] = relayStateName(statuses[i].state);
+        relay["override"] = statuses[i].override;
+    }
+    serializeJson(doc, response);
+    return version;
+}
+
 bool RelayControlHandler::setState(uint8_t relayId, RelayState newState) {
     if (relayId >= NUM_RELAYS) {
         Serial.println("[RELAY] Error: Invalid relay ID");
         return false;
     }
 
-    // First ensure we have a valid token
-    if (authToken.isEmpty() || millis() > tokenExpiry) {
-        if (!authenticate()) {
-            Serial.println("[RELAY] Failed to authenticate for relay control");
-            return false;
-        }
-    }
-
-    // Prepare the control request
-    HTTPClient http;
-    String url = String("http://") + SENSORHUB_URL + "/api/relay";
-    
-    http.begin(url);
-    http.addHeader("Authorization", "Bearer " + authToken);
-    http.addHeader("Content-Type", "application/json");
-    
     // Create payload exactly like the shell script
     StaticJsonDocument<128> doc;
     doc["relay_id"] = relayId;
@@ -96,145 +193,134 @@ bool RelayControlHandler::setState(uint8_t relayId, RelayState newState) {
     Serial.printf("[RELAY] Setting relay %d to %s\n", relayId, newState == RelayState::ON ? "ON" : "OFF");
     Serial.printf("[RELAY] Sending payload: %s\n", payload.c_str());
     
-    int httpCode = http.POST(payload);
+    // Runs on the relay worker, so waiting for a token here blocks nobody
+    String response;
+    int httpCode = makeAuthenticatedRequest(SENSORHUB_RELAY_ENDPOINT, "POST", payload.c_str(), &response);
     Serial.printf("[RELAY] HTTP response code: %d\n", httpCode);
 
-    // Handle 401 by re-authenticating once
-    if (httpCode == 401) {
-        Serial.println("[RELAY] Token expired, re-authenticating...");
-        if (authenticate()) {
-            http.addHeader("Authorization", "Bearer " + authToken);
-            httpCode = http.POST(payload);
-            Serial.printf("[RELAY] Retry response code: %d\n", httpCode);
-        }
-    }
-
     bool success = (httpCode == 200);
     
     if (success) {
-        String response = http.getString();
         Serial.printf("[RELAY] Response: %s\n", response.c_str());
         
+        updateCachedState(relayId, newState);
+
+        // Published by loop() on the MQTT task, never from the worker
         if (xSemaphoreTake(relayMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            currentState[relayId] = newState;
-            lastStateChange[relayId] = millis();
+            unpublishedState[relayId] = newState;
             xSemaphoreGive(relayMutex);
         }
     } else {
         Serial.printf("[RELAY] Failed with code %d\n", httpCode);
     }
     
-    http.end();
     return success;
 }
 
-void RelayControlHandler::processCommand(uint8_t relayId, RelayState state, RelayCommandSource source) {
-    Serial.printf("[RELAY] Processing command - Relay %d to %s from %s\n",
+void RelayControlHandler::loop() {
+    // Held until the broker is reachable; the topic is retained, so only
+    // the newest state per relay matters
+    if (!MQTTManager::getInstance().connected()) return;
+
+    for (uint8_t i = 0; i < NUM_RELAYS; i++) {
+        RelayState state = RelayState::UNKNOWN;
+        if (xSemaphoreTake(relayMutex, 0) == pdTRUE) {
+            state = unpublishedState[i];
+            unpublishedState[i] = RelayState::UNKNOWN;
+            xSemaphoreGive(relayMutex);
+        }
+        if (state != RelayState::UNKNOWN) {
+            publishState(i, state);
+        }
+    }
+}
+
+void RelayControlHandler::publishState(uint8_t relayId, RelayState state) {
+    MQTTManager& mqtt = MQTTManager::getInstance();
+
+    char topic[96];
+    snprintf(topic, sizeof(topic), "%s/%d/state", MQTT_TOPIC_RELAY, relayId);
+    mqtt.publish(topic, state == RelayState::ON ? "ON" : "OFF", true);
+}
+
+bool RelayControlHandler::processCommand(uint8_t relayId, RelayState state, RelayCommandSource source, uint32_t tag) {
+    Serial.printf("[RELAY] Queueing command - Relay %d to %s from %s\n",
                  relayId, 
                  state == RelayState::ON ? "ON" : "OFF",
-                 source == RelayCommandSource::USER ? "USER" : "MQTT");
+                 source == RelayCommandSource::USER ? "USER" :
+                 source == RelayCommandSource::MQTT ? "MQTT" : "SCHEDULE");
 
-    // Apply command directly
-    setState(relayId, state);
-}
+    if (relayId >= NUM_RELAYS) {
+        Serial.println("[RELAY] Error: Invalid relay ID");
+        return false;
+    }
 
-bool RelayControlHandler::getRelayStates(String& response) {
-    HTTPClient http;
-    String url = String("http://") + SENSORHUB_URL + "/api/relay";
-    
-    http.begin(url);
-    http.addHeader("Authorization", "Bearer " + authToken);
-    
-    int httpCode = http.GET();
-    
-    if (httpCode == 200) {
-        String rawResponse = http.getString();
-        
-        // Parse and reformat response
-        StaticJsonDocument<256> doc;
-        DeserializationError error = deserializeJson(doc, rawResponse);
-        
-        if (!error) {
-            JsonArray relays = doc.as<JsonArray>();
-            for (JsonVariant relay : relays) {
-                relay["state"] = relay["state"].as<bool>() ? "ON" : "OFF";
-            }
-            serializeJson(doc, response);
-            http.end();
-            return true;
-        }
+    RelayCommand command = {relayId, state, source, millis(), tag};
+    if (!worker.submit(command)) {
+        Serial.println("[RELAY] Command queue full, dropping command");
+        return false;
     }
-    
-    http.end();
-    return false;
+    return true;
 }
 
-// Authentication methods
-bool RelayControlHandler::authenticate() {
-    HTTPClient http;
-    String url = String("http://") + SENSORHUB_URL + "/api/login";
-    
-    http.begin(url);
-    http.addHeader("Content-Type", "application/json");
-    
-    StaticJsonDocument<200> doc;
-    doc["username"] = API_USERNAME;
-    doc["password"] = API_PASSWORD;
-    String payload;
-    serializeJson(doc, payload);
-    
-    int httpCode = http.POST(payload);
-    
-    if (httpCode == 200) {
-        String response = http.getString();
-        StaticJsonDocument<512> responseDoc;
-        DeserializationError error = deserializeJson(responseDoc, response);
-        
-        if (!error && responseDoc.containsKey("token")) {
-            authToken = responseDoc["token"].as<String>();
-            tokenExpiry = millis() + TOKEN_REFRESH_INTERVAL;
-            http.end();
-            return true;
-        }
+bool RelayControlHandler::refreshStates() {
+    String rawResponse;
+    int httpCode = makeAuthenticatedRequest(SENSORHUB_RELAY_ENDPOINT, "GET", nullptr, &rawResponse);
+    if (httpCode != 200) {
+        Serial.printf("[RELAY] State refresh failed with code %d\n", httpCode);
+        return false;
     }
-    
-    http.end();
-    return false;
-}
 
-bool RelayControlHandler::makeAuthenticatedRequest(const char* endpoint, const char* method, const char* payload) {
-    if (authToken.isEmpty() || millis() > tokenExpiry) {
-        if (!authenticate()) {
-            return false;
+    StaticJsonDocument<256> doc;
+    DeserializationError error = deserializeJson(doc, rawResponse);
+    if (error) {
+        Serial.printf("[RELAY] Failed to parse relay states: %s\n", error.c_str());
+        return false;
+    }
+
+    uint8_t index = 0;
+    for (JsonVariantConst entry : doc.as<JsonArrayConst>()) {
+        uint8_t relayId;
+        RelayState state;
+        if (parseRelayEntry(entry, index++, relayId, state)) {
+            updateCachedState(relayId, state);
         }
     }
+    return true;
+}
 
-    HTTPClient http;
-    String url = String("http://") + SENSORHUB_URL + endpoint;
-    
-    http.begin(url);
-    http.addHeader("Authorization", "Bearer " + authToken);
-    http.addHeader("Content-Type", "application/json");
-    
-    int httpCode;
-    if (strcmp(method, "GET") == 0) {
-        httpCode = http.GET();
-    } else if (strcmp(method, "POST") == 0) {
-        httpCode = http.POST(payload);
-    } else {
-        http.end();
-        return false;
+int RelayControlHandler::makeAuthenticatedRequest(const char* endpoint, const char* method, const char* payload,
+                                                  String* response, TickType_t tokenWait) {
+    SensorHubAuth& auth = SensorHubAuth::getInstance();
+
+    bool isGet = strcmp(method, "GET") == 0;
+    if (!isGet && strcmp(method, "POST") != 0) {
+        return HTTPC_ERROR_NOT_CONNECTED;
     }
-    
-    if (httpCode == 401) {
-        // Token expired, retry once
-        authToken = "";
-        if (authenticate()) {
-            http.addHeader("Authorization", "Bearer " + authToken);
-            httpCode = (strcmp(method, "GET") == 0) ? http.GET() : http.POST(payload);
+
+    int httpCode = HTTPC_ERROR_NOT_CONNECTED;
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        if (!auth.waitForToken(tokenWait)) {
+            Serial.println("[RELAY] No sensorHUB token available");
+            break;
+        }
+        String token = auth.getToken();
+
+        {
+            SensorHubClient::Request request(endpoint);
+            request.addHeader("Authorization", "Bearer " + token);
+            request.addHeader("Content-Type", "application/json");
+            httpCode = isGet ? request.GET() : request.POST(payload ? payload : "");
+            if (httpCode == 200 && response) {
+                *response = request.getString();
+            }
         }
+        
+        // Token rejected: hand it back to the token service and retry once
+        // with whatever it fetches next
+        if (httpCode != 401 || attempt > 0) break;
+        auth.invalidate(token);
     }
     
-    http.end();
-    return httpCode == 200;
-}
\ No newline at end of file
+    return httpCode;
+}
@@ -0,0 +1,281 @@
+// RelayScheduler.cpp
+#include "RelayScheduler.h"
+#include "GlobalState.h"
+#include "Metrics.h"
+#include <SPIFFS.h>
+
+const char* RelayScheduler::STORAGE_PATH = "/sched/rules.bin";
+
+static_assert(sizeof(ScheduleRule) == 12, "ScheduleRule is stored on flash as-is");
+
+namespace {
+
+const char* const CONDITION_NAMES[] = {"", "remote_temperature", "temperature", "humidity"};
+constexpr size_t CONDITION_COUNT = sizeof(CONDITION_NAMES) / sizeof(CONDITION_NAMES[0]);
+
+// Parses "HH:MM" into a minute of the day
+bool parseMinute(JsonVariantConst value, uint16_t& minute) {
+    const char* text = value.as<const char*>();
+    int hour, min;
+    if (!text || sscanf(text, "%d:%d", &hour, &min) != 2) return false;
+    if (hour < 0 || hour > 23 || min < 0 || min > 59) return false;
+    minute = hour * 60 + min;
+    return true;
+}
+
+void formatMinute(uint16_t minute, char* buffer, size_t size) {
+    snprintf(buffer, size, "%02u:%02u", minute / 60, minute % 60);
+}
+
+}  // namespace
+
+RelayScheduler& RelayScheduler::getInstance() {
+    static RelayScheduler instance;
+    return instance;
+}
+
+RelayScheduler::RelayScheduler()
+    : engine({readCondition, command})
+    , taskHandle(nullptr) {
+    mutex = xSemaphoreCreateMutex();
+}
+
+bool RelayScheduler::begin() {
+    if (!mutex) {
+        Serial.println("[SCHED] Failed to create scheduler mutex");
+        return false;
+    }
+    if (taskHandle) return true;
+
+    load();
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        schedulerTask,
+        "RelaySched",
+        TASK_STACK_SIZE,
+        this,
+        TASK_PRIORITY,
+        &taskHandle,
+        0
+    );
+    if (result != pdPASS) {
+        Serial.println("[SCHED] Failed to create scheduler task");
+        taskHandle = nullptr;
+        return false;
+    }
+    Metrics::getInstance().registerTask("RelaySched", taskHandle);
+    return true;
+}
+
+void RelayScheduler::schedulerTask(void* parameter) {
+    static_cast<RelayScheduler*>(parameter)->runScheduler();
+}
+
+void RelayScheduler::runScheduler() {
+    while (true) {
+        struct tm now;
+        if (!getLocalTime(&now, 0)) {
+            // No wall clock until NTP syncs
+            vTaskDelay(pdMS_TO_TICKS(10000));
+            continue;
+        }
+
+        tick(now);
+
+        // Sleep to the top of the next minute
+        vTaskDelay(pdMS_TO_TICKS((60 - now.tm_sec) * 1000UL));
+    }
+}
+
+void RelayScheduler::tick(const struct tm& now) {
+    uint16_t minute = now.tm_wday * MINUTES_PER_DAY + now.tm_hour * 60 + now.tm_min;
+
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    engine.tick(minute);
+    xSemaphoreGive(mutex);
+}
+
+bool RelayScheduler::readCondition(ScheduleCondition condition, float& value) {
+    GlobalState& state = GlobalState::getInstance();
+    uint32_t readAt;
+
+    switch (condition) {
+        case ScheduleCondition::REMOTE_TEMPERATURE:
+            value = state.getRemoteTemperature();
+            readAt = state.getLastRemoteUpdate();
+            break;
+        case ScheduleCondition::TEMPERATURE:
+            if (!state.isBMEWorking()) return false;
+            value = state.getTemperature();
+            readAt = state.getLastSensorUpdate();
+            break;
+        case ScheduleCondition::HUMIDITY:
+            if (!state.isBMEWorking()) return false;
+            value = state.getHumidity();
+            readAt = state.getLastSensorUpdate();
+            break;
+        default:
+            return false;
+    }
+
+    // Zero means no reading has arrived since boot
+    return readAt != 0 && millis() - readAt < READING_STALE_AFTER;
+}
+
+void RelayScheduler::command(uint8_t relayId, RelayState state) {
+    Serial.printf("[SCHED] Relay %d -> %s\n", relayId, state == RelayState::ON ? "ON" : "OFF");
+    if (!RelayControlHandler::getInstance().processCommand(relayId, state, RelayCommandSource::SCHEDULE)) {
+        Serial.println("[SCHED] Relay command queue full, command dropped");
+    }
+}
+
+bool RelayScheduler::isValid(const ScheduleRule& rule) {
+    if (rule.relayId >= NUM_RELAYS) return false;
+    if (rule.action != static_cast<uint8_t>(RelayState::ON) &&
+        rule.action != static_cast<uint8_t>(RelayState::OFF)) return false;
+    if (rule.days & ~ALL_DAYS) return false;
+    if (rule.startMinute >= MINUTES_PER_DAY || rule.endMinute >= MINUTES_PER_DAY) return false;
+    if (rule.condition >= CONDITION_COUNT) return false;
+    if (rule.condition != static_cast<uint8_t>(ScheduleCondition::NONE) &&
+        rule.comparison != '<' && rule.comparison != '>') return false;
+    return true;
+}
+
+bool RelayScheduler::setRules(const ScheduleRule* newRules, size_t count) {
+    if (count > MAX_RULES) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (!isValid(newRules[i])) return false;
+    }
+
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(1000)) != pdTRUE) return false;
+
+    engine.setRules(newRules, count);
+    bool saved = save(newRules, count);
+
+    xSemaphoreGive(mutex);
+    Serial.printf("[SCHED] %u rule(s) installed\n", count);
+    return saved;
+}
+
+size_t RelayScheduler::getRules(ScheduleRule* out, size_t capacity) {
+    size_t count = 0;
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        count = engine.getRules(out, capacity);
+        xSemaphoreGive(mutex);
+    }
+    return count;
+}
+
+bool RelayScheduler::fromJson(JsonArrayConst array) {
+    if (array.size() > MAX_RULES) return false;
+
+    ScheduleRule parsed[MAX_RULES];
+    size_t count = 0;
+
+    for (JsonObjectConst entry : array) {
+        ScheduleRule rule = {};
+        int relay = entry["relay"] | -1;
+        rule.relayId = relay >= 0 && relay < NUM_RELAYS ? relay : 0xFF;
+        const char* action = entry["action"] | "";
+        rule.action = strcmp(action, "ON") == 0  ? static_cast<uint8_t>(RelayState::ON)
+                    : strcmp(action, "OFF") == 0 ? static_cast<uint8_t>(RelayState::OFF)
+                                                 : 0xFF;
+        int days = entry["days"] | 0x7F;
+        rule.days = days >= 0 && days <= ALL_DAYS ? days : 0xFF;
+
+        if (!parseMinute(entry["start"], rule.startMinute)) return false;
+        rule.endMinute = rule.startMinute;
+        if (entry.containsKey("end") && !parseMinute(entry["end"], rule.endMinute)) return false;
+
+        JsonObjectConst when = entry["when"];
+        if (!when.isNull()) {
+            const char* source = when["source"] | "";
+            rule.condition = 0xFF;
+            for (size_t i = 1; i < CONDITION_COUNT; i++) {
+                if (strcmp(source, CONDITION_NAMES[i]) == 0) rule.condition = i;
+            }
+            const char* op = when["op"] | "";
+            rule.comparison = op[0];
+            rule.threshold = static_cast<int16_t>(lroundf((when["value"] | 0.0f) * 10.0f));
+        }
+
+        if (!isValid(rule)) return false;
+        parsed[count++] = rule;
+    }
+
+    return setRules(parsed, count);
+}
+
+void RelayScheduler::toJson(JsonStreamWriter& json) {
+    ScheduleRule copy[MAX_RULES];
+    size_t count = getRules(copy, MAX_RULES);
+
+    json.beginArray();
+    for (size_t i = 0; i < count; i++) {
+        const ScheduleRule& rule = copy[i];
+        char start[6], end[6];
+        formatMinute(rule.startMinute, start, sizeof(start));
+        formatMinute(rule.endMinute, end, sizeof(end));
+
+        json.beginObject()
+            .field("relay", rule.relayId)
+            .field("action", rule.action == static_cast<uint8_t>(RelayState::ON) ? "ON" : "OFF")
+            .field("days", rule.days)
+            .field("start", start)
+            .field("end", end);
+
+        if (rule.condition != static_cast<uint8_t>(ScheduleCondition::NONE)) {
+            char op[2] = {rule.comparison, '\0'};
+            json.beginObject("when")
+                .field("source", CONDITION_NAMES[rule.condition])
+                .field("op", op)
+                .field("value", rule.threshold / 10.0)
+                .endObject();
+        }
+        json.endObject();
+    }
+    json.endArray();
+}
+
+bool RelayScheduler::load() {
+    File file = SPIFFS.open(STORAGE_PATH, "r");
+    if (!file) return false;
+
+    uint8_t header[4];
+    bool ok = file.read(header, sizeof(header)) == sizeof(header) &&
+              header[0] == 'R' && header[1] == 'S' &&
+              header[2] == STORAGE_VERSION && header[3] <= MAX_RULES;
+
+    ScheduleRule rules[MAX_RULES];
+    size_t count = ok ? header[3] : 0;
+    size_t bytes = count * sizeof(ScheduleRule);
+    ok = ok && file.read(reinterpret_cast<uint8_t*>(rules), bytes) == bytes;
+    file.close();
+
+    for (size_t i = 0; ok && i < count; i++) {
+        ok = isValid(rules[i]);
+    }
+    if (!ok) {
+        Serial.println("[SCHED] Stored schedule is invalid, ignoring it");
+        return false;
+    }
+
+    engine.setRules(rules, count);
+    Serial.printf("[SCHED] Loaded %u rule(s)\n", count);
+    return true;
+}
+
+bool RelayScheduler::save(const ScheduleRule* rules, size_t count) {
+    File file = SPIFFS.open(STORAGE_PATH, "w");
+    if (!file) {
+        Serial.printf("[SCHED] Failed to open %s for writing\n", STORAGE_PATH);
+        return false;
+    }
+
+    uint8_t header[4] = {'R', 'S', STORAGE_VERSION, static_cast<uint8_t>(count)};
+    size_t bytes = count * sizeof(ScheduleRule);
+    bool ok = file.write(header, sizeof(header)) == sizeof(header) &&
+              file.write(reinterpret_cast<const uint8_t*>(rules), bytes) == bytes;
+    file.close();
+    return ok;
+}
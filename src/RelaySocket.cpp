@@ -0,0 +1,320 @@
+// RelaySocket.cpp
+#include "RelaySocket.h"
+#include "HttpServer.h"
+#include <base64.h>
+#include <mbedtls/md.h>
+
+namespace {
+
+enum Opcode : uint8_t {
+    OP_CONTINUATION = 0x0,
+    OP_TEXT = 0x1,
+    OP_BINARY = 0x2,
+    OP_CLOSE = 0x8,
+    OP_PING = 0x9,
+    OP_PONG = 0xA
+};
+
+// Close codes from RFC 6455 section 7.4.1
+constexpr uint16_t CLOSE_NORMAL = 1000;
+constexpr uint16_t CLOSE_PROTOCOL_ERROR = 1002;
+constexpr uint16_t CLOSE_UNSUPPORTED = 1003;
+constexpr uint16_t CLOSE_TOO_BIG = 1009;
+
+constexpr size_t MASK_SIZE = 4;
+
+}
+
+RelaySocket& RelaySocket::getInstance() {
+    static RelaySocket instance;
+    return instance;
+}
+
+RelaySocket::RelaySocket()
+    : server(nullptr)
+    , completions(nullptr)
+    , nextTag(1) {
+    for (Client& client : clients) {
+        client.active = false;
+        client.length = 0;
+    }
+    for (Pending& entry : pending) {
+        entry.used = false;
+    }
+}
+
+bool RelaySocket::begin(const Relays& relayHooks) {
+    if (completions) return true;
+    if (!relayHooks.submit || !relayHooks.state) return false;
+
+    completions = xQueueCreate(COMPLETION_QUEUE_SIZE, sizeof(Completion));
+    if (!completions) {
+        Serial.println("[WS] Failed to create completion queue");
+        return false;
+    }
+    relays = relayHooks;
+    return true;
+}
+
+bool RelaySocket::accept(HttpServer* httpServer, const String& key) {
+    Client* slot = nullptr;
+    for (Client& candidate : clients) {
+        if (!candidate.active) {
+            slot = &candidate;
+            break;
+        }
+    }
+    if (!slot) {
+        Serial.println("[WS] No free relay socket slot");
+        return false;
+    }
+
+    WiFiClient client = httpServer->client();
+    if (!client.connected()) return false;
+
+    client.setNoDelay(true);
+    char head[160];
+    int headLength = snprintf(head, sizeof(head),
+                              "HTTP/1.1 101 Switching Protocols\r\n"
+                              "Upgrade: websocket\r\n"
+                              "Connection: Upgrade\r\n"
+                              "Sec-WebSocket-Accept: %s\r\n"
+                              "\r\n", acceptKey(key).c_str());
+    if (!HttpServer::sendNow(client.fd(), head, headLength)) {
+        client.stop();
+        return false;
+    }
+    if (!httpServer->watch(client.fd())) {
+        Serial.println("[WS] No watch slot left; dropping client");
+        client.stop();
+        return false;
+    }
+
+    slot->socket = client;
+    slot->active = true;
+    slot->length = 0;
+    server = httpServer;
+    Serial.printf("[WS] Client connected (%u active)\n", clientCount());
+    return true;
+}
+
+void RelaySocket::loop() {
+    Completion completion;
+    while (completions && xQueueReceive(completions, &completion, 0) == pdTRUE) {
+        resolve(completion);
+    }
+
+    for (size_t i = 0; i < MAX_CLIENTS; i++) {
+        if (!clients[i].active) continue;
+        if (clients[i].socket.available() > 0) {
+            receive(i);
+        } else if (!clients[i].socket.connected()) {
+            drop(i);
+        }
+    }
+
+    expire(millis());
+}
+
+size_t RelaySocket::clientCount() const {
+    size_t count = 0;
+    for (const Client& client : clients) {
+        if (client.active) count++;
+    }
+    return count;
+}
+
+void RelaySocket::receive(size_t index) {
+    Client& client = clients[index];
+
+    while (client.active && client.socket.available() > 0) {
+        int read = client.socket.read(client.frame + client.length, sizeof(client.frame) - client.length);
+        if (read <= 0) break;
+        client.length += read;
+
+        // The buffer holds the largest frame accepted, so a frame that is
+        // still incomplete always has room to finish
+        size_t parsed = 0;
+        while (client.length - parsed >= 2) {
+            const uint8_t* header = client.frame + parsed;
+            if (!(header[1] & 0x80)) {
+                sendClose(index, CLOSE_PROTOCOL_ERROR);     // Clients must mask
+                return;
+            }
+            size_t length = header[1] & 0x7F;
+            if (length > MAX_PAYLOAD) {
+                sendClose(index, CLOSE_TOO_BIG);
+                return;
+            }
+            size_t frameSize = 2 + MASK_SIZE + length;
+            if (client.length - parsed < frameSize) break;
+
+            uint8_t* payload = client.frame + parsed + 2 + MASK_SIZE;
+            for (size_t i = 0; i < length; i++) {
+                payload[i] ^= header[2 + i % MASK_SIZE];
+            }
+            if (!handleFrame(index, header[0], payload, length)) return;
+            parsed += frameSize;
+        }
+
+        memmove(client.frame, client.frame + parsed, client.length - parsed);
+        client.length -= parsed;
+    }
+}
+
+bool RelaySocket::handleFrame(size_t index, uint8_t opcode, const uint8_t* payload, size_t length) {
+    bool fin = opcode & 0x80;
+    if (opcode & 0x70) {
+        sendClose(index, CLOSE_PROTOCOL_ERROR);     // No extensions were negotiated
+        return false;
+    }
+
+    switch (opcode & 0x0F) {
+        case OP_BINARY:
+            // Commands are a few bytes; nothing here needs fragmentation
+            if (!fin) break;
+            handleCommand(index, payload, length);
+            return clients[index].active;
+        case OP_PING:
+            return send(index, OP_PONG, payload, length);
+        case OP_PONG:
+            return true;
+        case OP_CLOSE:
+            sendClose(index, length >= 2 ? (payload[0] << 8) | payload[1] : CLOSE_NORMAL);
+            return false;
+        case OP_TEXT:
+        case OP_CONTINUATION:
+        default:
+            break;
+    }
+
+    sendClose(index, CLOSE_UNSUPPORTED);
+    return false;
+}
+
+void RelaySocket::handleCommand(size_t index, const uint8_t* payload, size_t length) {
+    uint8_t ack[] = {ACK, length >= 2 ? payload[1] : uint8_t(0), INVALID};
+    if (length != 4 || payload[0] != CMD || payload[2] >= RelayWorker::NUM_RELAYS || payload[3] > 1) {
+        send(index, OP_BINARY, ack, sizeof(ack));
+        return;
+    }
+
+    Pending* entry = nullptr;
+    for (Pending& candidate : pending) {
+        if (!candidate.used) {
+            entry = &candidate;
+            break;
+        }
+    }
+
+    uint32_t tag = nextTag++;
+    if (nextTag == 0) nextTag = 1;
+
+    RelayState state = payload[3] ? RelayState::ON : RelayState::OFF;
+    if (!entry || !relays.submit(payload[2], state, tag)) {
+        ack[2] = BUSY;
+        send(index, OP_BINARY, ack, sizeof(ack));
+        return;
+    }
+
+    entry->used = true;
+    entry->client = index;
+    entry->seq = payload[1];
+    entry->relayId = payload[2];
+    entry->tag = tag;
+    entry->queuedAt = millis();
+
+    ack[2] = QUEUED;
+    send(index, OP_BINARY, ack, sizeof(ack));
+}
+
+void RelaySocket::resolve(const Completion& completion) {
+    for (Pending& entry : pending) {
+        // Older commands for the relay were coalesced into this one
+        if (!entry.used || entry.relayId != completion.relayId ||
+            static_cast<int32_t>(entry.tag - completion.tag) > 0) {
+            continue;
+        }
+        entry.used = false;
+        uint8_t result[] = {RESULT, entry.seq, entry.relayId,
+                            completion.success ? DONE : FAILED, stateByte(completion.state)};
+        send(entry.client, OP_BINARY, result, sizeof(result));
+    }
+}
+
+void RelaySocket::expire(unsigned long now) {
+    for (Pending& entry : pending) {
+        if (!entry.used || now - entry.queuedAt < RESULT_TIMEOUT) continue;
+        // Lost to a full completion queue, or superseded by a command from
+        // another source; report whatever the relay is now known to be
+        entry.used = false;
+        uint8_t result[] = {RESULT, entry.seq, entry.relayId, TIMED_OUT, stateByte(relays.state(entry.relayId))};
+        send(entry.client, OP_BINARY, result, sizeof(result));
+    }
+}
+
+bool RelaySocket::send(size_t index, uint8_t opcode, const uint8_t* payload, size_t length) {
+    Client& client = clients[index];
+    if (!client.active || length > MAX_PAYLOAD) return false;
+
+    uint8_t frame[2 + MAX_PAYLOAD];
+    frame[0] = 0x80 | opcode;
+    frame[1] = length;
+    memcpy(frame + 2, payload, length);
+
+    // A short write means the peer is gone or stalled; drop it rather than
+    // block the web server loop
+    if (!HttpServer::sendNow(client.socket.fd(), frame, 2 + length)) {
+        drop(index);
+        return false;
+    }
+    return true;
+}
+
+void RelaySocket::sendClose(size_t index, uint16_t code) {
+    uint8_t payload[] = {static_cast<uint8_t>(code >> 8), static_cast<uint8_t>(code & 0xFF)};
+    send(index, OP_CLOSE, payload, sizeof(payload));
+    drop(index);
+}
+
+void RelaySocket::drop(size_t index) {
+    Client& client = clients[index];
+    if (!client.active) return;
+
+    if (server) server->unwatch(client.socket.fd());
+    client.socket.stop();
+    client.active = false;
+    client.length = 0;
+    for (Pending& entry : pending) {
+        if (entry.used && entry.client == index) entry.used = false;
+    }
+    Serial.printf("[WS] Client disconnected (%u active)\n", clientCount());
+}
+
+void RelaySocket::completed(const RelayCommand& command, bool success) {
+    if (command.tag == 0 || !completions) return;
+
+    // Runs on the relay worker; the sockets are only touched from loop()
+    Completion completion = {command.tag, command.relayId, success, command.state};
+    if (!success) {
+        completion.state = relays.state(command.relayId);
+    }
+    xQueueSend(completions, &completion, 0);
+}
+
+String RelaySocket::acceptKey(const String& key) {
+    static const char GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    String input = key + GUID;
+    uint8_t digest[20];
+    mbedtls_md(mbedtls_md_info_from_type(MBEDTLS_MD_SHA1),
+               reinterpret_cast<const unsigned char*>(input.c_str()), input.length(), digest);
+    return base64::encode(digest, sizeof(digest));
+}
+
+uint8_t RelaySocket::stateByte(RelayState state) {
+    switch (state) {
+        case RelayState::OFF: return 0;
+        case RelayState::ON: return 1;
+        default: return 2;
+    }
+}
@@ -0,0 +1,27 @@
+// RelayStateResponse.cpp
+#include "RelayStateResponse.h"
+#include "JsonStreamWriter.h"
+
+void sendRelayStates(HttpServer* server, const RelayStatus* statuses, uint8_t count,
+                     uint32_t epoch, uint32_t version) {
+    char etag[24];
+    snprintf(etag, sizeof(etag), "\"%x-%u\"", (unsigned)epoch, (unsigned)version);
+    server->sendHeader("Cache-Control", "no-cache");
+    server->sendHeader("ETag", etag);
+
+    if (server->header("If-None-Match") == etag) {
+        server->send(304);
+        return;
+    }
+
+    JsonStreamWriter json(server);
+    json.beginArray();
+    for (uint8_t i = 0; i < count; i++) {
+        json.beginObject()
+            .field("relay_id", i)
+            .field("state", relayStateName(statuses[i].state))
+            .field("override", statuses[i].override)
+            .endObject();
+    }
+    json.endArray();
+}
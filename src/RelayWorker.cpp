@@ -0,0 +1,57 @@
+// RelayWorker.cpp
+#include "RelayWorker.h"
+
+RelayWorker::RelayWorker(size_t queueSize, Executor executor)
+    : queue(xQueueCreate(queueSize, sizeof(RelayCommand)))
+    , executor(executor)
+    , coalesced(0)
+    , completionListenerCount(0) {
+}
+
+bool RelayWorker::addCompletionListener(CompletionCallback callback) {
+    if (!callback || completionListenerCount >= MAX_COMPLETION_LISTENERS) {
+        return false;
+    }
+    completionListeners[completionListenerCount++] = callback;
+    return true;
+}
+
+bool RelayWorker::submit(const RelayCommand& command) {
+    if (command.relayId >= NUM_RELAYS) return false;
+    return xQueueSend(queue, &command, 0) == pdTRUE;
+}
+
+bool RelayWorker::runOnce(TickType_t wait) {
+    RelayCommand command;
+    if (xQueueReceive(queue, &command, wait) != pdTRUE) {
+        return false;
+    }
+
+    // Drain everything already queued, keeping only the newest command
+    // per relay; older ones would be overwritten by the hub anyway
+    RelayCommand latest[NUM_RELAYS];
+    bool pending[NUM_RELAYS] = {false};
+    do {
+        if (command.relayId >= NUM_RELAYS) continue;
+        if (pending[command.relayId]) {
+            coalesced++;
+            Serial.printf("[RELAY] Superseded queued command for relay %d (%u coalesced)\n",
+                         command.relayId, coalesced);
+        }
+        latest[command.relayId] = command;
+        pending[command.relayId] = true;
+    } while (xQueueReceive(queue, &command, 0) == pdTRUE);
+
+    for (uint8_t i = 0; i < NUM_RELAYS; i++) {
+        if (!pending[i]) continue;
+        bool success = executor(latest[i]);
+        notifyCompletion(latest[i], success);
+    }
+    return true;
+}
+
+void RelayWorker::notifyCompletion(const RelayCommand& command, bool success) {
+    for (size_t i = 0; i < completionListenerCount; i++) {
+        completionListeners[i](command, success);
+    }
+}
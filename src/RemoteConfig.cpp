@@ -0,0 +1,69 @@
+// RemoteConfig.cpp
+#include "RemoteConfig.h"
+#include "config.h"
+#include "MQTTManager.h"
+#include "DisplayHandler.h"
+#include "GlobalState.h"
+#include "PreferencesManager.h"
+
+extern GlobalState* g_state;
+
+void RemoteConfig::begin(MQTTManager& mqtt) {
+    if (!mqtt.route(MQTT_TOPIC_CONFIG, handleMessage)) {
+        Serial.println("[CONFIG] Failed to register remote config topic");
+        return;
+    }
+    Serial.printf("[CONFIG] Listening for remote configuration on %s (applied version %u)\n",
+                 MQTT_TOPIC_CONFIG, PreferencesManager::getConfigVersion());
+}
+
+void RemoteConfig::handleMessage(const char* topic, MQTTPayload payload) {
+    StaticJsonDocument<256> doc;
+    DeserializationError error = deserializeJson(doc, reinterpret_cast<char*>(payload.data), payload.length);
+    if (error) {
+        Serial.printf("[CONFIG] Failed to parse remote config: %s\n", error.c_str());
+        return;
+    }
+
+    uint32_t version = doc["version"] | 0UL;
+    uint32_t appliedVersion = PreferencesManager::getConfigVersion();
+    if (version == 0 || version <= appliedVersion) {
+        Serial.printf("[CONFIG] Config version %u %s (applied %u)\n",
+                     version, resultToString(Result::STALE), appliedVersion);
+        return;
+    }
+
+    DisplayHandler* display = g_state ? g_state->getDisplay() : nullptr;
+    if (!display) {
+        Serial.println("[CONFIG] Display not initialized, cannot apply config");
+        return;
+    }
+
+    DisplayPreferences next;
+    uint8_t changed = 0;
+    Result result = computeDelta(doc["display"], display->getDisplayPreferences(), next, changed);
+
+    if (result == Result::INVALID) {
+        Serial.printf("[CONFIG] Rejecting invalid config version %u\n", version);
+        return;
+    }
+
+    if (result == Result::APPLIED) {
+        display->setDisplayPreferences(next);
+        PreferencesManager::saveDisplayPreferences(next, changed);
+    }
+    PreferencesManager::setConfigVersion(version);
+
+    Serial.printf("[CONFIG] Config version %u %s (fields 0x%02X)\n",
+                 version, resultToString(result), changed);
+}
+
+const char* RemoteConfig::resultToString(Result result) {
+    switch (result) {
+        case Result::APPLIED: return "applied";
+        case Result::UNCHANGED: return "unchanged";
+        case Result::STALE: return "stale";
+        case Result::INVALID: return "invalid";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,51 @@
+// RemoteConfigDelta.cpp
+// The pure half of RemoteConfig, kept apart from the MQTT and display
+// wiring so the host tests can build it
+#include "RemoteConfig.h"
+#include "PreferencesManager.h"
+
+RemoteConfig::Result RemoteConfig::computeDelta(JsonObjectConst display,
+                                                const DisplayPreferences& current,
+                                                DisplayPreferences& next,
+                                                uint8_t& changed) {
+    next = current;
+    changed = 0;
+
+    if (display.isNull()) {
+        return Result::UNCHANGED;
+    }
+
+    if (display.containsKey("nightDimming")) {
+        next.nightModeDimmingEnabled = display["nightDimming"].as<bool>();
+    }
+
+    // Brightness arrives on the web API's 1-25 scale and is stored as 1-75
+    const char* brightnessKeys[] = {"dayBrightness", "nightBrightness"};
+    uint8_t* brightnessFields[] = {&next.dayBrightness, &next.nightBrightness};
+    for (uint8_t i = 0; i < 2; i++) {
+        if (!display.containsKey(brightnessKeys[i])) continue;
+        int value = display[brightnessKeys[i]].as<int>();
+        if (value < 1 || value > 25) {
+            Serial.printf("[CONFIG] %s out of range: %d\n", brightnessKeys[i], value);
+            return Result::INVALID;
+        }
+        // Converted before the diff below, so the comparison is made against
+        // the stored byte rather than a lossy 1-25 read-back of it
+        *brightnessFields[i] = PreferencesManager::toStoredBrightness(value);
+    }
+
+    const char* hourKeys[] = {"nightStartHour", "nightEndHour"};
+    uint8_t* hourFields[] = {&next.nightStartHour, &next.nightEndHour};
+    for (uint8_t i = 0; i < 2; i++) {
+        if (!display.containsKey(hourKeys[i])) continue;
+        int value = display[hourKeys[i]].as<int>();
+        if (value < 0 || value >= 24) {
+            Serial.printf("[CONFIG] %s out of range: %d\n", hourKeys[i], value);
+            return Result::INVALID;
+        }
+        *hourFields[i] = value;
+    }
+
+    changed = PreferencesManager::diffDisplayPreferences(current, next);
+    return changed ? Result::APPLIED : Result::UNCHANGED;
+}
@@ -0,0 +1,112 @@
+// RemoteSensorSet.cpp
+#include "RemoteSensorSet.h"
+
+RemoteSensorSet& RemoteSensorSet::getInstance() {
+    static RemoteSensorSet instance;
+    return instance;
+}
+
+RemoteSensorSet::RemoteSensorSet()
+    : count(0)
+    , version(0) {
+    memset(entries, 0, sizeof(entries));
+    mutex = xSemaphoreCreateMutex();
+}
+
+bool RemoteSensorSet::update(const char* id, float value) {
+    if (!id || !id[0]) return false;
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) != pdTRUE) return false;
+
+    unsigned long now = millis();
+    Reading* slot = nullptr;
+    for (size_t i = 0; i < count; i++) {
+        if (strncmp(entries[i].id, id, ID_LENGTH - 1) == 0) {
+            slot = &entries[i];
+            break;
+        }
+    }
+
+    if (!slot) {
+        if (count < MAX_SENSORS) {
+            slot = &entries[count++];
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                if (!isFresh(entries[i], now) &&
+                    (!slot || now - entries[i].updatedAt > now - slot->updatedAt)) {
+                    slot = &entries[i];
+                }
+            }
+        }
+        if (!slot) {
+            xSemaphoreGive(mutex);
+            Serial.printf("[REMOTE] Sensor table full, dropping '%s'\n", id);
+            return false;
+        }
+        strlcpy(slot->id, id, ID_LENGTH);
+        slot->value = value;
+        version++;
+    } else if (slot->value != value || !isFresh(*slot, now)) {
+        slot->value = value;
+        version++;
+    }
+    slot->updatedAt = now;
+
+    xSemaphoreGive(mutex);
+    return true;
+}
+
+void RemoteSensorSet::touch(unsigned long since) {
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) != pdTRUE) return;
+
+    unsigned long now = millis();
+    for (size_t i = 0; i < count; i++) {
+        // Wrap-safe "updatedAt >= since"
+        if (static_cast<long>(entries[i].updatedAt - since) >= 0) {
+            entries[i].updatedAt = now;
+        }
+    }
+    xSemaphoreGive(mutex);
+}
+
+size_t RemoteSensorSet::freshCount() const {
+    size_t fresh = 0;
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        unsigned long now = millis();
+        for (size_t i = 0; i < count; i++) {
+            if (isFresh(entries[i], now)) fresh++;
+        }
+        xSemaphoreGive(mutex);
+    }
+    return fresh;
+}
+
+bool RemoteSensorSet::getFresh(size_t index, Reading& out) const {
+    bool found = false;
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        unsigned long now = millis();
+        for (size_t i = 0; i < count; i++) {
+            if (!isFresh(entries[i], now)) continue;
+            if (index-- == 0) {
+                out = entries[i];
+                found = true;
+                break;
+            }
+        }
+        xSemaphoreGive(mutex);
+    }
+    return found;
+}
+
+size_t RemoteSensorSet::snapshot(Reading* out, size_t capacity) const {
+    size_t copied = 0;
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        unsigned long now = millis();
+        for (size_t i = 0; i < count && copied < capacity; i++) {
+            if (isFresh(entries[i], now)) {
+                out[copied++] = entries[i];
+            }
+        }
+        xSemaphoreGive(mutex);
+    }
+    return copied;
+}
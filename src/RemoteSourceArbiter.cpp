@@ -0,0 +1,41 @@
+// RemoteSourceArbiter.cpp
+#include "RemoteSourceArbiter.h"
+
+RemoteSourceArbiter::RemoteSourceArbiter()
+    : source(RemoteSource::HTTP)
+    , lastMqttReading(0)
+    , mqttStreakStart(0)
+    , mqttMessages(0) {
+}
+
+void RemoteSourceArbiter::onMqttReading(unsigned long now) {
+    // A gap longer than the stale limit breaks the streak
+    if (!mqttFresh(now)) {
+        mqttStreakStart = now;
+        mqttMessages = 0;
+    }
+    if (mqttMessages < UINT16_MAX) mqttMessages++;
+    lastMqttReading = now;
+}
+
+RemoteSource RemoteSourceArbiter::update(unsigned long now) {
+    RemoteSource next = source;
+
+    if (source == RemoteSource::MQTT && !mqttFresh(now)) {
+        next = RemoteSource::HTTP;
+    } else if (source == RemoteSource::HTTP && mqttFresh(now) &&
+               mqttMessages >= MQTT_RECOVER_MESSAGES &&
+               now - mqttStreakStart >= MQTT_RECOVER_HOLD) {
+        next = RemoteSource::MQTT;
+    }
+
+    if (next != source) {
+        Serial.printf("[REMOTE] Source %s -> %s\n", sourceToString(source), sourceToString(next));
+        source = next;
+    }
+    return source;
+}
+
+const char* RemoteSourceArbiter::sourceToString(RemoteSource source) {
+    return source == RemoteSource::MQTT ? "MQTT" : "HTTP";
+}
@@ -0,0 +1,118 @@
+// ScheduleEngine.cpp
+#include "ScheduleEngine.h"
+#include <math.h>
+#include <string.h>
+
+static_assert(ScheduleEngine::MAX_RULES <= 32, "watching keeps one bit per rule");
+
+ScheduleEngine::ScheduleEngine(const Hooks& hooks)
+    : hooks(hooks)
+    , ruleCount(0)
+    , watching(0)
+    , lastMinute(-1) {
+    memset(rules, 0, sizeof(rules));
+    memset(engaged, 0, sizeof(engaged));
+}
+
+void ScheduleEngine::tick(uint16_t now) {
+    if (lastMinute == now) return;
+
+    if (lastMinute >= 0 && now == (lastMinute + 1) % ScheduleWindow::MINUTES_PER_WEEK) {
+        wheel.advance([this, now](uint8_t index) {
+            evaluate(index, now);
+            schedule(index, now);
+        });
+    } else {
+        rebuild(now);
+    }
+
+    // Open windows with a sensor condition are the only per-minute work
+    for (uint8_t i = 0; i < ruleCount; i++) {
+        if (watching & (1UL << i)) {
+            evaluate(i, now);
+        }
+    }
+
+    lastMinute = now;
+}
+
+void ScheduleEngine::setRules(const ScheduleRule* newRules, size_t count) {
+    if (count > MAX_RULES) count = MAX_RULES;
+    memcpy(rules, newRules, count * sizeof(ScheduleRule));
+    ruleCount = count;
+    memset(engaged, 0, sizeof(engaged));
+    if (lastMinute >= 0) {
+        rebuild(lastMinute);
+    } else {
+        wheel.clear();
+        watching = 0;
+    }
+}
+
+size_t ScheduleEngine::getRules(ScheduleRule* out, size_t capacity) const {
+    size_t count = ruleCount < capacity ? ruleCount : capacity;
+    memcpy(out, rules, count * sizeof(ScheduleRule));
+    return count;
+}
+
+void ScheduleEngine::rebuild(uint16_t now) {
+    wheel.clear();
+    watching = 0;
+
+    for (uint8_t i = 0; i < ruleCount; i++) {
+        evaluate(i, now);
+        schedule(i, now);
+    }
+}
+
+void ScheduleEngine::schedule(uint8_t index, uint16_t now) {
+    wheel.schedule(index, ScheduleWindow::minutesUntilEdge(rules[index], now));
+}
+
+void ScheduleEngine::evaluate(uint8_t index, uint16_t now) {
+    const ScheduleRule& rule = rules[index];
+    bool open = ScheduleWindow::contains(rule, now);
+
+    if (rule.startMinute == rule.endMinute) {
+        if (open && conditionHolds(rule, false)) {
+            command(rule, true);
+        }
+        return;
+    }
+
+    uint32_t bit = 1UL << index;
+    if (open && rule.condition != static_cast<uint8_t>(ScheduleCondition::NONE)) {
+        watching |= bit;
+    } else {
+        watching &= ~bit;
+    }
+
+    bool want = open && conditionHolds(rule, engaged[index]);
+    if (want != engaged[index]) {
+        engaged[index] = want;
+        command(rule, want);
+    }
+}
+
+bool ScheduleEngine::conditionHolds(const ScheduleRule& rule, bool engaged) const {
+    ScheduleCondition condition = static_cast<ScheduleCondition>(rule.condition);
+    if (condition == ScheduleCondition::NONE) return true;
+
+    // A missing or stale reading releases the relay rather than holding it
+    // on the last value seen
+    float value;
+    if (!hooks.read(condition, value) || isnan(value)) return false;
+
+    // Once engaged, the limit moves by HYSTERESIS so the rule lets go late
+    int32_t tenths = lroundf(value * 10.0f);
+    if (rule.comparison == '<') {
+        return tenths < rule.threshold + (engaged ? int32_t(HYSTERESIS) : 0);
+    }
+    return tenths > rule.threshold - (engaged ? int32_t(HYSTERESIS) : 0);
+}
+
+void ScheduleEngine::command(const ScheduleRule& rule, bool engage) {
+    RelayState action = static_cast<RelayState>(rule.action);
+    RelayState state = engage ? action : (action == RelayState::ON ? RelayState::OFF : RelayState::ON);
+    hooks.command(rule.relayId, state);
+}
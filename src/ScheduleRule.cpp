@@ -0,0 +1,40 @@
+// ScheduleRule.cpp
+#include "ScheduleRule.h"
+
+constexpr uint16_t ScheduleWindow::MINUTES_PER_DAY;
+constexpr uint16_t ScheduleWindow::MINUTES_PER_WEEK;
+
+bool ScheduleWindow::contains(const ScheduleRule& rule, uint16_t now) {
+    uint8_t day = now / MINUTES_PER_DAY;
+    uint16_t minute = now % MINUTES_PER_DAY;
+    bool today = rule.days & (1 << day);
+
+    if (rule.startMinute == rule.endMinute) {
+        return today && minute == rule.startMinute;
+    }
+    if (rule.startMinute < rule.endMinute) {
+        return today && minute >= rule.startMinute && minute < rule.endMinute;
+    }
+
+    // Window runs past midnight; the morning part belongs to yesterday's entry
+    bool yesterday = rule.days & (1 << ((day + 6) % 7));
+    return (today && minute >= rule.startMinute) || (yesterday && minute < rule.endMinute);
+}
+
+uint16_t ScheduleWindow::minutesUntilEdge(const ScheduleRule& rule, uint16_t now) {
+    uint32_t day = now / MINUTES_PER_DAY;
+    uint32_t best = MINUTES_PER_WEEK;
+
+    // Every start and end in the coming week is a candidate; edges on days the
+    // rule skips just evaluate to no change
+    for (uint32_t k = 0; k <= 7; k++) {
+        uint32_t base = (day + k) * MINUTES_PER_DAY;
+        uint32_t edges[] = {base + rule.startMinute, base + rule.endMinute};
+        for (uint32_t edge : edges) {
+            if (edge > now && edge - now < best) {
+                best = edge - now;
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,32 @@
+// SensorDocument.cpp
+#include "SensorDocument.h"
+#include <math.h>
+
+namespace {
+
+// Appends `"name":value` and a separator, advancing `offset`; false when it didn't fit
+bool appendField(char* buffer, size_t size, size_t& offset, const char* name, float value, char separator) {
+    int written = isfinite(value)
+        ? snprintf(buffer + offset, size - offset, "\"%s\":%.1f%c", name, value, separator)
+        : snprintf(buffer + offset, size - offset, "\"%s\":null%c", name, separator);
+    if (written < 0 || static_cast<size_t>(written) >= size - offset) return false;
+    offset += written;
+    return true;
+}
+
+}
+
+size_t SensorDocument::format(char* buffer, size_t size, float temperature, float humidity,
+                              float pressure, float remoteTemperature) {
+    if (size == 0) return 0;
+    buffer[0] = '{';
+    size_t offset = 1;
+    if (!appendField(buffer, size, offset, "temperature", temperature, ',') ||
+        !appendField(buffer, size, offset, "humidity", humidity, ',') ||
+        !appendField(buffer, size, offset, "pressure", pressure, ',') ||
+        !appendField(buffer, size, offset, "remote_temperature", remoteTemperature, '}')) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return offset;
+}
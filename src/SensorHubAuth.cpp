@@ -0,0 +1,151 @@
+// SensorHubAuth.cpp
+#include "SensorHubAuth.h"
+#include "Metrics.h"
+#include "SensorHubClient.h"
+#include <ArduinoJson.h>
+#include <WiFi.h>
+
+constexpr TokenRefresh SensorHubAuth::REFRESH;
+
+SensorHubAuth& SensorHubAuth::getInstance() {
+    static SensorHubAuth instance;
+    return instance;
+}
+
+SensorHubAuth::SensorHubAuth()
+    : issuedAt(0)
+    , valid(false)
+    , taskHandle(nullptr)
+    , logins(0) {
+    mutex = xSemaphoreCreateMutex();
+    events = xEventGroupCreate();
+}
+
+bool SensorHubAuth::begin() {
+    if (!mutex || !events) {
+        Serial.println("[AUTH] Failed to create token synchronization primitives");
+        return false;
+    }
+    if (taskHandle) return true;
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        refreshTask,
+        "HubAuth",
+        TASK_STACK_SIZE,
+        this,
+        TASK_PRIORITY,
+        &taskHandle,
+        0
+    );
+    if (result != pdPASS) {
+        Serial.println("[AUTH] Failed to create token refresh task");
+        taskHandle = nullptr;
+        return false;
+    }
+    Metrics::getInstance().registerTask("HubAuth", taskHandle);
+    return true;
+}
+
+String SensorHubAuth::getToken() {
+    String copy;
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        if (valid) copy = token;
+        xSemaphoreGive(mutex);
+    }
+    return copy;
+}
+
+bool SensorHubAuth::hasToken() {
+    return (xEventGroupGetBits(events) & TOKEN_READY) != 0;
+}
+
+void SensorHubAuth::invalidate(const String& rejected) {
+    bool wake = false;
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        // Several clients may report the same token; only the first counts
+        if (valid && token == rejected) {
+            valid = false;
+            xEventGroupClearBits(events, TOKEN_READY);
+            wake = true;
+        }
+        xSemaphoreGive(mutex);
+    }
+    if (wake && taskHandle) {
+        Serial.println("[AUTH] Token rejected by hub, refreshing");
+        xTaskNotifyGive(taskHandle);
+    }
+}
+
+bool SensorHubAuth::waitForToken(TickType_t wait) {
+    EventBits_t bits = xEventGroupWaitBits(events, TOKEN_READY, pdFALSE, pdTRUE, wait);
+    return (bits & TOKEN_READY) != 0;
+}
+
+void SensorHubAuth::refreshTask(void* parameter) {
+    static_cast<SensorHubAuth*>(parameter)->runRefresh();
+}
+
+void SensorHubAuth::runRefresh() {
+    while (true) {
+        unsigned long now = millis();
+        bool isValid = false;
+        unsigned long issued = 0;
+        if (xSemaphoreTake(mutex, portMAX_DELAY) == pdTRUE) {
+            isValid = valid;
+            issued = issuedAt;
+            xSemaphoreGive(mutex);
+        }
+
+        unsigned long waitMs;
+        if (isValid && !needsRefresh(now, issued)) {
+            // Sleep until the refresh margin, unless a client reports a rejection
+            waitMs = REFRESH.remaining(now, issued);
+        } else if (WiFi.status() == WL_CONNECTED && login()) {
+            waitMs = REFRESH.refreshAfter();
+        } else {
+            waitMs = RETRY_DELAY;
+        }
+
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+    }
+}
+
+bool SensorHubAuth::login() {
+    String newToken;
+    {
+        SensorHubClient::Request request(API_LOGIN_ENDPOINT);
+        request.addHeader("Content-Type", "application/json");
+
+        StaticJsonDocument<200> credentials;
+        credentials["username"] = API_USERNAME;
+        credentials["password"] = API_PASSWORD;
+        String requestBody;
+        serializeJson(credentials, requestBody);
+
+        int httpCode = request.POST(requestBody);
+        if (httpCode != 200) {
+            Serial.printf("[AUTH] Login failed with code: %d\n", httpCode);
+            return false;
+        }
+
+        StaticJsonDocument<512> doc;
+        DeserializationError error = deserializeJson(doc, request.getString());
+        if (error || !doc.containsKey("token")) {
+            Serial.println("[AUTH] Invalid authentication response format");
+            return false;
+        }
+        newToken = doc["token"].as<String>();
+    }
+
+    if (xSemaphoreTake(mutex, portMAX_DELAY) == pdTRUE) {
+        token = newToken;
+        issuedAt = millis();
+        valid = true;
+        logins++;
+        xSemaphoreGive(mutex);
+    }
+    xEventGroupSetBits(events, TOKEN_READY);
+
+    Serial.printf("[AUTH] Token refreshed (%u logins since boot)\n", logins);
+    return true;
+}
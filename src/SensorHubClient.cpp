@@ -0,0 +1,193 @@
+// SensorHubClient.cpp
+#include "SensorHubClient.h"
+#include <ESPmDNS.h>
+#include <WiFi.h>
+
+SensorHubClient& SensorHubClient::getInstance() {
+    static SensorHubClient instance;
+    return instance;
+}
+
+SensorHubClient::SensorHubClient()
+    : resolvedAt(0)
+    , addressValid(false) {
+    for (size_t i = 0; i < POOL_SIZE; i++) {
+        pool[i].inUse = false;
+        pool[i].http.setReuse(true);
+        pool[i].http.setTimeout(HTTP_TIMEOUT);
+    }
+    poolSemaphore = xSemaphoreCreateCounting(POOL_SIZE, POOL_SIZE);
+    poolMutex = xSemaphoreCreateMutex();
+}
+
+bool SensorHubClient::resolve(IPAddress& address) {
+    if (xSemaphoreTake(poolMutex, ACQUIRE_TIMEOUT) != pdTRUE) {
+        return false;
+    }
+
+    if (addressValid && millis() - resolvedAt < ADDRESS_TTL) {
+        address = cachedAddress;
+        xSemaphoreGive(poolMutex);
+        return true;
+    }
+    xSemaphoreGive(poolMutex);
+
+    // Resolve outside the lock; mDNS queries take a while
+    IPAddress resolved;
+    String host = SENSORHUB_URL;
+    if (host.endsWith(".local")) {
+        resolved = MDNS.queryHost(host.substring(0, host.length() - 6), RESOLVE_TIMEOUT);
+    } else if (!WiFi.hostByName(host.c_str(), resolved)) {
+        resolved = IPAddress();
+    }
+
+    if (resolved == IPAddress()) {
+        Serial.printf("[HUB] Failed to resolve %s\n", SENSORHUB_URL);
+        return false;
+    }
+
+    if (xSemaphoreTake(poolMutex, ACQUIRE_TIMEOUT) == pdTRUE) {
+        cachedAddress = resolved;
+        resolvedAt = millis();
+        addressValid = true;
+        xSemaphoreGive(poolMutex);
+    }
+
+    Serial.printf("[HUB] Resolved %s to %s\n", SENSORHUB_URL, resolved.toString().c_str());
+    address = resolved;
+    return true;
+}
+
+void SensorHubClient::invalidateAddress() {
+    if (xSemaphoreTake(poolMutex, ACQUIRE_TIMEOUT) == pdTRUE) {
+        addressValid = false;
+        xSemaphoreGive(poolMutex);
+    }
+}
+
+SensorHubClient::Connection* SensorHubClient::acquire(TickType_t wait) {
+    if (xSemaphoreTake(poolSemaphore, wait) != pdTRUE) {
+        Serial.println("[HUB] No free connection in pool");
+        return nullptr;
+    }
+
+    Connection* chosen = nullptr;
+    if (xSemaphoreTake(poolMutex, wait) == pdTRUE) {
+        // Prefer a connection that is still open so its socket gets reused
+        for (size_t i = 0; i < POOL_SIZE; i++) {
+            if (pool[i].inUse) continue;
+            if (!chosen || pool[i].client.connected()) {
+                chosen = &pool[i];
+            }
+        }
+        if (chosen) chosen->inUse = true;
+        xSemaphoreGive(poolMutex);
+    }
+
+    if (!chosen) {
+        xSemaphoreGive(poolSemaphore);
+    }
+    return chosen;
+}
+
+void SensorHubClient::release(Connection* connection, bool healthy) {
+    if (!connection) return;
+
+    if (!healthy) {
+        connection->client.stop();
+    }
+
+    if (xSemaphoreTake(poolMutex, portMAX_DELAY) == pdTRUE) {
+        connection->inUse = false;
+        xSemaphoreGive(poolMutex);
+    }
+    xSemaphoreGive(poolSemaphore);
+}
+
+SensorHubClient::Request::Request(const char* path, TickType_t wait)
+    : connection(nullptr)
+    , lastCode(0) {
+    SensorHubClient& hub = SensorHubClient::getInstance();
+
+    IPAddress address;
+    if (!hub.resolve(address)) {
+        return;
+    }
+
+    connection = hub.acquire(wait);
+    if (!connection) {
+        return;
+    }
+
+    if (!connection->http.begin(connection->client, address.toString(), 80, path)) {
+        hub.release(connection, false);
+        connection = nullptr;
+    }
+}
+
+SensorHubClient::Request::~Request() {
+    if (!connection) return;
+
+    // end() keeps the socket open when both sides agreed to keep-alive, but
+    // doesn't drain it: unread body bytes would desync the next request
+    bool healthy = ResponseBodyStream::canReuse(lastCode, body.finished(connection->http.getSize()));
+    connection->http.useHTTP10(false);
+    connection->http.end();
+    SensorHubClient::getInstance().release(connection, healthy);
+}
+
+void SensorHubClient::Request::addHeader(const String& name, const String& value) {
+    if (connection) {
+        connection->http.addHeader(name, value);
+    }
+}
+
+void SensorHubClient::Request::useHTTP10(bool enable) {
+    if (connection) {
+        connection->http.useHTTP10(enable);
+    }
+}
+
+void SensorHubClient::Request::collectHeaders(const char* headers[], size_t count) {
+    if (connection) {
+        connection->http.collectHeaders(headers, count);
+    }
+}
+
+String SensorHubClient::Request::header(const char* name) {
+    return connection ? connection->http.header(name) : String();
+}
+
+int SensorHubClient::Request::GET() {
+    if (!connection) return HTTPC_ERROR_CONNECTION_REFUSED;
+    return finish(connection->http.GET());
+}
+
+int SensorHubClient::Request::POST(const String& payload) {
+    if (!connection) return HTTPC_ERROR_CONNECTION_REFUSED;
+    return finish(connection->http.POST(payload));
+}
+
+String SensorHubClient::Request::getString() {
+    if (!connection) return String();
+    String payload = connection->http.getString();
+    int size = connection->http.getSize();
+    if (size >= 0 ? payload.length() == static_cast<unsigned>(size) : payload.length() > 0) {
+        body.markComplete();
+    }
+    return payload;
+}
+
+Stream& SensorHubClient::Request::getStream() {
+    body.attach(&connection->http.getStream());
+    return body;
+}
+
+int SensorHubClient::Request::finish(int code) {
+    lastCode = code;
+    if (code == HTTPC_ERROR_CONNECTION_REFUSED) {
+        // The hub may have moved to a new address; resolve again next time
+        SensorHubClient::getInstance().invalidateAddress();
+    }
+    return code;
+}
@@ -0,0 +1,28 @@
+#include "WebAssets.h"
+#include "WebAssetsData.h"
+
+const WebAsset* findWebAsset(const char* name) {
+    for (const WebAsset& asset : WEB_ASSETS) {
+        if (strcmp(asset.name, name) == 0) {
+            return &asset;
+        }
+    }
+    return nullptr;
+}
+
+void sendWebAsset(HttpServer* server, const WebAsset& asset, const char* cacheControl) {
+    if (!server) return;
+
+    server->sendHeader("ETag", asset.etag);
+    server->sendHeader("Cache-Control", cacheControl);
+
+    if (server->header("If-None-Match") == asset.etag) {
+        server->send(304);
+        return;
+    }
+
+    // Every client this UI targets accepts gzip, so the compressed bytes go
+    // out as they are rather than keeping a second, uncompressed copy in flash
+    server->sendHeader("Content-Encoding", "gzip");
+    server->send_P(200, asset.contentType, reinterpret_cast<const char*>(asset.data), asset.length);
+}
@@ -1,6 +1,8 @@
 #include "WebHandlers.h"
 #include "DisplayHandler.h"
-#include "icons.h"
+#include "WebAssets.h"
+#include "WiFiScanner.h"
+#include "JsonStreamWriter.h"
 #include <WiFi.h>
 #include <HTTPClient.h>
 #include "config.h"
@@ -8,12 +10,64 @@
 #include "GlobalState.h"
 #include "PreferencesManager.h"
 #include "RelayControlHandler.h"
+#include "RelayStateResponse.h"
+#include "RelayScheduler.h"
+#include "RelaySocket.h"
+#include "EventStream.h"
+#include "WebServerManager.h"
+#include "Metrics.h"
+#include "auth_manager.h"
+#include "rate_limiter.h"
 #include <base64.h>
 
 extern GlobalState* g_state;
 extern PreferencesManager prefsManager;
 
-void addCorsHeaders(WebServer* server) {
+// Connection attempts take seconds. They run on a short-lived worker that
+// answers a deferred request, so the server keeps serving others.
+static constexpr uint32_t DEFERRED_WORKER_STACK_SIZE = 4096;
+
+static bool runDeferred(HttpServer* server, TaskFunction_t worker, const char* name) {
+    HttpServer::Ticket ticket = server->defer();
+    if (!ticket) return false;
+
+    if (xTaskCreate(worker, name, DEFERRED_WORKER_STACK_SIZE,
+                    reinterpret_cast<void*>(static_cast<uintptr_t>(ticket)), 1, nullptr) != pdPASS) {
+        server->complete(ticket, 503, "application/json", "{\"success\":false,\"error\":\"Server busy\"}");
+        return false;
+    }
+    return true;
+}
+
+// Failed logins, per client address. Only the server task touches it.
+static RateLimiter loginLimiter;
+
+static void sendSessionCookie(HttpServer* server, const char* token) {
+    String cookie = String(AuthenticationManager::COOKIE_NAME) + "=" + token +
+                    "; Path=/; HttpOnly; SameSite=Strict";
+    server->sendHeader("Set-Cookie", cookie);
+}
+
+static HttpServer::Ticket workerTicket(void* parameter) {
+    return static_cast<HttpServer::Ticket>(reinterpret_cast<uintptr_t>(parameter));
+}
+
+static void connectWorker(void* parameter) {
+    auto& webManager = WebServerManager::getInstance();
+    bool connected = webManager.connectWithStoredCredentials();
+
+    HttpServer* server = webManager.getServer();
+    if (connected) {
+        if (server) server->complete(workerTicket(parameter), 200, "text/plain", "Connected successfully. Device will restart...");
+        delay(1000);
+        ESP.restart();
+    } else if (server) {
+        server->complete(workerTicket(parameter), 500, "text/plain", "Failed to connect to WiFi");
+    }
+    vTaskDelete(nullptr);
+}
+
+void addCorsHeaders(HttpServer* server) {
     if (!server) return;
     server->sendHeader("Access-Control-Allow-Origin", "*");
     server->sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
@@ -22,47 +76,37 @@ void addCorsHeaders(WebServer* server) {
 
 void handleRoot() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
-    // Add cache control headers
-    server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-    server->sendHeader("Pragma", "no-cache");
-    server->sendHeader("Expires", "-1");
-
-    // Serve the appropriate page based on the connection state
-    if (webManager.isInAPMode()) {
-        server->send(200, "text/html", SETUP_PAGE_HTML);
-    } else {
-        server->send(200, "text/html", PREFERENCES_PAGE_HTML);
+    // Serve the appropriate page based on the connection state. Pages live at
+    // "/", so they are revalidated on every load; an unchanged page costs a 304
+    const WebAsset* page = findWebAsset(webManager.isInAPMode() ? "setup.html" : "preferences.html");
+    if (!page) {
+        server->send(500, "text/plain", "Page missing from build");
+        return;
     }
+    sendWebAsset(server, *page, "no-cache");
 }
 
 void handleScan() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
-    String networks = getNetworksJson();
-    server->send(200, "application/json", networks);
-}
+    // Answered from the cache at once; a stale cache also kicks off a
+    // background scan, reported as "scanning" until its results are in
+    WiFiScanner& scanner = WiFiScanner::getInstance();
+    scanner.requestScan();
 
-String getNetworksJson() {
-    String json = "[";
-    int n = WiFi.scanNetworks();
-    for (int i = 0; i < n; ++i) {
-        if (i > 0) json += ",";
-        json += "{\"ssid\":\"" + WiFi.SSID(i) + "\",\"rssi\":" + 
-                String(WiFi.RSSI(i)) + ",\"encrypted\":" + 
-                String(WiFi.encryptionType(i) != WIFI_AUTH_OPEN ? "true" : "false") + "}";
-    }
-    json += "]";
-    return json;
+    server->sendHeader("Cache-Control", "no-store");
+    JsonStreamWriter json(server);
+    scanner.toJson(json);
 }
 
 void handleConnect() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
     String ssid = server->arg("ssid");
@@ -74,19 +118,12 @@ void handleConnect() {
     }
 
     webManager.setWiFiCredentials(ssid, password);
-    
-    if (webManager.connectWithStoredCredentials()) {
-        server->send(200, "text/plain", "Connected successfully. Device will restart...");
-        delay(1000);
-        ESP.restart();
-    } else {
-        server->send(500, "text/plain", "Failed to connect to WiFi");
-    }
+    runDeferred(server, connectWorker, "WebConnect");
 }
 
 void handleGetPreferences() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
     DisplayHandler* display = g_state->getDisplay();
@@ -98,26 +135,23 @@ void handleGetPreferences() {
 
     DisplayPreferences prefs = display->getDisplayPreferences();
     
-    StaticJsonDocument<256> doc;
-    doc["success"] = true;
-    
-    JsonObject data = doc.createNestedObject("data");
-    data["nightDimming"] = prefs.nightModeDimmingEnabled;
-    data["dayBrightness"] = map(constrain(prefs.dayBrightness, 0, 255), 0, 255, 1, 25);
-    data["nightBrightness"] = map(constrain(prefs.nightBrightness, 0, 255), 0, 255, 1, 25);
-    data["nightStartHour"] = prefs.nightStartHour;
-    data["nightEndHour"] = prefs.nightEndHour;
-    
-    String response;
-    serializeJson(doc, response);
-    
     addCorsHeaders(server);
-    server->send(200, "application/json", response);
+    JsonStreamWriter json(server);
+    json.beginObject()
+        .field("success", true)
+        .beginObject("data")
+        .field("nightDimming", prefs.nightModeDimmingEnabled)
+        .field("dayBrightness", PreferencesManager::toBrightnessLevel(prefs.dayBrightness))
+        .field("nightBrightness", PreferencesManager::toBrightnessLevel(prefs.nightBrightness))
+        .field("nightStartHour", prefs.nightStartHour)
+        .field("nightEndHour", prefs.nightEndHour)
+        .endObject()
+        .endObject();
 }
 
 void handleSetPreferences() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
     addCorsHeaders(server);
@@ -157,8 +191,8 @@ void handleSetPreferences() {
             return;
         }
 
-        prefs.dayBrightness = map(dayBrightness, 1, 25, 1, 75);
-        prefs.nightBrightness = map(nightBrightness, 1, 25, 1, 75);
+        prefs.dayBrightness = PreferencesManager::toStoredBrightness(dayBrightness);
+        prefs.nightBrightness = PreferencesManager::toStoredBrightness(nightBrightness);
 
         prefs.nightStartHour = doc["nightStartHour"].as<uint8_t>();
         prefs.nightEndHour = doc["nightEndHour"].as<uint8_t>();
@@ -169,8 +203,12 @@ void handleSetPreferences() {
             return;
         }
 
+        // Only rewrite the storage files for fields that actually changed
+        uint8_t changed = PreferencesManager::diffDisplayPreferences(display->getDisplayPreferences(), prefs);
         display->setDisplayPreferences(prefs);
-        PreferencesManager::saveDisplayPreferences(prefs);
+        if (changed) {
+            PreferencesManager::saveDisplayPreferences(prefs, changed);
+        }
 
         server->send(200, "application/json", "{\"success\":true}");
 
@@ -184,7 +222,7 @@ void handleSetPreferences() {
 
 void handleOptionsPreferences() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
     
     addCorsHeaders(server);
@@ -193,7 +231,7 @@ void handleOptionsPreferences() {
 
 void handleCaptivePortal() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
     if (webManager.isInAPMode() && server->hostHeader() != WiFi.softAPIP().toString()) {
@@ -206,63 +244,149 @@ void handleCaptivePortal() {
 
 void handleIcon() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
-    String path = server->uri();
-    String iconName = path.substring(path.lastIndexOf('/') + 1);
-    
-    addCorsHeaders(server);
-    server->sendHeader("Cache-Control", "public, max-age=31536000");
-    server->sendHeader("Content-Type", "image/svg+xml");
-    
-    const char* iconContent = nullptr;
-    
-    if (iconName == "lock") {
-        iconContent = LOCK_ICON;
-    } 
-    else if (iconName == "signal-1") {
-        iconContent = SIGNAL_WEAK;
-    }
-    else if (iconName == "signal-2") {
-        iconContent = SIGNAL_FAIR;
-    }
-    else if (iconName == "signal-3") {
-        iconContent = SIGNAL_GOOD;
+    // Icons are requested as /icon.svg?name=<icon>; a trailing path segment
+    // is still accepted for routes registered under a prefix
+    String iconName = server->arg("name");
+    if (iconName.isEmpty()) {
+        String path = server->uri();
+        iconName = path.substring(path.lastIndexOf('/') + 1);
     }
-    else if (iconName == "signal-4") {
-        iconContent = SIGNAL_STRONG;
-    }
-    
-    if (iconContent) {
-        server->send(200, "image/svg+xml", iconContent);
+
+    addCorsHeaders(server);
+
+    const WebAsset* icon = findWebAsset(iconName.c_str());
+    if (icon && strcmp(icon->contentType, "image/svg+xml") == 0) {
+        sendWebAsset(server, *icon, "public, max-age=31536000");
     } else {
         server->send(404, "text/plain", "Icon not found");
     }
 }
 
+void handleStaticAsset() {
+    auto& webManager = WebServerManager::getInstance();
+    HttpServer* server = webManager.getServer();
+    if (!server) return;
+
+    // Pages reference shared assets with their content hash in the query, so
+    // a cached copy can never be stale and needs no revalidation
+    const WebAsset* asset = findWebAsset(server->uri().c_str() + 1);
+    if (!asset) {
+        server->send(404, "text/plain", "Not found");
+        return;
+    }
+    sendWebAsset(server, *asset, "public, max-age=31536000, immutable");
+}
+
 void handleGetRelayState() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
     addCorsHeaders(server);
-    
+
+    // Served from the relay state cache, never from the hub
     auto& relayHandler = RelayControlHandler::getInstance();
-    String response;
-    
-    if (!relayHandler.getRelayStates(response)) {
-        server->send(500, "application/json", "{\"error\":\"Failed to fetch relay status\"}");
+    RelayStatus statuses[RelayControlHandler::NUM_RELAYS];
+    uint32_t version = relayHandler.getCachedStates(statuses);
+    sendRelayStates(server, statuses, RelayControlHandler::NUM_RELAYS, relayHandler.getStateEpoch(), version);
+}
+
+void handleGetSchedule() {
+    auto& webManager = WebServerManager::getInstance();
+    HttpServer* server = webManager.getServer();
+    if (!server) return;
+
+    addCorsHeaders(server);
+    JsonStreamWriter json(server);
+    json.beginObject().field("success", true).key("rules");
+    RelayScheduler::getInstance().toJson(json);
+    json.endObject();
+}
+
+// Prometheus scrape target
+void handleMetrics() {
+    HttpServer* server = WebServerManager::getInstance().getServer();
+    if (!server) return;
+    Metrics::getInstance().render(server);
+}
+
+void handleSetSchedule() {
+    auto& webManager = WebServerManager::getInstance();
+    HttpServer* server = webManager.getServer();
+    if (!server) return;
+
+    addCorsHeaders(server);
+
+    if (!server->hasArg("plain")) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"No data received\"}");
+        return;
+    }
+
+    DynamicJsonDocument doc(4096);
+    DeserializationError error = deserializeJson(doc, server->arg("plain"));
+    if (error || !doc["rules"].is<JsonArray>()) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"Invalid JSON\"}");
+        return;
+    }
+
+    if (!RelayScheduler::getInstance().fromJson(doc["rules"].as<JsonArrayConst>())) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"Invalid schedule rule\"}");
+        return;
+    }
+
+    server->send(200, "application/json", "{\"success\":true}");
+}
+
+void handleEvents() {
+    auto& webManager = WebServerManager::getInstance();
+    HttpServer* server = webManager.getServer();
+    if (!server) return;
+
+    auto& events = EventStream::getInstance();
+    if (events.clientCount() >= EventStream::MAX_CLIENTS) {
+        addCorsHeaders(server);
+        server->send(503, "application/json", "{\"success\":false,\"error\":\"Too many event listeners\"}");
         return;
     }
 
-    // Pass the response directly since it's already in JSON format
-    server->send(200, "application/json", response);
+    // The stream takes over the socket and the request gets no regular
+    // response; if the snapshot can't be written the socket is just closed
+    WiFiClient client = server->client();
+    events.subscribe(client);
+}
+
+void handleRelaySocket() {
+    auto& webManager = WebServerManager::getInstance();
+    HttpServer* server = webManager.getServer();
+    if (!server) return;
+
+    String key = server->header("Sec-WebSocket-Key");
+    if (!server->header("Upgrade").equalsIgnoreCase("websocket") || key.isEmpty()) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"WebSocket upgrade expected\"}");
+        return;
+    }
+    if (server->header("Sec-WebSocket-Version") != "13") {
+        server->sendHeader("Sec-WebSocket-Version", "13");
+        server->send(426, "application/json", "{\"success\":false,\"error\":\"Unsupported WebSocket version\"}");
+        return;
+    }
+
+    auto& channel = RelaySocket::getInstance();
+    if (channel.clientCount() >= RelaySocket::MAX_CLIENTS) {
+        server->send(503, "application/json", "{\"success\":false,\"error\":\"Too many relay sockets\"}");
+        return;
+    }
+
+    // Like the event stream, the channel takes over the socket
+    channel.accept(server, key);
 }
 
 void handleSetRelayState() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
     addCorsHeaders(server);
@@ -295,18 +419,18 @@ void handleSetRelayState() {
     auto& relayHandler = RelayControlHandler::getInstance();
     RelayState newState = (stateStr == "ON") ? RelayState::ON : RelayState::OFF;
     
-    // Use setState which already handles authentication internally
-    if (relayHandler.setState(relayId, newState)) {
-        server->send(200, "application/json", "{\"success\":true}");
+    // The relay worker talks to the sensorHUB; answer as soon as it is queued
+    if (relayHandler.processCommand(relayId, newState, RelayCommandSource::USER)) {
+        server->send(202, "application/json", "{\"success\":true,\"pending\":true}");
     } else {
-        server->send(500, "application/json", 
-            "{\"success\":false,\"error\":\"Failed to set relay state\"}");
+        server->send(503, "application/json", 
+            "{\"success\":false,\"error\":\"Relay command queue unavailable\"}");
     }
 }
 
 void handleRelayControl() {
     auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+    HttpServer* server = webManager.getServer();
     if (!server) return;
 
     if (server->method() == HTTP_OPTIONS) {
@@ -328,38 +452,93 @@ void handleRelayControl() {
     server->send(405, "application/json", "{\"success\":false,\"error\":\"Method not allowed\"}");
 }
 
-void setupWebHandlers() {
-    auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
+// Sent by the resolver in place of a route that needs a session
+void handleUnauthorized() {
+    HttpServer* server = WebServerManager::getInstance().getServer();
     if (!server) return;
 
-    // Basic handlers
-    server->on("/", HTTP_GET, handleRoot);
-    server->onNotFound(handleCaptivePortal);
+    addCorsHeaders(server);
+    server->send(401, "application/json", "{\"success\":false,\"error\":\"Login required\"}");
+}
 
-    // WiFi configuration handlers
-    server->on("/scan", HTTP_GET, handleScan);
-    server->on("/connect", HTTP_POST, handleConnect);
-    
-    // Device preferences handlers
-    server->on("/api/preferences", HTTP_GET, handleGetPreferences);
-    server->on("/api/preferences", HTTP_POST, handleSetPreferences);
-    server->on("/api/preferences", HTTP_OPTIONS, handleOptionsPreferences);
-
-    // Relay control handlers
-    server->on("/api/relay", HTTP_GET, handleGetRelayState);
-    server->on("/api/relay", HTTP_POST, handleSetRelayState);
-    server->on("/api/relay", HTTP_OPTIONS, []() {
-        auto& webManager = WebServerManager::getInstance();
-        WebServer* server = webManager.getServer();
-        if (!server) return;
-        
-        addCorsHeaders(server);
-        server->send(204);
-    });
+void handleGetSession() {
+    HttpServer* server = WebServerManager::getInstance().getServer();
+    if (!server) return;
+
+    auto& auth = AuthenticationManager::getInstance();
+    bool enabled = auth.isEnabled();
+    JsonStreamWriter json(server);
+    json.beginObject()
+        .field("success", true)
+        .field("enabled", enabled)
+        .field("authenticated", !enabled || auth.validateCookie(server->header("Cookie")))
+        .endObject();
+}
+
+void handleLogin() {
+    HttpServer* server = WebServerManager::getInstance().getServer();
+    if (!server) return;
+
+    uint32_t address = server->remoteAddress();
+    if (!loginLimiter.canAttemptLogin(address)) {
+        unsigned long seconds = (loginLimiter.getRemainingBlockTime(address) + 999) / 1000;
+        server->sendHeader("Retry-After", String(seconds));
+        server->send(429, "application/json", "{\"success\":false,\"error\":\"Too many failed logins\"}");
+        return;
+    }
 
-    // Icon handler
-    server->on("/icon.svg", HTTP_GET, handleIcon);
+    StaticJsonDocument<256> doc;
+    if (!server->hasArg("plain") || deserializeJson(doc, server->arg("plain"))) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"Invalid JSON\"}");
+        return;
+    }
+
+    auto& auth = AuthenticationManager::getInstance();
+    if (!auth.validateCredentials(doc["username"] | "", doc["password"] | "")) {
+        loginLimiter.recordAttempt(address);
+        server->send(401, "application/json", "{\"success\":false,\"error\":\"Invalid username or password\"}");
+        return;
+    }
 
-    Serial.println("Web handlers initialized");
-}
\ No newline at end of file
+    loginLimiter.resetAttempts(address);
+    char token[AuthenticationManager::TOKEN_TEXT_SIZE];
+    auth.createSession(token);
+    sendSessionCookie(server, token);
+    server->send(200, "application/json", "{\"success\":true}");
+}
+
+void handleLogout() {
+    HttpServer* server = WebServerManager::getInstance().getServer();
+    if (!server) return;
+
+    AuthenticationManager::getInstance().invalidateCookie(server->header("Cookie"));
+    server->sendHeader("Set-Cookie", String(AuthenticationManager::COOKIE_NAME) +
+                                     "=; Path=/; Max-Age=0; HttpOnly; SameSite=Strict");
+    server->send(200, "application/json", "{\"success\":true}");
+}
+
+// Sets or replaces the web login. Open until the first credentials are set,
+// after that it needs a session; every other session ends.
+void handleSetCredentials() {
+    HttpServer* server = WebServerManager::getInstance().getServer();
+    if (!server) return;
+
+    StaticJsonDocument<256> doc;
+    if (!server->hasArg("plain") || deserializeJson(doc, server->arg("plain"))) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"Invalid JSON\"}");
+        return;
+    }
+
+    auto& auth = AuthenticationManager::getInstance();
+    if (!auth.setCredentials(doc["username"] | "", doc["password"] | "")) {
+        server->send(400, "application/json",
+            "{\"success\":false,\"error\":\"Username needs 3 characters and password 8\"}");
+        return;
+    }
+
+    // The caller stays signed in with a fresh session
+    char token[AuthenticationManager::TOKEN_TEXT_SIZE];
+    auth.createSession(token);
+    sendSessionCookie(server, token);
+    server->send(200, "application/json", "{\"success\":true}");
+}
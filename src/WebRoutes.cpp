@@ -0,0 +1,102 @@
+// WebRoutes.cpp
+#include "WebRoutes.h"
+#include "WebHandlers.h"
+
+namespace {
+
+struct WebRoute {
+    HTTPMethod method;
+    const char* path;
+    uint8_t modes;
+    HttpServer::RequestHandler handler;
+    bool session;       // Needs a login session once credentials are set
+};
+
+// Every route the device serves, registered once. /scan and /connect only
+// make sense while the setup access point is up, which its own password
+// guards. Pages, assets and the login calls stay open so a signed-out
+// browser can reach the login form.
+constexpr WebRoute ROUTES[] = {
+    {HTTP_GET, "/", ROUTE_ALL, handleRoot, false},
+    {HTTP_GET, "/app.css", ROUTE_ALL, handleStaticAsset, false},
+    {HTTP_GET, "/app.js", ROUTE_ALL, handleStaticAsset, false},
+    {HTTP_GET, "/icon.svg", ROUTE_ALL, handleIcon, false},
+    {HTTP_GET, "/scan", ROUTE_PORTAL, handleScan, false},
+    {HTTP_POST, "/connect", ROUTE_PORTAL, handleConnect, false},
+    {HTTP_GET, "/api/preferences", ROUTE_ALL, handleGetPreferences, true},
+    {HTTP_POST, "/api/preferences", ROUTE_ALL, handleSetPreferences, true},
+    {HTTP_OPTIONS, "/api/preferences", ROUTE_ALL, handleOptionsPreferences, false},
+    {HTTP_GET, "/api/relay", ROUTE_ALL, handleGetRelayState, true},
+    {HTTP_POST, "/api/relay", ROUTE_ALL, handleSetRelayState, true},
+    {HTTP_OPTIONS, "/api/relay", ROUTE_ALL, handleOptionsPreferences, false},
+    {HTTP_GET, "/api/relay/ws", ROUTE_ALL, handleRelaySocket, true},
+    {HTTP_GET, "/api/schedule", ROUTE_ALL, handleGetSchedule, true},
+    {HTTP_POST, "/api/schedule", ROUTE_ALL, handleSetSchedule, true},
+    {HTTP_OPTIONS, "/api/schedule", ROUTE_ALL, handleOptionsPreferences, false},
+    {HTTP_GET, "/api/events", ROUTE_ALL, handleEvents, true},
+    {HTTP_GET, "/metrics", ROUTE_ALL, handleMetrics, false},
+    {HTTP_GET, "/api/session", ROUTE_ALL, handleGetSession, false},
+    {HTTP_POST, "/api/login", ROUTE_ALL, handleLogin, false},
+    {HTTP_POST, "/api/logout", ROUTE_ALL, handleLogout, false},
+    {HTTP_POST, "/api/credentials", ROUTE_ALL, handleSetCredentials, true},
+};
+
+constexpr size_t ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);
+constexpr size_t SLOT_COUNT = 64;  // Power of two; sparse enough for a seed to be found quickly
+constexpr uint8_t EMPTY_SLOT = 0xFF;
+constexpr uint32_t MAX_SEED = 10000;
+
+static_assert(ROUTE_COUNT < EMPTY_SLOT && ROUTE_COUNT <= SLOT_COUNT / 2, "Route table too full for its slots");
+
+// FNV-1a over the method and the path, mixed with a seed
+constexpr uint32_t routeHash(uint32_t seed, HTTPMethod method, const char* path) {
+    uint32_t hash = (2166136261u ^ seed) * 16777619u;
+    hash = (hash ^ static_cast<uint8_t>(method)) * 16777619u;
+    for (; *path; path++) {
+        hash = (hash ^ static_cast<uint8_t>(*path)) * 16777619u;
+    }
+    return hash ^ (hash >> 16);
+}
+
+struct SlotTable {
+    uint32_t seed;
+    uint8_t slots[SLOT_COUNT];
+};
+
+// Tries seeds until every route lands in a slot of its own
+constexpr SlotTable buildSlotTable() {
+    for (uint32_t seed = 1; seed < MAX_SEED; seed++) {
+        SlotTable table = {seed, {}};
+        for (size_t i = 0; i < SLOT_COUNT; i++) {
+            table.slots[i] = EMPTY_SLOT;
+        }
+
+        bool collision = false;
+        for (size_t i = 0; i < ROUTE_COUNT && !collision; i++) {
+            size_t slot = routeHash(seed, ROUTES[i].method, ROUTES[i].path) & (SLOT_COUNT - 1);
+            collision = table.slots[slot] != EMPTY_SLOT;
+            table.slots[slot] = static_cast<uint8_t>(i);
+        }
+        if (!collision) return table;
+    }
+    return SlotTable{0, {}};
+}
+
+constexpr SlotTable SLOT_TABLE = buildSlotTable();
+static_assert(SLOT_TABLE.seed != 0, "No perfect hash seed for the route table");
+
+}
+
+HttpServer::RequestHandler findWebRoute(HTTPMethod method, const char* path, uint8_t modes, bool* needsSession) {
+    size_t slot = routeHash(SLOT_TABLE.seed, method, path) & (SLOT_COUNT - 1);
+    uint8_t index = SLOT_TABLE.slots[slot];
+    if (index == EMPTY_SLOT) return nullptr;
+
+    // A path that isn't in the table can still hash onto a used slot
+    const WebRoute& route = ROUTES[index];
+    if (route.method != method || strcmp(route.path, path) != 0 || !(route.modes & modes)) {
+        return nullptr;
+    }
+    if (needsSession) *needsSession = route.session;
+    return route.handler;
+}
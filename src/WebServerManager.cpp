@@ -1,15 +1,25 @@
 #include "WebServerManager.h"
 #include "WebHandlers.h"
+#include "WiFiScanner.h"
+#include "WebRoutes.h"
+#include "auth_manager.h"
+#include "EventStream.h"
+#include "RelaySocket.h"
 #include <WiFi.h>
 #include <esp_wifi.h>
 
+static_assert(HttpServer::MAX_WATCHED >= RelaySocket::MAX_CLIENTS + 1,
+              "The server must watch the DNS socket and every relay socket");
+
 class WebServerManager::WiFiEventHandler {
 public:
     uint8_t retry_count = 0;
 };
 
 WebServerManager::WebServerManager() 
-    : _currentMode(ServerMode::UNDEFINED)
+    : _dnsAddress(0)
+    , _dnsRetryAt(0)
+    , _currentMode(ServerMode::UNDEFINED)
     , _connectionStatus(ConnectionStatus::DISCONNECTED)
     , _initialized(false)
     , _lastReconnectAttempt(0)
@@ -73,7 +83,16 @@ bool WebServerManager::begin() {
     
     Serial.println("Starting WebServerManager initialization...");
     
-    _server = std::unique_ptr<WebServer>(new WebServer(80));
+    // One server for the device's lifetime; a mode switch only changes which
+    // routes the resolver lets through
+    static const char* collectedHeaders[] = {"If-None-Match", "Upgrade", "Sec-WebSocket-Key", "Sec-WebSocket-Version",
+                                             "Cookie"};
+    AuthenticationManager::getInstance().begin();
+    _server = std::unique_ptr<HttpServer>(new HttpServer(80));
+    _server->collectHeaders(collectedHeaders, sizeof(collectedHeaders) / sizeof(collectedHeaders[0]));
+    _server->setResolver(resolveRoute);
+    _server->onNotFound(handleCaptivePortal);
+    _server->setLoopHook([this]() { handleClient(); });
     _initialized = true;
 
     if (WiFi.status() == WL_CONNECTED) {
@@ -92,31 +111,37 @@ void WebServerManager::handleClient() {
     // Add debug logging
     static unsigned long lastLog = 0;
     if (millis() - lastLog > 5000) {  // Log every 5 seconds
-        Serial.printf("WebServer status - Mode: %d, Connected: %d\n", 
+        Serial.printf("WebServer status - Mode: %d, Connected: %d, Event clients: %u\n", 
             static_cast<int>(_currentMode),
-            WiFi.status() == WL_CONNECTED);
+            WiFi.status() == WL_CONNECTED,
+            EventStream::getInstance().clientCount());
         lastLog = millis();
     }
     
-    if (_dnsServer && _currentMode == ServerMode::PORTAL) {
-        _dnsServer->processNextRequest();
+    updateDNSServer();
+    if (_dns.isRunning()) {
+        _dns.poll();
     }
-    
-    _server->handleClient();
+
+    WiFiScanner::getInstance().poll();
+    EventStream::getInstance().loop();
+    RelaySocket::getInstance().loop();
 }
 
 void WebServerManager::stop() {
+    stopDNSServer();
     if (_server) {
+        // With the task gone the responder can be shut down from here
         _server->stop();
+        _server->unwatch(_dns.fd());
     }
-    stopDNSServer();
+    _dns.stop();
     WiFi.disconnect(true);
 }
 
 bool WebServerManager::startPortalMode() {
     if (!_initialized || !_server) return false;
     
-    clearHandlers();
     stopDNSServer();
     _currentMode = ServerMode::PORTAL;
     
@@ -140,7 +165,6 @@ bool WebServerManager::startPortalMode() {
         return false;
     }
     
-    setupHandlers();  // Register all handlers
     startDNSServer();
     _server->begin();
     
@@ -152,118 +176,31 @@ bool WebServerManager::startPortalMode() {
 bool WebServerManager::startPreferencesMode() {
     if (!_initialized || !_server) return false;
     
-    clearHandlers();
     stopDNSServer();
     _currentMode = ServerMode::PREFERENCES;
-    
-    setupHandlers();  // Register all handlers
     _server->begin();
     
     Serial.println("Preferences mode started successfully");
     return true;
 }
 
-void WebServerManager::setupPortalHandlers() {
-    _server->on("/", HTTP_GET, handleRoot);
-    _server->on("/scan", HTTP_GET, handleScan);
-    _server->on("/connect", HTTP_POST, handleConnect);
-    _server->on("/icon.svg", HTTP_GET, handleIcon);
-    _server->onNotFound(handleCaptivePortal);
-}
-
-void WebServerManager::setupPreferencesHandlers() {
-    if (!_server) return;
-
-    // Existing handlers...
-
-    // Add relay control handlers
-    _server->on("/api/preferences/relay", HTTP_GET, [this]() {
-        auto& handler = RelayControlHandler::getInstance();
-        
-        StaticJsonDocument<256> doc;
-        JsonArray relays = doc.createNestedArray("relays");
-        
-        for (uint8_t i = 0; i < RelayControlHandler::NUM_RELAYS; i++) {
-            RelayStatus status = handler.getRelayStatus(i);
-            JsonObject relay = relays.createNestedObject();
-            relay["relay_id"] = i;
-            relay["state"] = status.state == RelayState::ON ? "ON" : "OFF";
-            relay["override"] = status.override;
-        }
-        
-        String response;
-        serializeJson(doc, response);
-        this->_server->send(200, "application/json", response);
-    });
-
-    _server->on("/api/preferences/relay", HTTP_POST, [this]() {
-        if (!this->_server->hasArg("plain")) {
-            this->_server->send(400, "application/json", "{\"error\":\"No data received\"}");
-            return;
-        }
-
-        StaticJsonDocument<128> doc;
-        DeserializationError error = deserializeJson(doc, this->_server->arg("plain"));
-        
-        if (error) {
-            this->_server->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
-            return;
-        }
-
-        if (!doc.containsKey("relay_id") || !doc.containsKey("state")) {
-            this->_server->send(400, "application/json", "{\"error\":\"Missing required fields\"}");
-            return;
-        }
-
-        uint8_t relayId = doc["relay_id"].as<uint8_t>();
-        const char* stateStr = doc["state"].as<const char*>();
-        
-        if (relayId >= RelayControlHandler::NUM_RELAYS) {
-            this->_server->send(400, "application/json", "{\"error\":\"Invalid relay ID\"}");
-            return;
-        }
-
-        RelayState newState = (strcmp(stateStr, "ON") == 0) ? RelayState::ON : RelayState::OFF;
-        RelayControlHandler::getInstance().processCommand(relayId, newState, RelayCommandSource::USER);
-        
-        this->_server->send(200, "application/json", "{\"success\":true}");
-    });
-}
-
-void WebServerManager::setupHandlers() {
-    if (!_server) return;
+HttpServer::RequestHandler WebServerManager::resolveRoute(HTTPMethod method, const char* uri) {
+    uint8_t modes = 0;
+    switch (getInstance()._currentMode) {
+        case ServerMode::PORTAL: modes = ROUTE_PORTAL; break;
+        case ServerMode::PREFERENCES: modes = ROUTE_PREFERENCES; break;
+        default: break;
+    }
 
-    // Register core handlers
-    _server->on("/", HTTP_GET, handleRoot);
-    _server->on("/scan", HTTP_GET, handleScan);
-    _server->on("/connect", HTTP_POST, handleConnect);
-    _server->on("/icon.svg", HTTP_GET, handleIcon);
-    
-    // Register API handlers
-    _server->on("/api/preferences", HTTP_GET, handleGetPreferences);
-    _server->on("/api/preferences", HTTP_POST, handleSetPreferences);
-    _server->on("/api/preferences", HTTP_OPTIONS, handleOptionsPreferences);
-    
-    // Register relay handlers
-    _server->on("/api/relay", HTTP_GET, handleGetRelayState);
-    _server->on("/api/relay", HTTP_POST, handleSetRelayState);
-    _server->on("/api/relay", HTTP_OPTIONS, [this]() {
-        if (_server) {
-            addCorsHeaders();
-            _server->send(204);
+    bool needsSession = false;
+    HttpServer::RequestHandler handler = findWebRoute(method, uri, modes, &needsSession);
+    if (handler && needsSession) {
+        AuthenticationManager& auth = AuthenticationManager::getInstance();
+        if (auth.isEnabled() && !auth.validateCookie(getInstance()._server->header("Cookie"))) {
+            return handleUnauthorized;
         }
-    });
-
-    // Must be last - handle captive portal and 404s
-    _server->onNotFound(handleCaptivePortal);
-}
-
-
-void WebServerManager::addCorsHeaders() {
-    if (!_server) return;
-    _server->sendHeader("Access-Control-Allow-Origin", "*");
-    _server->sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
-    _server->sendHeader("Access-Control-Allow-Headers", "Content-Type");
+    }
+    return handler;
 }
 
 void WebServerManager::setWiFiCredentials(const String& ssid, const String& password) {
@@ -345,24 +282,34 @@ bool WebServerManager::validateConnection() {
     return true;
 }
 
-void WebServerManager::clearHandlers() {
-    if (_server) {
-        _server->stop();
-        _server = std::unique_ptr<WebServer>(new WebServer(80));
-    }
-}
-
 void WebServerManager::startDNSServer() {
-    stopDNSServer();
-    _dnsServer = std::unique_ptr<DNSServer>(new DNSServer());
-    _dnsServer->start(53, "*", WiFi.softAPIP());
+    _dnsAddress = static_cast<uint32_t>(WiFi.softAPIP());
 }
 
 void WebServerManager::stopDNSServer() {
-    if (_dnsServer) {
-        _dnsServer->stop();
-        _dnsServer.reset();
+    _dnsAddress = 0;
+}
+
+// Brings the responder in line with _dnsAddress. Runs on the server task, so
+// the socket is never closed under a select() or a poll.
+void WebServerManager::updateDNSServer() {
+    uint32_t address = _dnsAddress;
+    if (_dns.isRunning() && _dns.address() == address) return;
+
+    if (_dns.isRunning()) {
+        _server->unwatch(_dns.fd());
+        _dns.stop();
+        Serial.println("[DNS] Stopped");
+    }
+    if (address == 0 || (long)(millis() - _dnsRetryAt) < 0) return;
+
+    if (_dns.begin(address)) {
+        if (_server->watch(_dns.fd())) return;
+        // Unwatched, it would only be read on the select() timeout; retry later
+        Serial.println("[DNS] No watch slot left");
+        _dns.stop();
     }
+    _dnsRetryAt = millis() + DNS_RETRY_INTERVAL;
 }
 
 WebServerManager& WebServerManager::getInstance() {
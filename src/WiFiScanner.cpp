@@ -0,0 +1,98 @@
+// WiFiScanner.cpp
+#include "WiFiScanner.h"
+#include <WiFi.h>
+
+WiFiScanner& WiFiScanner::getInstance() {
+    static WiFiScanner instance;
+    return instance;
+}
+
+WiFiScanner::WiFiScanner()
+    : networkCount(0)
+    , hasResults(false)
+    , scanning(false)
+    , lastScan(0)
+    , scanStarted(0) {
+}
+
+void WiFiScanner::requestScan() {
+    if (scanning) return;
+    if (hasResults && millis() - lastScan < CACHE_TTL) return;
+
+    // Async: returns at once and the driver fills in the results meanwhile
+    if (WiFi.scanNetworks(true) == WIFI_SCAN_FAILED) {
+        Serial.println("[SCAN] Failed to start WiFi scan");
+        return;
+    }
+    scanning = true;
+    scanStarted = millis();
+}
+
+void WiFiScanner::poll() {
+    if (!scanning) return;
+
+    int16_t found = WiFi.scanComplete();
+    if (found == WIFI_SCAN_RUNNING) {
+        if (millis() - scanStarted < SCAN_TIMEOUT) return;
+        Serial.println("[SCAN] WiFi scan timed out");
+        WiFi.scanDelete();
+        scanning = false;
+        return;
+    }
+
+    scanning = false;
+    if (found < 0) {
+        // Keep serving the previous results
+        Serial.println("[SCAN] WiFi scan failed");
+        return;
+    }
+
+    networkCount = 0;
+    for (int16_t i = 0; i < found; i++) {
+        const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(i));
+        if (!record || record->ssid[0] == '\0') continue;  // Hidden networks can't be picked anyway
+        insert(reinterpret_cast<const char*>(record->ssid), record->rssi, record->authmode != WIFI_AUTH_OPEN);
+    }
+    WiFi.scanDelete();
+
+    hasResults = true;
+    lastScan = millis();
+    Serial.printf("[SCAN] %d network(s) found, %u kept\n", found, (unsigned)networkCount);
+}
+
+void WiFiScanner::insert(const char* ssid, int8_t rssi, bool encrypted) {
+    // Kept sorted strongest first, so a full table drops the weakest
+    size_t index = networkCount;
+    while (index > 0 && networks[index - 1].rssi < rssi) {
+        index--;
+    }
+    if (index >= MAX_NETWORKS) return;
+
+    size_t last = networkCount < MAX_NETWORKS ? networkCount : MAX_NETWORKS - 1;
+    memmove(&networks[index + 1], &networks[index], (last - index) * sizeof(Network));
+    if (networkCount < MAX_NETWORKS) networkCount++;
+
+    Network& network = networks[index];
+    strlcpy(network.ssid, ssid, sizeof(network.ssid));
+    network.rssi = rssi;
+    network.encrypted = encrypted;
+}
+
+void WiFiScanner::toJson(JsonStreamWriter& json) const {
+    json.beginObject().field("scanning", scanning);
+    if (hasResults) {
+        json.field("age", (millis() - lastScan) / 1000);
+    } else {
+        json.key("age").null();
+    }
+
+    json.beginArray("networks");
+    for (size_t i = 0; i < networkCount; i++) {
+        json.beginObject()
+            .field("ssid", networks[i].ssid)
+            .field("rssi", networks[i].rssi)
+            .field("encrypted", networks[i].encrypted)
+            .endObject();
+    }
+    json.endArray().endObject();
+}
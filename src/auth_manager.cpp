@@ -1,40 +1,55 @@
 #include "auth_manager.h"
-#include "CustomHash.h"
 #include <Preferences.h>
+#include <esp_system.h>
 
 // Define static class members
 const char* AuthenticationManager::PREF_NAMESPACE = "auth";
+const char AuthenticationManager::COOKIE_NAME[] = "session";
 const uint8_t AuthenticationManager::MIN_USERNAME_LENGTH;  // Value already defined in header
 const uint8_t AuthenticationManager::MIN_PASSWORD_LENGTH;  // Value already defined in header
 
-bool AuthenticationManager::validateCredentials(const String& username, const String& password) {
-    // Early validation for empty credentials
-    if (username.isEmpty() || password.isEmpty()) {
-        return false;
-    }
-    
-    // Get stored values from preferences
+AuthenticationManager& AuthenticationManager::getInstance() {
+    static AuthenticationManager instance;
+    return instance;
+}
+
+AuthenticationManager::AuthenticationManager()
+    : enabled(false) {
+    memset(usernameHash, 0, sizeof(usernameHash));
+    memset(passwordHash, 0, sizeof(passwordHash));
+    invalidateAll();
+}
+
+void AuthenticationManager::begin() {
     Preferences preferences;
     preferences.begin(PREF_NAMESPACE, true);  // Read-only mode
-    
-    String storedUsername = preferences.getString("username", "");
+    storedUsername = preferences.getString("username", "");
     String storedHash = preferences.getString("password_hash", "");
-    
     preferences.end();
-    
-    // Verify username first
-    if (storedUsername != username) {
-        return false;
+
+    // The hash is stored as hex; a malformed one leaves the UI open rather
+    // than locking everyone out
+    enabled = !storedUsername.isEmpty() && storedHash.length() == CustomHash::SHA256_SIZE * 2 &&
+              parseHex(storedHash.c_str(), passwordHash, sizeof(passwordHash));
+    if (enabled) {
+        CustomHash::sha256(storedUsername, usernameHash);
     }
-    
-    // If we have no stored hash, authentication fails
-    if (storedHash.isEmpty()) {
+    Serial.printf("[AUTH] Web login %s\n", enabled ? "enabled" : "disabled, no credentials set");
+}
+
+bool AuthenticationManager::validateCredentials(const String& username, const String& password) const {
+    if (!enabled || username.isEmpty() || password.isEmpty()) {
         return false;
     }
-    
-    // Calculate hash of provided password and compare
-    String calculatedHash = CustomHash::sha256(password);
-    return calculatedHash.equals(storedHash);
+
+    // Both digests are always compared, so timing says nothing about which
+    // of the two was wrong
+    uint8_t digest[CustomHash::SHA256_SIZE];
+    CustomHash::sha256(username, digest);
+    bool usernameMatches = constantTimeEquals(digest, usernameHash, sizeof(digest));
+    CustomHash::sha256(password, digest);
+    bool passwordMatches = constantTimeEquals(digest, passwordHash, sizeof(digest));
+    return usernameMatches & passwordMatches;
 }
 
 bool AuthenticationManager::setCredentials(const String& username, const String& password) {
@@ -42,60 +57,120 @@ bool AuthenticationManager::setCredentials(const String& username, const String&
     if (username.length() < MIN_USERNAME_LENGTH || password.length() < MIN_PASSWORD_LENGTH) {
         return false;
     }
-    
-    // Generate password hash
-    String passwordHash = CustomHash::sha256(password);
-    
-    // Store credentials
+
+    // Stored as hex, as before, so existing credentials keep working
     Preferences preferences;
     preferences.begin(PREF_NAMESPACE, false);  // Write mode
-    
-    bool success = preferences.putString("username", username) && 
-                  preferences.putString("password_hash", passwordHash);
-    
+    bool success = preferences.putString("username", username) &&
+                   preferences.putString("password_hash", CustomHash::sha256(password));
     preferences.end();
-    return success;
+    if (!success) return false;
+
+    storedUsername = username;
+    CustomHash::sha256(username, usernameHash);
+    CustomHash::sha256(password, passwordHash);
+    enabled = true;
+    invalidateAll();
+    return true;
 }
 
-String AuthenticationManager::getStoredUsername() {
-    Preferences preferences;
-    preferences.begin(PREF_NAMESPACE, true);  // Read-only mode
-    String username = preferences.getString("username", "");
-    preferences.end();
-    
-    return username;
+void AuthenticationManager::createSession(char (&token)[TOKEN_TEXT_SIZE]) {
+    unsigned long now = millis();
+    Session* slot = &sessions[0];
+    for (Session& session : sessions) {
+        if (!session.used || now - session.lastUsed > SESSION_IDLE_TIMEOUT) {
+            slot = &session;
+            break;
+        }
+        if (now - session.lastUsed > now - slot->lastUsed) {
+            slot = &session;
+        }
+    }
+
+    esp_fill_random(slot->token, sizeof(slot->token));
+    slot->used = true;
+    slot->lastUsed = now;
+
+    for (size_t i = 0; i < TOKEN_SIZE; i++) {
+        snprintf(token + i * 2, 3, "%02x", slot->token[i]);
+    }
 }
 
-// Constructor implementation
-AuthenticationManager::AuthenticationManager() : 
-    currentToken(""),
-    tokenCreationTime(0) {
-    // Initialization code if needed
+bool AuthenticationManager::validateCookie(const String& cookieHeader) {
+    int index = findSession(cookieHeader);
+    if (index < 0) return false;
+    sessions[index].lastUsed = millis();
+    return true;
 }
 
-String AuthenticationManager::generateToken() {
-    // Simple token generation
-    String token = String(random(0xFFFFFFFF), HEX);
-    currentToken = token;
-    tokenCreationTime = millis();
-    return token;
+void AuthenticationManager::invalidateCookie(const String& cookieHeader) {
+    int index = findSession(cookieHeader);
+    if (index >= 0) sessions[index].used = false;
 }
 
-bool AuthenticationManager::validateToken(const String& providedToken) {
-    if (currentToken.isEmpty() || providedToken.isEmpty()) {
-        return false;
+void AuthenticationManager::invalidateAll() {
+    for (Session& session : sessions) {
+        session.used = false;
+        session.lastUsed = 0;
     }
-    
-    // Check token expiry
-    if (millis() - tokenCreationTime > TOKEN_EXPIRY) {
-        invalidateToken();
-        return false;
+}
+
+int AuthenticationManager::findSession(const String& cookieHeader) {
+    uint8_t token[TOKEN_SIZE];
+    if (!parseToken(cookieHeader, token)) return -1;
+
+    // Every live session is compared in full, whichever one matches
+    int found = -1;
+    for (size_t i = 0; i < MAX_SESSIONS; i++) {
+        if (sessions[i].used && constantTimeEquals(token, sessions[i].token, TOKEN_SIZE)) {
+            found = i;
+        }
+    }
+    if (found < 0) return -1;
+
+    if (millis() - sessions[found].lastUsed > SESSION_IDLE_TIMEOUT) {
+        sessions[found].used = false;
+        return -1;
     }
-    
-    return currentToken.equals(providedToken);
+    return found;
 }
 
-void AuthenticationManager::invalidateToken() {
-    currentToken = "";
-    tokenCreationTime = 0;
-}
\ No newline at end of file
+bool AuthenticationManager::parseToken(const String& cookieHeader, uint8_t (&token)[TOKEN_SIZE]) {
+    const size_t nameLength = sizeof(COOKIE_NAME) - 1;
+    const char* p = cookieHeader.c_str();
+    while (*p) {
+        while (*p == ' ') p++;
+        const char* end = strchr(p, ';');
+        size_t length = end ? static_cast<size_t>(end - p) : strlen(p);
+
+        if (length == nameLength + 1 + TOKEN_SIZE * 2 && strncmp(p, COOKIE_NAME, nameLength) == 0 &&
+            p[nameLength] == '=') {
+            return parseHex(p + nameLength + 1, token, TOKEN_SIZE);
+        }
+        if (!end) break;
+        p = end + 1;
+    }
+    return false;
+}
+
+bool AuthenticationManager::parseHex(const char* text, uint8_t* out, size_t size) {
+    for (size_t i = 0; i < size * 2; i++) {
+        char c = text[i];
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') nibble = c - '0';
+        else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+        else return false;
+        out[i / 2] = (i % 2) ? (out[i / 2] | nibble) : (nibble << 4);
+    }
+    return true;
+}
+
+bool AuthenticationManager::constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t length) {
+    // Volatile keeps the compiler from turning this back into an early exit
+    volatile uint8_t difference = 0;
+    for (size_t i = 0; i < length; i++) {
+        difference |= a[i] ^ b[i];
+    }
+    return difference == 0;
+}
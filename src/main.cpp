@@ -14,8 +14,16 @@
 #include "config.h"
 #include "PreferencesManager.h"
 #include "RelayControlHandler.h" 
+#include "RelaySocket.h"
+#include "SensorDocument.h"
 #include "WebHandlers.h"
 #include "BabelSensor.h"
+#include "RemoteConfig.h"
+#include "SensorHubAuth.h"
+#include "RelayScheduler.h"
+#include "RemoteSensorSet.h"
+#include "RemoteSourceArbiter.h"
+#include "Metrics.h"
 
 // System Constants
 constexpr uint32_t BOOT_DELAY_MS = 250;
@@ -29,11 +37,13 @@ extern GlobalState* g_state;
 extern QueueHandle_t displayQueue;
 extern QueueHandle_t sensorQueue;
 extern RelayControlHandler* g_relayHandler;
+extern TaskHandle_t displayTaskHandle;
+extern TaskHandle_t sensorTaskHandle;
 
 // Local global objects that are only used in main.cpp
 static DisplayHandler* display = nullptr;
 static BME280Handler bme280;
-static MQTTManager mqtt;
+static MQTTManager& mqtt = MQTTManager::getInstance();
 BabelSensor babelSensor(API_SERVER_URL);
 
 // Task Declarations
@@ -41,9 +51,12 @@ void displayTask(void* parameter);
 void sensorTask(void* parameter);
 
 static unsigned long lastWdtReset = 0;
-static const unsigned long REMOTE_TEMP_UPDATE_INTERVAL = 30000; // 30 seconds between sensor reads
 static unsigned long lastRemoteTempUpdate = 0;
-static float lastBabelTemp = 0.0;
+static unsigned long lastBabelReadAt = 0;
+static uint32_t lastRemoteSensorsVersion = 0;
+static unsigned long lastRemoteSensorsPublish = 0;
+static const unsigned long REMOTE_PUBLISH_INTERVAL = 10000;  // At most one remote set publish per 10 s
+static RemoteSourceArbiter remoteArbiter;
 
 // Store device ID globally so it can be used for mDNS later
 char deviceIdString[5] = {0};
@@ -183,10 +196,6 @@ bool initializeSystem() {
 }
 
 void setupRelayControl() {
-    auto& webManager = WebServerManager::getInstance();
-    WebServer* server = webManager.getServer();
-    if (!server) return;
-
     // Initialize the global relay handler instance
     g_relayHandler = &RelayControlHandler::getInstance();
     if (!g_relayHandler->begin()) {
@@ -194,10 +203,19 @@ void setupRelayControl() {
         return;
     }
     
-    // Register relay web handlers
-    server->on("/api/relay", HTTP_GET, handleGetRelayState);
-    server->on("/api/relay", HTTP_POST, handleSetRelayState);
-    
+    RelaySocket::Relays relays = {
+        [](uint8_t relayId, RelayState state, uint32_t tag) {
+            return g_relayHandler->processCommand(relayId, state, RelayCommandSource::USER, tag);
+        },
+        [](uint8_t relayId) { return g_relayHandler->getRelayStatus(relayId).state; }
+    };
+    auto onCompletion = [](const RelayCommand& command, bool success) {
+        RelaySocket::getInstance().completed(command, success);
+    };
+    if (!RelaySocket::getInstance().begin(relays) || !g_relayHandler->addCompletionListener(onCompletion)) {
+        Serial.println("Warning: relay WebSocket channel failed to start");
+    }
+
     Serial.println("Relay control initialized successfully");
 }
 
@@ -253,7 +271,7 @@ void createTasks() {
         TASK_STACK_SIZE,
         nullptr,
         1,
-        nullptr,
+        &displayTaskHandle,
         1
     );
 
@@ -263,9 +281,25 @@ void createTasks() {
         TASK_STACK_SIZE,
         nullptr,
         1,
-        nullptr,
+        &sensorTaskHandle,
         0
     );
+
+    Metrics& metrics = Metrics::getInstance();
+    metrics.registerTask("Display", displayTaskHandle);
+    metrics.registerTask("Sensor", sensorTaskHandle);
+}
+
+// Publishes every fresh remote sensor as one retained {"<id>": value} document
+bool publishRemoteSensors() {
+    RemoteSensorSet::Reading readings[RemoteSensorSet::MAX_SENSORS];
+    size_t count = RemoteSensorSet::getInstance().snapshot(readings, RemoteSensorSet::MAX_SENSORS);
+
+    StaticJsonDocument<512> doc;
+    for (size_t i = 0; i < count; i++) {
+        doc[readings[i].id] = roundf(readings[i].value * 10.0f) / 10.0f;
+    }
+    return mqtt.publishJson(MQTT_TOPIC_REMOTE_SENSORS, doc, true);
 }
 
 void setup() {
@@ -273,6 +307,7 @@ void setup() {
     delay(100);
     
     Serial.println("System starting...");
+    Metrics::getInstance().registerTask("Loop", xTaskGetCurrentTaskHandle());
 
     if (!initializeSystem()) {
         Serial.println("System initialization failed");
@@ -301,25 +336,40 @@ void setup() {
     esp_task_wdt_init(WDT_TIMEOUT_S, true);
     esp_task_wdt_add(nullptr);
 
+    // One sensorHUB login shared by relay control and BabelSensor
+    if (!SensorHubAuth::getInstance().begin()) {
+        Serial.println("Warning: sensorHUB token service failed to start");
+    }
+
     // Create system tasks
     createTasks();
     setupRelayControl();
     
-    // Register relay callback
-    mqtt.setCallback([](char* topic, uint8_t* payload, unsigned int length) {
-        // Convert payload to String for easier handling
-        String payloadStr((char*)payload, length);
-        RelayControlHandler::handleMqttMessage(topic, payloadStr);
+    // Route relay commands straight from the MQTT receive buffer
+    mqtt.route(MQTT_TOPIC_RELAY_COMMAND, RelayControlHandler::handleMqttMessage);
+    // Only the per-sensor topics: the full list the hub publishes on the base
+    // topic is several kB, past MQTTManager::BUFFER_SIZE, and PubSubClient
+    // drops such a message without a word. The list is polled over HTTP.
+    mqtt.route(MQTT_TOPIC_HUB_SENSORS "/+", [](const char* topic, MQTTPayload payload) {
+        if (babelSensor.applyMqttPayload(payload)) {
+            remoteArbiter.onMqttReading(millis());
+        }
     });
+    mqtt.setQueueDepthProbe([]() {
+        return RelayControlHandler::getInstance().getPendingCommands();
+    });
+
+    // Fleet configuration arrives on a retained topic
+    RemoteConfig::begin(mqtt);
+
+    // Timed and sensor-conditioned relay rules; idle until NTP sets the clock
+    if (!RelayScheduler::getInstance().begin()) {
+        Serial.println("Warning: relay scheduler failed to start");
+    }
 
-    // Initialize BabelSensor
+    // Initialize BabelSensor; it shares the hub token with relay control
     if (babelSensor.init()) {
         Serial.println("BabelSensor initialized");
-        if (babelSensor.login(API_USERNAME, API_PASSWORD)) {
-            Serial.println("BabelSensor authenticated successfully");
-        } else {
-            Serial.println("BabelSensor authentication failed - will retry in loop");
-        }
     } else {
         Serial.println("BabelSensor initialization failed");
     }
@@ -329,6 +379,7 @@ void setup() {
 
 void loop() {
     const unsigned long now = millis();
+    const unsigned long started = micros();
 
     // Watchdog handling
     if (now - lastWdtReset >= 1000) {
@@ -336,10 +387,10 @@ void loop() {
         lastWdtReset = now;
     }
     
-    // Handle web server requests if network is up
+    // Web requests are served by the HTTP server task; keep MQTT up while the network is
     if (WiFi.status() == WL_CONNECTED) {
-        WebServerManager::getInstance().handleClient();
         mqtt.maintainConnection();
+        RelayControlHandler::getInstance().loop();
     } else {
         // Attempt reconnection periodically if network is down
         static unsigned long lastReconnectAttempt = 0;
@@ -350,16 +401,38 @@ void loop() {
         }
     }
 
-    // Update remote temperature at fixed interval if network is up
-    if (WiFi.status() == WL_CONNECTED && now - lastRemoteTempUpdate >= REMOTE_TEMP_UPDATE_INTERVAL) {
-        float remoteTemp = babelSensor.getRemoteTemperature();
-        if (remoteTemp != 0.0 && remoteTemp != lastBabelTemp) {
-            g_state->setRemoteTemperature(remoteTemp);
-            lastBabelTemp = remoteTemp;
-        }
+    // Remote readings normally arrive over MQTT; the hub is polled over HTTP
+    // only while the arbiter considers the MQTT feed stale
+    if (remoteArbiter.update(now) == RemoteSource::HTTP &&
+        WiFi.status() == WL_CONNECTED && now - lastRemoteTempUpdate >= babelSensor.getPollInterval()) {
+        unsigned long readStarted = micros();
+        babelSensor.getRemoteTemperature();
+        Metrics::getInstance().sensorHubRead.record(micros() - readStarted);
         lastRemoteTempUpdate = now;
-    }  
-    
+    }
+
+    // Handed on each time the hub reports or confirms it, so the scheduler
+    // can tell a current value from one the hub stopped sending
+    unsigned long remoteReadAt = babelSensor.getLastReadingTime();
+    if (remoteReadAt != lastBabelReadAt) {
+        g_state->setRemoteTemperature(babelSensor.getLastTemperature(), remoteReadAt);
+        lastBabelReadAt = remoteReadAt;
+    }
+
+    // Publish the remote sensor set when it changed, whichever source fed it
+    uint32_t remoteVersion = RemoteSensorSet::getInstance().getVersion();
+    if (remoteVersion != lastRemoteSensorsVersion && now - lastRemoteSensorsPublish >= REMOTE_PUBLISH_INTERVAL &&
+        mqtt.connected() && publishRemoteSensors()) {
+        lastRemoteSensorsVersion = remoteVersion;
+        lastRemoteSensorsPublish = now;
+    }
+
+    Metrics& metrics = Metrics::getInstance();
+    metrics.loopLatency.record(micros() - started);
+    if (metrics.sample()) {
+        g_state->updateSystemStats(metrics.getHeapFree(), metrics.getUptime());
+    }
+
     delay(10);
 }
 
@@ -413,9 +486,25 @@ void displayTask(void* parameter) {
             case DisplayMode::PRESSURE:
                 display->showPressure(g_state->getPressure());
                 break;
-            case DisplayMode::REMOTE_TEMP:
-                display->showRemoteTemp(g_state->getRemoteTemperature());
+            case DisplayMode::REMOTE_TEMP: {
+                // One slot per fresh remote sensor, each opened by its number
+                // when there is more than one
+                RemoteSensorSet& remotes = RemoteSensorSet::getInstance();
+                size_t sensors = remotes.freshCount();
+                display->setRemoteSlots(sensors);
+
+                unsigned long elapsed = display->getModeElapsed();
+                size_t slot = sensors > 0 ? (elapsed / DISPLAY_REMOTE_DURATION) % sensors : 0;
+                RemoteSensorSet::Reading reading;
+                if (sensors > 1 && elapsed % DISPLAY_REMOTE_DURATION < DISPLAY_REMOTE_LABEL_DURATION) {
+                    display->showRemoteIndex(slot);
+                } else if (remotes.getFresh(slot, reading)) {
+                    display->showRemoteTemp(reading.value);
+                } else {
+                    display->showRemoteTemp(g_state->getRemoteTemperature());
+                }
                 break;
+            }
         }
 
         display->update();
@@ -426,11 +515,19 @@ void displayTask(void* parameter) {
 void sensorTask(void* parameter) {
     TickType_t lastWakeTime = xTaskGetTickCount();
     const TickType_t frequency = pdMS_TO_TICKS(2000);  // 0.5Hz measurement rate
+    unsigned long lastStatePublish = 0;
     
     while (true) {
         esp_task_wdt_reset();
 
-        if (g_state->isBMEWorking() && bme280.takeMeasurement()) {
+        bool measured = false;
+        if (g_state->isBMEWorking()) {
+            unsigned long readStarted = micros();
+            measured = bme280.takeMeasurement();
+            Metrics::getInstance().bme280Read.record(micros() - readStarted);
+        }
+
+        if (measured) {
             float temperature = bme280.getTemperature();
             float humidity = bme280.getHumidity();
             float pressure = bme280.getPressure();
@@ -442,10 +539,20 @@ void sensorTask(void* parameter) {
                 g_state->updateSensorData(temperature, humidity, pressure);
                 
                 if (mqtt.connected()) {
-                    char payload[64];
+                    char payload[SensorDocument::MAX_LENGTH];
                     snprintf(payload, sizeof(payload), "%.1f", temperature);
                     String sensorTopic = String(MQTT_TOPIC_AUX_DISPLAY) + "/sensors";
                     mqtt.publish(sensorTopic.c_str(), payload);
+
+                    // Combined state document consumed by Home Assistant
+                    unsigned long now = millis();
+                    if (lastStatePublish == 0 || now - lastStatePublish >= MQTT_PUBLISH_INTERVAL) {
+                        size_t length = SensorDocument::format(payload, sizeof(payload), temperature, humidity,
+                                                               pressure, g_state->getRemoteTemperature());
+                        if (length > 0 && mqtt.publish(MQTT_TOPIC_STATE, payload, false)) {
+                            lastStatePublish = now;
+                        }
+                    }
                 }
             }
         }
@@ -3,54 +3,115 @@
 // Define static constants
 const int RateLimiter::MAX_ATTEMPTS = 5;
 const unsigned long RateLimiter::BLOCK_DURATION = 15 * 60 * 1000;  // 15 minutes
+const size_t RateLimiter::MAX_CLIENTS;  // Value already defined in header
 
 RateLimiter::RateLimiter() {
     // Initialize all tracking values to zero
-    loginAttempts = {0, 0, 0};
+    for (AttemptRecord& record : records) {
+        record = {false, 0, 0, 0, 0};
+    }
 }
 
-bool RateLimiter::canAttemptLogin() {
+bool RateLimiter::canAttemptLogin(uint32_t address) {
     unsigned long now = millis();
+    AttemptRecord* record = find(address);
+    if (!record) {
+        return true;
+    }
     
     // Check if still blocked from previous attempts
-    if (now < loginAttempts.blockUntil) {
+    if (isBlocked(*record, now)) {
         return false;
     }
     
     // Reset block if enough time has passed
-    if (now - loginAttempts.lastAttemptTime > BLOCK_DURATION) {
-        loginAttempts.attempts = 0;
+    if (now - record->lastAttemptTime >= BLOCK_DURATION) {
+        record->attempts = 0;
     }
     
     // Allow login if max attempts not reached
-    return loginAttempts.attempts < MAX_ATTEMPTS;
+    return record->attempts < MAX_ATTEMPTS;
 }
 
-void RateLimiter::recordAttempt() {
+void RateLimiter::recordAttempt(uint32_t address) {
     unsigned long now = millis();
+    AttemptRecord& record = findOrAdd(address, now);
+
+    // Failures spread over more than a block period don't add up
+    if (now - record.lastAttemptTime >= BLOCK_DURATION) {
+        record.attempts = 0;
+    }
     
-    loginAttempts.attempts++;
-    loginAttempts.lastAttemptTime = now;
+    record.attempts++;
+    record.lastAttemptTime = now;
     
     // If max attempts reached, block further attempts
-    if (loginAttempts.attempts >= MAX_ATTEMPTS) {
-        loginAttempts.blockUntil = now + BLOCK_DURATION;
+    if (record.attempts >= MAX_ATTEMPTS) {
+        record.blockUntil = now + BLOCK_DURATION;
     }
 }
 
-void RateLimiter::resetAttempts() {
-    loginAttempts.attempts = 0;
-    loginAttempts.blockUntil = 0;
+void RateLimiter::resetAttempts(uint32_t address) {
+    AttemptRecord* record = find(address);
+    if (record) {
+        record->used = false;
+    }
 }
 
-unsigned long RateLimiter::getRemainingBlockTime() {
+unsigned long RateLimiter::getRemainingBlockTime(uint32_t address) {
     unsigned long now = millis();
+    AttemptRecord* record = find(address);
     
     // If not blocked, return 0
-    if (now >= loginAttempts.blockUntil) {
+    if (!record || !isBlocked(*record, now)) {
         return 0;
     }
     
     // Return remaining block time
-    return loginAttempts.blockUntil - now;
-}
\ No newline at end of file
+    return record->blockUntil - now;
+}
+
+RateLimiter::AttemptRecord* RateLimiter::find(uint32_t address) {
+    for (AttemptRecord& record : records) {
+        if (record.used && record.address == address) {
+            return &record;
+        }
+    }
+    return nullptr;
+}
+
+RateLimiter::AttemptRecord& RateLimiter::findOrAdd(uint32_t address, unsigned long now) {
+    AttemptRecord* record = find(address);
+    if (record) {
+        return *record;
+    }
+
+    // A free record, else the least recently seen one, preferring any that
+    // isn't blocked
+    AttemptRecord* victim = nullptr;
+    for (AttemptRecord& candidate : records) {
+        if (!candidate.used) {
+            victim = &candidate;
+            break;
+        }
+        if (!victim) {
+            victim = &candidate;
+            continue;
+        }
+        bool candidateBlocked = isBlocked(candidate, now);
+        bool victimBlocked = isBlocked(*victim, now);
+        if (candidateBlocked != victimBlocked) {
+            if (victimBlocked) victim = &candidate;
+        } else if (now - candidate.lastAttemptTime > now - victim->lastAttemptTime) {
+            victim = &candidate;
+        }
+    }
+
+    *victim = {true, address, 0, now, 0};
+    return *victim;
+}
+
+bool RateLimiter::isBlocked(const AttemptRecord& record, unsigned long now) {
+    // Signed difference, so the check survives millis() wrapping
+    return record.attempts >= MAX_ATTEMPTS && static_cast<long>(record.blockUntil - now) > 0;
+}
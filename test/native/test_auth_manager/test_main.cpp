@@ -0,0 +1,182 @@
+#include <unity.h>
+#include <string>
+#include <Preferences.h>
+#include "auth_manager.h"
+#include "Benchmark.h"
+
+namespace {
+
+AuthenticationManager& auth = AuthenticationManager::getInstance();
+
+using Token = char[AuthenticationManager::TOKEN_TEXT_SIZE];
+
+String cookie(const char* token) {
+    return String("session=") + token;
+}
+
+void login(Token& token) {
+    auth.createSession(token);
+}
+
+}
+
+void setUp() {
+    testPreferences().clear();
+    testMillis() = 1000;
+    auth.begin();
+    auth.invalidateAll();
+}
+
+void tearDown() {}
+
+void test_no_credentials_leaves_login_disabled() {
+    TEST_ASSERT_FALSE(auth.isEnabled());
+    TEST_ASSERT_FALSE(auth.validateCredentials("admin", "password"));
+}
+
+void test_credentials_are_stored_as_sha256_and_reloaded() {
+    TEST_ASSERT_FALSE(auth.setCredentials("ab", "correct horse"));
+    TEST_ASSERT_FALSE(auth.setCredentials("admin", "short"));
+    TEST_ASSERT_TRUE(auth.setCredentials("admin", "correct horse"));
+
+    TEST_ASSERT_EQUAL_STRING("4104d36f8da2c254349f85836793ebe029e0c957063a34c91c2e9203187b5631",
+                             testPreferences()["auth/password_hash"].c_str());
+    TEST_ASSERT_TRUE(auth.validateCredentials("admin", "correct horse"));
+    TEST_ASSERT_FALSE(auth.validateCredentials("admin", "correct horsE"));
+    TEST_ASSERT_FALSE(auth.validateCredentials("Admin", "correct horse"));
+
+    // As after a reboot
+    auth.begin();
+    TEST_ASSERT_TRUE(auth.isEnabled());
+    TEST_ASSERT_EQUAL_STRING("admin", auth.getStoredUsername().c_str());
+    TEST_ASSERT_TRUE(auth.validateCredentials("admin", "correct horse"));
+}
+
+void test_session_cookie_is_found_among_others() {
+    Token token;
+    login(token);
+
+    TEST_ASSERT_EQUAL(AuthenticationManager::TOKEN_TEXT_SIZE - 1, strlen(token));
+    TEST_ASSERT_TRUE(auth.validateCookie(cookie(token)));
+    TEST_ASSERT_TRUE(auth.validateCookie(String("theme=dark; ") + cookie(token) + "; lang=nl"));
+}
+
+void test_tampered_or_short_cookie_is_refused() {
+    Token token;
+    login(token);
+    std::string valid = token;
+
+    std::string flipped = valid;
+    flipped[7] = flipped[7] == '0' ? '1' : '0';
+    std::string nonHex = valid;
+    nonHex[0] = 'g';
+    const std::string refused[] = {
+        flipped,
+        nonHex,
+        valid.substr(0, valid.size() - 1),
+        valid + "0",
+        "",
+    };
+    for (const std::string& text : refused) {
+        TEST_ASSERT_FALSE_MESSAGE(auth.validateCookie(cookie(text.c_str())), text.c_str());
+    }
+    TEST_ASSERT_FALSE(auth.validateCookie(String("sessionx=") + token));
+    TEST_ASSERT_FALSE(auth.validateCookie(String("xsession=") + token));
+    TEST_ASSERT_FALSE(auth.validateCookie(token));
+
+    // None of that ended the real session
+    TEST_ASSERT_TRUE(auth.validateCookie(cookie(token)));
+}
+
+void test_idle_session_expires_and_use_keeps_it_alive() {
+    Token token;
+    login(token);
+
+    testMillis() += AuthenticationManager::SESSION_IDLE_TIMEOUT - 1;
+    TEST_ASSERT_TRUE(auth.validateCookie(cookie(token)));
+    testMillis() += AuthenticationManager::SESSION_IDLE_TIMEOUT - 1;
+    TEST_ASSERT_TRUE(auth.validateCookie(cookie(token)));
+
+    testMillis() += AuthenticationManager::SESSION_IDLE_TIMEOUT + 1;
+    TEST_ASSERT_FALSE(auth.validateCookie(cookie(token)));
+}
+
+void test_full_table_ends_the_least_recently_used_session() {
+    Token tokens[AuthenticationManager::MAX_SESSIONS];
+    for (Token& token : tokens) {
+        login(token);
+        testMillis() += 1000;
+    }
+    // The oldest session is used again, leaving the second as the idlest
+    TEST_ASSERT_TRUE(auth.validateCookie(cookie(tokens[0])));
+    testMillis() += 1000;
+
+    Token newest;
+    login(newest);
+
+    TEST_ASSERT_TRUE(auth.validateCookie(cookie(newest)));
+    TEST_ASSERT_FALSE(auth.validateCookie(cookie(tokens[1])));
+    for (size_t i = 0; i < AuthenticationManager::MAX_SESSIONS; i++) {
+        if (i != 1) TEST_ASSERT_TRUE(auth.validateCookie(cookie(tokens[i])));
+    }
+}
+
+void test_logout_ends_only_its_own_session() {
+    Token first;
+    Token second;
+    login(first);
+    login(second);
+
+    auth.invalidateCookie(cookie(first));
+
+    TEST_ASSERT_FALSE(auth.validateCookie(cookie(first)));
+    TEST_ASSERT_TRUE(auth.validateCookie(cookie(second)));
+}
+
+void test_set_credentials_ends_every_session() {
+    TEST_ASSERT_TRUE(auth.setCredentials("admin", "correct horse"));
+    Token tokens[3];
+    for (Token& token : tokens) login(token);
+
+    TEST_ASSERT_TRUE(auth.setCredentials("admin", "battery staple"));
+
+    for (Token& token : tokens) {
+        TEST_ASSERT_FALSE(auth.validateCookie(cookie(token)));
+    }
+    TEST_ASSERT_FALSE(auth.validateCredentials("admin", "correct horse"));
+    TEST_ASSERT_TRUE(auth.validateCredentials("admin", "battery staple"));
+}
+
+void test_validate_cookie_benchmark_with_a_full_table() {
+    Token tokens[AuthenticationManager::MAX_SESSIONS];
+    for (Token& token : tokens) login(token);
+
+    // Cookie headers as a browser sends them, with other cookies around
+    String header = String("theme=dark; ") + cookie(tokens[AuthenticationManager::MAX_SESSIONS - 1]) + "; lang=nl";
+    Token forged;
+    strcpy(forged, tokens[0]);
+    forged[0] = forged[0] == 'f' ? '0' : 'f';
+    String unknown = String("theme=dark; ") + cookie(forged) + "; lang=nl";
+
+    size_t accepted = 0;
+    double hit = nanosPerCall(200000, [&](size_t) { accepted += auth.validateCookie(header); });
+    double miss = nanosPerCall(200000, [&](size_t) { accepted += auth.validateCookie(unknown); });
+
+    TEST_ASSERT_EQUAL(200000, accepted);
+    reportBenchmark("validateCookie, live session of 8", hit);
+    reportBenchmark("validateCookie, unknown token", miss);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_credentials_leaves_login_disabled);
+    RUN_TEST(test_credentials_are_stored_as_sha256_and_reloaded);
+    RUN_TEST(test_session_cookie_is_found_among_others);
+    RUN_TEST(test_tampered_or_short_cookie_is_refused);
+    RUN_TEST(test_idle_session_expires_and_use_keeps_it_alive);
+    RUN_TEST(test_full_table_ends_the_least_recently_used_session);
+    RUN_TEST(test_logout_ends_only_its_own_session);
+    RUN_TEST(test_set_credentials_ends_every_session);
+    RUN_TEST(test_validate_cookie_benchmark_with_a_full_table);
+    return UNITY_END();
+}
@@ -0,0 +1,156 @@
+#include <unity.h>
+#include "CaptiveDns.h"
+
+namespace {
+
+const uint32_t PORTAL = 0x0104A8C0;     // 192.168.4.1 in network byte order
+
+// Query for "portal.lan" with the given type and class, id 0x1234, RD set
+size_t buildQuery(uint8_t* packet, uint16_t type, uint16_t qclass = 1) {
+    const uint8_t header[] = {0x12, 0x34, 0x01, 0x00, 0, 1, 0, 0, 0, 0, 0, 0};
+    const uint8_t name[] = {6, 'p', 'o', 'r', 't', 'a', 'l', 3, 'l', 'a', 'n', 0};
+    memcpy(packet, header, sizeof(header));
+    memcpy(packet + sizeof(header), name, sizeof(name));
+    uint8_t* p = packet + sizeof(header) + sizeof(name);
+    p[0] = type >> 8;
+    p[1] = type & 0xFF;
+    p[2] = qclass >> 8;
+    p[3] = qclass & 0xFF;
+    return sizeof(header) + sizeof(name) + 4;
+}
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_a_query_is_answered_with_portal_address() {
+    uint8_t query[CaptiveDns::PACKET_SIZE];
+    uint8_t response[CaptiveDns::PACKET_SIZE];
+    size_t length = buildQuery(query, 1);
+
+    size_t replied = CaptiveDns::answer(query, length, PORTAL, response, sizeof(response));
+
+    TEST_ASSERT_EQUAL(length + 16, replied);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, readU16(response));
+    TEST_ASSERT_EQUAL_HEX8(0x85, response[2]);     // Response, authoritative, RD echoed
+    TEST_ASSERT_EQUAL_HEX8(0x00, response[3]);
+    TEST_ASSERT_EQUAL(1, readU16(response + 4));
+    TEST_ASSERT_EQUAL(1, readU16(response + 6));
+    TEST_ASSERT_EQUAL_MEMORY(query + 12, response + 12, length - 12);
+
+    const uint8_t* record = response + length;
+    TEST_ASSERT_EQUAL_HEX16(0xC00C, readU16(record));
+    TEST_ASSERT_EQUAL(1, readU16(record + 2));
+    TEST_ASSERT_EQUAL(1, readU16(record + 4));
+    TEST_ASSERT_EQUAL(CaptiveDns::TTL, (uint32_t(readU16(record + 6)) << 16) | readU16(record + 8));
+    TEST_ASSERT_EQUAL(4, readU16(record + 10));
+    const uint8_t address[] = {192, 168, 4, 1};
+    TEST_ASSERT_EQUAL_MEMORY(address, record + 12, 4);
+}
+
+void test_reply_can_be_built_in_place() {
+    uint8_t packet[CaptiveDns::PACKET_SIZE];
+    size_t length = buildQuery(packet, 1);
+
+    size_t replied = CaptiveDns::answer(packet, length, PORTAL, packet, sizeof(packet));
+
+    TEST_ASSERT_EQUAL(length + 16, replied);
+    TEST_ASSERT_EQUAL(1, readU16(packet + 6));
+    const uint8_t address[] = {192, 168, 4, 1};
+    TEST_ASSERT_EQUAL_MEMORY(address, packet + replied - 4, 4);
+}
+
+void test_other_types_get_an_empty_answer() {
+    uint8_t query[CaptiveDns::PACKET_SIZE];
+    uint8_t response[CaptiveDns::PACKET_SIZE];
+    size_t length = buildQuery(query, 28);     // AAAA
+
+    size_t replied = CaptiveDns::answer(query, length, PORTAL, response, sizeof(response));
+
+    TEST_ASSERT_EQUAL(length, replied);
+    TEST_ASSERT_EQUAL_HEX8(0x00, response[3]);
+    TEST_ASSERT_EQUAL(0, readU16(response + 6));
+}
+
+void test_trailing_records_are_dropped() {
+    uint8_t query[CaptiveDns::PACKET_SIZE];
+    uint8_t response[CaptiveDns::PACKET_SIZE];
+    size_t length = buildQuery(query, 1);
+    query[11] = 1;                              // One additional record (EDNS)
+    memset(query + length, 0, 11);
+
+    size_t replied = CaptiveDns::answer(query, length + 11, PORTAL, response, sizeof(response));
+
+    TEST_ASSERT_EQUAL(length + 16, replied);
+    TEST_ASSERT_EQUAL(0, readU16(response + 10));
+}
+
+void test_responses_and_runts_are_ignored() {
+    uint8_t query[CaptiveDns::PACKET_SIZE];
+    uint8_t response[CaptiveDns::PACKET_SIZE];
+    size_t length = buildQuery(query, 1);
+
+    TEST_ASSERT_EQUAL(0, CaptiveDns::answer(query, 11, PORTAL, response, sizeof(response)));
+    query[2] |= 0x80;
+    TEST_ASSERT_EQUAL(0, CaptiveDns::answer(query, length, PORTAL, response, sizeof(response)));
+}
+
+void test_unsupported_opcode_is_refused() {
+    uint8_t query[CaptiveDns::PACKET_SIZE];
+    uint8_t response[CaptiveDns::PACKET_SIZE];
+    size_t length = buildQuery(query, 1);
+    query[2] |= 0x10;                           // Opcode 2, STATUS
+
+    TEST_ASSERT_EQUAL(12, CaptiveDns::answer(query, length, PORTAL, response, sizeof(response)));
+    TEST_ASSERT_EQUAL_HEX8(4, response[3]);     // NOTIMP
+}
+
+void test_malformed_questions_are_format_errors() {
+    uint8_t query[CaptiveDns::PACKET_SIZE];
+    uint8_t response[CaptiveDns::PACKET_SIZE];
+    size_t length = buildQuery(query, 1);
+
+    // Question cut short
+    TEST_ASSERT_EQUAL(12, CaptiveDns::answer(query, length - 2, PORTAL, response, sizeof(response)));
+    TEST_ASSERT_EQUAL_HEX8(1, response[3]);
+
+    // Compression pointer in the question
+    buildQuery(query, 1);
+    query[12] = 0xC0;
+    TEST_ASSERT_EQUAL(12, CaptiveDns::answer(query, length, PORTAL, response, sizeof(response)));
+    TEST_ASSERT_EQUAL_HEX8(1, response[3]);
+
+    // More than one question
+    buildQuery(query, 1);
+    query[5] = 2;
+    TEST_ASSERT_EQUAL(12, CaptiveDns::answer(query, length, PORTAL, response, sizeof(response)));
+    TEST_ASSERT_EQUAL_HEX8(1, response[3]);
+}
+
+void test_reply_that_does_not_fit_is_a_format_error() {
+    uint8_t query[CaptiveDns::PACKET_SIZE];
+    uint8_t response[CaptiveDns::PACKET_SIZE];
+    size_t length = buildQuery(query, 1);
+
+    TEST_ASSERT_EQUAL(12, CaptiveDns::answer(query, length, PORTAL, response, length + 15));
+    TEST_ASSERT_EQUAL_HEX8(1, response[3]);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_a_query_is_answered_with_portal_address);
+    RUN_TEST(test_reply_can_be_built_in_place);
+    RUN_TEST(test_other_types_get_an_empty_answer);
+    RUN_TEST(test_trailing_records_are_dropped);
+    RUN_TEST(test_responses_and_runts_are_ignored);
+    RUN_TEST(test_unsupported_opcode_is_refused);
+    RUN_TEST(test_malformed_questions_are_format_errors);
+    RUN_TEST(test_reply_that_does_not_fit_is_a_format_error);
+    return UNITY_END();
+}
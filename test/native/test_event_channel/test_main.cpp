@@ -0,0 +1,200 @@
+#include <unity.h>
+#include <csignal>
+#include <string>
+#include "EventChannel.h"
+#include "Benchmark.h"
+
+namespace {
+
+const char HEAD[] = "HTTP/1.1 200 OK\r\n"
+                    "Content-Type: text/event-stream\r\n"
+                    "Cache-Control: no-cache\r\n"
+                    "Connection: keep-alive\r\n"
+                    "Access-Control-Allow-Origin: *\r\n"
+                    "\r\n"
+                    "retry: 3000\n\n";
+
+// A page on the other end of a socket the channel writes to
+struct Page {
+    WiFiClient client;
+    int peer = -1;
+
+    Page() {
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        client = WiFiClient(fds[0]);
+        peer = fds[1];
+    }
+
+    ~Page() {
+        if (peer >= 0) ::close(peer);
+    }
+
+    // Everything the channel has written so far
+    std::string received() {
+        std::string text;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = recv(peer, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) text.append(buffer, n);
+        return text;
+    }
+
+    void leave() {
+        ::close(peer);
+        peer = -1;
+    }
+
+    // Fills the socket until it takes no more, like a page that stopped reading
+    void stall() {
+        char filler[1024] = {};
+        while (::send(client.fd(), filler, sizeof(filler), MSG_DONTWAIT) > 0) {}
+    }
+};
+
+EventChannel* channel = nullptr;
+
+void assertReceived(const char* expected, Page& page) {
+    std::string text = page.received();
+    TEST_ASSERT_EQUAL_STRING(expected, text.c_str());
+}
+
+bool subscribe(Page& page) {
+    return channel->open(page.client) && channel->add(page.client);
+}
+
+}
+
+void setUp() {
+    channel = new EventChannel();
+}
+
+void tearDown() {
+    delete channel;
+    channel = nullptr;
+}
+
+void test_open_writes_event_stream_head() {
+    Page page;
+
+    TEST_ASSERT_TRUE(subscribe(page));
+
+    assertReceived(HEAD, page);
+    TEST_ASSERT_EQUAL(1, channel->clientCount());
+}
+
+void test_event_is_framed_with_name_and_data() {
+    Page page;
+    TEST_ASSERT_TRUE(subscribe(page));
+    page.received();
+
+    TEST_ASSERT_TRUE(channel->send(page.client, "relay", "{\"relays\":[true,false]}"));
+    channel->broadcast("sensors", "{\"temperature\":21.5}");
+
+    assertReceived("event: relay\ndata: {\"relays\":[true,false]}\n\n"
+                   "event: sensors\ndata: {\"temperature\":21.5}\n\n", page);
+}
+
+void test_event_too_large_is_refused_whole() {
+    Page page;
+    TEST_ASSERT_TRUE(subscribe(page));
+    page.received();
+
+    std::string data(EventChannel::EVENT_BUFFER_SIZE, 'x');
+    TEST_ASSERT_FALSE(channel->send(page.client, "relay", data.c_str()));
+
+    // Nothing partial goes out, and the client stays subscribed
+    assertReceived("", page);
+    TEST_ASSERT_EQUAL(1, channel->clientCount());
+}
+
+void test_client_past_the_last_slot_is_refused_untouched() {
+    Page pages[EventChannel::MAX_CLIENTS];
+    for (Page& page : pages) {
+        TEST_ASSERT_TRUE(subscribe(page));
+    }
+
+    Page extra;
+    TEST_ASSERT_FALSE(channel->open(extra.client));
+    TEST_ASSERT_FALSE(channel->add(extra.client));
+
+    assertReceived("", extra);
+    TEST_ASSERT_EQUAL(EventChannel::MAX_CLIENTS, channel->clientCount());
+}
+
+void test_page_that_left_frees_its_slot() {
+    Page pages[EventChannel::MAX_CLIENTS];
+    for (Page& page : pages) {
+        TEST_ASSERT_TRUE(subscribe(page));
+    }
+
+    pages[1].leave();
+    TEST_ASSERT_EQUAL(EventChannel::MAX_CLIENTS - 1, channel->clientCount());
+
+    Page next;
+    TEST_ASSERT_TRUE(subscribe(next));
+    TEST_ASSERT_EQUAL(EventChannel::MAX_CLIENTS, channel->clientCount());
+}
+
+void test_stalled_page_is_dropped_without_holding_up_others() {
+    Page fast;
+    Page stalled;
+    TEST_ASSERT_TRUE(subscribe(fast));
+    TEST_ASSERT_TRUE(subscribe(stalled));
+    fast.received();
+    stalled.stall();
+
+    channel->broadcast("relay", "{}");
+
+    assertReceived("event: relay\ndata: {}\n\n", fast);
+    TEST_ASSERT_EQUAL(1, channel->clientCount());
+}
+
+void test_keepalive_is_a_comment_line() {
+    Page first;
+    Page second;
+    TEST_ASSERT_TRUE(subscribe(first));
+    TEST_ASSERT_TRUE(subscribe(second));
+    first.received();
+    second.received();
+
+    channel->keepalive();
+
+    assertReceived(":\n\n", first);
+    assertReceived(":\n\n", second);
+}
+
+void test_broadcast_benchmark_at_max_clients() {
+    Page pages[EventChannel::MAX_CLIENTS];
+    for (Page& page : pages) {
+        TEST_ASSERT_TRUE(subscribe(page));
+        page.received();
+    }
+
+    const char* data = "{\"relays\":[{\"id\":0,\"state\":true},{\"id\":1,\"state\":false}]}";
+    size_t delivered = 0;
+    double nanos = nanosPerCall(20000, [&](size_t) {
+        channel->broadcast("relay", data);
+        for (Page& page : pages) delivered += page.received().size();
+    });
+
+    TEST_ASSERT_EQUAL(EventChannel::MAX_CLIENTS, channel->clientCount());
+    size_t eventLength = strlen("event: relay\ndata: \n\n") + strlen(data);
+    TEST_ASSERT_EQUAL(20000 * EventChannel::MAX_CLIENTS * eventLength, delivered);
+    reportBenchmark("relay event to 4 pages, written and read", nanos);
+}
+
+int main(int, char**) {
+    // lwIP has no SIGPIPE; a write to a page that left just fails
+    signal(SIGPIPE, SIG_IGN);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_open_writes_event_stream_head);
+    RUN_TEST(test_event_is_framed_with_name_and_data);
+    RUN_TEST(test_event_too_large_is_refused_whole);
+    RUN_TEST(test_client_past_the_last_slot_is_refused_untouched);
+    RUN_TEST(test_page_that_left_frees_its_slot);
+    RUN_TEST(test_stalled_page_is_dropped_without_holding_up_others);
+    RUN_TEST(test_keepalive_is_a_comment_line);
+    RUN_TEST(test_broadcast_benchmark_at_max_clients);
+    return UNITY_END();
+}
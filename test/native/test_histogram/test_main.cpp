@@ -0,0 +1,134 @@
+#include <unity.h>
+#include "Histogram.h"
+#include "Metrics.h"
+
+namespace {
+
+const uint32_t BOUNDS[] = {10, 100, 1000};
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_empty_histogram_reports_zero() {
+    FixedHistogram<3> histogram(BOUNDS);
+
+    TEST_ASSERT_EQUAL(0, histogram.count());
+    TEST_ASSERT_EQUAL(0, histogram.mean());
+    TEST_ASSERT_EQUAL(0, histogram.getMin());
+    TEST_ASSERT_EQUAL(0, histogram.getMax());
+    TEST_ASSERT_EQUAL(0, histogram.percentile(50));
+}
+
+void test_values_land_in_inclusive_buckets() {
+    FixedHistogram<3> histogram(BOUNDS);
+    histogram.record(0);
+    histogram.record(10);
+    histogram.record(11);
+    histogram.record(1000);
+    histogram.record(1001);
+
+    TEST_ASSERT_EQUAL(4, histogram.bucketCount());
+    TEST_ASSERT_EQUAL(2, histogram.bucket(0));
+    TEST_ASSERT_EQUAL(1, histogram.bucket(1));
+    TEST_ASSERT_EQUAL(1, histogram.bucket(2));
+    TEST_ASSERT_EQUAL(1, histogram.bucket(3));
+    TEST_ASSERT_EQUAL(0, histogram.bucket(4));
+    TEST_ASSERT_EQUAL(UINT32_MAX, histogram.bound(3));
+}
+
+void test_summary_statistics() {
+    FixedHistogram<3> histogram(BOUNDS);
+    histogram.record(5);
+    histogram.record(50);
+    histogram.record(500);
+
+    TEST_ASSERT_EQUAL(3, histogram.count());
+    TEST_ASSERT_EQUAL(555, histogram.getSum());
+    TEST_ASSERT_EQUAL(185, histogram.mean());
+    TEST_ASSERT_EQUAL(5, histogram.getMin());
+    TEST_ASSERT_EQUAL(500, histogram.getMax());
+}
+
+void test_sum_does_not_wrap_at_32_bits() {
+    FixedHistogram<3> histogram(BOUNDS);
+    histogram.record(UINT32_MAX);
+    histogram.record(UINT32_MAX);
+
+    TEST_ASSERT_TRUE(histogram.getSum() == 2ULL * UINT32_MAX);
+    TEST_ASSERT_EQUAL(UINT32_MAX, histogram.mean());
+}
+
+void test_percentile_reports_bucket_bound() {
+    FixedHistogram<3> histogram(BOUNDS);
+    for (int i = 0; i < 90; i++) histogram.record(5);
+    for (int i = 0; i < 9; i++) histogram.record(500);
+    histogram.record(5000);
+
+    TEST_ASSERT_EQUAL(10, histogram.percentile(0));
+    TEST_ASSERT_EQUAL(10, histogram.percentile(90));
+    TEST_ASSERT_EQUAL(1000, histogram.percentile(91));
+    TEST_ASSERT_EQUAL(1000, histogram.percentile(99));
+}
+
+void test_overflow_percentile_reports_maximum() {
+    FixedHistogram<3> histogram(BOUNDS);
+    histogram.record(5);
+    histogram.record(4321);
+
+    TEST_ASSERT_EQUAL(4321, histogram.percentile(100));
+}
+
+void test_reset_clears_everything() {
+    FixedHistogram<3> histogram(BOUNDS);
+    histogram.record(7);
+    histogram.record(7000);
+    histogram.reset();
+
+    TEST_ASSERT_EQUAL(0, histogram.count());
+    TEST_ASSERT_EQUAL(0, histogram.getSum());
+    TEST_ASSERT_EQUAL(0, histogram.getMax());
+    for (size_t i = 0; i < histogram.bucketCount(); i++) {
+        TEST_ASSERT_EQUAL(0, histogram.bucket(i));
+    }
+    histogram.record(3);
+    TEST_ASSERT_EQUAL(3, histogram.getMin());
+}
+
+void test_metric_histogram_matches_plain_one() {
+    MetricHistogram<3> metric(BOUNDS);
+    FixedHistogram<3> plain(BOUNDS);
+    const uint32_t values[] = {5, 50, 500, 5000, UINT32_MAX, UINT32_MAX};
+    for (uint32_t value : values) {
+        metric.record(value);
+        plain.record(value);
+    }
+
+    TEST_ASSERT_EQUAL(plain.count(), metric.count());
+    TEST_ASSERT_TRUE(metric.getSum() == plain.getSum());
+    TEST_ASSERT_EQUAL(plain.getMin(), metric.getMin());
+    TEST_ASSERT_EQUAL(plain.getMax(), metric.getMax());
+    TEST_ASSERT_EQUAL(plain.percentile(50), metric.percentile(50));
+    for (size_t i = 0; i < metric.bucketCount(); i++) {
+        TEST_ASSERT_EQUAL(plain.bucket(i), metric.bucket(i));
+    }
+
+    metric.reset();
+    TEST_ASSERT_EQUAL(0, metric.count());
+    TEST_ASSERT_TRUE(metric.getSum() == 0);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_histogram_reports_zero);
+    RUN_TEST(test_values_land_in_inclusive_buckets);
+    RUN_TEST(test_summary_statistics);
+    RUN_TEST(test_sum_does_not_wrap_at_32_bits);
+    RUN_TEST(test_percentile_reports_bucket_bound);
+    RUN_TEST(test_overflow_percentile_reports_maximum);
+    RUN_TEST(test_reset_clears_everything);
+    RUN_TEST(test_metric_histogram_matches_plain_one);
+    return UNITY_END();
+}
@@ -0,0 +1,278 @@
+#include <unity.h>
+#include <atomic>
+#include <csignal>
+#include <thread>
+#include <vector>
+#include "HttpServer.h"
+#include "Metrics.h"
+#include "Benchmark.h"
+#include "TestClient.h"
+
+namespace {
+
+constexpr uint16_t PORT = 18461;
+
+HttpServer* server = nullptr;
+std::atomic<HttpServer::Ticket> deferred(0);
+
+void handleHello() {
+    server->send(200, "text/plain", "hello");
+}
+
+void handleEcho() {
+    server->send(200, "text/plain", server->arg("n"));
+}
+
+void handleForm() {
+    server->send(200, "text/plain", server->arg("plain"));
+}
+
+// Answered later from the test thread, like a handler waiting on a scan
+void handleSlow() {
+    server->sendHeader("X-Deferred", "1");
+    deferred = server->defer();
+}
+
+HttpServer::RequestHandler resolve(HTTPMethod method, const char* uri) {
+    if (method == HTTP_GET && strcmp(uri, "/hello") == 0) return handleHello;
+    if (method == HTTP_GET && strcmp(uri, "/echo") == 0) return handleEcho;
+    if (method == HTTP_POST && strcmp(uri, "/form") == 0) return handleForm;
+    if (method == HTTP_GET && strcmp(uri, "/slow") == 0) return handleSlow;
+    return nullptr;
+}
+
+std::string get(const char* path, const char* headers = "") {
+    return std::string("GET ") + path + " HTTP/1.1\r\nHost: test\r\n" + headers + "\r\n";
+}
+
+bool waitForTicket() {
+    for (int i = 0; i < 200 && deferred == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return deferred != 0;
+}
+
+// One request per call on a kept-alive connection, or a fresh connection
+// per request; returns each request's latency in microseconds
+std::vector<double> runLoad(size_t requests, bool keepAlive, std::atomic<size_t>& failures) {
+    std::vector<double> latencies;
+    latencies.reserve(requests);
+    TestClient* shared = keepAlive ? new TestClient(PORT) : nullptr;
+    for (size_t i = 0; i < requests; i++) {
+        auto started = std::chrono::steady_clock::now();
+        TestClient* client = shared ? shared : new TestClient(PORT);
+        TestResponse response;
+        bool ok = client->send(get(i % 2 ? "/hello" : "/echo?n=1", keepAlive ? "" : "Connection: close\r\n")) &&
+                  client->readResponse(response) && response.code == 200;
+        if (!shared) delete client;
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count());
+        if (!ok) failures++;
+    }
+    delete shared;
+    return latencies;
+}
+
+}
+
+void setUp() {
+    deferred = 0;
+    server = new HttpServer(PORT);
+    server->setResolver(resolve);
+    TEST_ASSERT_TRUE(server->begin());
+}
+
+void tearDown() {
+    delete server;
+    server = nullptr;
+}
+
+void test_keep_alive_serves_requests_on_one_connection() {
+    uint32_t connections = Metrics::getInstance().http.connections.get();
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(client.isOpen());
+
+    for (int i = 0; i < 3; i++) {
+        TestResponse response;
+        TEST_ASSERT_TRUE(client.send(get("/hello")));
+        TEST_ASSERT_TRUE(client.readResponse(response));
+        TEST_ASSERT_EQUAL(200, response.code);
+        TEST_ASSERT_EQUAL_STRING("keep-alive", response.header("Connection").c_str());
+        TEST_ASSERT_EQUAL_STRING("hello", response.body.c_str());
+    }
+    TEST_ASSERT_EQUAL(connections + 1, Metrics::getInstance().http.connections.get());
+}
+
+void test_connection_close_and_http10_end_the_connection() {
+    TestClient closing(PORT);
+    TestResponse response;
+    TEST_ASSERT_TRUE(closing.send(get("/hello", "Connection: close\r\n")));
+    TEST_ASSERT_TRUE(closing.readResponse(response));
+    TEST_ASSERT_EQUAL_STRING("close", response.header("Connection").c_str());
+    TEST_ASSERT_TRUE(closing.closedByPeer());
+
+    TestClient old(PORT);
+    TEST_ASSERT_TRUE(old.send("GET /hello HTTP/1.0\r\n\r\n"));
+    TEST_ASSERT_TRUE(old.readResponse(response));
+    TEST_ASSERT_EQUAL(200, response.code);
+    TEST_ASSERT_EQUAL_STRING("close", response.header("Connection").c_str());
+    TEST_ASSERT_TRUE(old.closedByPeer());
+}
+
+void test_pipelined_requests_are_answered_in_order() {
+    TestClient client(PORT);
+    // Four requests in one write, one of them with a body
+    TEST_ASSERT_TRUE(client.send(get("/echo?n=1") + get("/echo?n=2") +
+                                 "POST /form HTTP/1.1\r\nContent-Length: 5\r\n\r\nthree" + get("/echo?n=4")));
+
+    const char* expected[] = {"1", "2", "three", "4"};
+    for (const char* body : expected) {
+        TestResponse response;
+        TEST_ASSERT_TRUE(client.readResponse(response));
+        TEST_ASSERT_EQUAL(200, response.code);
+        TEST_ASSERT_EQUAL_STRING(body, response.body.c_str());
+    }
+}
+
+void test_body_arriving_in_pieces_is_collected() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(client.send("POST /form HTTP/1.1\r\nContent-Length: 10\r\n\r\nfirst"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    TEST_ASSERT_TRUE(client.send("-half"));
+
+    TestResponse response;
+    TEST_ASSERT_TRUE(client.readResponse(response));
+    TEST_ASSERT_EQUAL_STRING("first-half", response.body.c_str());
+}
+
+void test_unknown_path_gets_404() {
+    TestClient client(PORT);
+    TestResponse response;
+    TEST_ASSERT_TRUE(client.send(get("/missing")));
+    TEST_ASSERT_TRUE(client.readResponse(response));
+    TEST_ASSERT_EQUAL(404, response.code);
+}
+
+void test_connection_past_the_last_slot_gets_503() {
+    uint32_t rejected = Metrics::getInstance().http.rejected.get();
+
+    // Each slot is known to be taken once it has answered a request
+    std::vector<TestClient*> clients;
+    for (size_t i = 0; i < HttpServer::MAX_CONNECTIONS; i++) {
+        clients.push_back(new TestClient(PORT));
+        TestResponse response;
+        TEST_ASSERT_TRUE(clients.back()->send(get("/hello")));
+        TEST_ASSERT_TRUE(clients.back()->readResponse(response));
+    }
+
+    TestClient extra(PORT);
+    TestResponse response;
+    TEST_ASSERT_TRUE(extra.readResponse(response));
+    TEST_ASSERT_EQUAL(503, response.code);
+    TEST_ASSERT_EQUAL_STRING("close", response.header("Connection").c_str());
+    TEST_ASSERT_TRUE(extra.closedByPeer());
+    TEST_ASSERT_EQUAL(rejected + 1, Metrics::getInstance().http.rejected.get());
+
+    // A freed slot takes the next connection
+    delete clients.back();
+    clients.pop_back();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    TestClient next(PORT);
+    TEST_ASSERT_TRUE(next.send(get("/hello")));
+    TEST_ASSERT_TRUE(next.readResponse(response));
+    TEST_ASSERT_EQUAL(200, response.code);
+
+    for (TestClient* client : clients) delete client;
+}
+
+void test_deferred_request_is_answered_by_complete() {
+    TestClient slow(PORT);
+    TEST_ASSERT_TRUE(slow.send(get("/slow")));
+    TEST_ASSERT_TRUE(waitForTicket());
+
+    // The deferred request holds only its own connection
+    TestClient other(PORT);
+    TestResponse response;
+    TEST_ASSERT_TRUE(other.send(get("/hello")));
+    TEST_ASSERT_TRUE(other.readResponse(response));
+    TEST_ASSERT_EQUAL(200, response.code);
+
+    HttpServer::Ticket ticket = deferred;
+    bool completed = false;
+    std::thread([&] { completed = server->complete(ticket, 202, "text/plain", "done"); }).join();
+    TEST_ASSERT_TRUE(completed);
+
+    TEST_ASSERT_TRUE(slow.readResponse(response));
+    TEST_ASSERT_EQUAL(202, response.code);
+    TEST_ASSERT_EQUAL_STRING("done", response.body.c_str());
+    // Headers set before defer() go out with the answer
+    TEST_ASSERT_EQUAL_STRING("1", response.header("X-Deferred").c_str());
+    TEST_ASSERT_EQUAL_STRING("keep-alive", response.header("Connection").c_str());
+
+    // The connection carries on afterwards
+    TEST_ASSERT_TRUE(slow.send(get("/hello")));
+    TEST_ASSERT_TRUE(slow.readResponse(response));
+    TEST_ASSERT_EQUAL_STRING("hello", response.body.c_str());
+}
+
+void test_deferred_request_times_out_with_504() {
+    TestClient slow(PORT);
+    TEST_ASSERT_TRUE(slow.send(get("/slow")));
+    TEST_ASSERT_TRUE(waitForTicket());
+
+    testMillis() += HttpServer::DEFER_TIMEOUT;
+
+    TestResponse response;
+    TEST_ASSERT_TRUE(slow.readResponse(response));
+    TEST_ASSERT_EQUAL(504, response.code);
+    TEST_ASSERT_EQUAL_STRING("1", response.header("X-Deferred").c_str());
+    TEST_ASSERT_EQUAL_STRING("close", response.header("Connection").c_str());
+    TEST_ASSERT_TRUE(slow.closedByPeer());
+
+    // A late answer is dropped and the server goes on serving
+    TEST_ASSERT_TRUE(server->complete(deferred, 200, "text/plain", "late"));
+    TestClient next(PORT);
+    TEST_ASSERT_TRUE(next.send(get("/hello")));
+    TEST_ASSERT_TRUE(next.readResponse(response));
+    TEST_ASSERT_EQUAL_STRING("hello", response.body.c_str());
+}
+
+void test_load_reports_throughput_and_p99() {
+    const size_t CLIENTS = 4;
+    const size_t REQUESTS = 2000;
+    std::atomic<size_t> failures(0);
+
+    for (bool keepAlive : {true, false}) {
+        std::vector<std::vector<double>> latencies(CLIENTS);
+        auto started = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t c = 0; c < CLIENTS; c++) {
+            threads.emplace_back([&, c] { latencies[c] = runLoad(REQUESTS, keepAlive, failures); });
+        }
+        for (std::thread& thread : threads) thread.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        std::vector<double> all;
+        for (const std::vector<double>& client : latencies) all.insert(all.end(), client.begin(), client.end());
+        reportLoad(keepAlive ? "4 clients, keep-alive" : "4 clients, connection per request",
+                   all.size(), seconds, all);
+    }
+    TEST_ASSERT_EQUAL(0, failures.load());
+}
+
+int main(int, char**) {
+    // lwIP has no SIGPIPE; on the host a write to a closed peer must fail the
+    // same way instead of ending the test binary
+    signal(SIGPIPE, SIG_IGN);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_keep_alive_serves_requests_on_one_connection);
+    RUN_TEST(test_connection_close_and_http10_end_the_connection);
+    RUN_TEST(test_pipelined_requests_are_answered_in_order);
+    RUN_TEST(test_body_arriving_in_pieces_is_collected);
+    RUN_TEST(test_unknown_path_gets_404);
+    RUN_TEST(test_connection_past_the_last_slot_gets_503);
+    RUN_TEST(test_deferred_request_is_answered_by_complete);
+    RUN_TEST(test_deferred_request_times_out_with_504);
+    RUN_TEST(test_load_reports_throughput_and_p99);
+    return UNITY_END();
+}
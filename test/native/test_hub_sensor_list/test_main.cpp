@@ -0,0 +1,291 @@
+#include <unity.h>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "HubSensorList.h"
+#include "MQTTRouter.h"
+#include "Benchmark.h"
+
+// Heap use is tracked around the parse, to show it does not grow with the list
+namespace {
+bool tracking = false;
+size_t liveBytes = 0;
+size_t peakBytes = 0;
+}
+
+void* operator new(size_t size) {
+    size_t* block = static_cast<size_t*>(malloc(size + sizeof(max_align_t)));
+    if (!block) throw std::bad_alloc();
+    *block = size;
+    if (tracking) {
+        liveBytes += size;
+        if (liveBytes > peakBytes) peakBytes = liveBytes;
+    }
+    return reinterpret_cast<char*>(block) + sizeof(max_align_t);
+}
+
+void operator delete(void* pointer) noexcept {
+    if (!pointer) return;
+    size_t* block = reinterpret_cast<size_t*>(static_cast<char*>(pointer) - sizeof(max_align_t));
+    if (tracking) liveBytes -= *block < liveBytes ? *block : liveBytes;
+    free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+namespace {
+
+// In-memory response body
+class TextStream : public Stream {
+public:
+    explicit TextStream(const std::string& text) : text(text), position(0) {}
+    int available() override { return static_cast<int>(text.size() - position); }
+    int read() override { return position < text.size() ? static_cast<uint8_t>(text[position++]) : -1; }
+    int peek() override { return position < text.size() ? static_cast<uint8_t>(text[position]) : -1; }
+    size_t write(uint8_t) override { return 0; }
+    std::string rest() const { return text.substr(position); }
+
+private:
+    std::string text;
+    size_t position;
+};
+
+// A sensor as the hub lists it, most of it fields the filter drops
+std::string sensorJson(size_t index, bool babel) {
+    char json[512];
+    snprintf(json, sizeof(json),
+             "{\"id\":%u,\"name\":\"Sensor %u\",\"type\":\"%s\",\"location\":\"Room %u\","
+             "\"temperature\":%.1f,\"humidity\":45.2,\"battery\":87,\"rssi\":-67,"
+             "\"lastSeen\":\"2026-10-18T12:00:00Z\",\"isBabelSensor\":%s,\"babelTemperature\":%s,"
+             "\"calibration\":{\"offset\":0.1,\"scale\":1.0},\"history\":[20.1,20.3,20.4]}",
+             static_cast<unsigned>(index), static_cast<unsigned>(index), babel ? "babel" : "DS18B20",
+             static_cast<unsigned>(index), 18.0 + index % 10, babel ? "true" : "false", babel ? "21.7" : "null");
+    return json;
+}
+
+// Listing of `count` sensors with the Babel sensor in the middle
+std::string listJson(size_t count) {
+    std::string json = "[";
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) json += ",\n  ";
+        json += sensorJson(i + 1, i == count / 2);
+    }
+    return json + "]";
+}
+
+std::vector<HubSensorList::Sensor> readAll(TextStream& stream, bool* ok = nullptr) {
+    std::vector<HubSensorList::Sensor> sensors;
+    bool parsed = HubSensorList::read(stream, [&](const HubSensorList::Sensor& sensor) { sensors.push_back(sensor); });
+    if (ok) *ok = parsed;
+    return sensors;
+}
+
+// As main.cpp routes the hub's topics, with MQTTManager::BUFFER_SIZE
+const char HUB_SENSORS[] = "chaoticvolt/sensorhub/sensors";
+const char HUB_SENSOR_FILTER[] = "chaoticvolt/sensorhub/sensors/+";
+constexpr size_t MQTT_BUFFER_SIZE = 512;
+
+MQTTRouter* router = nullptr;
+std::vector<HubSensorList::Sensor> routed;
+bool routedOk = false;
+
+// Delivers a message the way MQTTManager does, or reports that PubSubClient
+// would have dropped it for not fitting the packet buffer
+size_t deliver(const std::string& topic, std::string message) {
+    // Fixed header, remaining length, topic length and topic name
+    size_t packet = 1 + 2 + 2 + topic.size() + message.size();
+    if (packet > MQTT_BUFFER_SIZE) return 0;
+    MQTTPayload payload = {reinterpret_cast<uint8_t*>(&message[0]), static_cast<unsigned int>(message.size())};
+    return router->dispatch(topic.c_str(), payload);
+}
+
+}
+
+void setUp() {
+    router = new MQTTRouter();
+    routed.clear();
+    routedOk = false;
+    router->add(HUB_SENSOR_FILTER, [](const char*, MQTTPayload payload) {
+        routedOk = HubSensorList::parse(payload.data, payload.length,
+                                        [](const HubSensorList::Sensor& sensor) { routed.push_back(sensor); });
+    });
+}
+
+void tearDown() {
+    delete router;
+    router = nullptr;
+}
+
+void test_reads_every_sensor_with_a_value() {
+    TextStream stream("[{\"id\":\"hall\",\"temperature\":19.5,\"isBabelSensor\":false},"
+                      "{\"id\":7,\"isBabelSensor\":true,\"babelTemperature\":21.25,\"temperature\":3},"
+                      "{\"id\":8,\"humidity\":40}]");
+    bool ok = false;
+    std::vector<HubSensorList::Sensor> sensors = readAll(stream, &ok);
+
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL(2, sensors.size());
+    TEST_ASSERT_EQUAL_STRING("hall", sensors[0].id);
+    TEST_ASSERT_FALSE(sensors[0].isBabel);
+    TEST_ASSERT_EQUAL_FLOAT(19.5f, sensors[0].value);
+    // A Babel sensor reports its own field, not the generic one
+    TEST_ASSERT_EQUAL_STRING("7", sensors[1].id);
+    TEST_ASSERT_TRUE(sensors[1].isBabel);
+    TEST_ASSERT_EQUAL_FLOAT(21.25f, sensors[1].value);
+}
+
+void test_sensor_without_id_is_still_read() {
+    TextStream stream("[{\"isBabelSensor\":true,\"babelTemperature\":20}]");
+    std::vector<HubSensorList::Sensor> sensors = readAll(stream);
+
+    TEST_ASSERT_EQUAL(1, sensors.size());
+    TEST_ASSERT_EQUAL_STRING("", sensors[0].id);
+}
+
+void test_empty_list_is_valid() {
+    TextStream stream(" [ ] ");
+    bool ok = false;
+    TEST_ASSERT_EQUAL(0, readAll(stream, &ok).size());
+    TEST_ASSERT_TRUE(ok);
+}
+
+void test_list_is_read_through_its_closing_bracket() {
+    TextStream stream(listJson(3) + "NEXT");
+    bool ok = false;
+    TEST_ASSERT_EQUAL(3, readAll(stream, &ok).size());
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL_STRING("NEXT", stream.rest().c_str());
+}
+
+void test_malformed_list_fails() {
+    TextStream notAList("{\"error\":\"unauthorized\"}");
+    bool ok = true;
+    readAll(notAList, &ok);
+    TEST_ASSERT_FALSE(ok);
+
+    TextStream missingComma("[{\"id\":1,\"temperature\":2} {\"id\":2,\"temperature\":3}]");
+    TEST_ASSERT_EQUAL(1, readAll(missingComma, &ok).size());
+    TEST_ASSERT_FALSE(ok);
+
+    TextStream truncated(listJson(4).substr(0, 700));
+    readAll(truncated, &ok);
+    TEST_ASSERT_FALSE(ok);
+}
+
+// Fields the filter drops cost nothing, however large
+void test_large_sensor_object_fits_the_fixed_document() {
+    std::string notes(4096, 'x');
+    TextStream stream("[{\"id\":1,\"notes\":\"" + notes + "\",\"log\":[" + listJson(20) +
+                      "],\"isBabelSensor\":true,\"babelTemperature\":22.5}]");
+    bool ok = false;
+    std::vector<HubSensorList::Sensor> sensors = readAll(stream, &ok);
+
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL(1, sensors.size());
+    TEST_ASSERT_EQUAL_FLOAT(22.5f, sensors[0].value);
+}
+
+void test_mqtt_sensor_message_is_routed_and_parsed() {
+    std::string topic = std::string(HUB_SENSORS) + "/4";
+    TEST_ASSERT_EQUAL(1, deliver(topic, sensorJson(4, true)));
+
+    TEST_ASSERT_TRUE(routedOk);
+    TEST_ASSERT_EQUAL(1, routed.size());
+    TEST_ASSERT_EQUAL_STRING("4", routed[0].id);
+    TEST_ASSERT_TRUE(routed[0].isBabel);
+    TEST_ASSERT_EQUAL_FLOAT(21.7f, routed[0].value);
+
+    // A plain sensor reports its generic field
+    routed.clear();
+    TEST_ASSERT_EQUAL(1, deliver(std::string(HUB_SENSORS) + "/5", sensorJson(5, false)));
+    TEST_ASSERT_EQUAL(1, routed.size());
+    TEST_ASSERT_FALSE(routed[0].isBabel);
+    TEST_ASSERT_EQUAL_FLOAT(23.0f, routed[0].value);
+}
+
+// The hub's full list does not fit the packet buffer, which is why only the
+// per-sensor topics are routed
+void test_mqtt_hub_list_is_left_to_http() {
+    std::string list = listJson(10);
+    TEST_ASSERT_TRUE(list.size() > MQTT_BUFFER_SIZE);
+
+    TEST_ASSERT_EQUAL(0, deliver(HUB_SENSORS, list));
+    // Nor is the base topic matched, should a broker deliver it anyway
+    MQTTPayload payload = {reinterpret_cast<uint8_t*>(&list[0]), static_cast<unsigned int>(list.size())};
+    TEST_ASSERT_EQUAL(0, router->dispatch(HUB_SENSORS, payload));
+    TEST_ASSERT_EQUAL(0, routed.size());
+}
+
+// A list that does reach a handler is still read element by element
+void test_mqtt_list_message_is_parsed_per_element() {
+    std::string list = listJson(10);
+    std::string topic = std::string(HUB_SENSORS) + "/all";
+    MQTTPayload payload = {reinterpret_cast<uint8_t*>(&list[0]), static_cast<unsigned int>(list.size())};
+
+    TEST_ASSERT_EQUAL(1, router->dispatch(topic.c_str(), payload));
+    TEST_ASSERT_TRUE(routedOk);
+    TEST_ASSERT_EQUAL(10, routed.size());
+    TEST_ASSERT_TRUE(routed[5].isBabel);
+    TEST_ASSERT_EQUAL_FLOAT(21.7f, routed[5].value);
+}
+
+void test_mqtt_malformed_message_fails() {
+    TEST_ASSERT_EQUAL(1, deliver(std::string(HUB_SENSORS) + "/4", "{\"id\":4,\"temperature\":"));
+    TEST_ASSERT_FALSE(routedOk);
+    TEST_ASSERT_EQUAL(0, routed.size());
+
+    TEST_ASSERT_EQUAL(1, deliver(std::string(HUB_SENSORS) + "/4", sensorJson(4, false).substr(0, 120)));
+    TEST_ASSERT_FALSE(routedOk);
+}
+
+void test_parse_time_and_peak_heap_for_1_to_100_sensors() {
+    size_t firstPeak = 0;
+    for (size_t count : {1u, 10u, 50u, 100u}) {
+        std::string body = listJson(count);
+        size_t visited = 0;
+        float babel = 0;
+
+        peakBytes = liveBytes = 0;
+        double nanos = nanosPerCall(200, [&](size_t) {
+            TextStream stream(body);
+            visited = 0;
+            tracking = true;
+            HubSensorList::read(stream, [&](const HubSensorList::Sensor& sensor) {
+                visited++;
+                if (sensor.isBabel) babel = sensor.value;
+            });
+            tracking = false;
+        });
+
+        TEST_ASSERT_EQUAL(count, visited);
+        TEST_ASSERT_EQUAL_FLOAT(21.7f, babel);
+        if (count == 1) firstPeak = peakBytes;
+        // Memory use is the same for one sensor as for a hundred
+        TEST_ASSERT_EQUAL(firstPeak, peakBytes);
+
+        char line[160];
+        snprintf(line, sizeof(line), "[BENCH] %u sensor(s), %u byte body: %.1f us, peak heap %u bytes, document %u bytes",
+                 static_cast<unsigned>(count), static_cast<unsigned>(body.size()), nanos / 1000,
+                 static_cast<unsigned>(peakBytes), static_cast<unsigned>(HubSensorList::SENSOR_CAPACITY));
+        TEST_MESSAGE(line);
+    }
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_reads_every_sensor_with_a_value);
+    RUN_TEST(test_sensor_without_id_is_still_read);
+    RUN_TEST(test_empty_list_is_valid);
+    RUN_TEST(test_list_is_read_through_its_closing_bracket);
+    RUN_TEST(test_malformed_list_fails);
+    RUN_TEST(test_large_sensor_object_fits_the_fixed_document);
+    RUN_TEST(test_mqtt_sensor_message_is_routed_and_parsed);
+    RUN_TEST(test_mqtt_hub_list_is_left_to_http);
+    RUN_TEST(test_mqtt_list_message_is_parsed_per_element);
+    RUN_TEST(test_mqtt_malformed_message_fails);
+    RUN_TEST(test_parse_time_and_peak_heap_for_1_to_100_sensors);
+    return UNITY_END();
+}
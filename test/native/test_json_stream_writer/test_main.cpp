@@ -0,0 +1,159 @@
+#include <unity.h>
+#include <math.h>
+#include <string>
+#include "JsonStreamWriter.h"
+#include "CaptureStream.h"
+
+namespace {
+
+void assertQuoted(const char* expected, const char* text) {
+    CaptureStream stream;
+    {
+        JsonStreamWriter json(&stream);
+        json.value(text);
+    }
+    TEST_ASSERT_EQUAL_STRING(expected, stream.body.c_str());
+}
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_response_is_opened_and_ended_once() {
+    CaptureStream stream;
+    {
+        JsonStreamWriter json(&stream, 201);
+        json.beginObject().endObject();
+        json.end();
+    }
+    TEST_ASSERT_EQUAL(201, stream.code);
+    TEST_ASSERT_EQUAL_STRING("application/json", stream.contentType.c_str());
+    TEST_ASSERT_EQUAL(1, stream.ends);
+    TEST_ASSERT_EQUAL_STRING("{}", stream.body.c_str());
+}
+
+void test_scalars_and_commas() {
+    CaptureStream stream;
+    {
+        JsonStreamWriter json(&stream);
+        json.beginObject()
+            .field("success", true)
+            .field("off", false)
+            .field("n", -3)
+            .field("u", 4000000000UL)
+            .field("d", 1.5)
+            .field("s", "x")
+            .field("missing", static_cast<const char*>(nullptr))
+            .key("z").null()
+            .endObject();
+    }
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"success\":true,\"off\":false,\"n\":-3,\"u\":4000000000,\"d\":1.5,"
+        "\"s\":\"x\",\"missing\":null,\"z\":null}",
+        stream.body.c_str());
+}
+
+void test_nested_containers() {
+    CaptureStream stream;
+    {
+        JsonStreamWriter json(&stream);
+        json.beginObject()
+            .beginArray("a")
+                .value(1)
+                .beginObject().beginArray("b").endArray().endObject()
+                .beginArray().endArray()
+            .endArray()
+            .beginObject("c").endObject()
+            .field("d", 2)
+            .endObject();
+    }
+    TEST_ASSERT_EQUAL_STRING("{\"a\":[1,{\"b\":[]},[]],\"c\":{},\"d\":2}", stream.body.c_str());
+}
+
+void test_non_finite_numbers_become_null() {
+    CaptureStream stream;
+    {
+        JsonStreamWriter json(&stream);
+        json.beginArray().value(NAN).value(INFINITY).value(0.25).endArray();
+    }
+    TEST_ASSERT_EQUAL_STRING("[null,null,0.25]", stream.body.c_str());
+}
+
+void test_escapes() {
+    assertQuoted("\"a\\\"b\\\\c\"", "a\"b\\c");
+    assertQuoted("\"\\b\\f\\n\\r\\t\"", "\b\f\n\r\t");
+    assertQuoted("\"\\u0001\\u001f\\u007f\"", "\x01\x1f\x7f");
+    assertQuoted("\"/\"", "/");
+}
+
+void test_valid_utf8_passes_through() {
+    const char* text = "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF";
+    assertQuoted((std::string("\"") + text + "\"").c_str(), text);
+}
+
+void test_invalid_utf8_becomes_replacement() {
+    // Lone lead byte at the end
+    assertQuoted("\"a\\ufffd\"", "a\xC3");
+    // Overlong encoding of '/'
+    assertQuoted("\"\\ufffd\\ufffd\"", "\xC0\xAF");
+    // UTF-16 surrogate U+D800
+    assertQuoted("\"\\ufffd\\ufffd\\ufffd\"", "\xED\xA0\x80");
+    // Above U+10FFFF
+    assertQuoted("\"\\ufffd\\ufffd\\ufffd\\ufffd\"", "\xF4\x90\x80\x80");
+    // Truncated three-byte sequence followed by ASCII
+    assertQuoted("\"\\ufffd\\ufffdx\"", "\xE2\x82x");
+    // Stray continuation byte
+    assertQuoted("\"\\ufffd\"", "\x80");
+}
+
+void test_large_output_goes_out_in_buffer_sized_chunks() {
+    CaptureStream stream;
+    std::string expected = "[";
+    {
+        JsonStreamWriter json(&stream);
+        json.beginArray();
+        for (int i = 0; i < 300; i++) {
+            json.value(i);
+            expected += (i ? "," : "") + std::to_string(i);
+        }
+        json.endArray();
+    }
+    expected += "]";
+
+    TEST_ASSERT_TRUE(stream.chunks > 1);
+    TEST_ASSERT_EQUAL(JsonStreamWriter::BUFFER_SIZE, stream.largestChunk);
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), stream.body.c_str());
+}
+
+// A refused chunk stops all further output, but the response is still ended
+void test_stops_after_refused_chunk() {
+    CaptureStream stream(1);
+    {
+        JsonStreamWriter json(&stream);
+        json.beginArray();
+        for (int i = 0; i < 1000; i++) {
+            json.value(i);
+        }
+        TEST_ASSERT_TRUE(json.failed());
+        json.endArray();
+    }
+    TEST_ASSERT_EQUAL(2, stream.chunks);
+    TEST_ASSERT_EQUAL(JsonStreamWriter::BUFFER_SIZE, stream.body.size());
+    TEST_ASSERT_EQUAL(1, stream.ends);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_response_is_opened_and_ended_once);
+    RUN_TEST(test_scalars_and_commas);
+    RUN_TEST(test_nested_containers);
+    RUN_TEST(test_non_finite_numbers_become_null);
+    RUN_TEST(test_escapes);
+    RUN_TEST(test_valid_utf8_passes_through);
+    RUN_TEST(test_invalid_utf8_becomes_replacement);
+    RUN_TEST(test_large_output_goes_out_in_buffer_sized_chunks);
+    RUN_TEST(test_stops_after_refused_chunk);
+    return UNITY_END();
+}
@@ -0,0 +1,223 @@
+#include <unity.h>
+#include <string>
+#include <vector>
+#include "Metrics.h"
+#include "CaptureStream.h"
+
+namespace {
+
+std::vector<std::string> lines(const std::string& body) {
+    std::vector<std::string> result;
+    size_t start = 0;
+    size_t end;
+    while ((end = body.find('\n', start)) != std::string::npos) {
+        result.push_back(body.substr(start, end - start));
+        start = end + 1;
+    }
+    return result;
+}
+
+bool hasLine(const std::string& body, const std::string& line) {
+    for (const std::string& candidate : lines(body)) {
+        if (candidate == line) return true;
+    }
+    return false;
+}
+
+void assertLine(const std::string& body, const std::string& line) {
+    TEST_ASSERT_TRUE_MESSAGE(hasLine(body, line), line.c_str());
+}
+
+bool startsWith(const std::string& text, const std::string& prefix) {
+    return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+std::string render() {
+    CaptureStream stream;
+    Metrics::getInstance().render(&stream);
+    return stream.body;
+}
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_response_is_openmetrics_and_ends_with_eof() {
+    CaptureStream stream;
+    Metrics::getInstance().render(&stream);
+
+    TEST_ASSERT_EQUAL(200, stream.code);
+    TEST_ASSERT_TRUE(startsWith(stream.contentType, "application/openmetrics-text; version=1.0.0"));
+    TEST_ASSERT_EQUAL(1, stream.ends);
+    std::vector<std::string> all = lines(stream.body);
+    TEST_ASSERT_EQUAL_STRING("# EOF", all.back().c_str());
+    TEST_ASSERT_EQUAL('\n', stream.body.back());
+}
+
+void test_every_sample_follows_its_type_and_help() {
+    std::string body = render();
+    std::vector<std::string> all = lines(body);
+
+    std::string family;
+    std::string type;
+    size_t samples = 0;
+    for (size_t i = 0; i + 1 < all.size(); i++) {
+        const std::string& line = all[i];
+        if (startsWith(line, "# TYPE ")) {
+            size_t space = line.find(' ', 7);
+            family = line.substr(7, space - 7);
+            type = line.substr(space + 1);
+            // HELP comes right after TYPE, for the same family
+            TEST_ASSERT_TRUE_MESSAGE(startsWith(all[i + 1], "# HELP " + family + " "), line.c_str());
+            i++;
+            continue;
+        }
+        TEST_ASSERT_FALSE_MESSAGE(family.empty(), line.c_str());
+        TEST_ASSERT_TRUE_MESSAGE(startsWith(line, family), line.c_str());
+
+        std::string name = line.substr(0, line.find_first_of("{ "));
+        std::string suffix = name.substr(family.size());
+        if (type == "counter") {
+            TEST_ASSERT_EQUAL_STRING_MESSAGE("_total", suffix.c_str(), line.c_str());
+        } else if (type == "gauge") {
+            TEST_ASSERT_EQUAL_STRING_MESSAGE("", suffix.c_str(), line.c_str());
+        } else {
+            TEST_ASSERT_EQUAL_STRING("histogram", type.c_str());
+            TEST_ASSERT_TRUE_MESSAGE(suffix == "_bucket" || suffix == "_count" || suffix == "_sum", line.c_str());
+        }
+        samples++;
+    }
+    TEST_ASSERT_TRUE(samples > 40);
+}
+
+void test_counters_are_rendered_with_total_suffix() {
+    Metrics& metrics = Metrics::getInstance();
+    metrics.mqtt.connects.add(3);
+    metrics.http.responses[3].add(2);
+
+    std::string body = render();
+
+    assertLine(body, "auxdisplay_mqtt_connects_total " + std::to_string(metrics.mqtt.connects.get()));
+    assertLine(body, "auxdisplay_http_responses_total{code=\"4xx\"} " +
+                     std::to_string(metrics.http.responses[3].get()));
+    TEST_ASSERT_FALSE(hasLine(body, "auxdisplay_mqtt_connects " + std::to_string(metrics.mqtt.connects.get())));
+}
+
+void test_buckets_are_cumulative_and_end_with_inf() {
+    Metrics& metrics = Metrics::getInstance();
+    metrics.loopLatency.reset();
+    metrics.loopLatency.record(50);
+    metrics.loopLatency.record(100);
+    metrics.loopLatency.record(300);
+    metrics.loopLatency.record(2000000);
+
+    std::string body = render();
+
+    assertLine(body, "auxdisplay_loop_latency_seconds_bucket{le=\"0.0001\"} 2");
+    assertLine(body, "auxdisplay_loop_latency_seconds_bucket{le=\"0.00025\"} 2");
+    assertLine(body, "auxdisplay_loop_latency_seconds_bucket{le=\"0.0005\"} 3");
+    assertLine(body, "auxdisplay_loop_latency_seconds_bucket{le=\"0.25\"} 3");
+    assertLine(body, "auxdisplay_loop_latency_seconds_bucket{le=\"1\"} 3");
+    assertLine(body, "auxdisplay_loop_latency_seconds_bucket{le=\"+Inf\"} 4");
+    assertLine(body, "auxdisplay_loop_latency_seconds_count 4");
+    assertLine(body, "auxdisplay_loop_latency_seconds_sum 2.00045");
+
+    // +Inf is the last bucket, followed by count and sum
+    size_t inf = body.find("auxdisplay_loop_latency_seconds_bucket{le=\"+Inf\"}");
+    TEST_ASSERT_EQUAL(std::string::npos, body.find("auxdisplay_loop_latency_seconds_bucket", inf + 1));
+    TEST_ASSERT_TRUE(body.find("auxdisplay_loop_latency_seconds_count") > inf);
+}
+
+void test_labelled_series_drop_trailing_comma_for_count_and_sum() {
+    Metrics& metrics = Metrics::getInstance();
+    metrics.bme280Read.reset();
+    metrics.bme280Read.record(1500);
+    metrics.sensorHubRead.reset();
+    metrics.sensorHubRead.record(2000000);
+
+    std::string body = render();
+
+    assertLine(body, "auxdisplay_sensor_read_seconds_bucket{sensor=\"bme280\",le=\"0.001\"} 0");
+    assertLine(body, "auxdisplay_sensor_read_seconds_bucket{sensor=\"bme280\",le=\"0.002\"} 1");
+    assertLine(body, "auxdisplay_sensor_read_seconds_bucket{sensor=\"bme280\",le=\"+Inf\"} 1");
+    assertLine(body, "auxdisplay_sensor_read_seconds_count{sensor=\"bme280\"} 1");
+    assertLine(body, "auxdisplay_sensor_read_seconds_sum{sensor=\"bme280\"} 0.0015");
+
+    assertLine(body, "auxdisplay_sensor_read_seconds_bucket{sensor=\"sensorhub\",le=\"0.05\"} 0");
+    assertLine(body, "auxdisplay_sensor_read_seconds_bucket{sensor=\"sensorhub\",le=\"2.5\"} 1");
+    assertLine(body, "auxdisplay_sensor_read_seconds_bucket{sensor=\"sensorhub\",le=\"10\"} 1");
+    assertLine(body, "auxdisplay_sensor_read_seconds_count{sensor=\"sensorhub\"} 1");
+    // Whole seconds come out without a fraction
+    assertLine(body, "auxdisplay_sensor_read_seconds_sum{sensor=\"sensorhub\"} 2");
+}
+
+void test_chunks_fill_the_buffer_and_break_between_lines() {
+    CaptureStream stream;
+    Metrics::getInstance().render(&stream);
+
+    TEST_ASSERT_TRUE(stream.chunks > 1);
+    TEST_ASSERT_TRUE(stream.largestChunk < Metrics::RENDER_BUFFER_SIZE);
+    // Lines are batched up, not sent one per chunk
+    TEST_ASSERT_TRUE(stream.chunks <= stream.body.size() / (Metrics::RENDER_BUFFER_SIZE / 2) + 1);
+    for (size_t end : stream.chunkEnds) {
+        TEST_ASSERT_EQUAL('\n', stream.body[end - 1]);
+    }
+}
+
+void test_output_stops_after_refused_chunk() {
+    CaptureStream stream(1);
+    Metrics::getInstance().render(&stream);
+
+    // One chunk taken, one refused, and nothing tried after that
+    TEST_ASSERT_EQUAL(2, stream.chunks);
+    TEST_ASSERT_EQUAL(stream.chunkEnds[0], stream.body.size());
+    TEST_ASSERT_EQUAL(std::string::npos, stream.body.find("# EOF"));
+    TEST_ASSERT_EQUAL(1, stream.ends);
+}
+
+void test_registered_tasks_get_a_stack_series() {
+    Metrics& metrics = Metrics::getInstance();
+    TaskHandle_t handle = xTaskGetCurrentTaskHandle();
+    TEST_ASSERT_TRUE(metrics.registerTask("worker", handle));
+
+    assertLine(render(), "auxdisplay_task_stack_free_bytes{task=\"worker\"} 0");
+
+    metrics.unregisterTask(handle);
+    TEST_ASSERT_EQUAL(std::string::npos, render().find("task=\"worker\""));
+}
+
+void test_sample_is_rate_limited() {
+    Metrics& metrics = Metrics::getInstance();
+    testEsp().freeHeap = 120000;
+    testMillis() = 60000;
+
+    TEST_ASSERT_TRUE(metrics.sample());
+    TEST_ASSERT_EQUAL(120000, metrics.getHeapFree());
+    TEST_ASSERT_EQUAL(60, metrics.getUptime());
+
+    testEsp().freeHeap = 110000;
+    testMillis() += Metrics::SAMPLE_INTERVAL - 1;
+    TEST_ASSERT_FALSE(metrics.sample());
+    TEST_ASSERT_EQUAL(120000, metrics.getHeapFree());
+
+    testMillis() += 1;
+    TEST_ASSERT_TRUE(metrics.sample());
+    TEST_ASSERT_EQUAL(110000, metrics.getHeapFree());
+    assertLine(render(), "auxdisplay_heap_free_bytes 110000");
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_response_is_openmetrics_and_ends_with_eof);
+    RUN_TEST(test_every_sample_follows_its_type_and_help);
+    RUN_TEST(test_counters_are_rendered_with_total_suffix);
+    RUN_TEST(test_buckets_are_cumulative_and_end_with_inf);
+    RUN_TEST(test_labelled_series_drop_trailing_comma_for_count_and_sum);
+    RUN_TEST(test_chunks_fill_the_buffer_and_break_between_lines);
+    RUN_TEST(test_output_stops_after_refused_chunk);
+    RUN_TEST(test_registered_tasks_get_a_stack_series);
+    RUN_TEST(test_sample_is_rate_limited);
+    return UNITY_END();
+}
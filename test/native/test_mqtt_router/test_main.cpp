@@ -0,0 +1,216 @@
+#include <unity.h>
+#include "MQTTRouter.h"
+#include "Benchmark.h"
+
+namespace {
+
+char payloadBytes[] = "payload";
+MQTTPayload payload = {reinterpret_cast<uint8_t*>(payloadBytes), sizeof(payloadBytes) - 1};
+
+int hits[MQTTRouter::MAX_ROUTES];
+
+MQTTRouter::Handler counter(int index) {
+    return [index](const char*, MQTTPayload) { hits[index]++; };
+}
+
+}
+
+void setUp() {
+    memset(hits, 0, sizeof(hits));
+}
+
+void tearDown() {}
+
+void test_exact_topic_matches_only_itself() {
+    MQTTRouter router;
+    TEST_ASSERT_TRUE(router.add("a/b", counter(0)));
+
+    TEST_ASSERT_EQUAL(1, router.dispatch("a/b", payload));
+    TEST_ASSERT_EQUAL(0, router.dispatch("a/b/c", payload));
+    TEST_ASSERT_EQUAL(0, router.dispatch("a", payload));
+    TEST_ASSERT_EQUAL(0, router.dispatch("a/bc", payload));
+    TEST_ASSERT_EQUAL(1, hits[0]);
+}
+
+void test_plus_matches_one_level() {
+    MQTTRouter router;
+    TEST_ASSERT_TRUE(router.add("home/+/temp", counter(0)));
+
+    TEST_ASSERT_EQUAL(1, router.dispatch("home/kitchen/temp", payload));
+    TEST_ASSERT_EQUAL(1, router.dispatch("home//temp", payload));
+    TEST_ASSERT_EQUAL(0, router.dispatch("home/kitchen/hall/temp", payload));
+    TEST_ASSERT_EQUAL(2, hits[0]);
+}
+
+void test_hash_matches_parent_and_descendants() {
+    MQTTRouter router;
+    TEST_ASSERT_TRUE(router.add("a/#", counter(0)));
+
+    TEST_ASSERT_EQUAL(1, router.dispatch("a", payload));
+    TEST_ASSERT_EQUAL(1, router.dispatch("a/b", payload));
+    TEST_ASSERT_EQUAL(1, router.dispatch("a/b/c", payload));
+    TEST_ASSERT_EQUAL(0, router.dispatch("b", payload));
+}
+
+void test_overlapping_filters_all_fire() {
+    MQTTRouter router;
+    TEST_ASSERT_TRUE(router.add("a/b", counter(0)));
+    TEST_ASSERT_TRUE(router.add("a/+", counter(1)));
+    TEST_ASSERT_TRUE(router.add("#", counter(2)));
+
+    TEST_ASSERT_EQUAL(3, router.dispatch("a/b", payload));
+    TEST_ASSERT_EQUAL(1, hits[0]);
+    TEST_ASSERT_EQUAL(1, hits[1]);
+    TEST_ASSERT_EQUAL(1, hits[2]);
+}
+
+void test_wildcards_skip_system_topics() {
+    MQTTRouter router;
+    TEST_ASSERT_TRUE(router.add("#", counter(0)));
+    TEST_ASSERT_TRUE(router.add("+/broker", counter(1)));
+    TEST_ASSERT_TRUE(router.add("$SYS/broker", counter(2)));
+
+    TEST_ASSERT_EQUAL(1, router.dispatch("$SYS/broker", payload));
+    TEST_ASSERT_EQUAL(1, hits[2]);
+}
+
+void test_handler_sees_topic_and_payload() {
+    MQTTRouter router;
+    const char* seenTopic = nullptr;
+    unsigned int seenLength = 0;
+    TEST_ASSERT_TRUE(router.add("a/+", [&](const char* topic, MQTTPayload data) {
+        seenTopic = topic;
+        seenLength = data.length;
+    }));
+
+    const char* topic = "a/b";
+    router.dispatch(topic, payload);
+    TEST_ASSERT_TRUE(seenTopic == topic);
+    TEST_ASSERT_EQUAL(payload.length, seenLength);
+}
+
+void test_invalid_filters_are_rejected() {
+    MQTTRouter router;
+    TEST_ASSERT_FALSE(router.add("", counter(0)));
+    TEST_ASSERT_FALSE(router.add("a/b+", counter(0)));
+    TEST_ASSERT_FALSE(router.add("a/#/b", counter(0)));
+    TEST_ASSERT_FALSE(router.add("a", nullptr));
+
+    char tooLong[MQTTRouter::MAX_FILTER_LENGTH + 1];
+    memset(tooLong, 'x', sizeof(tooLong) - 1);
+    tooLong[sizeof(tooLong) - 1] = '\0';
+    TEST_ASSERT_FALSE(router.add(tooLong, counter(0)));
+
+    TEST_ASSERT_TRUE(router.add("a/b", counter(0)));
+    TEST_ASSERT_FALSE(router.add("a/b", counter(1)));
+    TEST_ASSERT_EQUAL(1, router.routeCount());
+}
+
+// A filter rejected partway through must not leave nodes behind that point
+// into the route slot the next filter is copied into
+void test_rejected_filter_leaves_trie_intact() {
+    MQTTRouter router;
+    TEST_ASSERT_FALSE(router.add("x/y/#/z", counter(0)));
+    TEST_ASSERT_FALSE(router.add("p/q/r+", counter(0)));
+    TEST_ASSERT_TRUE(router.add("p/q/s", counter(1)));
+
+    TEST_ASSERT_EQUAL(0, router.dispatch("x/y", payload));
+    TEST_ASSERT_EQUAL(0, router.dispatch("p/q/r", payload));
+    TEST_ASSERT_EQUAL(1, router.dispatch("p/q/s", payload));
+    TEST_ASSERT_EQUAL(0, hits[0]);
+    TEST_ASSERT_EQUAL(1, hits[1]);
+}
+
+void test_node_pool_exhaustion_rolls_back() {
+    MQTTRouter router;
+
+    // Root plus one node per level; fill the pool up to two free nodes
+    char filter[MQTTRouter::MAX_FILTER_LENGTH];
+    size_t used = 1;
+    int route = 0;
+    while (used + 4 <= MQTTRouter::MAX_NODES - 2) {
+        snprintf(filter, sizeof(filter), "r%d/a/b/c", route);
+        TEST_ASSERT_TRUE(router.add(filter, counter(route)));
+        used += 4;
+        route++;
+    }
+    size_t remaining = MQTTRouter::MAX_NODES - used;
+
+    // Needs more nodes than are left: rejected without using any of them
+    TEST_ASSERT_FALSE(router.add("long/filter/that/does/not/fit", counter(route)));
+
+    // The remaining nodes are still there for a filter that fits
+    snprintf(filter, sizeof(filter), "%s", remaining >= 2 ? "s/t" : "s");
+    TEST_ASSERT_TRUE(router.add(filter, counter(route)));
+    TEST_ASSERT_EQUAL(1, router.dispatch(filter, payload));
+    TEST_ASSERT_EQUAL(0, router.dispatch("long/filter/that/does/not/fit", payload));
+    TEST_ASSERT_EQUAL(1, hits[route]);
+}
+
+void test_filters_are_copied() {
+    MQTTRouter router;
+    char filter[] = "a/b";
+    TEST_ASSERT_TRUE(router.add(filter, counter(0)));
+    strcpy(filter, "x/y");
+
+    TEST_ASSERT_EQUAL(1, router.dispatch("a/b", payload));
+    TEST_ASSERT_EQUAL_STRING("a/b", router.filter(0));
+}
+
+// Dispatch cost with the table full, over the kinds of filter the firmware
+// registers: exact topics, one-level wildcards and subtree wildcards
+void test_dispatch_benchmark_at_max_routes() {
+    MQTTRouter router;
+    const char* filters[MQTTRouter::MAX_ROUTES] = {
+        "chaoticvolt/sensorhub/relay/state",
+        "chaoticvolt/sensorhub/sensors/#",
+        "auxdisplay/+/config",
+        "auxdisplay/relay/+/set",
+        "homeassistant/status",
+        "auxdisplay/display/set",
+        "auxdisplay/#",
+        "+/status",
+    };
+    for (size_t i = 0; i < MQTTRouter::MAX_ROUTES; i++) {
+        TEST_ASSERT_TRUE(router.add(filters[i], counter(i)));
+    }
+
+    struct Case {
+        const char* name;
+        const char* topic;
+        size_t matches;
+    };
+    const Case cases[] = {
+        {"exact", "chaoticvolt/sensorhub/relay/state", 1},
+        {"plus", "auxdisplay/relay/1/set", 2},
+        {"hash", "chaoticvolt/sensorhub/sensors/28-0000/temperature", 1},
+        {"miss", "zigbee2mqtt/bridge/state", 0},
+    };
+    for (const Case& c : cases) {
+        TEST_ASSERT_EQUAL(c.matches, router.dispatch(c.topic, payload));
+
+        size_t matched = 0;
+        double nanos = nanosPerCall(100000, [&](size_t) { matched += router.dispatch(c.topic, payload); });
+        TEST_ASSERT_EQUAL(c.matches * 100000, matched);
+
+        char name[48];
+        snprintf(name, sizeof(name), "dispatch %s", c.name);
+        reportBenchmark(name, nanos);
+    }
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_exact_topic_matches_only_itself);
+    RUN_TEST(test_plus_matches_one_level);
+    RUN_TEST(test_hash_matches_parent_and_descendants);
+    RUN_TEST(test_overlapping_filters_all_fire);
+    RUN_TEST(test_wildcards_skip_system_topics);
+    RUN_TEST(test_handler_sees_topic_and_payload);
+    RUN_TEST(test_invalid_filters_are_rejected);
+    RUN_TEST(test_rejected_filter_leaves_trie_intact);
+    RUN_TEST(test_node_pool_exhaustion_rolls_back);
+    RUN_TEST(test_filters_are_copied);
+    RUN_TEST(test_dispatch_benchmark_at_max_routes);
+    return UNITY_END();
+}
@@ -0,0 +1,113 @@
+#include <unity.h>
+#include <cstdio>
+#include "PollInterval.h"
+
+namespace {
+
+constexpr unsigned long SECOND = 1000;
+constexpr unsigned long MINUTE = 60 * SECOND;
+
+// Polls until the interval stops moving, returning how many it took
+int settle(PollInterval& interval, bool changed) {
+    int polls = 0;
+    unsigned long last;
+    do {
+        last = interval.get();
+        interval.update(changed);
+        polls++;
+    } while (interval.get() != last && polls < 100);
+    return polls - 1;
+}
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_starts_at_thirty_seconds() {
+    PollInterval interval;
+    TEST_ASSERT_EQUAL(30 * SECOND, interval.get());
+}
+
+void test_unchanged_polls_back_off_to_sixty_seconds() {
+    PollInterval interval;
+
+    unsigned long expected = 30 * SECOND;
+    for (int i = 0; i < 6; i++) {
+        interval.update(false);
+        expected += 5 * SECOND;
+        TEST_ASSERT_EQUAL(expected, interval.get());
+    }
+    TEST_ASSERT_EQUAL(PollInterval::MAX, interval.get());
+
+    // And stays there however long the hub keeps answering 304
+    for (int i = 0; i < 1000; i++) interval.update(false);
+    TEST_ASSERT_EQUAL(60 * SECOND, interval.get());
+}
+
+void test_changes_bring_it_back_to_ten_seconds() {
+    PollInterval interval;
+    settle(interval, false);
+    TEST_ASSERT_EQUAL(60 * SECOND, interval.get());
+
+    interval.update(true);
+    TEST_ASSERT_EQUAL(30 * SECOND, interval.get());
+    interval.update(true);
+    TEST_ASSERT_EQUAL(15 * SECOND, interval.get());
+    interval.update(true);
+    TEST_ASSERT_EQUAL(PollInterval::MIN, interval.get());
+
+    interval.update(true);
+    TEST_ASSERT_EQUAL(10 * SECOND, interval.get());
+}
+
+void test_full_swing_takes_a_few_polls() {
+    PollInterval interval;
+    TEST_ASSERT_EQUAL(2, settle(interval, true));
+    TEST_ASSERT_EQUAL(PollInterval::MIN, interval.get());
+    TEST_ASSERT_EQUAL(10, settle(interval, false));
+    TEST_ASSERT_EQUAL(PollInterval::MAX, interval.get());
+}
+
+// A hub whose readings change every `period`, polled for an hour: bytes on
+// the wire with conditional requests and the adapted interval, against
+// fetching the full list every 30 s
+void test_bytes_per_hour_against_fixed_polling() {
+    const unsigned long BODY = 2800;        // Ten sensors, as /api/sensors lists them
+    const unsigned long HEADERS = 250;      // Request plus response head
+    const unsigned long FIXED = 30 * SECOND;
+
+    for (unsigned long period : {1 * MINUTE, 5 * MINUTE, 30 * MINUTE}) {
+        PollInterval interval;
+        unsigned long adaptive = 0;
+        unsigned long polls = 0;
+        unsigned long seenVersion = static_cast<unsigned long>(-1);
+        for (unsigned long now = 0; now < 60 * MINUTE; now += interval.get()) {
+            unsigned long version = now / period;
+            bool changed = version != seenVersion;
+            adaptive += HEADERS + (changed ? BODY : 0);
+            seenVersion = version;
+            interval.update(changed);
+            polls++;
+        }
+        unsigned long fixed = (60 * MINUTE / FIXED) * (HEADERS + BODY);
+
+        TEST_ASSERT_TRUE(adaptive < fixed);
+
+        char line[128];
+        snprintf(line, sizeof(line), "[BENCH] change every %lu min: %lu polls, %lu bytes/h (fixed 30 s: %lu bytes/h)",
+                 period / MINUTE, polls, adaptive, fixed);
+        TEST_MESSAGE(line);
+    }
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_starts_at_thirty_seconds);
+    RUN_TEST(test_unchanged_polls_back_off_to_sixty_seconds);
+    RUN_TEST(test_changes_bring_it_back_to_ten_seconds);
+    RUN_TEST(test_full_swing_takes_a_few_polls);
+    RUN_TEST(test_bytes_per_hour_against_fixed_polling);
+    return UNITY_END();
+}
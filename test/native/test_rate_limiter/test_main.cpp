@@ -0,0 +1,127 @@
+#include <unity.h>
+#include <climits>
+#include "rate_limiter.h"
+
+namespace {
+
+const int MAX_ATTEMPTS = 5;
+const unsigned long BLOCK_DURATION = 15 * 60 * 1000;
+const uint32_t CLIENT = 0x0A04A8C0;     // 192.168.4.10
+const uint32_t OTHER = 0x0B04A8C0;      // 192.168.4.11
+
+void fail(RateLimiter& limiter, uint32_t address, int times) {
+    for (int i = 0; i < times; i++) limiter.recordAttempt(address);
+}
+
+}
+
+void setUp() {
+    testMillis() = 1000;
+}
+
+void tearDown() {}
+
+void test_unknown_client_may_attempt() {
+    RateLimiter limiter;
+
+    TEST_ASSERT_TRUE(limiter.canAttemptLogin(CLIENT));
+    TEST_ASSERT_EQUAL(0, limiter.getRemainingBlockTime(CLIENT));
+}
+
+void test_repeated_failures_block_only_that_client() {
+    RateLimiter limiter;
+    fail(limiter, CLIENT, MAX_ATTEMPTS - 1);
+    TEST_ASSERT_TRUE(limiter.canAttemptLogin(CLIENT));
+
+    limiter.recordAttempt(CLIENT);
+
+    TEST_ASSERT_FALSE(limiter.canAttemptLogin(CLIENT));
+    TEST_ASSERT_EQUAL(BLOCK_DURATION, limiter.getRemainingBlockTime(CLIENT));
+    TEST_ASSERT_TRUE(limiter.canAttemptLogin(OTHER));
+}
+
+void test_block_expires() {
+    RateLimiter limiter;
+    fail(limiter, CLIENT, MAX_ATTEMPTS);
+
+    testMillis() += BLOCK_DURATION - 1;
+    TEST_ASSERT_FALSE(limiter.canAttemptLogin(CLIENT));
+    TEST_ASSERT_EQUAL(1, limiter.getRemainingBlockTime(CLIENT));
+
+    testMillis() += 1;
+    TEST_ASSERT_TRUE(limiter.canAttemptLogin(CLIENT));
+    TEST_ASSERT_EQUAL(0, limiter.getRemainingBlockTime(CLIENT));
+}
+
+void test_successful_login_clears_failures() {
+    RateLimiter limiter;
+    fail(limiter, CLIENT, MAX_ATTEMPTS - 1);
+
+    limiter.resetAttempts(CLIENT);
+    fail(limiter, CLIENT, MAX_ATTEMPTS - 1);
+
+    TEST_ASSERT_TRUE(limiter.canAttemptLogin(CLIENT));
+}
+
+void test_failures_spread_out_do_not_add_up() {
+    RateLimiter limiter;
+    fail(limiter, CLIENT, MAX_ATTEMPTS - 1);
+
+    testMillis() += BLOCK_DURATION;
+    limiter.recordAttempt(CLIENT);
+
+    TEST_ASSERT_TRUE(limiter.canAttemptLogin(CLIENT));
+}
+
+void test_block_survives_millis_wrap() {
+    RateLimiter limiter;
+    testMillis() = ULONG_MAX - 1000;
+    fail(limiter, CLIENT, MAX_ATTEMPTS);
+
+    testMillis() += 2000;       // Wrapped
+    TEST_ASSERT_FALSE(limiter.canAttemptLogin(CLIENT));
+    TEST_ASSERT_EQUAL(BLOCK_DURATION - 2000, limiter.getRemainingBlockTime(CLIENT));
+
+    testMillis() += BLOCK_DURATION;
+    TEST_ASSERT_TRUE(limiter.canAttemptLogin(CLIENT));
+}
+
+void test_flood_of_new_addresses_cannot_lift_a_block() {
+    RateLimiter limiter;
+    fail(limiter, CLIENT, MAX_ATTEMPTS);
+
+    for (uint32_t i = 0; i < 64; i++) {
+        testMillis() += 10;
+        limiter.recordAttempt(OTHER + (i << 24));
+    }
+
+    TEST_ASSERT_FALSE(limiter.canAttemptLogin(CLIENT));
+    TEST_ASSERT_TRUE(limiter.getRemainingBlockTime(CLIENT) > 0);
+}
+
+void test_full_table_evicts_least_recently_seen() {
+    RateLimiter limiter;
+    fail(limiter, CLIENT, MAX_ATTEMPTS - 1);
+
+    // Eight newer clients fill the table and push out the oldest record
+    for (uint32_t i = 0; i < 8; i++) {
+        testMillis() += 10;
+        limiter.recordAttempt(OTHER + (i << 24));
+    }
+    fail(limiter, CLIENT, MAX_ATTEMPTS - 1);
+
+    TEST_ASSERT_TRUE(limiter.canAttemptLogin(CLIENT));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_unknown_client_may_attempt);
+    RUN_TEST(test_repeated_failures_block_only_that_client);
+    RUN_TEST(test_block_expires);
+    RUN_TEST(test_successful_login_clears_failures);
+    RUN_TEST(test_failures_spread_out_do_not_add_up);
+    RUN_TEST(test_block_survives_millis_wrap);
+    RUN_TEST(test_flood_of_new_addresses_cannot_lift_a_block);
+    RUN_TEST(test_full_table_evicts_least_recently_seen);
+    return UNITY_END();
+}
@@ -0,0 +1,345 @@
+#include <unity.h>
+#include <cmath>
+#include <vector>
+#include "ScheduleEngine.h"
+#include "ScheduleRule.h"
+#include "TimerWheel.h"
+
+namespace {
+
+constexpr uint16_t DAY = ScheduleWindow::MINUTES_PER_DAY;
+constexpr uint8_t EVERY_DAY = 0x7F;
+constexpr uint8_t MONDAY = 1 << 1;
+
+ScheduleRule window(uint8_t days, uint16_t start, uint16_t end) {
+    ScheduleRule rule = {};
+    rule.days = days;
+    rule.startMinute = start;
+    rule.endMinute = end;
+    return rule;
+}
+
+uint16_t at(uint8_t day, uint8_t hour, uint8_t minute) {
+    return day * DAY + hour * 60 + minute;
+}
+
+using Wheel = TimerWheel<8, 4>;
+
+// Steps the wheel until `id` fires and returns how many steps that took
+uint32_t stepsUntilFired(Wheel& wheel, uint8_t id, uint32_t limit) {
+    for (uint32_t step = 1; step <= limit; step++) {
+        bool fired = false;
+        wheel.advance([&](uint8_t firedId) { fired |= firedId == id; });
+        if (fired) return step;
+    }
+    return 0;
+}
+
+// Sensor and relays the engine sees through its hooks
+struct Command {
+    uint16_t at;
+    uint8_t relayId;
+    RelayState state;
+};
+
+uint16_t currentMinute = 0;
+bool fresh = true;
+float reading = 0.0f;
+std::vector<Command> commands;
+
+ScheduleEngine::Hooks hooks() {
+    return {
+        [](ScheduleCondition, float& value) {
+            value = reading;
+            return fresh;
+        },
+        [](uint8_t relayId, RelayState state) { commands.push_back({currentMinute, relayId, state}); },
+    };
+}
+
+ScheduleRule conditional(ScheduleRule rule, char comparison, float limit) {
+    rule.condition = static_cast<uint8_t>(ScheduleCondition::TEMPERATURE);
+    rule.comparison = comparison;
+    rule.threshold = static_cast<int16_t>(lroundf(limit * 10.0f));
+    return rule;
+}
+
+// Ticks every minute from currentMinute through `until`
+void runTo(ScheduleEngine& engine, uint16_t until) {
+    while (currentMinute != until) {
+        currentMinute = (currentMinute + 1) % ScheduleWindow::MINUTES_PER_WEEK;
+        engine.tick(currentMinute);
+    }
+}
+
+void jumpTo(ScheduleEngine& engine, uint16_t to) {
+    currentMinute = to;
+    engine.tick(currentMinute);
+}
+
+void assertCommand(size_t index, uint16_t at, RelayState state) {
+    TEST_ASSERT_TRUE(index < commands.size());
+    TEST_ASSERT_EQUAL(at, commands[index].at);
+    TEST_ASSERT_EQUAL(0, commands[index].relayId);
+    TEST_ASSERT_EQUAL(static_cast<int>(state), static_cast<int>(commands[index].state));
+}
+
+}
+
+void setUp() {
+    currentMinute = 0;
+    fresh = true;
+    reading = 0.0f;
+    commands.clear();
+}
+
+void tearDown() {}
+
+void test_wheel_fires_after_delay() {
+    for (uint32_t delay : {1u, 5u, 8u, 9u, 17u, 100u}) {
+        Wheel wheel;
+        wheel.schedule(0, delay);
+        TEST_ASSERT_EQUAL(delay, stepsUntilFired(wheel, 0, 200));
+    }
+}
+
+void test_wheel_fires_each_timer_once() {
+    Wheel wheel;
+    wheel.schedule(0, 3);
+    wheel.schedule(1, 3);
+    wheel.schedule(2, 11);
+
+    int fired[4] = {0};
+    for (int step = 0; step < 40; step++) {
+        wheel.advance([&](uint8_t id) { fired[id]++; });
+    }
+    TEST_ASSERT_EQUAL(1, fired[0]);
+    TEST_ASSERT_EQUAL(1, fired[1]);
+    TEST_ASSERT_EQUAL(1, fired[2]);
+    TEST_ASSERT_EQUAL(0, fired[3]);
+}
+
+// The callback reschedules, as the scheduler does for every rule
+void test_wheel_reschedule_from_callback() {
+    Wheel wheel;
+    wheel.schedule(0, 8);
+
+    int fired = 0;
+    for (int step = 1; step <= 32; step++) {
+        wheel.advance([&](uint8_t id) {
+            TEST_ASSERT_EQUAL(0, step % 8);
+            fired++;
+            wheel.schedule(id, 8);
+        });
+    }
+    TEST_ASSERT_EQUAL(4, fired);
+}
+
+void test_wheel_clear_drops_timers() {
+    Wheel wheel;
+    wheel.schedule(0, 2);
+    wheel.clear();
+    TEST_ASSERT_EQUAL(0, stepsUntilFired(wheel, 0, 20));
+}
+
+void test_daytime_window() {
+    ScheduleRule rule = window(MONDAY, 8 * 60, 17 * 60);
+
+    TEST_ASSERT_FALSE(ScheduleWindow::contains(rule, at(1, 7, 59)));
+    TEST_ASSERT_TRUE(ScheduleWindow::contains(rule, at(1, 8, 0)));
+    TEST_ASSERT_TRUE(ScheduleWindow::contains(rule, at(1, 16, 59)));
+    TEST_ASSERT_FALSE(ScheduleWindow::contains(rule, at(1, 17, 0)));
+    TEST_ASSERT_FALSE(ScheduleWindow::contains(rule, at(2, 9, 0)));
+}
+
+// The morning part of an overnight window belongs to the previous day
+void test_overnight_window_follows_start_day() {
+    ScheduleRule rule = window(MONDAY, 22 * 60, 6 * 60);
+
+    TEST_ASSERT_TRUE(ScheduleWindow::contains(rule, at(1, 23, 0)));
+    TEST_ASSERT_TRUE(ScheduleWindow::contains(rule, at(2, 5, 59)));
+    TEST_ASSERT_FALSE(ScheduleWindow::contains(rule, at(2, 6, 0)));
+    TEST_ASSERT_FALSE(ScheduleWindow::contains(rule, at(1, 5, 0)));
+}
+
+void test_overnight_window_wraps_the_week() {
+    ScheduleRule rule = window(1 << 6, 22 * 60, 6 * 60);  // Saturday night
+
+    TEST_ASSERT_TRUE(ScheduleWindow::contains(rule, at(6, 22, 30)));
+    TEST_ASSERT_TRUE(ScheduleWindow::contains(rule, at(0, 1, 0)));
+}
+
+void test_one_shot_rule_is_open_for_its_minute() {
+    ScheduleRule rule = window(EVERY_DAY, 7 * 60, 7 * 60);
+
+    TEST_ASSERT_TRUE(ScheduleWindow::contains(rule, at(3, 7, 0)));
+    TEST_ASSERT_FALSE(ScheduleWindow::contains(rule, at(3, 7, 1)));
+}
+
+void test_minutes_until_edge() {
+    ScheduleRule rule = window(EVERY_DAY, 8 * 60, 17 * 60);
+
+    TEST_ASSERT_EQUAL(60, ScheduleWindow::minutesUntilEdge(rule, at(1, 7, 0)));
+    TEST_ASSERT_EQUAL(9 * 60, ScheduleWindow::minutesUntilEdge(rule, at(1, 8, 0)));
+    TEST_ASSERT_EQUAL(15 * 60, ScheduleWindow::minutesUntilEdge(rule, at(1, 17, 0)));
+    // Saturday evening: the next edge is Sunday morning, across the week wrap
+    TEST_ASSERT_EQUAL(15 * 60, ScheduleWindow::minutesUntilEdge(rule, at(6, 17, 0)));
+}
+
+void test_one_shot_edge_is_a_day_away() {
+    ScheduleRule rule = window(EVERY_DAY, 7 * 60, 7 * 60);
+
+    TEST_ASSERT_EQUAL(DAY, ScheduleWindow::minutesUntilEdge(rule, at(2, 7, 0)));
+    TEST_ASSERT_EQUAL(1, ScheduleWindow::minutesUntilEdge(rule, at(2, 6, 59)));
+}
+
+void test_engine_window_opens_and_closes() {
+    ScheduleEngine engine(hooks());
+    ScheduleRule rule = window(MONDAY, 8 * 60, 9 * 60);
+    rule.action = static_cast<uint8_t>(RelayState::ON);
+    engine.setRules(&rule, 1);
+
+    jumpTo(engine, at(1, 7, 0));
+    runTo(engine, at(2, 12, 0));
+
+    TEST_ASSERT_EQUAL(2, commands.size());
+    assertCommand(0, at(1, 8, 0), RelayState::ON);
+    assertCommand(1, at(1, 9, 0), RelayState::OFF);
+}
+
+void test_engine_same_minute_twice_does_nothing() {
+    ScheduleEngine engine(hooks());
+    ScheduleRule rule = window(EVERY_DAY, 7 * 60, 7 * 60);
+    rule.action = static_cast<uint8_t>(RelayState::ON);
+    engine.setRules(&rule, 1);
+
+    jumpTo(engine, at(3, 7, 0));
+    engine.tick(currentMinute);
+
+    TEST_ASSERT_EQUAL(1, commands.size());
+}
+
+// Heating below 20.0: engages under the limit and lets go HYSTERESIS above it
+void test_engine_hysteresis_at_threshold() {
+    ScheduleEngine engine(hooks());
+    ScheduleRule rule = conditional(window(EVERY_DAY, 0, DAY - 1), '<', 20.0f);
+    rule.action = static_cast<uint8_t>(RelayState::ON);
+    engine.setRules(&rule, 1);
+
+    reading = 20.0f;
+    jumpTo(engine, at(1, 6, 0));
+    TEST_ASSERT_EQUAL(0, commands.size());
+
+    reading = 19.9f;
+    runTo(engine, at(1, 6, 1));
+    assertCommand(0, at(1, 6, 1), RelayState::ON);
+
+    // Inside the band the relay stays where it is
+    for (float value : {20.0f, 20.2f, 20.4f}) {
+        reading = value;
+        runTo(engine, currentMinute + 1);
+    }
+    TEST_ASSERT_EQUAL(1, commands.size());
+    TEST_ASSERT_TRUE(engine.isEngaged(0));
+
+    reading = 20.5f;
+    runTo(engine, at(1, 6, 5));
+    assertCommand(1, at(1, 6, 5), RelayState::OFF);
+
+    // Going back into the band does not engage it again
+    reading = 20.1f;
+    runTo(engine, at(1, 6, 10));
+    TEST_ASSERT_EQUAL(2, commands.size());
+
+    reading = 19.9f;
+    runTo(engine, at(1, 6, 11));
+    assertCommand(2, at(1, 6, 11), RelayState::ON);
+}
+
+// NTP sync or DST moves the currentMinute by more than a minute; the wheel is rebuilt
+// and its old timers must not fire at the wrong time
+void test_engine_clock_jump_rebuilds_wheel() {
+    ScheduleEngine engine(hooks());
+    ScheduleRule rule = window(MONDAY, 8 * 60, 9 * 60);
+    rule.action = static_cast<uint8_t>(RelayState::ON);
+    engine.setRules(&rule, 1);
+
+    jumpTo(engine, at(1, 7, 0));
+    jumpTo(engine, at(1, 8, 30));
+    assertCommand(0, at(1, 8, 30), RelayState::ON);
+
+    // Back an hour while engaged: the window is closed again
+    jumpTo(engine, at(1, 7, 30));
+    assertCommand(1, at(1, 7, 30), RelayState::OFF);
+
+    runTo(engine, at(1, 10, 0));
+    TEST_ASSERT_EQUAL(4, commands.size());
+    assertCommand(2, at(1, 8, 0), RelayState::ON);
+    assertCommand(3, at(1, 9, 0), RelayState::OFF);
+}
+
+void test_engine_missing_reading_releases_relay() {
+    ScheduleEngine engine(hooks());
+    ScheduleRule rule = conditional(window(EVERY_DAY, 0, DAY - 1), '>', 25.0f);
+    rule.action = static_cast<uint8_t>(RelayState::ON);
+    engine.setRules(&rule, 1);
+
+    reading = 30.0f;
+    jumpTo(engine, at(2, 12, 0));
+    assertCommand(0, at(2, 12, 0), RelayState::ON);
+
+    // The last value still says hot, but it is no longer current
+    fresh = false;
+    runTo(engine, at(2, 12, 1));
+    assertCommand(1, at(2, 12, 1), RelayState::OFF);
+    runTo(engine, at(2, 13, 0));
+    TEST_ASSERT_EQUAL(2, commands.size());
+
+    fresh = true;
+    runTo(engine, at(2, 13, 1));
+    assertCommand(2, at(2, 13, 1), RelayState::ON);
+
+    // A reading that is there but not a number counts as missing too
+    reading = NAN;
+    runTo(engine, at(2, 13, 2));
+    assertCommand(3, at(2, 13, 2), RelayState::OFF);
+}
+
+void test_engine_missing_reading_skips_one_shot() {
+    ScheduleEngine engine(hooks());
+    ScheduleRule rule = conditional(window(EVERY_DAY, 7 * 60, 7 * 60), '<', 18.0f);
+    rule.action = static_cast<uint8_t>(RelayState::ON);
+    engine.setRules(&rule, 1);
+
+    reading = 15.0f;
+    fresh = false;
+    jumpTo(engine, at(4, 6, 0));
+    runTo(engine, at(4, 8, 0));
+    TEST_ASSERT_EQUAL(0, commands.size());
+
+    fresh = true;
+    runTo(engine, at(5, 8, 0));
+    TEST_ASSERT_EQUAL(1, commands.size());
+    assertCommand(0, at(5, 7, 0), RelayState::ON);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_wheel_fires_after_delay);
+    RUN_TEST(test_wheel_fires_each_timer_once);
+    RUN_TEST(test_wheel_reschedule_from_callback);
+    RUN_TEST(test_wheel_clear_drops_timers);
+    RUN_TEST(test_daytime_window);
+    RUN_TEST(test_overnight_window_follows_start_day);
+    RUN_TEST(test_overnight_window_wraps_the_week);
+    RUN_TEST(test_one_shot_rule_is_open_for_its_minute);
+    RUN_TEST(test_minutes_until_edge);
+    RUN_TEST(test_one_shot_edge_is_a_day_away);
+    RUN_TEST(test_engine_window_opens_and_closes);
+    RUN_TEST(test_engine_same_minute_twice_does_nothing);
+    RUN_TEST(test_engine_hysteresis_at_threshold);
+    RUN_TEST(test_engine_clock_jump_rebuilds_wheel);
+    RUN_TEST(test_engine_missing_reading_releases_relay);
+    RUN_TEST(test_engine_missing_reading_skips_one_shot);
+    return UNITY_END();
+}
@@ -0,0 +1,427 @@
+#include <unity.h>
+#include <atomic>
+#include <csignal>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "RelaySocket.h"
+#include "HttpServer.h"
+#include "Benchmark.h"
+#include "TestClient.h"
+
+namespace {
+
+constexpr uint16_t PORT = 18462;
+
+// RFC 6455 section 1.3 sample handshake
+const char SAMPLE_KEY[] = "dGhlIHNhbXBsZSBub25jZQ==";
+const char SAMPLE_ACCEPT[] = "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=";
+
+HttpServer* server = nullptr;
+
+// Stands in for RelayControlHandler: records every command it is handed
+struct FakeRelays {
+    std::mutex mutex;
+    std::vector<RelayCommand> submitted;
+    std::atomic<bool> accepting{true};
+    std::atomic<RelayState> states[RelayWorker::NUM_RELAYS];
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        submitted.clear();
+        accepting = true;
+        for (auto& state : states) state = RelayState::OFF;
+    }
+
+    RelayCommand last() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return submitted.back();
+    }
+};
+
+FakeRelays relays;
+
+// Like handleRelaySocket; the key is copied since accept() ends the request
+void handleUpgrade() {
+    String key = server->header("Sec-WebSocket-Key");
+    RelaySocket::getInstance().accept(server, key);
+}
+
+HttpServer::RequestHandler resolve(HTTPMethod method, const char* uri) {
+    return method == HTTP_GET && strcmp(uri, "/ws") == 0 ? handleUpgrade : nullptr;
+}
+
+std::string bytes(std::initializer_list<int> values) {
+    std::string text;
+    for (int value : values) text += static_cast<char>(value);
+    return text;
+}
+
+// A client frame: masked unless asked otherwise, payload up to 125 bytes
+std::string frame(uint8_t first, const std::string& payload, bool masked = true) {
+    static const uint8_t MASK[4] = {0x37, 0xFA, 0x21, 0x3D};
+    std::string out;
+    out += static_cast<char>(first);
+    out += static_cast<char>((masked ? 0x80 : 0) | payload.size());
+    if (masked) out.append(reinterpret_cast<const char*>(MASK), 4);
+    for (size_t i = 0; i < payload.size(); i++) {
+        out += static_cast<char>(masked ? payload[i] ^ MASK[i % 4] : payload[i]);
+    }
+    return out;
+}
+
+std::string command(uint8_t seq, uint8_t relayId, uint8_t state) {
+    return frame(0x82, bytes({RelaySocket::CMD, seq, relayId, state}));
+}
+
+struct Frame {
+    uint8_t first = 0;
+    std::string payload;
+};
+
+bool readFrame(TestClient& client, Frame& frame) {
+    std::string header;
+    if (!client.readExactly(2, header)) return false;
+    frame.first = static_cast<uint8_t>(header[0]);
+    return client.readExactly(header[1] & 0x7F, frame.payload);
+}
+
+void assertFrame(TestClient& client, uint8_t first, const std::string& payload) {
+    Frame received;
+    TEST_ASSERT_TRUE(readFrame(client, received));
+    TEST_ASSERT_EQUAL_HEX8(first, received.first);
+    TEST_ASSERT_EQUAL(payload.size(), received.payload.size());
+    TEST_ASSERT_EQUAL_MEMORY(payload.data(), received.payload.data(), payload.size());
+}
+
+void assertAck(TestClient& client, uint8_t seq, uint8_t status) {
+    assertFrame(client, 0x82, bytes({RelaySocket::ACK, seq, status}));
+}
+
+void assertResult(TestClient& client, uint8_t seq, uint8_t relayId, uint8_t outcome, uint8_t state) {
+    assertFrame(client, 0x82, bytes({RelaySocket::RESULT, seq, relayId, outcome, state}));
+}
+
+// The server answers a protocol violation with a close frame and hangs up
+void assertClosedWith(TestClient& client, uint16_t code) {
+    assertFrame(client, 0x88, bytes({code >> 8, code & 0xFF}));
+    TEST_ASSERT_TRUE(client.closedByPeer());
+}
+
+bool upgrade(TestClient& client, std::string* head = nullptr) {
+    std::string response;
+    if (!client.send(std::string("GET /ws HTTP/1.1\r\nHost: test\r\nUpgrade: websocket\r\n"
+                                 "Connection: Upgrade\r\nSec-WebSocket-Version: 13\r\n"
+                                 "Sec-WebSocket-Key: ") + SAMPLE_KEY + "\r\n\r\n") ||
+        !client.readUntil("\r\n\r\n", response)) {
+        return false;
+    }
+    if (head) *head = response;
+    return response.compare(0, 12, "HTTP/1.1 101") == 0;
+}
+
+template <typename Condition>
+bool waitFor(Condition condition) {
+    for (int i = 0; i < 400 && !condition(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return condition();
+}
+
+void complete(uint32_t tag, uint8_t relayId, RelayState state, bool success) {
+    RelayCommand command = {relayId, state, RelayCommandSource::USER, millis(), tag};
+    RelaySocket::getInstance().completed(command, success);
+}
+
+}
+
+void setUp() {
+    relays.reset();
+    // Sockets the previous test closed are dropped on the server task
+    TEST_ASSERT_TRUE(waitFor([] { return RelaySocket::getInstance().clientCount() == 0; }));
+}
+
+void tearDown() {}
+
+void test_handshake_answers_with_accept_key() {
+    TestClient client(PORT);
+    std::string head;
+
+    TEST_ASSERT_TRUE(upgrade(client, &head));
+
+    TEST_ASSERT_TRUE(head.find("Upgrade: websocket\r\n") != std::string::npos);
+    TEST_ASSERT_TRUE(head.find("Connection: Upgrade\r\n") != std::string::npos);
+    TEST_ASSERT_TRUE(head.find(std::string("Sec-WebSocket-Accept: ") + SAMPLE_ACCEPT + "\r\n") != std::string::npos);
+    TEST_ASSERT_TRUE(waitFor([] { return RelaySocket::getInstance().clientCount() == 1; }));
+}
+
+void test_command_is_acked_once_queued() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    TEST_ASSERT_TRUE(client.send(command(7, 1, 1)));
+
+    assertAck(client, 7, RelaySocket::QUEUED);
+    RelayCommand submitted = relays.last();
+    TEST_ASSERT_EQUAL(1, submitted.relayId);
+    TEST_ASSERT_TRUE(submitted.state == RelayState::ON);
+    TEST_ASSERT_TRUE(submitted.tag != 0);
+}
+
+void test_malformed_commands_are_acked_invalid() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    TEST_ASSERT_TRUE(client.send(command(1, RelayWorker::NUM_RELAYS, 1)));
+    assertAck(client, 1, RelaySocket::INVALID);
+    TEST_ASSERT_TRUE(client.send(command(2, 0, 2)));
+    assertAck(client, 2, RelaySocket::INVALID);
+    TEST_ASSERT_TRUE(client.send(frame(0x82, bytes({RelaySocket::CMD, 3, 0}))));
+    assertAck(client, 3, RelaySocket::INVALID);
+    TEST_ASSERT_TRUE(client.send(frame(0x82, bytes({RelaySocket::CMD}))));
+    assertAck(client, 0, RelaySocket::INVALID);
+
+    std::lock_guard<std::mutex> lock(relays.mutex);
+    TEST_ASSERT_EQUAL(0, relays.submitted.size());
+}
+
+void test_refused_or_untracked_command_is_acked_busy() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    relays.accepting = false;
+    TEST_ASSERT_TRUE(client.send(command(1, 0, 1)));
+    assertAck(client, 1, RelaySocket::BUSY);
+
+    // Every pending slot taken by a command still waiting for its result
+    relays.accepting = true;
+    for (uint8_t seq = 10; seq < 10 + RelaySocket::MAX_PENDING; seq++) {
+        TEST_ASSERT_TRUE(client.send(command(seq, 0, 1)));
+        assertAck(client, seq, RelaySocket::QUEUED);
+    }
+    TEST_ASSERT_TRUE(client.send(command(99, 0, 1)));
+    assertAck(client, 99, RelaySocket::BUSY);
+}
+
+void test_frames_split_and_batched_on_the_wire() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    // One frame a byte at a time, then two frames in one write
+    std::string first = command(1, 0, 1);
+    for (char c : first) {
+        TEST_ASSERT_TRUE(client.send(std::string(1, c)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    TEST_ASSERT_TRUE(client.send(command(2, 1, 0) + command(3, 0, 0)));
+
+    assertAck(client, 1, RelaySocket::QUEUED);
+    assertAck(client, 2, RelaySocket::QUEUED);
+    assertAck(client, 3, RelaySocket::QUEUED);
+}
+
+void test_ping_is_answered_with_pong() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    TEST_ASSERT_TRUE(client.send(frame(0x89, "are you there")));
+    assertFrame(client, 0x8A, "are you there");
+
+    // An unsolicited pong needs no answer; the socket carries on
+    TEST_ASSERT_TRUE(client.send(frame(0x8A, "") + command(4, 0, 1)));
+    assertAck(client, 4, RelaySocket::QUEUED);
+}
+
+void test_close_is_echoed_with_its_code() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+    TEST_ASSERT_TRUE(client.send(frame(0x88, bytes({0x0F, 0xA0}))));
+    assertClosedWith(client, 4000);
+
+    TestClient bare(PORT);
+    TEST_ASSERT_TRUE(upgrade(bare));
+    TEST_ASSERT_TRUE(bare.send(frame(0x88, "")));
+    assertClosedWith(bare, 1000);
+}
+
+void test_unmasked_frame_is_a_protocol_error() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    TEST_ASSERT_TRUE(client.send(frame(0x82, bytes({RelaySocket::CMD, 1, 0, 1}), false)));
+
+    assertClosedWith(client, 1002);
+    std::lock_guard<std::mutex> lock(relays.mutex);
+    TEST_ASSERT_EQUAL(0, relays.submitted.size());
+}
+
+void test_reserved_bits_are_a_protocol_error() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    TEST_ASSERT_TRUE(client.send(frame(0xC2, bytes({RelaySocket::CMD, 1, 0, 1}))));
+
+    assertClosedWith(client, 1002);
+}
+
+void test_extended_lengths_are_too_big() {
+    TestClient medium(PORT);
+    TEST_ASSERT_TRUE(upgrade(medium));
+    TEST_ASSERT_TRUE(medium.send(bytes({0x82, 0x80 | 126, 0x00, 0x80, 1, 2, 3, 4})));
+    assertClosedWith(medium, 1009);
+
+    TestClient large(PORT);
+    TEST_ASSERT_TRUE(upgrade(large));
+    TEST_ASSERT_TRUE(large.send(bytes({0x82, 0x80 | 127, 0, 0, 0, 0, 0, 1, 0, 0, 1, 2, 3, 4})));
+    assertClosedWith(large, 1009);
+}
+
+void test_text_frame_is_unsupported() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    TEST_ASSERT_TRUE(client.send(frame(0x81, "{\"relay\":0}")));
+
+    assertClosedWith(client, 1003);
+}
+
+void test_fragmented_frames_are_unsupported() {
+    TestClient first(PORT);
+    TEST_ASSERT_TRUE(upgrade(first));
+    TEST_ASSERT_TRUE(first.send(frame(0x02, bytes({RelaySocket::CMD, 1}))));
+    assertClosedWith(first, 1003);
+
+    TestClient continuation(PORT);
+    TEST_ASSERT_TRUE(upgrade(continuation));
+    TEST_ASSERT_TRUE(continuation.send(frame(0x80, bytes({0, 1}))));
+    assertClosedWith(continuation, 1003);
+}
+
+void test_completion_resolves_its_command_and_older_ones_for_the_relay() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    TEST_ASSERT_TRUE(client.send(command(1, 0, 1)));
+    assertAck(client, 1, RelaySocket::QUEUED);
+    uint32_t firstTag = relays.last().tag;
+    TEST_ASSERT_TRUE(client.send(command(2, 0, 0)));
+    assertAck(client, 2, RelaySocket::QUEUED);
+    uint32_t secondTag = relays.last().tag;
+    TEST_ASSERT_TRUE(client.send(command(3, 1, 1)));
+    assertAck(client, 3, RelaySocket::QUEUED);
+    uint32_t otherRelayTag = relays.last().tag;
+    TEST_ASSERT_TRUE(client.send(command(4, 0, 1)));
+    assertAck(client, 4, RelaySocket::QUEUED);
+    uint32_t newestTag = relays.last().tag;
+
+    // The first command ran on its own: only it is resolved
+    complete(firstTag, 0, RelayState::ON, true);
+    assertResult(client, 1, 0, RelaySocket::DONE, 1);
+
+    // The worker coalesced the second into the fourth: both get its outcome,
+    // the command for the other relay stays pending
+    complete(newestTag, 0, RelayState::ON, true);
+    assertResult(client, 2, 0, RelaySocket::DONE, 1);
+    assertResult(client, 4, 0, RelaySocket::DONE, 1);
+
+    // A stale completion finds nothing left to resolve
+    complete(secondTag, 0, RelayState::OFF, true);
+    complete(otherRelayTag, 1, RelayState::ON, true);
+    assertResult(client, 3, 1, RelaySocket::DONE, 1);
+}
+
+void test_failed_command_reports_the_relay_as_it_is() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+    TEST_ASSERT_TRUE(client.send(command(5, 1, 0)));
+    assertAck(client, 5, RelaySocket::QUEUED);
+
+    relays.states[1] = RelayState::ON;
+    complete(relays.last().tag, 1, RelayState::OFF, false);
+
+    assertResult(client, 5, 1, RelaySocket::FAILED, 1);
+}
+
+void test_command_without_completion_times_out() {
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+    TEST_ASSERT_TRUE(client.send(command(6, 0, 1)));
+    assertAck(client, 6, RelaySocket::QUEUED);
+
+    relays.states[0] = RelayState::UNKNOWN;
+    testMillis() += RelaySocket::RESULT_TIMEOUT;
+
+    assertResult(client, 6, 0, RelaySocket::TIMED_OUT, 2);
+}
+
+void test_command_to_ack_latency() {
+    const size_t COMMANDS = 2000;
+    TestClient client(PORT);
+    TEST_ASSERT_TRUE(upgrade(client));
+
+    std::vector<double> ackLatencies;
+    std::vector<double> resultLatencies;
+    for (size_t i = 0; i < COMMANDS; i++) {
+        uint8_t seq = static_cast<uint8_t>(i);
+        uint8_t relayId = i % RelayWorker::NUM_RELAYS;
+        auto sent = std::chrono::steady_clock::now();
+        TEST_ASSERT_TRUE(client.send(command(seq, relayId, i % 2)));
+        assertAck(client, seq, RelaySocket::QUEUED);
+        auto acked = std::chrono::steady_clock::now();
+        ackLatencies.push_back(std::chrono::duration<double, std::micro>(acked - sent).count());
+
+        complete(relays.last().tag, relayId, i % 2 ? RelayState::ON : RelayState::OFF, true);
+        assertResult(client, seq, relayId, RelaySocket::DONE, i % 2);
+        resultLatencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - acked).count());
+    }
+
+    reportLatency("relay socket, command to ack", ackLatencies);
+    // A completion waits for the server task's next select() round
+    reportLatency("relay socket, completion to result", resultLatencies);
+}
+
+int main(int, char**) {
+    // lwIP has no SIGPIPE; a write to a peer that left just fails
+    signal(SIGPIPE, SIG_IGN);
+
+    RelaySocket::Relays hooks = {
+        [](uint8_t relayId, RelayState state, uint32_t tag) {
+            if (!relays.accepting) return false;
+            std::lock_guard<std::mutex> lock(relays.mutex);
+            relays.submitted.push_back({relayId, state, RelayCommandSource::USER, millis(), tag});
+            return true;
+        },
+        [](uint8_t relayId) { return relays.states[relayId].load(); }
+    };
+    RelaySocket::getInstance().begin(hooks);
+
+    // Served the way WebServerManager does: the server task runs the
+    // channel's loop after every select() round
+    static const char* collected[] = {"Sec-WebSocket-Key"};
+    server = new HttpServer(PORT);
+    server->setResolver(resolve);
+    server->collectHeaders(collected, 1);
+    server->setLoopHook([] { RelaySocket::getInstance().loop(); });
+    if (!server->begin()) return 1;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_handshake_answers_with_accept_key);
+    RUN_TEST(test_command_is_acked_once_queued);
+    RUN_TEST(test_malformed_commands_are_acked_invalid);
+    RUN_TEST(test_refused_or_untracked_command_is_acked_busy);
+    RUN_TEST(test_frames_split_and_batched_on_the_wire);
+    RUN_TEST(test_ping_is_answered_with_pong);
+    RUN_TEST(test_close_is_echoed_with_its_code);
+    RUN_TEST(test_unmasked_frame_is_a_protocol_error);
+    RUN_TEST(test_reserved_bits_are_a_protocol_error);
+    RUN_TEST(test_extended_lengths_are_too_big);
+    RUN_TEST(test_text_frame_is_unsupported);
+    RUN_TEST(test_fragmented_frames_are_unsupported);
+    RUN_TEST(test_completion_resolves_its_command_and_older_ones_for_the_relay);
+    RUN_TEST(test_failed_command_reports_the_relay_as_it_is);
+    RUN_TEST(test_command_without_completion_times_out);
+    RUN_TEST(test_command_to_ack_latency);
+    int failures = UNITY_END();
+    delete server;
+    return failures;
+}
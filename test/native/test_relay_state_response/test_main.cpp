@@ -0,0 +1,208 @@
+#include <unity.h>
+#include <atomic>
+#include <csignal>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "RelayStateResponse.h"
+#include "Benchmark.h"
+#include "TestClient.h"
+
+namespace {
+
+constexpr uint16_t PORT = 18463;
+constexpr uint8_t NUM_RELAYS = 2;
+constexpr uint32_t EPOCH = 0xbeef;
+
+// Stands in for the relay state cache the handler reads
+struct Cache {
+    std::mutex lock;
+    RelayStatus statuses[NUM_RELAYS] = {{RelayState::OFF, false}, {RelayState::ON, true}};
+    uint32_t epoch = EPOCH;
+    uint32_t version = 1;
+    std::atomic<size_t> snapshots{0};
+
+    void change(uint8_t relayId, RelayState state) {
+        std::lock_guard<std::mutex> guard(lock);
+        statuses[relayId].state = state;
+        version++;
+    }
+};
+
+HttpServer* server = nullptr;
+Cache* cache = nullptr;
+
+void handleRelayState() {
+    RelayStatus statuses[NUM_RELAYS];
+    uint32_t epoch;
+    uint32_t version;
+    {
+        std::lock_guard<std::mutex> guard(cache->lock);
+        memcpy(statuses, cache->statuses, sizeof(statuses));
+        epoch = cache->epoch;
+        version = cache->version;
+    }
+    cache->snapshots++;
+    sendRelayStates(server, statuses, NUM_RELAYS, epoch, version);
+}
+
+HttpServer::RequestHandler resolve(HTTPMethod method, const char* uri) {
+    if (method == HTTP_GET && strcmp(uri, "/api/relay") == 0) return handleRelayState;
+    return nullptr;
+}
+
+// Polls like the status page: the ETag of the last answer goes back with the
+// next request
+struct Poller {
+    TestClient client;
+    std::string etag;
+
+    Poller() : client(PORT) {}
+
+    bool poll(TestResponse& response) {
+        std::string request = "GET /api/relay HTTP/1.1\r\nHost: test\r\n";
+        if (!etag.empty()) request += "If-None-Match: " + etag + "\r\n";
+        if (!client.send(request + "\r\n") || !client.readResponse(response)) return false;
+        if (response.code == 200) etag = response.header("ETag");
+        return response.code == 200 || response.code == 304;
+    }
+};
+
+}
+
+void setUp() {
+    cache = new Cache();
+    server = new HttpServer(PORT);
+    const char* headers[] = {"If-None-Match"};
+    server->collectHeaders(headers, 1);
+    server->setResolver(resolve);
+    TEST_ASSERT_TRUE(server->begin());
+}
+
+void tearDown() {
+    delete server;
+    server = nullptr;
+    delete cache;
+    cache = nullptr;
+}
+
+void test_first_poll_gets_states_and_etag() {
+    Poller page;
+    TestResponse response;
+
+    TEST_ASSERT_TRUE(page.poll(response));
+
+    TEST_ASSERT_EQUAL(200, response.code);
+    TEST_ASSERT_EQUAL_STRING("\"beef-1\"", response.header("ETag").c_str());
+    TEST_ASSERT_EQUAL_STRING("no-cache", response.header("Cache-Control").c_str());
+    TEST_ASSERT_EQUAL_STRING("[{\"relay_id\":0,\"state\":\"OFF\",\"override\":false},"
+                             "{\"relay_id\":1,\"state\":\"ON\",\"override\":true}]",
+                             response.body.c_str());
+}
+
+void test_unchanged_state_gets_304_without_body() {
+    Poller page;
+    TestResponse response;
+    TEST_ASSERT_TRUE(page.poll(response));
+
+    TEST_ASSERT_TRUE(page.poll(response));
+
+    TEST_ASSERT_EQUAL(304, response.code);
+    TEST_ASSERT_EQUAL_STRING("", response.body.c_str());
+    // The 304 still names the version it vouches for
+    TEST_ASSERT_EQUAL_STRING("\"beef-1\"", response.header("ETag").c_str());
+}
+
+void test_changed_state_gets_new_body() {
+    Poller page;
+    TestResponse response;
+    TEST_ASSERT_TRUE(page.poll(response));
+
+    cache->change(0, RelayState::ON);
+    TEST_ASSERT_TRUE(page.poll(response));
+
+    TEST_ASSERT_EQUAL(200, response.code);
+    TEST_ASSERT_EQUAL_STRING("\"beef-2\"", response.header("ETag").c_str());
+    TEST_ASSERT_EQUAL_STRING("[{\"relay_id\":0,\"state\":\"ON\",\"override\":false},"
+                             "{\"relay_id\":1,\"state\":\"ON\",\"override\":true}]",
+                             response.body.c_str());
+}
+
+void test_new_epoch_does_not_match_old_copy() {
+    Poller page;
+    TestResponse response;
+    TEST_ASSERT_TRUE(page.poll(response));
+
+    // After a reboot the version counts from the same place again
+    cache->epoch = 0x1234;
+    TEST_ASSERT_TRUE(page.poll(response));
+
+    TEST_ASSERT_EQUAL(200, response.code);
+    TEST_ASSERT_EQUAL_STRING("\"1234-1\"", response.header("ETag").c_str());
+}
+
+// Every connection slot polls flat out while the state changes now and then.
+// Each page should get a body once per version it sees and 304s otherwise,
+// and every answer comes from the cache snapshot alone.
+void test_load_pollers_mostly_get_304() {
+    const size_t PAGES = HttpServer::MAX_CONNECTIONS;
+    const size_t POLLS = 2000;
+    const uint32_t CHANGES = 20;
+    std::atomic<size_t> failures(0);
+    std::atomic<size_t> bodies(0);
+    std::atomic<size_t> bodyBytes(0);
+    std::atomic<size_t> running(PAGES);
+
+    std::vector<std::vector<double>> latencies(PAGES);
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < PAGES; p++) {
+        threads.emplace_back([&, p] {
+            Poller page;
+            latencies[p].reserve(POLLS);
+            for (size_t i = 0; i < POLLS; i++) {
+                auto sent = std::chrono::steady_clock::now();
+                TestResponse response;
+                if (!page.poll(response)) failures++;
+                latencies[p].push_back(
+                    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sent).count());
+                if (response.code == 200) {
+                    bodies++;
+                    bodyBytes += response.body.size();
+                }
+            }
+            running--;
+        });
+    }
+    for (uint32_t i = 0; i < CHANGES && running > 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        cache->change(i % NUM_RELAYS, i % 2 ? RelayState::OFF : RelayState::ON);
+    }
+    for (std::thread& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::vector<double> all;
+    for (const std::vector<double>& page : latencies) all.insert(all.end(), page.begin(), page.end());
+    reportLoad("6 pages polling relay state", all.size(), seconds, all);
+    printf("  %zu of %zu polls carried a body (%zu bytes), %u state changes\n",
+           bodies.load(), all.size(), bodyBytes.load(), (unsigned)CHANGES);
+
+    TEST_ASSERT_EQUAL(0, failures.load());
+    TEST_ASSERT_EQUAL(PAGES * POLLS, cache->snapshots.load());
+    // At most one body per page for the first poll and one per change
+    TEST_ASSERT_TRUE(bodies >= PAGES);
+    TEST_ASSERT_TRUE(bodies <= PAGES * (CHANGES + 1));
+}
+
+int main(int, char**) {
+    // lwIP has no SIGPIPE
+    signal(SIGPIPE, SIG_IGN);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_first_poll_gets_states_and_etag);
+    RUN_TEST(test_unchanged_state_gets_304_without_body);
+    RUN_TEST(test_changed_state_gets_new_body);
+    RUN_TEST(test_new_epoch_does_not_match_old_copy);
+    RUN_TEST(test_load_pollers_mostly_get_304);
+    return UNITY_END();
+}
@@ -0,0 +1,203 @@
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "RelayWorker.h"
+
+namespace {
+
+constexpr size_t QUEUE_SIZE = 10;
+
+using Clock = std::chrono::steady_clock;
+
+// Stands in for the hub's /api/relay: records what it was asked to do and
+// answers after an injected delay, as the real call would over WiFi
+struct HubStandIn {
+    std::mutex mutex;
+    std::vector<RelayCommand> calls;
+    std::chrono::milliseconds latency{0};
+    bool accept = true;
+    std::atomic<int> started{0};
+
+    bool execute(const RelayCommand& command) {
+        started++;
+        std::this_thread::sleep_for(latency);
+        std::lock_guard<std::mutex> lock(mutex);
+        calls.push_back(command);
+        return accept;
+    }
+};
+
+struct Completion {
+    RelayCommand command;
+    bool success;
+    std::thread::id thread;
+    Clock::time_point at;
+};
+
+HubStandIn* hub;
+std::mutex completionsMutex;
+std::vector<Completion> completions;
+
+RelayWorker* makeWorker() {
+    RelayWorker* worker = new RelayWorker(QUEUE_SIZE, [](const RelayCommand& command) {
+        return hub->execute(command);
+    });
+    worker->addCompletionListener([](const RelayCommand& command, bool success) {
+        std::lock_guard<std::mutex> lock(completionsMutex);
+        completions.push_back({command, success, std::this_thread::get_id(), Clock::now()});
+    });
+    return worker;
+}
+
+RelayCommand command(uint8_t relayId, RelayState state, uint32_t tag) {
+    return {relayId, state, RelayCommandSource::USER, millis(), tag};
+}
+
+}
+
+void setUp() {
+    hub = new HubStandIn();
+    completions.clear();
+}
+
+void tearDown() {
+    delete hub;
+}
+
+void test_nothing_queued_times_out() {
+    RelayWorker* worker = makeWorker();
+
+    TEST_ASSERT_FALSE(worker->runOnce(5));
+    TEST_ASSERT_EQUAL(0, hub->calls.size());
+    delete worker;
+}
+
+void test_queued_commands_coalesce_to_newest_per_relay() {
+    RelayWorker* worker = makeWorker();
+    TEST_ASSERT_TRUE(worker->submit(command(0, RelayState::ON, 1)));
+    TEST_ASSERT_TRUE(worker->submit(command(1, RelayState::ON, 2)));
+    TEST_ASSERT_TRUE(worker->submit(command(0, RelayState::OFF, 3)));
+    TEST_ASSERT_TRUE(worker->submit(command(0, RelayState::ON, 4)));
+    TEST_ASSERT_EQUAL(4, worker->getPending());
+
+    TEST_ASSERT_TRUE(worker->runOnce(0));
+
+    TEST_ASSERT_EQUAL(0, worker->getPending());
+    TEST_ASSERT_EQUAL(2, worker->getCoalesced());
+    TEST_ASSERT_EQUAL(2, hub->calls.size());
+    TEST_ASSERT_EQUAL(0, hub->calls[0].relayId);
+    TEST_ASSERT_EQUAL(4, hub->calls[0].tag);
+    TEST_ASSERT_TRUE(hub->calls[0].state == RelayState::ON);
+    TEST_ASSERT_EQUAL(1, hub->calls[1].relayId);
+    TEST_ASSERT_EQUAL(2, hub->calls[1].tag);
+
+    TEST_ASSERT_EQUAL(2, completions.size());
+    TEST_ASSERT_EQUAL(4, completions[0].command.tag);
+    TEST_ASSERT_EQUAL(2, completions[1].command.tag);
+    TEST_ASSERT_TRUE(completions[0].success);
+    delete worker;
+}
+
+void test_rejected_command_is_reported_as_failed() {
+    RelayWorker* worker = makeWorker();
+    hub->accept = false;
+    worker->submit(command(1, RelayState::OFF, 7));
+
+    worker->runOnce(0);
+
+    TEST_ASSERT_EQUAL(1, completions.size());
+    TEST_ASSERT_FALSE(completions[0].success);
+    delete worker;
+}
+
+void test_full_queue_and_bad_relay_are_refused() {
+    RelayWorker* worker = makeWorker();
+    TEST_ASSERT_FALSE(worker->submit(command(RelayWorker::NUM_RELAYS, RelayState::ON, 1)));
+    for (size_t i = 0; i < QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(worker->submit(command(i % RelayWorker::NUM_RELAYS, RelayState::ON, i)));
+    }
+
+    TEST_ASSERT_FALSE(worker->submit(command(0, RelayState::OFF, 99)));
+    TEST_ASSERT_EQUAL(QUEUE_SIZE, worker->getPending());
+    delete worker;
+}
+
+void test_listener_limit() {
+    RelayWorker* worker = makeWorker();
+    auto listener = [](const RelayCommand&, bool) {};
+    for (size_t i = 1; i < RelayWorker::MAX_COMPLETION_LISTENERS; i++) {
+        TEST_ASSERT_TRUE(worker->addCompletionListener(listener));
+    }
+
+    TEST_ASSERT_FALSE(worker->addCompletionListener(listener));
+    TEST_ASSERT_FALSE(worker->addCompletionListener(nullptr));
+    delete worker;
+}
+
+// The worker runs on its own thread against a hub that takes 50 ms a call.
+// Callers get control back at once; commands that pile up behind a slow call
+// collapse to the newest per relay, and completions arrive on the worker.
+void test_worker_thread_against_slow_hub() {
+    RelayWorker* worker = makeWorker();
+    hub->latency = std::chrono::milliseconds(50);
+    std::atomic<bool> running(true);
+    std::thread workerThread([&] {
+        while (running) worker->runOnce(5);
+    });
+
+    Clock::time_point submitted = Clock::now();
+    TEST_ASSERT_TRUE(worker->submit(command(0, RelayState::ON, 1)));
+    // Let the worker pick up the first command and block on the hub
+    while (hub->started == 0) std::this_thread::yield();
+    Clock::time_point beforeBurst = Clock::now();
+    TEST_ASSERT_TRUE(worker->submit(command(0, RelayState::OFF, 2)));
+    TEST_ASSERT_TRUE(worker->submit(command(1, RelayState::ON, 3)));
+    TEST_ASSERT_TRUE(worker->submit(command(0, RelayState::ON, 4)));
+    auto submitCost = Clock::now() - beforeBurst;
+
+    Clock::time_point deadline = Clock::now() + std::chrono::seconds(2);
+    while (Clock::now() < deadline) {
+        {
+            std::lock_guard<std::mutex> lock(completionsMutex);
+            if (completions.size() >= 3) break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::thread::id workerId = workerThread.get_id();
+    running = false;
+    workerThread.join();
+
+    // Submitting never waits for the hub
+    TEST_ASSERT_TRUE(submitCost < std::chrono::milliseconds(10));
+
+    TEST_ASSERT_EQUAL(3, hub->calls.size());
+    TEST_ASSERT_EQUAL(1, hub->calls[0].tag);
+    TEST_ASSERT_EQUAL(4, hub->calls[1].tag);
+    TEST_ASSERT_EQUAL(3, hub->calls[2].tag);
+    TEST_ASSERT_EQUAL(1, worker->getCoalesced());
+
+    TEST_ASSERT_EQUAL(3, completions.size());
+    for (const Completion& completion : completions) {
+        TEST_ASSERT_TRUE(completion.thread == workerId);
+    }
+
+    char line[96];
+    snprintf(line, sizeof(line), "[LATENCY] 50 ms hub: first command done in %lld ms, burst of 3 in %lld ms",
+             (long long)std::chrono::duration_cast<std::chrono::milliseconds>(completions[0].at - submitted).count(),
+             (long long)std::chrono::duration_cast<std::chrono::milliseconds>(completions[2].at - beforeBurst).count());
+    TEST_MESSAGE(line);
+    delete worker;
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_queued_times_out);
+    RUN_TEST(test_queued_commands_coalesce_to_newest_per_relay);
+    RUN_TEST(test_rejected_command_is_reported_as_failed);
+    RUN_TEST(test_full_queue_and_bad_relay_are_refused);
+    RUN_TEST(test_listener_limit);
+    RUN_TEST(test_worker_thread_against_slow_hub);
+    return UNITY_END();
+}
@@ -0,0 +1,127 @@
+#include <unity.h>
+#include "RemoteConfig.h"
+#include "PreferencesManager.h"
+
+namespace {
+
+DisplayPreferences stored() {
+    DisplayPreferences prefs;
+    prefs.nightModeDimmingEnabled = false;
+    prefs.dayBrightness = PreferencesManager::toStoredBrightness(25);
+    prefs.nightBrightness = PreferencesManager::toStoredBrightness(4);
+    prefs.nightStartHour = 22;
+    prefs.nightEndHour = 6;
+    return prefs;
+}
+
+RemoteConfig::Result delta(const char* json, const DisplayPreferences& current,
+                           DisplayPreferences& next, uint8_t& changed) {
+    StaticJsonDocument<256> doc;
+    TEST_ASSERT_FALSE(deserializeJson(doc, json));
+    return RemoteConfig::computeDelta(doc["display"], current, next, changed);
+}
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_missing_display_is_unchanged() {
+    DisplayPreferences current = stored();
+    DisplayPreferences next;
+    uint8_t changed = 0xFF;
+
+    TEST_ASSERT_EQUAL(RemoteConfig::Result::UNCHANGED, delta("{\"version\":2}", current, next, changed));
+    TEST_ASSERT_EQUAL(0, changed);
+    TEST_ASSERT_EQUAL(0, PreferencesManager::diffDisplayPreferences(current, next));
+}
+
+void test_same_levels_are_unchanged() {
+    DisplayPreferences current = stored();
+    DisplayPreferences next;
+    uint8_t changed = 0xFF;
+
+    RemoteConfig::Result result = delta(
+        "{\"display\":{\"nightDimming\":false,\"dayBrightness\":25,\"nightBrightness\":4,"
+        "\"nightStartHour\":22,\"nightEndHour\":6}}", current, next, changed);
+    TEST_ASSERT_EQUAL(RemoteConfig::Result::UNCHANGED, result);
+    TEST_ASSERT_EQUAL(0, changed);
+}
+
+void test_only_changed_fields_are_reported() {
+    DisplayPreferences current = stored();
+    DisplayPreferences next;
+    uint8_t changed = 0;
+
+    RemoteConfig::Result result = delta(
+        "{\"display\":{\"dayBrightness\":20,\"nightEndHour\":7}}", current, next, changed);
+    TEST_ASSERT_EQUAL(RemoteConfig::Result::APPLIED, result);
+    TEST_ASSERT_EQUAL(PREF_FIELD_DAY_BRIGHT | PREF_FIELD_NIGHT_END, changed);
+    TEST_ASSERT_EQUAL(PreferencesManager::toStoredBrightness(20), next.dayBrightness);
+    TEST_ASSERT_EQUAL(7, next.nightEndHour);
+    TEST_ASSERT_EQUAL(current.nightBrightness, next.nightBrightness);
+    TEST_ASSERT_EQUAL(current.nightStartHour, next.nightStartHour);
+}
+
+// Stored brightness is on 1-75; reading it back on 0-255 made a stored 10
+// look like level 1, so a request for level 1 was dropped
+void test_brightness_is_compared_as_stored() {
+    DisplayPreferences current = stored();
+    current.dayBrightness = 10;
+    DisplayPreferences next;
+    uint8_t changed = 0;
+
+    TEST_ASSERT_EQUAL(RemoteConfig::Result::APPLIED,
+                      delta("{\"display\":{\"dayBrightness\":1}}", current, next, changed));
+    TEST_ASSERT_EQUAL(PREF_FIELD_DAY_BRIGHT, changed);
+    TEST_ASSERT_EQUAL(1, next.dayBrightness);
+}
+
+void test_night_dimming_toggles() {
+    DisplayPreferences current = stored();
+    DisplayPreferences next;
+    uint8_t changed = 0;
+
+    TEST_ASSERT_EQUAL(RemoteConfig::Result::APPLIED,
+                      delta("{\"display\":{\"nightDimming\":true}}", current, next, changed));
+    TEST_ASSERT_EQUAL(PREF_FIELD_NIGHT_MODE, changed);
+    TEST_ASSERT_TRUE(next.nightModeDimmingEnabled);
+}
+
+void test_out_of_range_values_are_invalid() {
+    DisplayPreferences current = stored();
+    DisplayPreferences next;
+    uint8_t changed = 0;
+
+    TEST_ASSERT_EQUAL(RemoteConfig::Result::INVALID,
+                      delta("{\"display\":{\"dayBrightness\":0}}", current, next, changed));
+    TEST_ASSERT_EQUAL(RemoteConfig::Result::INVALID,
+                      delta("{\"display\":{\"nightBrightness\":26}}", current, next, changed));
+    TEST_ASSERT_EQUAL(RemoteConfig::Result::INVALID,
+                      delta("{\"display\":{\"nightStartHour\":24}}", current, next, changed));
+    TEST_ASSERT_EQUAL(RemoteConfig::Result::INVALID,
+                      delta("{\"display\":{\"nightEndHour\":-1}}", current, next, changed));
+}
+
+void test_brightness_round_trips() {
+    for (int level = 1; level <= 25; level++) {
+        uint8_t storedByte = PreferencesManager::toStoredBrightness(level);
+        TEST_ASSERT_TRUE(storedByte >= 1 && storedByte <= 75);
+        TEST_ASSERT_EQUAL(level, PreferencesManager::toBrightnessLevel(storedByte));
+    }
+    TEST_ASSERT_EQUAL(1, PreferencesManager::toBrightnessLevel(0));
+    TEST_ASSERT_EQUAL(25, PreferencesManager::toBrightnessLevel(255));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_missing_display_is_unchanged);
+    RUN_TEST(test_same_levels_are_unchanged);
+    RUN_TEST(test_only_changed_fields_are_reported);
+    RUN_TEST(test_brightness_is_compared_as_stored);
+    RUN_TEST(test_night_dimming_toggles);
+    RUN_TEST(test_out_of_range_values_are_invalid);
+    RUN_TEST(test_brightness_round_trips);
+    return UNITY_END();
+}
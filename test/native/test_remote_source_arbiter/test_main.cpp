@@ -0,0 +1,94 @@
+#include <unity.h>
+#include "RemoteSourceArbiter.h"
+
+namespace {
+
+constexpr unsigned long STALE = RemoteSourceArbiter::MQTT_STALE_AFTER;
+constexpr unsigned long HOLD = RemoteSourceArbiter::MQTT_RECOVER_HOLD;
+
+// Feeds readings every `interval` ms from `start` up to and including `end`
+void feed(RemoteSourceArbiter& arbiter, unsigned long start, unsigned long end, unsigned long interval) {
+    for (unsigned long t = start; t - start <= end - start; t += interval) {
+        arbiter.onMqttReading(t);
+        arbiter.update(t);
+    }
+}
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_boots_on_http() {
+    RemoteSourceArbiter arbiter;
+    TEST_ASSERT_EQUAL(RemoteSource::HTTP, arbiter.getSource());
+    TEST_ASSERT_EQUAL(RemoteSource::HTTP, arbiter.update(1000));
+}
+
+void test_single_reading_does_not_switch() {
+    RemoteSourceArbiter arbiter;
+    arbiter.onMqttReading(1000);
+
+    TEST_ASSERT_EQUAL(RemoteSource::HTTP, arbiter.update(1000 + HOLD));
+}
+
+void test_switches_to_mqtt_after_steady_hold() {
+    RemoteSourceArbiter arbiter;
+    feed(arbiter, 1000, 1000 + HOLD - 10000, 10000);
+    TEST_ASSERT_EQUAL(RemoteSource::HTTP, arbiter.getSource());
+
+    arbiter.onMqttReading(1000 + HOLD);
+    TEST_ASSERT_EQUAL(RemoteSource::MQTT, arbiter.update(1000 + HOLD));
+}
+
+void test_falls_back_to_http_when_mqtt_goes_quiet() {
+    RemoteSourceArbiter arbiter;
+    feed(arbiter, 0, HOLD, 10000);
+    TEST_ASSERT_EQUAL(RemoteSource::MQTT, arbiter.getSource());
+
+    TEST_ASSERT_EQUAL(RemoteSource::MQTT, arbiter.update(HOLD + STALE - 1));
+    TEST_ASSERT_EQUAL(RemoteSource::HTTP, arbiter.update(HOLD + STALE));
+}
+
+// After a stale gap the hold starts over from the first new reading
+void test_gap_restarts_the_streak() {
+    RemoteSourceArbiter arbiter;
+    feed(arbiter, 0, HOLD / 2, 10000);
+
+    unsigned long resumed = HOLD / 2 + STALE + 1000;
+    arbiter.onMqttReading(resumed);
+    arbiter.onMqttReading(resumed + 10000);
+    TEST_ASSERT_EQUAL(RemoteSource::HTTP, arbiter.update(resumed + 10000));
+
+    feed(arbiter, resumed + 20000, resumed + HOLD, 10000);
+    TEST_ASSERT_EQUAL(RemoteSource::MQTT, arbiter.getSource());
+}
+
+void test_correct_across_millis_wrap() {
+    RemoteSourceArbiter arbiter;
+    unsigned long start = static_cast<unsigned long>(-1) - HOLD / 2;
+    feed(arbiter, start, start + HOLD, 10000);
+    TEST_ASSERT_EQUAL(RemoteSource::MQTT, arbiter.getSource());
+
+    unsigned long last = start + HOLD - (HOLD % 10000);
+    TEST_ASSERT_EQUAL(RemoteSource::MQTT, arbiter.update(last + STALE - 1));
+    TEST_ASSERT_EQUAL(RemoteSource::HTTP, arbiter.update(last + STALE));
+}
+
+void test_source_names() {
+    TEST_ASSERT_EQUAL_STRING("MQTT", RemoteSourceArbiter::sourceToString(RemoteSource::MQTT));
+    TEST_ASSERT_EQUAL_STRING("HTTP", RemoteSourceArbiter::sourceToString(RemoteSource::HTTP));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_boots_on_http);
+    RUN_TEST(test_single_reading_does_not_switch);
+    RUN_TEST(test_switches_to_mqtt_after_steady_hold);
+    RUN_TEST(test_falls_back_to_http_when_mqtt_goes_quiet);
+    RUN_TEST(test_gap_restarts_the_streak);
+    RUN_TEST(test_correct_across_millis_wrap);
+    RUN_TEST(test_source_names);
+    return UNITY_END();
+}
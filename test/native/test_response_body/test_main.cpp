@@ -0,0 +1,300 @@
+#include <unity.h>
+#include <lwip/sockets.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "ResponseBodyStream.h"
+#include "Benchmark.h"
+
+namespace {
+
+// In-memory body for the counting tests
+class TextStream : public Stream {
+public:
+    explicit TextStream(const char* text) : text(text), position(0) {}
+    int available() override { return static_cast<int>(strlen(text) - position); }
+    int read() override { return text[position] ? text[position++] : -1; }
+    int peek() override { return text[position] ? text[position] : -1; }
+    size_t write(uint8_t) override { return 0; }
+
+private:
+    const char* text;
+    size_t position;
+};
+
+// Blocking socket as a Stream, for the client side of the stand-in tests
+class SocketStream : public Stream {
+public:
+    explicit SocketStream(int fd) : fd(fd) {}
+    int available() override {
+        int pending = 0;
+        ioctl(fd, FIONREAD, &pending);
+        return pending;
+    }
+    int read() override {
+        uint8_t c;
+        return recv(fd, &c, 1, 0) == 1 ? c : -1;
+    }
+    int peek() override {
+        uint8_t c;
+        return recv(fd, &c, 1, MSG_PEEK) == 1 ? c : -1;
+    }
+    using Stream::readBytes;
+    size_t readBytes(char* buffer, size_t length) override {
+        size_t total = 0;
+        while (total < length) {
+            ssize_t n = recv(fd, buffer + total, length - total, 0);
+            if (n <= 0) break;
+            total += n;
+        }
+        return total;
+    }
+    size_t write(uint8_t c) override { return send(fd, &c, 1, 0) == 1 ? 1 : 0; }
+
+private:
+    int fd;
+};
+
+// Stand-in for the hub: answers every request on a keep-alive connection
+// with a fixed JSON body, one connection at a time, like the hub's server
+class HubStandIn {
+public:
+    static constexpr size_t BODY_SIZE = 600;
+
+    HubStandIn() : running(true) {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        socklen_t length = sizeof(address);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+        listen(listenFd, 4);
+
+        body.assign("{\"sensors\":[");
+        while (body.size() < BODY_SIZE - 2) body += "{\"id\":1},";
+        body.resize(BODY_SIZE - 2);
+        body += "]}";
+        thread = std::thread([this] { serve(); });
+    }
+
+    ~HubStandIn() {
+        running = false;
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        thread.join();
+    }
+
+    uint16_t port;
+    std::string body;
+
+private:
+    void serve() {
+        while (running) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) return;
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+            std::string request;
+            char buffer[512];
+            ssize_t n;
+            while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+                request.append(buffer, n);
+                size_t end;
+                while ((end = request.find("\r\n\r\n")) != std::string::npos) {
+                    request.erase(0, end + 4);
+                    std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+                                           std::to_string(body.size()) + "\r\nConnection: keep-alive\r\n\r\n" + body;
+                    send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+                }
+            }
+            close(fd);
+        }
+    }
+
+    int listenFd;
+    volatile bool running;
+    std::thread thread;
+};
+
+int connectTo(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return fd;
+}
+
+struct Response {
+    int code;
+    int contentLength;
+};
+
+// Sends a GET and reads the status line and headers, leaving the body
+Response request(int fd, Stream& stream) {
+    const char get[] = "GET /api/sensors HTTP/1.1\r\nHost: sensorhub.local\r\n\r\n";
+    send(fd, get, sizeof(get) - 1, MSG_NOSIGNAL);
+
+    std::string head;
+    while (head.size() < 4 || head.compare(head.size() - 4, 4, "\r\n\r\n") != 0) {
+        int c = stream.read();
+        if (c < 0) return {-1, -1};
+        head += static_cast<char>(c);
+    }
+    Response response = {-1, -1};
+    if (head.compare(0, 9, "HTTP/1.1 ") == 0) response.code = atoi(head.c_str() + 9);
+    size_t length = head.find("Content-Length: ");
+    if (length != std::string::npos) response.contentLength = atoi(head.c_str() + length + 16);
+    return response;
+}
+
+// One request through the pool policy: reuses `fd` when the previous
+// response allowed it, reads `toRead` body bytes and reports whether the
+// connection may be reused
+bool pooledRequest(uint16_t port, int& fd, bool& reusable, size_t toRead, Response& response) {
+    if (!reusable && fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    if (fd < 0) fd = connectTo(port);
+    SocketStream socketStream(fd);
+    response = request(fd, socketStream);
+
+    ResponseBodyStream body;
+    body.attach(&socketStream);
+    char buffer[HubStandIn::BODY_SIZE];
+    size_t wanted = min(toRead, sizeof(buffer));
+    if (body.readBytes(buffer, wanted) != wanted) return false;
+    reusable = ResponseBodyStream::canReuse(response.code, body.finished(response.contentLength));
+    return true;
+}
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_only_finished_successes_are_reused() {
+    TEST_ASSERT_TRUE(ResponseBodyStream::canReuse(200, true));
+    TEST_ASSERT_TRUE(ResponseBodyStream::canReuse(204, false));
+    TEST_ASSERT_TRUE(ResponseBodyStream::canReuse(304, false));
+    TEST_ASSERT_FALSE(ResponseBodyStream::canReuse(200, false));
+    TEST_ASSERT_FALSE(ResponseBodyStream::canReuse(401, true));
+    TEST_ASSERT_FALSE(ResponseBodyStream::canReuse(500, true));
+    TEST_ASSERT_FALSE(ResponseBodyStream::canReuse(-1, true));
+    TEST_ASSERT_FALSE(ResponseBodyStream::canReuse(0, true));
+}
+
+void test_body_is_finished_once_read_to_content_length() {
+    TextStream text("0123456789");
+    ResponseBodyStream body;
+    body.attach(&text);
+
+    char buffer[10];
+    body.readBytes(buffer, 4);
+    TEST_ASSERT_FALSE(body.finished(10));
+    body.read();
+    body.peek();
+    TEST_ASSERT_EQUAL(5, body.getConsumed());
+    body.readBytes(buffer, 5);
+    TEST_ASSERT_TRUE(body.finished(10));
+    TEST_ASSERT_EQUAL(-1, body.read());
+    TEST_ASSERT_EQUAL(10, body.getConsumed());
+}
+
+void test_body_of_unknown_length_needs_marking() {
+    TextStream text("abc");
+    ResponseBodyStream body;
+    body.attach(&text);
+    char buffer[8];
+    body.readBytes(buffer, sizeof(buffer));
+
+    TEST_ASSERT_FALSE(body.finished(-1));
+    body.markComplete();
+    TEST_ASSERT_TRUE(body.finished(-1));
+}
+
+void test_empty_body_is_finished_unread() {
+    ResponseBodyStream body;
+    TEST_ASSERT_TRUE(body.finished(0));
+    TEST_ASSERT_FALSE(body.finished(1));
+}
+
+// Against the stand-in: a body abandoned halfway makes the pool drop the
+// connection, so the next request still gets a clean response. Reusing the
+// socket anyway reads the old body's tail as the next status line.
+void test_partly_read_body_is_not_reused() {
+    HubStandIn hub;
+    int fd = -1;
+    bool reusable = false;
+    Response response;
+
+    TEST_ASSERT_TRUE(pooledRequest(hub.port, fd, reusable, 100, response));
+    TEST_ASSERT_EQUAL(200, response.code);
+    TEST_ASSERT_FALSE(reusable);
+
+    TEST_ASSERT_TRUE(pooledRequest(hub.port, fd, reusable, HubStandIn::BODY_SIZE, response));
+    TEST_ASSERT_EQUAL(200, response.code);
+    TEST_ASSERT_TRUE(reusable);
+
+    // What the old policy did: reuse whatever had a status code
+    SocketStream stream(fd);
+    Response first = request(fd, stream);
+    char buffer[100];
+    stream.readBytes(buffer, sizeof(buffer));
+    Response desynced = request(fd, stream);
+    TEST_ASSERT_EQUAL(200, first.code);
+    TEST_ASSERT_TRUE(desynced.code != 200);
+    close(fd);
+}
+
+// Per-request latency against the stand-in, on a kept-alive connection and
+// with a fresh connection each time, as after a body was left unread
+void test_request_latency_against_stand_in() {
+    HubStandIn hub;
+    const size_t requests = 500;
+    Response response;
+
+    int fd = -1;
+    bool reusable = false;
+    size_t ok = 0;
+    double kept = nanosPerCall(requests, [&](size_t) {
+        ok += pooledRequest(hub.port, fd, reusable, HubStandIn::BODY_SIZE, response) && response.code == 200;
+    });
+    TEST_ASSERT_EQUAL(requests, ok);
+    close(fd);
+
+    fd = -1;
+    ok = 0;
+    double fresh = nanosPerCall(requests, [&](size_t) {
+        reusable = false;
+        ok += pooledRequest(hub.port, fd, reusable, HubStandIn::BODY_SIZE, response) && response.code == 200;
+    });
+    TEST_ASSERT_EQUAL(requests, ok);
+    close(fd);
+
+    reportBenchmark("hub request, kept-alive connection", kept);
+    reportBenchmark("hub request, new connection", fresh);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_only_finished_successes_are_reused);
+    RUN_TEST(test_body_is_finished_once_read_to_content_length);
+    RUN_TEST(test_body_of_unknown_length_needs_marking);
+    RUN_TEST(test_empty_body_is_finished_unread);
+    RUN_TEST(test_partly_read_body_is_not_reused);
+    RUN_TEST(test_request_latency_against_stand_in);
+    return UNITY_END();
+}
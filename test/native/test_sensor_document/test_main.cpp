@@ -0,0 +1,58 @@
+#include <unity.h>
+#include <math.h>
+#include "SensorDocument.h"
+
+namespace {
+
+char buffer[SensorDocument::MAX_LENGTH];
+
+}
+
+void setUp() {
+    memset(buffer, 'x', sizeof(buffer));
+}
+
+void tearDown() {}
+
+void test_readings_carry_one_decimal() {
+    size_t length = SensorDocument::format(buffer, sizeof(buffer), 21.44f, 48.0f, 1013.25f, 54.46f);
+
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"temperature\":21.4,\"humidity\":48.0,\"pressure\":1013.2,\"remote_temperature\":54.5}", buffer);
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+}
+
+void test_missing_readings_are_null() {
+    SensorDocument::format(buffer, sizeof(buffer), NAN, INFINITY, -INFINITY, NAN);
+
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"temperature\":null,\"humidity\":null,\"pressure\":null,\"remote_temperature\":null}", buffer);
+}
+
+void test_only_the_missing_reading_is_null() {
+    SensorDocument::format(buffer, sizeof(buffer), -5.0f, 30.0f, 990.0f, NAN);
+
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"temperature\":-5.0,\"humidity\":30.0,\"pressure\":990.0,\"remote_temperature\":null}", buffer);
+}
+
+void test_extreme_readings_fit_max_length() {
+    TEST_ASSERT_TRUE(SensorDocument::format(buffer, sizeof(buffer), -273.1f, 100.0f, 99999.9f, -9999.9f) > 0);
+}
+
+void test_too_small_buffer_yields_nothing() {
+    TEST_ASSERT_EQUAL(0, SensorDocument::format(buffer, 40, 21.4f, 48.0f, 1013.2f, 54.5f));
+    TEST_ASSERT_EQUAL_STRING("", buffer);
+    TEST_ASSERT_EQUAL(0, SensorDocument::format(buffer, 1, 21.4f, 48.0f, 1013.2f, 54.5f));
+    TEST_ASSERT_EQUAL_STRING("", buffer);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_readings_carry_one_decimal);
+    RUN_TEST(test_missing_readings_are_null);
+    RUN_TEST(test_only_the_missing_reading_is_null);
+    RUN_TEST(test_extreme_readings_fit_max_length);
+    RUN_TEST(test_too_small_buffer_yields_nothing);
+    return UNITY_END();
+}
@@ -0,0 +1,209 @@
+#include <unity.h>
+#include <new>
+#include "StreamedPublish.h"
+
+namespace {
+
+constexpr size_t CHUNK = 128;
+constexpr size_t MAX_BODY = 70000;
+constexpr size_t MAX_WRITES = MAX_BODY / 8;
+
+// Heap accounting for the whole test binary; a publish should not touch it
+size_t heapLive = 0;
+size_t heapPeak = 0;
+
+// Stands in for PubSubClient: records each write and can refuse bytes past
+// a limit, like a socket whose send buffer filled up
+struct MockClient {
+    bool beginResult = true;
+    bool begun = false;
+    bool ended = false;
+    unsigned int announced = 0;
+    size_t acceptLimit = SIZE_MAX;
+    uint8_t body[MAX_BODY];
+    size_t bodyLength = 0;
+    size_t writes[MAX_WRITES];
+    size_t writeCount = 0;
+
+    bool beginPublish(const char*, unsigned int length, bool) {
+        begun = beginResult;
+        announced = length;
+        return beginResult;
+    }
+
+    size_t write(const uint8_t* data, size_t size) {
+        size_t n = min(size, acceptLimit - min(acceptLimit, bodyLength));
+        memcpy(body + bodyLength, data, n);
+        bodyLength += n;
+        writes[writeCount++] = size;
+        return n;
+    }
+
+    int endPublish() {
+        ended = true;
+        return 1;
+    }
+};
+
+struct MockTransport {
+    bool stopped = false;
+    void stop() { stopped = true; }
+};
+
+MockClient client;
+MockTransport transport;
+
+uint8_t patternByte(size_t i) {
+    return static_cast<uint8_t>(i * 31 + (i >> 8));
+}
+
+// Writes `length` pattern bytes in pieces of varying size, as a serializer
+// would: single bytes, short runs and long runs
+bool writePattern(Print& out, size_t length) {
+    static uint8_t piece[1500];
+    size_t offset = 0;
+    size_t step = 0;
+    const size_t sizes[] = {1, 7, 300, 1, 1500, 64};
+    while (offset < length) {
+        size_t n = min(sizes[step++ % 6], length - offset);
+        for (size_t i = 0; i < n; i++) piece[i] = patternByte(offset + i);
+        if (n == 1) {
+            if (out.write(piece[0]) != 1) return false;
+        } else if (out.write(piece, n) != n) {
+            return false;
+        }
+        offset += n;
+    }
+    return true;
+}
+
+bool publishPattern(size_t announced, size_t produced) {
+    auto writer = [produced](Print& out) { return writePattern(out, produced); };
+    return streamPublish<CHUNK>(client, transport, "test/topic", announced, writer, false);
+}
+
+}
+
+void* operator new(size_t size) {
+    heapLive += size;
+    heapPeak = max(heapPeak, heapLive);
+    size_t* block = static_cast<size_t*>(malloc(sizeof(size_t) + size));
+    if (!block) throw std::bad_alloc();
+    *block = size;
+    return block + 1;
+}
+
+void operator delete(void* pointer) noexcept {
+    if (!pointer) return;
+    size_t* block = static_cast<size_t*>(pointer) - 1;
+    heapLive -= *block;
+    free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+void setUp() {
+    client = MockClient();
+    transport = MockTransport();
+}
+
+void tearDown() {}
+
+void test_64k_payload_goes_out_in_full_chunks() {
+    const size_t length = 64 * 1024;
+    size_t heapBefore = heapLive;
+    heapPeak = heapLive;
+
+    TEST_ASSERT_TRUE(publishPattern(length, length));
+
+    TEST_ASSERT_EQUAL(length, client.announced);
+    TEST_ASSERT_EQUAL(length, client.bodyLength);
+    TEST_ASSERT_EQUAL(length / CHUNK, client.writeCount);
+    for (size_t i = 0; i < client.writeCount; i++) {
+        TEST_ASSERT_EQUAL(CHUNK, client.writes[i]);
+    }
+    for (size_t i = 0; i < length; i++) {
+        TEST_ASSERT_EQUAL(patternByte(i), client.body[i]);
+    }
+    TEST_ASSERT_TRUE(client.ended);
+    TEST_ASSERT_FALSE(transport.stopped);
+
+    // The body is never held in memory: the only buffer is the writer's
+    // chunk, on the stack
+    TEST_ASSERT_EQUAL(heapBefore, heapPeak);
+    char line[96];
+    snprintf(line, sizeof(line), "[HEAP] 64 KB publish: heap high-water +%u bytes, writer %u bytes of stack",
+             (unsigned)(heapPeak - heapBefore), (unsigned)sizeof(ChunkedPublishWriter<CHUNK, MockClient>));
+    TEST_MESSAGE(line);
+}
+
+void test_last_chunk_carries_the_remainder() {
+    TEST_ASSERT_TRUE(publishPattern(1000, 1000));
+
+    TEST_ASSERT_EQUAL(8, client.writeCount);
+    for (size_t i = 0; i < 7; i++) {
+        TEST_ASSERT_EQUAL(CHUNK, client.writes[i]);
+    }
+    TEST_ASSERT_EQUAL(1000 - 7 * CHUNK, client.writes[7]);
+    TEST_ASSERT_EQUAL(1000, client.bodyLength);
+}
+
+void test_short_write_aborts_and_closes_socket() {
+    client.acceptLimit = 5 * CHUNK + 10;
+
+    TEST_ASSERT_FALSE(publishPattern(4096, 4096));
+
+    TEST_ASSERT_TRUE(transport.stopped);
+    TEST_ASSERT_FALSE(client.ended);
+    // Nothing more is written once a chunk has been cut short
+    TEST_ASSERT_EQUAL(6, client.writeCount);
+}
+
+void test_short_body_aborts_and_closes_socket() {
+    TEST_ASSERT_FALSE(publishPattern(1000, 999));
+
+    TEST_ASSERT_TRUE(transport.stopped);
+    TEST_ASSERT_FALSE(client.ended);
+}
+
+void test_long_body_aborts_and_closes_socket() {
+    TEST_ASSERT_FALSE(publishPattern(1000, 1001));
+
+    TEST_ASSERT_TRUE(transport.stopped);
+    TEST_ASSERT_FALSE(client.ended);
+}
+
+void test_failing_writer_aborts_and_closes_socket() {
+    auto writer = [](Print& out) {
+        out.write(reinterpret_cast<const uint8_t*>("partial"), 7);
+        return false;
+    };
+
+    TEST_ASSERT_FALSE(streamPublish<CHUNK>(client, transport, "test/topic", 7, writer, false));
+
+    TEST_ASSERT_TRUE(transport.stopped);
+    TEST_ASSERT_FALSE(client.ended);
+}
+
+void test_refused_begin_leaves_connection_alone() {
+    client.beginResult = false;
+
+    TEST_ASSERT_FALSE(publishPattern(100, 100));
+
+    TEST_ASSERT_EQUAL(0, client.writeCount);
+    TEST_ASSERT_FALSE(transport.stopped);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_64k_payload_goes_out_in_full_chunks);
+    RUN_TEST(test_last_chunk_carries_the_remainder);
+    RUN_TEST(test_short_write_aborts_and_closes_socket);
+    RUN_TEST(test_short_body_aborts_and_closes_socket);
+    RUN_TEST(test_long_body_aborts_and_closes_socket);
+    RUN_TEST(test_failing_writer_aborts_and_closes_socket);
+    RUN_TEST(test_refused_begin_leaves_connection_alone);
+    return UNITY_END();
+}
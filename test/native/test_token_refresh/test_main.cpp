@@ -0,0 +1,56 @@
+#include <unity.h>
+#include "TokenRefresh.h"
+
+namespace {
+
+// The sensorHUB token: 12 hours, renewed 10 minutes early
+constexpr unsigned long HOUR = 60UL * 60UL * 1000UL;
+constexpr unsigned long MINUTE = 60UL * 1000UL;
+constexpr TokenRefresh REFRESH = {12 * HOUR, 10 * MINUTE};
+constexpr unsigned long REFRESH_AFTER = 12 * HOUR - 10 * MINUTE;
+static_assert(REFRESH.refreshAfter() == REFRESH_AFTER, "usable in constant expressions");
+
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_fresh_token_is_not_due() {
+    TEST_ASSERT_FALSE(REFRESH.due(1000, 1000));
+    TEST_ASSERT_EQUAL(REFRESH_AFTER, REFRESH.remaining(1000, 1000));
+}
+
+void test_due_exactly_at_the_margin() {
+    const unsigned long issued = 5000;
+    TEST_ASSERT_FALSE(REFRESH.due(issued + REFRESH_AFTER - 1, issued));
+    TEST_ASSERT_EQUAL(1, REFRESH.remaining(issued + REFRESH_AFTER - 1, issued));
+    TEST_ASSERT_TRUE(REFRESH.due(issued + REFRESH_AFTER, issued));
+    TEST_ASSERT_EQUAL(0, REFRESH.remaining(issued + REFRESH_AFTER, issued));
+    TEST_ASSERT_TRUE(REFRESH.due(issued + 13 * HOUR, issued));
+}
+
+void test_correct_across_millis_wrap() {
+    // Issued an hour before millis() wraps
+    const unsigned long issued = static_cast<unsigned long>(-1) - HOUR + 1;
+    const unsigned long twoHoursLater = issued + 2 * HOUR;  // Wrapped past zero
+    TEST_ASSERT_TRUE(twoHoursLater < issued);
+    TEST_ASSERT_FALSE(REFRESH.due(twoHoursLater, issued));
+    TEST_ASSERT_EQUAL(REFRESH_AFTER - 2 * HOUR, REFRESH.remaining(twoHoursLater, issued));
+    TEST_ASSERT_TRUE(REFRESH.due(issued + REFRESH_AFTER, issued));
+}
+
+void test_margin_longer_than_lifetime_is_always_due() {
+    constexpr TokenRefresh shortLived = {MINUTE, 10 * MINUTE};
+    TEST_ASSERT_EQUAL(0, shortLived.refreshAfter());
+    TEST_ASSERT_TRUE(shortLived.due(0, 0));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_fresh_token_is_not_due);
+    RUN_TEST(test_due_exactly_at_the_margin);
+    RUN_TEST(test_correct_across_millis_wrap);
+    RUN_TEST(test_margin_longer_than_lifetime_is_always_due);
+    return UNITY_END();
+}
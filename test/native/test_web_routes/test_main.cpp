@@ -0,0 +1,221 @@
+#include <unity.h>
+#include <cstring>
+#include <string>
+#include "WebRoutes.h"
+#include "WebHandlers.h"
+#include "Benchmark.h"
+
+// The route table points at the firmware's handlers, so WebRoutes.cpp stays
+// out of the native build_src_filter and is built here against the
+// stand-ins below instead
+#include "../../../src/WebRoutes.cpp"
+
+// Each handler records its own name, so a lookup is checked by what it
+// resolved to rather than by comparing function addresses
+namespace {
+const char* called = nullptr;
+}
+
+#define TEST_HANDLER(name) \
+    void name() { called = #name; }
+
+TEST_HANDLER(handleRoot)
+TEST_HANDLER(handleScan)
+TEST_HANDLER(handleConnect)
+TEST_HANDLER(handleGetPreferences)
+TEST_HANDLER(handleSetPreferences)
+TEST_HANDLER(handleOptionsPreferences)
+TEST_HANDLER(handleIcon)
+TEST_HANDLER(handleStaticAsset)
+TEST_HANDLER(handleEvents)
+TEST_HANDLER(handleRelaySocket)
+TEST_HANDLER(handleGetSchedule)
+TEST_HANDLER(handleSetSchedule)
+TEST_HANDLER(handleMetrics)
+TEST_HANDLER(handleGetRelayState)
+TEST_HANDLER(handleSetRelayState)
+TEST_HANDLER(handleGetSession)
+TEST_HANDLER(handleLogin)
+TEST_HANDLER(handleLogout)
+TEST_HANDLER(handleSetCredentials)
+
+namespace {
+
+struct ExpectedRoute {
+    HTTPMethod method;
+    const char* path;
+    uint8_t modes;
+    const char* handler;
+    bool session;
+};
+
+// The route table as the web UI and the API clients rely on it
+const ExpectedRoute EXPECTED[] = {
+    {HTTP_GET, "/", ROUTE_ALL, "handleRoot", false},
+    {HTTP_GET, "/app.css", ROUTE_ALL, "handleStaticAsset", false},
+    {HTTP_GET, "/app.js", ROUTE_ALL, "handleStaticAsset", false},
+    {HTTP_GET, "/icon.svg", ROUTE_ALL, "handleIcon", false},
+    {HTTP_GET, "/scan", ROUTE_PORTAL, "handleScan", false},
+    {HTTP_POST, "/connect", ROUTE_PORTAL, "handleConnect", false},
+    {HTTP_GET, "/api/preferences", ROUTE_ALL, "handleGetPreferences", true},
+    {HTTP_POST, "/api/preferences", ROUTE_ALL, "handleSetPreferences", true},
+    {HTTP_OPTIONS, "/api/preferences", ROUTE_ALL, "handleOptionsPreferences", false},
+    {HTTP_GET, "/api/relay", ROUTE_ALL, "handleGetRelayState", true},
+    {HTTP_POST, "/api/relay", ROUTE_ALL, "handleSetRelayState", true},
+    {HTTP_OPTIONS, "/api/relay", ROUTE_ALL, "handleOptionsPreferences", false},
+    {HTTP_GET, "/api/relay/ws", ROUTE_ALL, "handleRelaySocket", true},
+    {HTTP_GET, "/api/schedule", ROUTE_ALL, "handleGetSchedule", true},
+    {HTTP_POST, "/api/schedule", ROUTE_ALL, "handleSetSchedule", true},
+    {HTTP_OPTIONS, "/api/schedule", ROUTE_ALL, "handleOptionsPreferences", false},
+    {HTTP_GET, "/api/events", ROUTE_ALL, "handleEvents", true},
+    {HTTP_GET, "/metrics", ROUTE_ALL, "handleMetrics", false},
+    {HTTP_GET, "/api/session", ROUTE_ALL, "handleGetSession", false},
+    {HTTP_POST, "/api/login", ROUTE_ALL, "handleLogin", false},
+    {HTTP_POST, "/api/logout", ROUTE_ALL, "handleLogout", false},
+    {HTTP_POST, "/api/credentials", ROUTE_ALL, "handleSetCredentials", true},
+};
+
+// Name of the handler a lookup resolves to, or nullptr
+const char* resolve(HTTPMethod method, const char* path, uint8_t modes, bool* needsSession = nullptr) {
+    HttpServer::RequestHandler handler = findWebRoute(method, path, modes, needsSession);
+    if (!handler) return nullptr;
+    called = nullptr;
+    handler();
+    return called;
+}
+
+// The lookup findWebRoute replaced: a scan of the table comparing paths
+bool linearLookup(HTTPMethod method, const char* path, uint8_t modes) {
+    for (const ExpectedRoute& route : EXPECTED) {
+        if (route.method == method && strcmp(route.path, path) == 0 && (route.modes & modes)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+void setUp() {
+    called = nullptr;
+}
+
+void tearDown() {}
+
+void test_every_route_resolves_to_its_handler() {
+    for (const WebRoute& route : ROUTES) {
+        TEST_ASSERT_TRUE_MESSAGE(findWebRoute(route.method, route.path, route.modes) == route.handler, route.path);
+    }
+
+    TEST_ASSERT_EQUAL(ROUTE_COUNT, sizeof(EXPECTED) / sizeof(EXPECTED[0]));
+    for (const ExpectedRoute& route : EXPECTED) {
+        const char* handler = resolve(route.method, route.path, route.modes);
+        TEST_ASSERT_NOT_NULL_MESSAGE(handler, route.path);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(route.handler, handler, route.path);
+    }
+}
+
+// A path that isn't in the table can still hash onto a used slot; only the
+// path and method comparison turns it away
+void test_unknown_paths_resolve_to_nothing() {
+    char path[48];
+    size_t onUsedSlot = 0;
+    for (unsigned i = 0; i < 2000; i++) {
+        snprintf(path, sizeof(path), "/api/unknown/%u", i);
+        size_t slot = routeHash(SLOT_TABLE.seed, HTTP_GET, path) & (SLOT_COUNT - 1);
+        onUsedSlot += SLOT_TABLE.slots[slot] != EMPTY_SLOT;
+        TEST_ASSERT_NULL_MESSAGE(findWebRoute(HTTP_GET, path, ROUTE_ALL), path);
+    }
+    TEST_ASSERT_TRUE(onUsedSlot > 0);
+
+    // Near misses of real routes
+    const char* nearMisses[] = {"", "/api/relay/", "/api/rela", "/API/relay", "/api/relay?x=1", "//",
+                                "/api/relay/ws/", "/metrics ", "app.css", "/api/sessions"};
+    for (const char* miss : nearMisses) {
+        TEST_ASSERT_NULL_MESSAGE(findWebRoute(HTTP_GET, miss, ROUTE_ALL), miss);
+    }
+}
+
+void test_known_path_with_another_method_resolves_to_nothing() {
+    TEST_ASSERT_NULL(findWebRoute(HTTP_DELETE, "/api/relay", ROUTE_ALL));
+    TEST_ASSERT_NULL(findWebRoute(HTTP_PUT, "/api/schedule", ROUTE_ALL));
+    TEST_ASSERT_NULL(findWebRoute(HTTP_POST, "/scan", ROUTE_ALL));
+    TEST_ASSERT_NULL(findWebRoute(HTTP_GET, "/connect", ROUTE_ALL));
+    TEST_ASSERT_NULL(findWebRoute(HTTP_HEAD, "/", ROUTE_ALL));
+}
+
+void test_setup_routes_are_served_only_in_the_portal() {
+    TEST_ASSERT_EQUAL_STRING("handleScan", resolve(HTTP_GET, "/scan", ROUTE_PORTAL));
+    TEST_ASSERT_EQUAL_STRING("handleConnect", resolve(HTTP_POST, "/connect", ROUTE_PORTAL));
+    TEST_ASSERT_NULL(findWebRoute(HTTP_GET, "/scan", ROUTE_PREFERENCES));
+    TEST_ASSERT_NULL(findWebRoute(HTTP_POST, "/connect", ROUTE_PREFERENCES));
+
+    // Everything else is served in both modes, and nothing in neither
+    for (const ExpectedRoute& route : EXPECTED) {
+        bool inPreferences = route.modes & ROUTE_PREFERENCES;
+        TEST_ASSERT_EQUAL_MESSAGE(inPreferences, findWebRoute(route.method, route.path, ROUTE_PREFERENCES) != nullptr,
+                                  route.path);
+        TEST_ASSERT_NOT_NULL_MESSAGE(findWebRoute(route.method, route.path, ROUTE_PORTAL), route.path);
+        TEST_ASSERT_NULL_MESSAGE(findWebRoute(route.method, route.path, 0), route.path);
+    }
+}
+
+void test_needs_session_is_reported_per_route() {
+    for (const ExpectedRoute& route : EXPECTED) {
+        bool needsSession = !route.session;
+        TEST_ASSERT_NOT_NULL(findWebRoute(route.method, route.path, ROUTE_ALL, &needsSession));
+        TEST_ASSERT_EQUAL_MESSAGE(route.session, needsSession, route.path);
+    }
+
+    // Left alone when nothing matches
+    bool needsSession = true;
+    TEST_ASSERT_NULL(findWebRoute(HTTP_GET, "/missing", ROUTE_ALL, &needsSession));
+    TEST_ASSERT_TRUE(needsSession);
+    needsSession = true;
+    TEST_ASSERT_NULL(findWebRoute(HTTP_GET, "/scan", ROUTE_PREFERENCES, &needsSession));
+    TEST_ASSERT_TRUE(needsSession);
+}
+
+void test_lookup_benchmark() {
+    const size_t COUNT = sizeof(EXPECTED) / sizeof(EXPECTED[0]);
+    const size_t ITERATIONS = 200000;
+    char unknown[COUNT][32];
+    for (size_t i = 0; i < COUNT; i++) snprintf(unknown[i], sizeof(unknown[i]), "/api/missing/%u", static_cast<unsigned>(i));
+
+    size_t hashHits = 0;
+    size_t linearHits = 0;
+    size_t misses = 0;
+    double hash = nanosPerCall(ITERATIONS, [&](size_t i) {
+        const ExpectedRoute& route = EXPECTED[i % COUNT];
+        hashHits += findWebRoute(route.method, route.path, ROUTE_PREFERENCES) != nullptr;
+    });
+    double linear = nanosPerCall(ITERATIONS, [&](size_t i) {
+        const ExpectedRoute& route = EXPECTED[i % COUNT];
+        linearHits += linearLookup(route.method, route.path, ROUTE_PREFERENCES);
+    });
+    double hashMiss = nanosPerCall(ITERATIONS, [&](size_t i) {
+        misses += findWebRoute(HTTP_GET, unknown[i % COUNT], ROUTE_ALL) != nullptr;
+    });
+    double linearMiss = nanosPerCall(ITERATIONS, [&](size_t i) {
+        misses += linearLookup(HTTP_GET, unknown[i % COUNT], ROUTE_ALL);
+    });
+
+    TEST_ASSERT_EQUAL(linearHits, hashHits);
+    TEST_ASSERT_TRUE(hashHits > 0);
+    TEST_ASSERT_EQUAL(0, misses);
+    reportBenchmark("findWebRoute, known routes", hash);
+    reportBenchmark("linear scan, known routes", linear);
+    reportBenchmark("findWebRoute, unknown paths", hashMiss);
+    reportBenchmark("linear scan, unknown paths", linearMiss);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_route_resolves_to_its_handler);
+    RUN_TEST(test_unknown_paths_resolve_to_nothing);
+    RUN_TEST(test_known_path_with_another_method_resolves_to_nothing);
+    RUN_TEST(test_setup_routes_are_served_only_in_the_portal);
+    RUN_TEST(test_needs_session_is_reported_per_route);
+    RUN_TEST(test_lookup_benchmark);
+    return UNITY_END();
+}
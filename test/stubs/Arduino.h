@@ -0,0 +1,162 @@
+// Arduino.h stand-in for the host unit tests (pio test -e native). Only what
+// the hardware-independent modules use: fixed-width types, String, millis()
+// on a clock the tests set, map()/constrain(), Print/Stream, a silent Serial
+// and an ESP whose heap figures the tests set.
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <strings.h>
+#include <cmath>
+#include <cstdarg>
+#include <string>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+typedef const char* PGM_P;
+typedef uint8_t byte;
+
+// Test clock: millis() returns whatever the test last set
+inline unsigned long& testMillis() {
+    static unsigned long now = 0;
+    return now;
+}
+
+inline unsigned long millis() {
+    return testMillis();
+}
+
+inline unsigned long micros() {
+    return testMillis() * 1000UL;
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// newlib has strlcpy; glibc only since 2.38
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char* destination, const char* source, size_t size) {
+    size_t length = strlen(source);
+    if (size > 0) {
+        size_t copied = length < size - 1 ? length : size - 1;
+        memcpy(destination, source, copied);
+        destination[copied] = '\0';
+    }
+    return length;
+}
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class String {
+public:
+    String(const char* text = "") : _text(text ? text : "") {}
+    String(const std::string& text) : _text(text) {}
+    explicit String(unsigned long number) : _text(std::to_string(number)) {}
+
+    const char* c_str() const { return _text.c_str(); }
+    unsigned int length() const { return _text.length(); }
+    bool isEmpty() const { return _text.empty(); }
+    bool reserve(unsigned int size) { _text.reserve(size); return true; }
+    bool startsWith(const char* prefix) const { return _text.compare(0, strlen(prefix), prefix) == 0; }
+    bool concat(const char* text, unsigned int length) { _text.append(text, length); return true; }
+
+    String& operator+=(const String& other) { _text += other._text; return *this; }
+    String& operator+=(const char* other) { _text += other; return *this; }
+    String& operator+=(char c) { _text += c; return *this; }
+    bool operator==(const String& other) const { return _text == other._text; }
+    bool operator==(const char* other) const { return _text == other; }
+    bool operator!=(const String& other) const { return _text != other._text; }
+
+    friend String operator+(const String& a, const String& b) { return String(a._text + b._text); }
+
+private:
+    std::string _text;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* data, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*data++);
+        return n;
+    }
+    virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    virtual size_t readBytes(char* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int c = read();
+            if (c < 0) break;
+            buffer[count++] = static_cast<char>(c);
+        }
+        return count;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) {
+        return readBytes(reinterpret_cast<char*>(buffer), length);
+    }
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+
+    // Reads up to and including `target`; false if the stream ends first
+    bool find(const char* target) {
+        size_t matched = 0;
+        size_t length = strlen(target);
+        while (matched < length) {
+            int c = read();
+            if (c < 0) return false;
+            matched = c == target[matched] ? matched + 1 : (c == target[0] ? 1 : 0);
+        }
+        return true;
+    }
+    bool find(char target) {
+        char text[2] = {target, '\0'};
+        return find(text);
+    }
+
+protected:
+    unsigned long _timeout = 1000;
+};
+
+class HardwareSerial {
+public:
+    int printf(const char*, ...) { return 0; }
+    size_t print(const char*) { return 0; }
+    size_t println(const char* = "") { return 0; }
+    size_t println(const String&) { return 0; }
+};
+
+static HardwareSerial Serial __attribute__((unused));
+
+class EspClass {
+public:
+    uint32_t getFreeHeap() { return freeHeap; }
+    uint32_t getMinFreeHeap() { return minFreeHeap; }
+    uint32_t getMaxAllocHeap() { return maxAllocHeap; }
+
+    uint32_t freeHeap = 0;
+    uint32_t minFreeHeap = 0;
+    uint32_t maxAllocHeap = 0;
+};
+
+inline EspClass& testEsp() {
+    static EspClass esp;
+    return esp;
+}
+
+#define ESP testEsp()
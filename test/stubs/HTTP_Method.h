@@ -0,0 +1,16 @@
+// HTTP_Method.h stand-in: the method enum the ESP32 WebServer library takes
+// from http_parser
+#pragma once
+
+enum http_method {
+    HTTP_DELETE = 0,
+    HTTP_GET = 1,
+    HTTP_HEAD = 2,
+    HTTP_POST = 3,
+    HTTP_PUT = 4,
+    HTTP_OPTIONS = 6,
+    HTTP_PATCH = 28
+};
+typedef enum http_method HTTPMethod;
+
+#define HTTP_ANY (HTTPMethod)(255)
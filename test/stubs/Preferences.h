@@ -0,0 +1,42 @@
+// Preferences.h stand-in: NVS as an in-memory map the tests can inspect and
+// clear. A handle opened read-only refuses writes, as on the device.
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+
+// Every namespace's keys, stored as "namespace/key"
+inline std::map<std::string, String>& testPreferences() {
+    static std::map<std::string, String> values;
+    return values;
+}
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr) {
+        _name = name;
+        _readOnly = readOnly;
+        _open = true;
+        return true;
+    }
+
+    void end() { _open = false; }
+
+    String getString(const char* key, const String defaultValue = String()) {
+        auto it = testPreferences().find(path(key));
+        return _open && it != testPreferences().end() ? it->second : defaultValue;
+    }
+
+    size_t putString(const char* key, const String& value) {
+        if (!_open || _readOnly) return 0;
+        testPreferences()[path(key)] = value;
+        return value.length();
+    }
+
+private:
+    std::string path(const char* key) const { return _name + "/" + key; }
+
+    std::string _name;
+    bool _readOnly = true;
+    bool _open = false;
+};
@@ -0,0 +1,2 @@
+// SPIFFS stand-in for the host unit tests; nothing under test touches flash
+#pragma once
@@ -0,0 +1,71 @@
+// WiFiClient.h stand-in: a Stream over a host socket. As on the ESP32, copies
+// share the socket, which closes once the last of them lets go of it.
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+#include <lwip/sockets.h>
+
+class WiFiClient : public Stream {
+public:
+    WiFiClient() {}
+    explicit WiFiClient(int fd) : handle(std::make_shared<Handle>(fd)) {}
+
+    int fd() const { return handle ? handle->fd : -1; }
+    explicit operator bool() { return connected(); }
+
+    uint8_t connected() {
+        if (!handle) return 0;
+        char c;
+        ssize_t received = recv(handle->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+        return received > 0 || (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+    }
+
+    void stop() { handle.reset(); }
+
+    int setNoDelay(bool enable) {
+        int value = enable;
+        return setsockopt(fd(), IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+    }
+
+    int available() override {
+        int count = 0;
+        if (!handle || ioctl(handle->fd, FIONREAD, &count) < 0) return 0;
+        return count;
+    }
+
+    int read() override {
+        uint8_t c;
+        return handle && recv(handle->fd, &c, 1, MSG_DONTWAIT) == 1 ? c : -1;
+    }
+
+    int read(uint8_t* buffer, size_t size) {
+        if (!handle) return -1;
+        ssize_t received = recv(handle->fd, buffer, size, MSG_DONTWAIT);
+        return received < 0 ? -1 : static_cast<int>(received);
+    }
+
+    int peek() override {
+        uint8_t c;
+        return handle && recv(handle->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+    }
+
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        if (!handle) return 0;
+        ssize_t written = send(handle->fd, data, size, MSG_NOSIGNAL);
+        return written < 0 ? 0 : static_cast<size_t>(written);
+    }
+
+private:
+    struct Handle {
+        explicit Handle(int fd) : fd(fd) {}
+        ~Handle() { ::close(fd); }
+        int fd;
+    };
+
+    std::shared_ptr<Handle> handle;
+};
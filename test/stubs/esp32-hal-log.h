@@ -0,0 +1,8 @@
+// esp32-hal-log.h stand-in: the core's log macros, silent on the host
+#pragma once
+
+#define log_e(format, ...)
+#define log_w(format, ...)
+#define log_i(format, ...)
+#define log_d(format, ...)
+#define log_v(format, ...)
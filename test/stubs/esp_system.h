@@ -0,0 +1,18 @@
+// esp_system.h stand-in: esp_fill_random() from a fixed-seed generator, so
+// tokens differ from one another but a test run is repeatable
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+inline void esp_fill_random(void* buffer, size_t length) {
+    static uint32_t state = 0x2545F491;
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    for (size_t i = 0; i < length; i++) {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        out[i] = static_cast<uint8_t>(state);
+    }
+}
@@ -0,0 +1,8 @@
+// esp_timer.h stand-in: the microsecond clock follows the test clock
+#pragma once
+
+#include <Arduino.h>
+
+inline int64_t esp_timer_get_time() {
+    return static_cast<int64_t>(micros());
+}
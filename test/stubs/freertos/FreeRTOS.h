@@ -0,0 +1,49 @@
+// FreeRTOS stand-in for the host unit tests. Queues, semaphores, event groups
+// and tasks are emulated with std::thread primitives, so code that hands work
+// between tasks can be driven from a test. A tick is one real millisecond;
+// it has nothing to do with the millis() test clock in Arduino.h.
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t EventBits_t;
+typedef void* TaskHandle_t;
+typedef void* QueueHandle_t;
+typedef void* SemaphoreHandle_t;
+typedef void* EventGroupHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define portTICK_PERIOD_MS 1
+#define configTICK_RATE_HZ 1000
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+#define BIT0 0x01
+#define BIT1 0x02
+#define BIT2 0x04
+#define BIT3 0x08
+
+namespace hostrtos {
+
+// Waits on `changed` until `ready` holds or `ticks` run out; true if it holds
+template <typename Predicate>
+bool waitFor(std::unique_lock<std::mutex>& lock, std::condition_variable& changed, TickType_t ticks,
+             Predicate ready) {
+    if (ticks == portMAX_DELAY) {
+        changed.wait(lock, ready);
+        return true;
+    }
+    return changed.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+}
@@ -0,0 +1,51 @@
+// FreeRTOS event group stand-in
+#pragma once
+
+#include "FreeRTOS.h"
+
+namespace hostrtos {
+
+struct EventGroup {
+    std::mutex mutex;
+    std::condition_variable changed;
+    EventBits_t bits = 0;
+};
+
+}
+
+inline EventGroupHandle_t xEventGroupCreate() {
+    return new hostrtos::EventGroup();
+}
+
+inline EventBits_t xEventGroupGetBits(EventGroupHandle_t handle) {
+    hostrtos::EventGroup& group = *static_cast<hostrtos::EventGroup*>(handle);
+    std::lock_guard<std::mutex> lock(group.mutex);
+    return group.bits;
+}
+
+inline EventBits_t xEventGroupSetBits(EventGroupHandle_t handle, EventBits_t bits) {
+    hostrtos::EventGroup& group = *static_cast<hostrtos::EventGroup*>(handle);
+    std::lock_guard<std::mutex> lock(group.mutex);
+    group.bits |= bits;
+    group.changed.notify_all();
+    return group.bits;
+}
+
+inline EventBits_t xEventGroupClearBits(EventGroupHandle_t handle, EventBits_t bits) {
+    hostrtos::EventGroup& group = *static_cast<hostrtos::EventGroup*>(handle);
+    std::lock_guard<std::mutex> lock(group.mutex);
+    EventBits_t before = group.bits;
+    group.bits &= ~bits;
+    return before;
+}
+
+inline EventBits_t xEventGroupWaitBits(EventGroupHandle_t handle, EventBits_t bits, BaseType_t clearOnExit,
+                                       BaseType_t waitForAll, TickType_t wait) {
+    hostrtos::EventGroup& group = *static_cast<hostrtos::EventGroup*>(handle);
+    std::unique_lock<std::mutex> lock(group.mutex);
+    auto ready = [&] { return waitForAll ? (group.bits & bits) == bits : (group.bits & bits) != 0; };
+    hostrtos::waitFor(lock, group.changed, wait, ready);
+    EventBits_t result = group.bits;
+    if (clearOnExit && ready()) group.bits &= ~bits;
+    return result;
+}
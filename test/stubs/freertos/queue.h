@@ -0,0 +1,72 @@
+// FreeRTOS queue stand-in: a bounded FIFO of fixed-size items that blocks
+// across threads like the real one
+#pragma once
+
+#include <cstring>
+#include <deque>
+#include <vector>
+#include "FreeRTOS.h"
+
+namespace hostrtos {
+
+struct Queue {
+    Queue(size_t length, size_t itemSize) : length(length), itemSize(itemSize) {}
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::vector<uint8_t>> items;
+    size_t length;
+    size_t itemSize;
+};
+
+}
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    return new hostrtos::Queue(length, itemSize);
+}
+
+inline void vQueueDelete(QueueHandle_t handle) {
+    delete static_cast<hostrtos::Queue*>(handle);
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t handle, const void* item, TickType_t wait) {
+    hostrtos::Queue& queue = *static_cast<hostrtos::Queue*>(handle);
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    if (!hostrtos::waitFor(lock, queue.changed, wait, [&] { return queue.items.size() < queue.length; })) {
+        return pdFALSE;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    queue.items.emplace_back(bytes, bytes + queue.itemSize);
+    queue.changed.notify_all();
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueSendToBack(QueueHandle_t handle, const void* item, TickType_t wait) {
+    return xQueueSend(handle, item, wait);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t handle, void* item, TickType_t wait) {
+    hostrtos::Queue& queue = *static_cast<hostrtos::Queue*>(handle);
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    if (!hostrtos::waitFor(lock, queue.changed, wait, [&] { return !queue.items.empty(); })) {
+        return pdFALSE;
+    }
+    memcpy(item, queue.items.front().data(), queue.itemSize);
+    queue.items.pop_front();
+    queue.changed.notify_all();
+    return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t handle) {
+    hostrtos::Queue& queue = *static_cast<hostrtos::Queue*>(handle);
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    return queue.items.size();
+}
+
+inline BaseType_t xQueueReset(QueueHandle_t handle) {
+    hostrtos::Queue& queue = *static_cast<hostrtos::Queue*>(handle);
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.items.clear();
+    queue.changed.notify_all();
+    return pdPASS;
+}
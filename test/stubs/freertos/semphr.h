@@ -0,0 +1,53 @@
+// FreeRTOS semaphore stand-in. Mutexes are binary semaphores that start
+// given; like the real ones they are not recursive.
+#pragma once
+
+#include "FreeRTOS.h"
+
+namespace hostrtos {
+
+struct Semaphore {
+    Semaphore(UBaseType_t maximum, UBaseType_t initial) : count(initial), maximum(maximum) {}
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    UBaseType_t count;
+    UBaseType_t maximum;
+};
+
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new hostrtos::Semaphore(1, 1);
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return new hostrtos::Semaphore(1, 0);
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maximum, UBaseType_t initial) {
+    return new hostrtos::Semaphore(maximum, initial);
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t handle) {
+    delete static_cast<hostrtos::Semaphore*>(handle);
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t wait) {
+    hostrtos::Semaphore& semaphore = *static_cast<hostrtos::Semaphore*>(handle);
+    std::unique_lock<std::mutex> lock(semaphore.mutex);
+    if (!hostrtos::waitFor(lock, semaphore.changed, wait, [&] { return semaphore.count > 0; })) {
+        return pdFALSE;
+    }
+    semaphore.count--;
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t handle) {
+    hostrtos::Semaphore& semaphore = *static_cast<hostrtos::Semaphore*>(handle);
+    std::lock_guard<std::mutex> lock(semaphore.mutex);
+    if (semaphore.count >= semaphore.maximum) return pdFALSE;
+    semaphore.count++;
+    semaphore.changed.notify_all();
+    return pdTRUE;
+}
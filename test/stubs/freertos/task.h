@@ -0,0 +1,87 @@
+// FreeRTOS task stand-in: each task is a detached std::thread. A task that
+// never returns keeps running until the test binary exits, so suites drive
+// one step of a task loop themselves where they can.
+#pragma once
+
+#include <thread>
+#include "FreeRTOS.h"
+
+namespace hostrtos {
+
+struct Task {
+    std::mutex mutex;
+    std::condition_variable notified;
+    uint32_t notifications = 0;
+};
+
+inline Task*& currentTask() {
+    static thread_local Task* task = nullptr;
+    return task;
+}
+
+inline std::chrono::steady_clock::time_point bootTime() {
+    static const std::chrono::steady_clock::time_point boot = std::chrono::steady_clock::now();
+    return boot;
+}
+
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char*, uint32_t, void* parameter,
+                                          UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+    hostrtos::Task* task = new hostrtos::Task();
+    if (handle) *handle = task;
+    std::thread([function, parameter, task] {
+        hostrtos::currentTask() = task;
+        function(parameter);
+    }).detach();
+    return pdPASS;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackSize, void* parameter,
+                              UBaseType_t priority, TaskHandle_t* handle) {
+    return xTaskCreatePinnedToCore(function, name, stackSize, parameter, priority, handle, 0);
+}
+
+// Only the calling task can end itself on the host; its function returns next
+inline void vTaskDelete(TaskHandle_t) {}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+    hostrtos::Task*& task = hostrtos::currentTask();
+    if (!task) task = new hostrtos::Task();
+    return task;
+}
+
+inline TickType_t xTaskGetTickCount() {
+    auto elapsed = std::chrono::steady_clock::now() - hostrtos::bootTime();
+    return static_cast<TickType_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+inline void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+inline void vTaskDelayUntil(TickType_t* previousWake, TickType_t period) {
+    *previousWake += period;
+    TickType_t now = xTaskGetTickCount();
+    if (static_cast<int32_t>(*previousWake - now) > 0) vTaskDelay(*previousWake - now);
+}
+
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) {
+    return 0;
+}
+
+inline void xTaskNotifyGive(TaskHandle_t handle) {
+    hostrtos::Task& task = *static_cast<hostrtos::Task*>(handle);
+    std::lock_guard<std::mutex> lock(task.mutex);
+    task.notifications++;
+    task.notified.notify_all();
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t wait) {
+    hostrtos::Task& task = *static_cast<hostrtos::Task*>(xTaskGetCurrentTaskHandle());
+    std::unique_lock<std::mutex> lock(task.mutex);
+    if (!hostrtos::waitFor(lock, task.notified, wait, [&] { return task.notifications > 0; })) return 0;
+    uint32_t count = task.notifications;
+    task.notifications = clearOnExit ? 0 : count - 1;
+    return count;
+}
@@ -0,0 +1,52 @@
+// Benchmark.h
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <unity.h>
+
+// Host timing for the native suites. The figures are printed with the test
+// output rather than asserted, since they depend on the machine running them;
+// they are for comparing one change against the next on the same host.
+
+// Average wall-clock cost of one call to `body`, in nanoseconds
+template <typename Body>
+double nanosPerCall(size_t iterations, Body body) {
+    auto started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) body(i);
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+inline void reportBenchmark(const char* name, double nanos) {
+    char line[128];
+    snprintf(line, sizeof(line), "[BENCH] %s: %.1f ns", name, nanos);
+    TEST_MESSAGE(line);
+}
+
+// Value below which `percent` of the samples fall, nearest-rank
+inline double percentile(std::vector<double> samples, double percent) {
+    if (samples.empty()) return 0;
+    std::sort(samples.begin(), samples.end());
+    size_t rank = static_cast<size_t>(percent / 100 * samples.size() + 0.999999);
+    return samples[rank > 0 ? rank - 1 : 0];
+}
+
+// Throughput and tail latency of a load run; `latencies` in microseconds
+inline void reportLoad(const char* name, size_t requests, double seconds, const std::vector<double>& latencies) {
+    char line[160];
+    snprintf(line, sizeof(line), "[BENCH] %s: %u requests, %.0f req/s, p50 %.0f us, p99 %.0f us",
+             name, static_cast<unsigned>(requests), requests / seconds,
+             percentile(latencies, 50), percentile(latencies, 99));
+    TEST_MESSAGE(line);
+}
+
+// Tail latency of a series of round trips; `latencies` in microseconds
+inline void reportLatency(const char* name, const std::vector<double>& latencies) {
+    char line[128];
+    snprintf(line, sizeof(line), "[BENCH] %s: p50 %.0f us, p99 %.0f us",
+             name, percentile(latencies, 50), percentile(latencies, 99));
+    TEST_MESSAGE(line);
+}
@@ -0,0 +1,44 @@
+// CaptureStream.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ResponseStream.h"
+
+// Collects a streamed response in memory; refuses every chunk after
+// `acceptChunks`, like a client that went away
+class CaptureStream : public ResponseStream {
+public:
+    explicit CaptureStream(size_t acceptChunks = SIZE_MAX) : acceptChunks(acceptChunks) {}
+
+    bool beginChunked(int statusCode, const char* type) override {
+        code = statusCode;
+        contentType = type;
+        return true;
+    }
+
+    bool sendChunk(const char* data, size_t length) override {
+        chunks++;
+        largestChunk = length > largestChunk ? length : largestChunk;
+        if (chunks > acceptChunks) return false;
+        body.append(data, length);
+        chunkEnds.push_back(body.size());
+        return true;
+    }
+
+    void endChunked() override {
+        ends++;
+    }
+
+    std::string body;
+    std::string contentType;
+    std::vector<size_t> chunkEnds;  // Offset in body where each accepted chunk ends
+    int code = 0;
+    size_t chunks = 0;
+    size_t largestChunk = 0;
+    size_t ends = 0;
+
+private:
+    size_t acceptChunks;
+};
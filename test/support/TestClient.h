@@ -0,0 +1,132 @@
+// TestClient.h
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// One HTTP response as read off the wire
+struct TestResponse {
+    int code = 0;
+    std::string head;   // Status line and headers, without the blank line
+    std::string body;
+
+    // Value of the first header called `name`, or "" when there is none
+    std::string header(const char* name) const {
+        std::string marker = std::string("\r\n") + name + ": ";
+        size_t start = head.find(marker);
+        if (start == std::string::npos) return "";
+        start += marker.size();
+        return head.substr(start, head.find("\r\n", start) - start);
+    }
+};
+
+// Blocking loopback client for the suites that drive a server over real
+// sockets. Every read gives up after TIMEOUT_MS, so a server that never
+// answers fails the test instead of hanging it.
+class TestClient {
+public:
+    static constexpr int TIMEOUT_MS = 2000;
+
+    explicit TestClient(uint16_t port) : fd(socket(AF_INET, SOCK_STREAM, 0)) {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        timeval timeout = {TIMEOUT_MS / 1000, (TIMEOUT_MS % 1000) * 1000};
+        int enable = 1;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    ~TestClient() { close(); }
+
+    TestClient(const TestClient&) = delete;
+    TestClient& operator=(const TestClient&) = delete;
+
+    bool isOpen() const { return fd >= 0; }
+    int socketFd() const { return fd; }
+
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    bool send(const std::string& data) {
+        return fd >= 0 && ::send(fd, data.data(), data.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(data.size());
+    }
+
+    // Reads through the next occurrence of `marker`; what follows it stays
+    // buffered for the next read
+    bool readUntil(const std::string& marker, std::string& out) {
+        size_t end;
+        while ((end = buffer.find(marker)) == std::string::npos) {
+            if (!fill()) return false;
+        }
+        out = buffer.substr(0, end + marker.size());
+        buffer.erase(0, end + marker.size());
+        return true;
+    }
+
+    bool readExactly(size_t length, std::string& out) {
+        while (buffer.size() < length) {
+            if (!fill()) return false;
+        }
+        out = buffer.substr(0, length);
+        buffer.erase(0, length);
+        return true;
+    }
+
+    // A response with a Content-Length or chunked body
+    bool readResponse(TestResponse& response) {
+        std::string head;
+        if (!readUntil("\r\n\r\n", head)) return false;
+        response.head = head.substr(0, head.size() - 2);
+        response.code = head.compare(0, 9, "HTTP/1.1 ") == 0 ? atoi(head.c_str() + 9) : 0;
+        if (response.header("Transfer-Encoding") == "chunked") return readChunked(response.body);
+        std::string length = response.header("Content-Length");
+        return readExactly(length.empty() ? 0 : strtoul(length.c_str(), nullptr, 10), response.body);
+    }
+
+    // Whether the server closed the connection, waiting up to TIMEOUT_MS for
+    // it; anything still unread counts as open
+    bool closedByPeer() {
+        return buffer.empty() && !fill() && lastReceived == 0;
+    }
+
+private:
+    bool readChunked(std::string& body) {
+        body.clear();
+        std::string line;
+        std::string data;
+        while (readUntil("\r\n", line)) {
+            size_t length = strtoul(line.c_str(), nullptr, 16);
+            if (!readExactly(length + 2, data)) return false;
+            if (length == 0) return true;
+            body.append(data, 0, length);
+        }
+        return false;
+    }
+
+    bool fill() {
+        char chunk[4096];
+        lastReceived = recv(fd, chunk, sizeof(chunk), 0);
+        if (lastReceived <= 0) return false;
+        buffer.append(chunk, lastReceived);
+        return true;
+    }
+
+    int fd;
+    std::string buffer;
+    ssize_t lastReceived = -1;
+};
@@ -0,0 +1,145 @@
+"""Build step: turn the web UI sources into pre-gzipped PROGMEM assets.
+
+Reads the page literals in include/WebContent.h and the SVG icons in
+include/icons.h, minifies them, gzips them and writes include/WebAssetsData.h
+with one byte array, length and content-hash ETag per asset. Each asset is
+decompressed again and compared with its minified source before anything is
+written, and the size reduction is reported.
+
+Runs as a PlatformIO pre-build script (extra_scripts = pre:tools/build_assets.py)
+or standalone: python3 tools/build_assets.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+# (C identifier in the sources, asset name served by the web server, content type).
+# Shared assets come first: a later asset may reference one as {{name}}, which
+# is replaced with its content hash to bust the browser cache when it changes.
+ASSETS = [
+    ("APP_CSS", "app.css", "text/css"),
+    ("APP_JS", "app.js", "application/javascript"),
+    ("SETUP_PAGE_HTML", "setup.html", "text/html"),
+    ("PREFERENCES_PAGE_HTML", "preferences.html", "text/html"),
+    ("LOCK_ICON", "lock", "image/svg+xml"),
+    ("SIGNAL_WEAK", "signal-1", "image/svg+xml"),
+    ("SIGNAL_FAIR", "signal-2", "image/svg+xml"),
+    ("SIGNAL_GOOD", "signal-3", "image/svg+xml"),
+    ("SIGNAL_STRONG", "signal-4", "image/svg+xml"),
+]
+
+SOURCES = ["include/WebContent.h", "include/icons.h"]
+OUTPUT = "include/WebAssetsData.h"
+
+RAW_LITERAL = re.compile(r'const char (\w+)\[\] PROGMEM = R"rawliteral\((.*?)\)rawliteral";', re.S)
+STRING_LITERAL = re.compile(r'const char (\w+)\[\] PROGMEM = "((?:[^"\\]|\\.)*)";')
+PLACEHOLDER = re.compile(r"\{\{([\w.-]+)\}\}")
+BLOCK_COMMENT_LINE = re.compile(r"^/\*.*\*/$")
+TRAILING_COMMENT = re.compile(r"(?<=[;{}])\s+//.*$")
+
+
+def extract_literals(text):
+    literals = {name: body for name, body in RAW_LITERAL.findall(text)}
+    for name, body in STRING_LITERAL.findall(text):
+        literals[name] = bytes(body, "utf-8").decode("unicode_escape")
+    return literals
+
+
+def minify(text):
+    """Conservative minifier: keeps line breaks so inline scripts still get
+    automatic semicolon insertion, and only drops whole-line comments."""
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//") or BLOCK_COMMENT_LINE.match(line):
+            continue
+        if line.startswith("<!--") and line.endswith("-->"):
+            continue
+        lines.append(TRAILING_COMMENT.sub("", line))
+    return "\n".join(lines)
+
+
+def c_identifier(name):
+    return re.sub(r"\W", "_", name).upper()
+
+
+def format_bytes(data):
+    rows = []
+    for i in range(0, len(data), 16):
+        rows.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(rows)
+
+
+def build(project_dir):
+    literals = {}
+    for source in SOURCES:
+        with open(os.path.join(project_dir, source), encoding="utf-8") as f:
+            literals.update(extract_literals(f.read()))
+
+    parts = [
+        "// WebAssetsData.h",
+        "// Generated by tools/build_assets.py from " + " and ".join(SOURCES) + ". Do not edit.",
+        "#pragma once",
+        "",
+        "#include \"WebAssets.h\"",
+        "",
+    ]
+    entries = []
+    hashes = {}
+    total_source = total_gzip = 0
+
+    for symbol, name, content_type in ASSETS:
+        if symbol not in literals:
+            sys.exit("build_assets: %s not found in %s" % (symbol, ", ".join(SOURCES)))
+
+        source = literals[symbol].encode("utf-8")
+        try:
+            text = PLACEHOLDER.sub(lambda m: hashes[m.group(1)], literals[symbol])
+        except KeyError as e:
+            sys.exit("build_assets: %s references unknown asset %s" % (name, e))
+        minified = minify(text).encode("utf-8")
+        # mtime=0 keeps the output byte-identical across builds
+        compressed = gzip.compress(minified, compresslevel=9, mtime=0)
+        if gzip.decompress(compressed) != minified:
+            sys.exit("build_assets: round trip mismatch for %s" % name)
+
+        digest = hashlib.sha256(minified).hexdigest()[:16]
+        hashes[name] = digest
+        ident = c_identifier(name)
+        parts += [
+            "static const uint8_t ASSET_%s[] PROGMEM = {" % ident,
+            format_bytes(compressed),
+            "};",
+            "",
+        ]
+        entries.append('    {"%s", "%s", ASSET_%s, %d, "\\"%s\\""},'
+                       % (name, content_type, ident, len(compressed), digest))
+
+        total_source += len(source)
+        total_gzip += len(compressed)
+        print("build_assets: %-18s %6d -> %6d min -> %6d gz (%.0f%%)"
+              % (name, len(source), len(minified), len(compressed), 100.0 * len(compressed) / len(source)))
+
+    parts += ["static const WebAsset WEB_ASSETS[] = {"] + entries + ["};", ""]
+    print("build_assets: total %d -> %d bytes" % (total_source, total_gzip))
+
+    output = os.path.join(project_dir, OUTPUT)
+    content = "\n".join(parts)
+    try:
+        with open(output, encoding="utf-8") as f:
+            if f.read() == content:
+                return  # Unchanged; don't trigger a rebuild
+    except FileNotFoundError:
+        pass
+    with open(output, "w", encoding="utf-8") as f:
+        f.write(content)
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO's SCons environment
+    build(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    build(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))